@@ -0,0 +1,153 @@
+//
+//  AnimationClips.cpp
+//  SweetSweetBetrayal
+//
+
+#include "AnimationClips.h"
+#include <unordered_map>
+
+using namespace cugl;
+using namespace cugl::graphics;
+
+/** The clips, by texture and layout */
+static std::unordered_map<std::string, std::shared_ptr<AnimationClip>> CLIPS;
+/** The frame sequences, by playback and length */
+static std::unordered_map<std::string, std::shared_ptr<const std::vector<int>>> SEQUENCES;
+
+#pragma mark -
+#pragma mark Animation Clip
+/**
+ * Initializes a clip for the given sheet and frame sequence.
+ *
+ * @param texture   The texture key of the sheet
+ * @param rows      The rows of the sheet
+ * @param cols      The columns of the sheet
+ * @param size      The number of frames in the sheet
+ * @param frames    The frame sequence
+ *
+ * @return true if the clip was initialized properly
+ */
+bool AnimationClip::init(const std::string& texture, int rows, int cols, int size,
+                         const std::shared_ptr<const std::vector<int>>& frames) {
+    if (rows < 1 || cols < 1 || size < 1 || size > rows * cols || frames == nullptr || frames->empty()) {
+        return false;
+    }
+    _texture = texture;
+    _rows = rows;
+    _cols = cols;
+    _size = size;
+    _frames = frames;
+    return true;
+}
+
+/**
+ * Returns a new sprite node for the sheet of this clip.
+ *
+ * @param assets    The asset manager with the texture
+ *
+ * @return a new sprite node (nullptr if the texture is not loaded)
+ */
+std::shared_ptr<scene2::SpriteNode> AnimationClip::allocNode(const std::shared_ptr<AssetManager>& assets) const {
+    std::shared_ptr<Texture> texture = assets->get<Texture>(_texture);
+    if (texture == nullptr) {
+        CULogError("Animation texture %s is not loaded", _texture.c_str());
+        return nullptr;
+    }
+    return scene2::SpriteNode::allocWithSheet(texture, _rows, _cols, _size);
+}
+
+#pragma mark -
+#pragma mark Library
+/**
+ * Returns the frame sequence for the given playback and length.
+ *
+ * @param playback  The order the frames are played in
+ * @param length    The number of frames played
+ */
+static std::shared_ptr<const std::vector<int>> getSequence(AnimationClip::Playback playback, int length) {
+    std::string key = std::to_string((int)playback) + ":" + std::to_string(length);
+    auto it = SEQUENCES.find(key);
+    if (it != SEQUENCES.end()) {
+        return it->second;
+    }
+
+    std::vector<int> frames;
+    frames.reserve(length);
+    switch (playback) {
+        case AnimationClip::Playback::LOOP:
+            for (int ii = 1; ii < length; ii++) {
+                frames.push_back(ii);
+            }
+            // Loop back to beginning
+            frames.push_back(0);
+            break;
+        case AnimationClip::Playback::FORWARD:
+            for (int ii = 0; ii < length; ii++) {
+                frames.push_back(ii);
+            }
+            break;
+        case AnimationClip::Playback::SKIP_FIRST:
+            for (int ii = 1; ii < length; ii++) {
+                frames.push_back(ii);
+            }
+            break;
+        case AnimationClip::Playback::HOLD:
+            frames.assign(length, 0);
+            break;
+    }
+    if (frames.empty()) {
+        frames.push_back(0);
+    }
+
+    auto sequence = std::make_shared<const std::vector<int>>(std::move(frames));
+    SEQUENCES[key] = sequence;
+    return sequence;
+}
+
+/**
+ * Returns the clip for the given sheet and playback.
+ *
+ * @param texture   The texture key of the sheet
+ * @param rows      The rows of the sheet
+ * @param cols      The columns of the sheet
+ * @param size      The number of frames in the sheet
+ * @param playback  The order the frames are played in
+ * @param length    The number of frames played (0 for the whole sheet)
+ *
+ * @return the shared clip (nullptr if the layout is invalid)
+ */
+std::shared_ptr<AnimationClip> AnimationClips::get(const std::string& texture, int rows, int cols, int size,
+                                                   AnimationClip::Playback playback, int length) {
+    if (length <= 0 || length > size) {
+        length = size;
+    }
+    std::string key = texture + ":" + std::to_string(rows) + "x" + std::to_string(cols) + ":" +
+                      std::to_string(size) + ":" + std::to_string((int)playback) + ":" + std::to_string(length);
+    auto it = CLIPS.find(key);
+    if (it != CLIPS.end()) {
+        return it->second;
+    }
+
+    std::shared_ptr<AnimationClip> clip = AnimationClip::alloc(texture, rows, cols, size, getSequence(playback, length));
+    if (clip == nullptr) {
+        CULogError("Invalid animation layout %s", key.c_str());
+        return nullptr;
+    }
+    CLIPS[key] = clip;
+    return clip;
+}
+
+/** Returns the number of clips built so far */
+size_t AnimationClips::size() {
+    return CLIPS.size();
+}
+
+/**
+ * Drops every clip from the library.
+ *
+ * Objects that still hold clips keep them.
+ */
+void AnimationClips::clear() {
+    CLIPS.clear();
+    SEQUENCES.clear();
+}
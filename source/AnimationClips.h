@@ -0,0 +1,149 @@
+//
+//  AnimationClips.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_ANIMATION_CLIPS_H__
+#define __SSB_ANIMATION_CLIPS_H__
+#include <cugl/cugl.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace cugl;
+using namespace cugl::graphics;
+
+/**
+ * A sprite sheet animation that is shared by every object that plays it.
+ *
+ * A clip is the texture key and layout of a sheet together with the frame
+ * sequence played over it. Objects get clips from {@link AnimationClips}, so
+ * two treasures (or two red players) hold the same clip, and only their sprite
+ * nodes and playheads (see {@link Animator}) are their own.
+ *
+ * A clip does not hold its texture, so it never keeps an unloaded asset group
+ * alive. The texture is looked up when a node is allocated.
+ */
+class AnimationClip {
+public:
+    /** The order the frames of a sheet are played in */
+    enum class Playback {
+        /** Frames 1 to n-1 and then 0, so a looping clip ends where it began */
+        LOOP,
+        /** Frames 0 to n-1 */
+        FORWARD,
+        /** Frames 1 to n-1 (the sheet starts on frame 0 before it plays) */
+        SKIP_FIRST,
+        /** Frame 0, n times (a still clip of the same length) */
+        HOLD
+    };
+
+private:
+    /** The texture key of the sheet */
+    std::string _texture;
+    /** The rows of the sheet */
+    int _rows;
+    /** The columns of the sheet */
+    int _cols;
+    /** The number of frames in the sheet */
+    int _size;
+    /** The frame sequence (shared with every clip with the same sequence) */
+    std::shared_ptr<const std::vector<int>> _frames;
+
+public:
+    /**
+     * Initializes a clip for the given sheet and frame sequence.
+     *
+     * @param texture   The texture key of the sheet
+     * @param rows      The rows of the sheet
+     * @param cols      The columns of the sheet
+     * @param size      The number of frames in the sheet
+     * @param frames    The frame sequence
+     *
+     * @return true if the clip was initialized properly
+     */
+    bool init(const std::string& texture, int rows, int cols, int size,
+              const std::shared_ptr<const std::vector<int>>& frames);
+
+    /**
+     * Returns a newly allocated clip for the given sheet and frame sequence.
+     *
+     * Use {@link AnimationClips#get} instead, which shares clips.
+     *
+     * @param texture   The texture key of the sheet
+     * @param rows      The rows of the sheet
+     * @param cols      The columns of the sheet
+     * @param size      The number of frames in the sheet
+     * @param frames    The frame sequence
+     *
+     * @return a newly allocated clip
+     */
+    static std::shared_ptr<AnimationClip> alloc(const std::string& texture, int rows, int cols, int size,
+                                                const std::shared_ptr<const std::vector<int>>& frames) {
+        std::shared_ptr<AnimationClip> result = std::make_shared<AnimationClip>();
+        return (result->init(texture, rows, cols, size, frames) ? result : nullptr);
+    }
+
+    /** Returns the texture key of the sheet */
+    const std::string& getTexture() const { return _texture; }
+
+    /** Returns the rows of the sheet */
+    int getRows() const { return _rows; }
+
+    /** Returns the columns of the sheet */
+    int getCols() const { return _cols; }
+
+    /** Returns the number of frames in the sheet */
+    int getSize() const { return _size; }
+
+    /** Returns the frame sequence (the sheet frame shown at each step) */
+    const std::vector<int>& getFrames() const { return *_frames; }
+
+    /**
+     * Returns a new sprite node for the sheet of this clip.
+     *
+     * @param assets    The asset manager with the texture
+     *
+     * @return a new sprite node (nullptr if the texture is not loaded)
+     */
+    std::shared_ptr<scene2::SpriteNode> allocNode(const std::shared_ptr<AssetManager>& assets) const;
+};
+
+/**
+ * The library of shared animation clips.
+ *
+ * Clips are keyed by texture and frame layout, and are built the first time
+ * they are asked for. Frame sequences are also shared between clips, so the
+ * fan and a gust of the same length use one sequence. The library must only
+ * be used from the main thread.
+ */
+class AnimationClips {
+public:
+    /**
+     * Returns the clip for the given sheet and playback.
+     *
+     * @param texture   The texture key of the sheet
+     * @param rows      The rows of the sheet
+     * @param cols      The columns of the sheet
+     * @param size      The number of frames in the sheet
+     * @param playback  The order the frames are played in
+     * @param length    The number of frames played (0 for the whole sheet)
+     *
+     * @return the shared clip (nullptr if the layout is invalid)
+     */
+    static std::shared_ptr<AnimationClip> get(const std::string& texture, int rows, int cols, int size,
+                                              AnimationClip::Playback playback = AnimationClip::Playback::LOOP,
+                                              int length = 0);
+
+    /** Returns the number of clips built so far */
+    static size_t size();
+
+    /**
+     * Drops every clip from the library.
+     *
+     * Objects that still hold clips keep them.
+     */
+    static void clear();
+};
+
+#endif /* __SSB_ANIMATION_CLIPS_H__ */
@@ -0,0 +1,200 @@
+//
+//  AnimationSystem.cpp
+//  SweetSweetBetrayal
+//
+
+#include "AnimationSystem.h"
+#include <cmath>
+#include <vector>
+
+using namespace cugl;
+
+/** The state of one animation */
+struct Playhead {
+    /** The frames of the clip */
+    const int* frames;
+    /** The number of frames in the clip */
+    int count;
+    /** The time into the clip (in seconds) */
+    float time;
+    /** The time to play the clip once (in seconds) */
+    float duration;
+    /** The frame last set on the node (-1 if unknown) */
+    int frame;
+    /** Whether the clip is playing */
+    bool playing;
+    /** Whether the clip starts again when it ends */
+    bool loop;
+    /** The id of the animator */
+    Uint32 id;
+    /** The sprite node */
+    std::shared_ptr<scene2::SpriteNode> node;
+    /** The clip (which owns the frames) */
+    std::shared_ptr<AnimationClip> clip;
+};
+
+/** The attached playheads, packed */
+static std::vector<Playhead> PLAYHEADS;
+/** The position in PLAYHEADS of each animator id (-1 if unused) */
+static std::vector<int> SLOTS(1, -1);
+/** The animator ids that can be reused */
+static std::vector<Uint32> FREE_IDS;
+
+/** Returns the playhead of an animator id */
+static Playhead& getPlayhead(Uint32 id) {
+    return PLAYHEADS[SLOTS[id]];
+}
+
+#pragma mark -
+#pragma mark Animator
+/**
+ * Attaches this animator to the given node and clip.
+ *
+ * If the animator is already attached, it keeps its time and state, so
+ * this can switch between nodes that play in step (such as the gust
+ * levels of a fan). The frame is set on the next update.
+ *
+ * @param node  The sprite node with the sheet of the clip
+ * @param clip  The clip to play
+ */
+void Animator::attach(const std::shared_ptr<scene2::SpriteNode>& node, const std::shared_ptr<AnimationClip>& clip) {
+    if (node == nullptr || clip == nullptr) {
+        release();
+        return;
+    }
+    if (_id == 0) {
+        if (FREE_IDS.empty()) {
+            _id = (Uint32)SLOTS.size();
+            SLOTS.push_back(-1);
+        } else {
+            _id = FREE_IDS.back();
+            FREE_IDS.pop_back();
+        }
+        SLOTS[_id] = (int)PLAYHEADS.size();
+        Playhead head;
+        head.time = 0;
+        head.duration = 1.0f;
+        head.playing = false;
+        head.loop = false;
+        head.id = _id;
+        PLAYHEADS.push_back(std::move(head));
+    }
+
+    Playhead& head = getPlayhead(_id);
+    head.node = node;
+    head.clip = clip;
+    head.frames = clip->getFrames().data();
+    head.count = (int)clip->getFrames().size();
+    head.frame = -1;
+}
+
+/**
+ * Plays the clip from the start.
+ *
+ * @param duration  The time to play the clip once (in seconds)
+ * @param loop      Whether to start again when the clip ends
+ */
+void Animator::play(float duration, bool loop) {
+    if (_id == 0) {
+        return;
+    }
+    Playhead& head = getPlayhead(_id);
+    head.time = 0;
+    head.duration = duration > 0 ? duration : 1.0f;
+    head.playing = true;
+    head.loop = loop;
+}
+
+/**
+ * Sets the time to play the clip once, without restarting it.
+ *
+ * @param duration  The time to play the clip once (in seconds)
+ */
+void Animator::setDuration(float duration) {
+    if (_id != 0 && duration > 0) {
+        getPlayhead(_id).duration = duration;
+    }
+}
+
+/** Returns true if the clip is playing (a clip that is not looped stops at its end) */
+bool Animator::isPlaying() const {
+    return _id != 0 && getPlayhead(_id).playing;
+}
+
+/** Stops the clip on its current frame */
+void Animator::stop() {
+    if (_id != 0) {
+        getPlayhead(_id).playing = false;
+    }
+}
+
+/**
+ * Stops the clip and shows the given frame of the sheet.
+ *
+ * @param frame The frame of the sheet
+ */
+void Animator::show(int frame) {
+    if (_id == 0) {
+        return;
+    }
+    Playhead& head = getPlayhead(_id);
+    head.playing = false;
+    if (head.frame != frame) {
+        head.frame = frame;
+        head.node->setFrame(frame);
+    }
+}
+
+/** Gives the playhead back to the system */
+void Animator::release() {
+    if (_id == 0) {
+        return;
+    }
+    // Move the last playhead into the gap so the array stays packed
+    int index = SLOTS[_id];
+    int last = (int)PLAYHEADS.size() - 1;
+    if (index != last) {
+        PLAYHEADS[index] = std::move(PLAYHEADS[last]);
+        SLOTS[PLAYHEADS[index].id] = index;
+    }
+    PLAYHEADS.pop_back();
+    SLOTS[_id] = -1;
+    FREE_IDS.push_back(_id);
+    _id = 0;
+}
+
+#pragma mark -
+#pragma mark System
+/**
+ * Advances every playing animation.
+ *
+ * @param dt    The time since the last update (in seconds)
+ */
+void AnimationSystem::update(float dt) {
+    for (Playhead& head : PLAYHEADS) {
+        if (!head.playing) {
+            continue;
+        }
+        head.time += dt;
+        if (head.time >= head.duration) {
+            if (head.loop) {
+                head.time = std::fmod(head.time, head.duration);
+            } else {
+                head.time = head.duration;
+                head.playing = false;
+            }
+        }
+
+        int index = (int)(head.time / head.duration * head.count);
+        int frame = head.frames[index < head.count ? index : head.count - 1];
+        if (frame != head.frame) {
+            head.frame = frame;
+            head.node->setFrame(frame);
+        }
+    }
+}
+
+/** Returns the number of attached playheads */
+size_t AnimationSystem::size() {
+    return PLAYHEADS.size();
+}
@@ -0,0 +1,105 @@
+//
+//  AnimationSystem.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_ANIMATION_SYSTEM_H__
+#define __SSB_ANIMATION_SYSTEM_H__
+#include <cugl/cugl.h>
+#include <memory>
+#include "AnimationClips.h"
+
+using namespace cugl;
+
+/**
+ * A playhead in the {@link AnimationSystem}, owned by one object.
+ *
+ * An animator plays a clip on a sprite node. It only holds the index of its
+ * playhead, and gives the playhead back to the system when it is destroyed,
+ * so it must not be copied. It does nothing until it is attached.
+ */
+class Animator {
+private:
+    /** The playhead id (0 if not attached) */
+    Uint32 _id;
+
+public:
+    /** Creates an animator that is not attached */
+    Animator() : _id(0) {}
+
+    /** Gives the playhead back to the system */
+    ~Animator() { release(); }
+
+    Animator(const Animator&) = delete;
+    Animator& operator=(const Animator&) = delete;
+
+    /**
+     * Attaches this animator to the given node and clip.
+     *
+     * If the animator is already attached, it keeps its time and state, so
+     * this can switch between nodes that play in step (such as the gust
+     * levels of a fan). The frame is set on the next update.
+     *
+     * @param node  The sprite node with the sheet of the clip
+     * @param clip  The clip to play
+     */
+    void attach(const std::shared_ptr<scene2::SpriteNode>& node, const std::shared_ptr<AnimationClip>& clip);
+
+    /** Returns true if this animator is attached */
+    bool isAttached() const { return _id != 0; }
+
+    /**
+     * Plays the clip from the start.
+     *
+     * @param duration  The time to play the clip once (in seconds)
+     * @param loop      Whether to start again when the clip ends
+     */
+    void play(float duration, bool loop);
+
+    /**
+     * Sets the time to play the clip once, without restarting it.
+     *
+     * @param duration  The time to play the clip once (in seconds)
+     */
+    void setDuration(float duration);
+
+    /** Returns true if the clip is playing (a clip that is not looped stops at its end) */
+    bool isPlaying() const;
+
+    /** Stops the clip on its current frame */
+    void stop();
+
+    /**
+     * Stops the clip and shows the given frame of the sheet.
+     *
+     * @param frame The frame of the sheet
+     */
+    void show(int frame);
+
+    /** Gives the playhead back to the system */
+    void release();
+};
+
+/**
+ * The system that advances every animation.
+ *
+ * The playheads of all {@link Animator}s are kept in one contiguous array and
+ * advanced in a single loop, once per fixed step, by the controller that
+ * steps the physics world. A sprite node is only touched when its frame
+ * changes. Objects decide what to play in their own update (which runs in the
+ * world step first) and never tick their animations themselves.
+ */
+class AnimationSystem {
+public:
+    /**
+     * Advances every playing animation.
+     *
+     * @param dt    The time since the last update (in seconds)
+     */
+    static void update(float dt);
+
+    /** Returns the number of attached playheads */
+    static size_t size();
+};
+
+#endif /* __SSB_ANIMATION_SYSTEM_H__ */
@@ -1,20 +0,0 @@
-//
-//  ArtAssetMapHelper.h
-//  SweetSweetBetrayal
-//
-//  Created by Benjamin Isaacson on 5/5/25.
-//
-
-#ifndef __ART_ASSET_MAP_HELPER_H__
-#define __ART_ASSET_MAP_HELPER_H__
-
-#include <cugl/cugl.h>
-
-using namespace cugl;
-class ArtAssetMapHelper {
-public: 
-	static void populateConstantsMaps();
-};
-
-
-#endif /* __ART_ASSET_MAP_HELPER_H__ */
\ No newline at end of file
@@ -0,0 +1,228 @@
+//
+//  ArtAssetTables.cpp
+//  SweetSweetBetrayal
+//
+//  The lookup tables for art assets by json type and by item. They are built
+//  at compile time (see PerfectHash.h), so there is nothing to populate at
+//  startup and no lookup allocates. To add a new art asset, add a row to
+//  ART_ASSETS, and to ART_LAYERS or ART_ANIMATIONS if it needs one.
+//
+
+#include "Constants.h"
+#include "PerfectHash.h"
+
+using namespace cugl;
+
+namespace Constants {
+
+#pragma mark -
+#pragma mark Tables
+/** The texture (and item, if it has one) of a json type */
+struct ArtAsset {
+    /** The json type */
+    std::string_view key;
+    /** The texture key */
+    std::string_view texture;
+    /** The item type */
+    Item item;
+    /** Whether the json type has an item type */
+    bool typed;
+};
+
+/** The drawing layer of an art object json type */
+struct ArtLayer {
+    /** The json type */
+    std::string_view key;
+    /** The layer */
+    int layer;
+};
+
+/** The sprite sheet of an animated art object json type */
+struct ArtAnimation {
+    /** The json type */
+    std::string_view key;
+    /** The rows of the sprite sheet */
+    int rows;
+    /** The columns of the sprite sheet */
+    int cols;
+};
+
+/**
+ * Every json type with its texture and item type.
+ *
+ * For items in more than one row, the last row gives the texture of the item.
+ */
+constexpr ArtAsset ART_ASSETS[] = {
+    { "default",                    EARTH_TEXTURE,              Item::ART_OBJECT,           true },
+    { "tileTop",                    TOP_TILE_TEXTURE,           Item::TILE_TOP,             true },
+    { "tileBottom",                 BOTTOM_TILE_TEXTURE,        Item::TILE_BOTTOM,          true },
+    { "tileInner",                  INNER_TILE_TEXTURE,         Item::TILE_INNER,           true },
+    { "tileLeft",                   LEFT_TILE_TEXTURE,          Item::TILE_LEFT,            true },
+    { "tileRight",                  RIGHT_TILE_TEXTURE,         Item::TILE_RIGHT,           true },
+    { "tileTopLeft",                TOPLEFT_TILE_TEXTURE,       Item::TILE_TOPLEFT,         true },
+    { "tileTopRight",               TOPRIGHT_TILE_TEXTURE,      Item::TILE_TOPRIGHT,        true },
+    { "tileBottomLeft",             "tile-bottomleft-corner",   Item::TILE_BOTTOMLEFT,      true },
+    { "tileBottomRight",            "tile-bottomright-corner",  Item::TILE_BOTTOMRIGHT,     true },
+    { "crack1",                     CRACK1_TEXTURE,             Item::CRACK_1,              true },
+    { "crack2",                     CRACK2_TEXTURE,             Item::CRACK_2,              true },
+    { "crack3",                     CRACK3_TEXTURE,             Item::CRACK_3,              true },
+    { "crack4",                     CRACK4_TEXTURE,             Item::CRACK_4,              true },
+    { "crack5",                     CRACK5_TEXTURE,             Item::CRACK_5,              true },
+    { "crackLarge1",                CRACKLARGE1_TEXTURE,        Item::CRACK_LARGE_1,        true },
+    { "moss1",                      MOSS1_TEXTURE,              Item::MOSS_1,               true },
+    { "moss2",                      MOSS2_TEXTURE,              Item::MOSS_2,               true },
+    { "rocky1",                     ROCKY1_TEXTURE,             Item::ROCKY_1,              true },
+    { "rocky2",                     ROCKY2_TEXTURE,             Item::ROCKY_2,              true },
+    { "spikeUp",                    SPIKE_UP_TEXTURE,           Item::SPIKE_UP,             true },
+    { "spikeDown",                  SPIKE_DOWN_TEXTURE,         Item::SPIKE_DOWN,           true },
+    { "spikeLeft",                  SPIKE_LEFT_TEXTURE,         Item::SPIKE_LEFT,           true },
+    { "spikeRight",                 SPIKE_RIGHT_TEXTURE,        Item::SPIKE_RIGHT,          true },
+    // These items likely won't ever be saved in a JSON file, but are here to keep this logic in one place
+    { "thorn",                      THORN_TEXTURE,              Item::THORN,                true },
+    { "wind",                       FAN_TEXTURE,                Item::WIND,                 true },
+    { "platform",                   LOG_TEXTURE,                Item::PLATFORM,             true },
+    { "movingPlatform",             GLIDING_LOG_TEXTURE,        Item::MOVING_PLATFORM,      true },
+    { "spike",                      SPIKE_TILE_TEXTURE,         Item::SPIKE,                true },
+    { "treasure",                   TREASURE_TEXTURE,           Item::TREASURE,             true },
+    { "artObject",                  EARTH_TEXTURE,              Item::ART_OBJECT,           true },
+    { "tileItem",                   TILE_TEXTURE,               Item::TILE_ITEM,            true },
+    { "mushroom",                   MUSHROOM_TEXTURE,           Item::MUSHROOM,             true },
+    { "bomb",                       BOMB_TEXTURE,               Item::BOMB,                 true },
+    { "none",                       EARTH_TEXTURE,              Item::NONE,                 true },
+    { "torchRight",                 "torch-right",              Item::TORCH_RIGHT,          true },
+    { "torchLeft",                  "torch-left",               Item::TORCH_LEFT,           true },
+    { "tileTopRightInnerCorner",    "tile-topright-inner",      Item::TILE_TOPRIGHT_INNER,  true },
+    { "tileTopLeftInnerCorner",     "tile-topleft-inner",       Item::TILE_TOPLEFT_INNER,   true },
+    { "tileInsideFilled",           "tile-inside-filled",       Item::TILE_INSIDEFILLED,    true },
+    { "tileInsideLeft",             "tile-inside-left",         Item::TILE_INSIDELEFT,      true },
+    { "tileInsideRight",            "tile-inside-right",        Item::TILE_INSIDERIGHT,     true },
+    // Parallax layers have a texture but no item
+    { "parallax0",                  "parallax-0",               Item::NONE,                 false },
+    { "parallax1",                  "parallax-1",               Item::NONE,                 false },
+    { "parallax2",                  "parallax-2",               Item::NONE,                 false },
+    { "parallax3",                  "parallax-3",               Item::NONE,                 false },
+    { "parallax-ww-1",              "parallax-ww-1",            Item::NONE,                 false },
+    { "parallax-ww-2",              "parallax-ww-2",            Item::NONE,                 false },
+    { "parallax-ww-3",              "parallax-ww-3",            Item::NONE,                 false },
+    { "parallax-ww-4",              "parallax-ww-4",            Item::NONE,                 false },
+    { "parallax-ww-5",              "parallax-ww-5",            Item::NONE,                 false },
+    { "parallax-ww-6",              "parallax-ww-6",            Item::NONE,                 false },
+    { "parallax-gg-1",              "parallax-gg-1",            Item::NONE,                 false },
+    { "parallax-gg-2",              "parallax-gg-2",            Item::NONE,                 false },
+    { "parallax-gg-3",              "parallax-gg-3",            Item::NONE,                 false },
+    { "parallax-gg-4",              "parallax-gg-4",            Item::NONE,                 false },
+    { "parallax-gg-5",              "parallax-gg-5",            Item::NONE,                 false },
+    { "parallax-pp-1",              "parallax-pp-1",            Item::NONE,                 false },
+    { "parallax-pp-2",              "parallax-pp-2",            Item::NONE,                 false },
+    { "parallax-pp-3",              "parallax-pp-3",            Item::NONE,                 false },
+    { "parallax-pp-4",              "parallax-pp-4",            Item::NONE,                 false },
+    { "parallax-pp-5",              "parallax-pp-5",            Item::NONE,                 false },
+    { "parallax-pp-6",              "parallax-pp-6",            Item::NONE,                 false }
+};
+
+/** The art object json types drawn on a fixed layer (instead of their saved one) */
+constexpr ArtLayer ART_LAYERS[] = {
+    { "default",        1 },
+    { "crack1",         1 },
+    { "crack2",         1 },
+    { "crack3",         1 },
+    { "crack4",         1 },
+    { "crack5",         1 },
+    { "crackLarge1",    1 },
+    { "moss1",          1 },
+    { "moss2",          1 },
+    { "rocky1",         1 },
+    { "rocky2",         1 }
+};
+
+/** The animated art object json types, with the rows and columns of their sprite sheets */
+constexpr ArtAnimation ART_ANIMATIONS[] = {
+    { "torchRight",     1, 8 },
+    { "torchLeft",      1, 8 }
+};
+
+constexpr auto ART_ASSET_TABLE = makePerfectHashTable(ART_ASSETS);
+constexpr auto ART_LAYER_TABLE = makePerfectHashTable(ART_LAYERS);
+constexpr auto ART_ANIMATION_TABLE = makePerfectHashTable(ART_ANIMATIONS);
+static_assert(ART_ASSET_TABLE.isValid(), "ART_ASSETS has a json type more than once (or needs more seeds)");
+static_assert(ART_LAYER_TABLE.isValid(), "ART_LAYERS has a json type more than once (or needs more seeds)");
+static_assert(ART_ANIMATION_TABLE.isValid(), "ART_ANIMATIONS has a json type more than once (or needs more seeds)");
+
+/** Returns the texture of every item, indexed by Item (empty if it has none) */
+constexpr std::array<std::string_view, Item::NONE + 1> makeItemTextures() {
+    std::array<std::string_view, Item::NONE + 1> result{};
+    for (const ArtAsset& asset : ART_ASSETS) {
+        if (asset.typed) {
+            result[asset.item] = asset.texture;
+        }
+    }
+    return result;
+}
+
+/** The texture of every item, indexed by Item */
+constexpr std::array<std::string_view, Item::NONE + 1> ITEM_TEXTURES = makeItemTextures();
+
+#pragma mark -
+#pragma mark Lookups
+/** Objects shifted left by half a unit when loaded */
+std::vector<std::string> xOffsetArtObjects = {
+    //"crackLarge1"
+};
+
+/** Objects shifted down by half a unit when loaded */
+std::vector<std::string> yOffsetArtObjects = {
+     //"crack1",
+     //"crack2",
+     //"crack3",
+     //"crack4",
+     //"crack5",
+     //"crackLarge1",
+     //"moss1",
+     //"moss2"
+};
+
+/**
+ * Returns the texture key of a json type (empty if it has none).
+ */
+std::string_view jsonTypeToAsset(std::string_view jsonType) {
+    const ArtAsset* asset = ART_ASSET_TABLE.find(jsonType);
+    return asset == nullptr ? std::string_view() : asset->texture;
+}
+
+/**
+ * Returns the item type of a json type (PLATFORM if it has none).
+ */
+Item jsonTypeToItemType(std::string_view jsonType) {
+    const ArtAsset* asset = ART_ASSET_TABLE.find(jsonType);
+    return (asset == nullptr || !asset->typed) ? Item::PLATFORM : asset->item;
+}
+
+/**
+ * Returns the texture key of an item (empty if it has none).
+ */
+std::string_view itemToTexture(Item item) {
+    return (item >= 0 && item <= Item::NONE) ? ITEM_TEXTURES[item] : std::string_view();
+}
+
+/**
+ * Returns the fixed layer of an art object json type (-1 if it has none).
+ */
+int jsonTypeToLayer(std::string_view jsonType) {
+    const ArtLayer* layer = ART_LAYER_TABLE.find(jsonType);
+    return layer == nullptr ? -1 : layer->layer;
+}
+
+/**
+ * Returns true if an art object json type is animated, with its sprite sheet size.
+ */
+bool jsonTypeToAnimation(std::string_view jsonType, int& rows, int& cols) {
+    const ArtAnimation* animation = ART_ANIMATION_TABLE.find(jsonType);
+    if (animation == nullptr) {
+        return false;
+    }
+    rows = animation->rows;
+    cols = animation->cols;
+    return true;
+}
+
+}
@@ -7,59 +7,30 @@
 using namespace cugl;
 using namespace cugl::graphics;
 
-void ArtObject::update(float timestep) {
-    if (_isAnimated) {
-        doStrip(_animationAction, _animationDuration);
-        _timeline->update(timestep);
-    }
-}
-
 string ArtObject::getJsonKey() {
     return JSON_KEY;
 }
 
 void ArtObject::setAnimationDuration(float dur) {
     _animationDuration = dur;
+    _animator.setDuration(dur);
 }
 
 void ArtObject::setAnimated(bool isAnimated) {
     _isAnimated = isAnimated;
 }
 
-void ArtObject::setAnimation(std::shared_ptr<scene2::SpriteNode> sprite) {
+void ArtObject::setAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip) {
     _animateSpriteNode = sprite;
 
     _node = _animateSpriteNode;
     _animateSpriteNode->setVisible(true);
     //    _node->setScale(0.065f);
 
-    _timeline = ActionTimeline::alloc();
-
-    auto pair = animatedArtObjects[_jsonType];
-
-    // Create the frame sequence
-    // For an 8x8 spritesheet
-    const int span = pair.first * pair.second;
-
-    std::vector<int> forward;
-    for (int ii = 1; ii < span; ii++) {
-        forward.push_back(ii);
-    }
-    // Loop back to beginning
-    forward.push_back(0);
-
-    // Create animation
-    _animateSprite = AnimateSprite::alloc(forward);
-    _animationAction = _animateSprite->attach<scene2::SpriteNode>(_animateSpriteNode);
-}
-
-/** Increments an animation film strip */
-void ArtObject::doStrip(cugl::ActionFunction action, float duration) {
-    if (_timeline->isActive(ACT_KEY)) {
-        // NO OP
-    }
-    else {
-        _timeline->add(ACT_KEY, action, duration);
+    // The frames are shared with every art object of this type
+    _animator.attach(_animateSpriteNode, clip);
+    if (_isAnimated) {
+        _animator.play(_animationDuration, true);
     }
 }
 
@@ -97,7 +68,7 @@ bool ArtObject::init(const Vec2 pos, const Size size, float scale, float angle,
     _angle = angle;
     _itemType = Item::ART_OBJECT;
     _jsonType = jsonType;
-    _itemType = jsonTypeToItemType[jsonType];
+    _itemType = jsonTypeToItemType(jsonType);
     
     PolyFactory factory;
     Poly2 rect = factory.makeRect(size / -2.0f, size);
@@ -131,6 +102,7 @@ void ArtObject::setLayer(int layer) {
 void ArtObject::dispose() {
     Object::dispose();
     markRemoved(true);
+    _animator.release();
 
     if (_node && _node->getParent()) {
         _node->removeFromParent();
@@ -158,16 +130,26 @@ void ArtObject::setParallaxScrollRate(float scrollRate) {
     _scrollRate = scrollRate;
 }
 
-std::map<std::string, std::any> ArtObject::getMap() {
-    std::map<std::string, std::any> m = {
-        {"x", double(_position.x)},
-        {"y", double(_position.y)},
-        {"width", double(_size.getIWidth())},
-        {"height", double(_size.getIHeight())},
-        {"scale", double(_drawScale)},
-        {"angle", double(_angle)},
-        {"layer", long(_layer)},
-        {"type", std::string(_jsonType)},
-    };
-    return m;
+/**
+ * Returns the value of a level field of this object.
+ *
+ * @param field The field
+ * @param value The value of the field
+ *
+ * @return true if this object has the field
+ */
+bool ArtObject::getLevelField(LevelField field, double& value) const {
+    switch (field) {
+        case FIELD_SCALE:
+            value = _drawScale;
+            return true;
+        case FIELD_ANGLE:
+            value = _angle;
+            return true;
+        case FIELD_LAYER:
+            value = _layer;
+            return true;
+        default:
+            return Object::getLevelField(field, value);
+    }
 }
@@ -4,8 +4,6 @@
 #include <cugl/cugl.h>
 #include "Object.h"
 
-#define ACT_KEY "defaultArtAnimation"
-
 using namespace cugl;
 using namespace std;
 
@@ -42,23 +40,16 @@ protected:
     std::shared_ptr<scene2::SceneNode> _node;
 
 #pragma mark Animation Variables
-    /** Manager to process the animation actions */
-    std::shared_ptr<cugl::ActionTimeline> _timeline;
-
     /** Animation variables */
-    std::shared_ptr<AnimateSprite> _animateSprite;
     std::shared_ptr<cugl::scene2::SpriteNode> _animateSpriteNode;
-    cugl::ActionFunction _animationAction;
-    float _animationDuration;
+    Animator _animator;
+    float _animationDuration = 1.0f;
 
 public:
     ArtObject() : Object(), _layer(0), _angle(0), _drawScale(0) {}
 
     ArtObject(Vec2 pos) : Object(pos) {}
 
-    /** The update method for the spike */
-    void update(float timestep) override;
-
     string getJsonKey() override;
 
     ~ArtObject(void) override { dispose(); }
@@ -67,9 +58,13 @@ public:
 
     void setAnimated(bool isAnimated);
 
+    bool isAnimated() {
+        return _isAnimated;
+    }
+
     void setAnimationDuration(float dur);
 
-    void setAnimation(std::shared_ptr<scene2::SpriteNode> sprite);
+    void setAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip);
 
     void setPositionInit(const cugl::Vec2& position) override;
 
@@ -79,9 +74,6 @@ public:
         return _node->getPriority();
     }
 
-    /** Increments an animation film strip */
-    void doStrip(cugl::ActionFunction action, float duration);
-
     /** This method allocates a BoxObstacle.
     * It is important to call this method to properly set up the ArtObject.
     */
@@ -128,7 +120,15 @@ public:
         return _scrollRate;
     }
 
-    std::map<std::string, std::any> getMap() override;
+    /**
+     * Returns the value of a level field of this object.
+     *
+     * @param field The field
+     * @param value The value of the field
+     *
+     * @return true if this object has the field
+     */
+    bool getLevelField(LevelField field, double& value) const override;
 };
 
 
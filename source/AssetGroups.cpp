@@ -0,0 +1,117 @@
+//
+//  AssetGroups.cpp
+//  SweetSweetBetrayal
+//
+
+#include "AssetGroups.h"
+
+using namespace cugl;
+
+#pragma mark -
+#pragma mark Groups
+/**
+ * Returns the group with the sprite sheets of a player color.
+ *
+ * @param color The player color
+ */
+std::string AssetGroups::getColorGroup(ColorType color) {
+    switch (color) {
+        case ColorType::RED:
+            return "characters-red";
+        case ColorType::BLUE:
+            return "characters-blue";
+        case ColorType::GREEN:
+            return "characters-green";
+        case ColorType::YELLOW:
+            return "characters-yellow";
+    }
+    return "characters-red";
+}
+
+#pragma mark -
+#pragma mark Loading
+/**
+ * Acquires a group, loading it if it is not loaded.
+ *
+ * @param name  The group name
+ * @param async Whether to load the group asynchronously
+ *
+ * @return true if the group is (or is being) loaded
+ */
+bool AssetGroups::acquire(const std::string& name, bool async) {
+    Group& group = _groups[name];
+    group.count++;
+    if (group.loaded || group.loading) {
+        return true;
+    }
+
+    std::string directory = getDirectory(name);
+    if (!async) {
+        group.loaded = _assets->loadDirectory(directory);
+        if (!group.loaded) {
+            CULogError("Could not load asset group %s", name.c_str());
+        }
+        return group.loaded;
+    }
+
+    group.loading = true;
+    return _assets->loadDirectoryAsync(directory, [this, name](const std::string key, bool success) {
+        Group& group = _groups[name];
+        group.loading = false;
+        group.loaded = success;
+        if (!success) {
+            CULogError("Could not load asset group %s", name.c_str());
+        }
+        // The group may have been released while it was loading
+        if (group.count == 0) {
+            unload(name);
+        }
+    });
+}
+
+/**
+ * Releases a group, unloading it when it is no longer acquired.
+ *
+ * A group that is still loading is unloaded once it finishes.
+ *
+ * @param name  The group name
+ */
+void AssetGroups::release(const std::string& name) {
+    auto it = _groups.find(name);
+    if (it == _groups.end() || it->second.count == 0) {
+        return;
+    }
+    it->second.count--;
+    if (it->second.count == 0 && !it->second.loading) {
+        unload(name);
+    }
+}
+
+/**
+ * Acquires the given groups and releases the previously held ones.
+ *
+ * @param held      The held groups, replaced by the new groups
+ * @param groups    The new groups
+ * @param async     Whether to load new groups asynchronously
+ */
+void AssetGroups::swap(std::vector<std::string>& held, const std::vector<std::string>& groups, bool async) {
+    for (auto& name : groups) {
+        acquire(name, async);
+    }
+    for (auto& name : held) {
+        release(name);
+    }
+    held = groups;
+}
+
+/**
+ * Unloads every asset in a group.
+ *
+ * @param name  The group name
+ */
+void AssetGroups::unload(const std::string& name) {
+    if (_groups[name].loaded) {
+        _assets->unloadDirectory(getDirectory(name));
+    }
+    _groups.erase(name);
+}
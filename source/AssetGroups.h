@@ -0,0 +1,137 @@
+//
+//  AssetGroups.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_ASSET_GROUPS_H__
+#define __SSB_ASSET_GROUPS_H__
+#include <cugl/cugl.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Message.h"
+
+using namespace cugl;
+
+/** The directory of the asset group files */
+#define ASSET_GROUP_DIRECTORY   "json/groups/"
+/** The group with the victory screens */
+#define VICTORY_GROUP           "victory"
+
+/**
+ * The asset groups that are loaded on demand.
+ *
+ * json/assets.json only holds the core assets (menus, UI, level objects),
+ * which are all the loading scene waits for. The rest are split into groups,
+ * each an asset directory of its own in {@link ASSET_GROUP_DIRECTORY}: the
+ * parallax art of each level, the sprite sheets of each player color, and the
+ * victory screens.
+ *
+ * Groups are reference counted. The first acquire loads a group and the last
+ * release unloads it, so a group shared by two uses (such as a color that is
+ * still in play in the next round) is never reloaded.
+ */
+class AssetGroups {
+private:
+    /** The state of a group */
+    struct Group {
+        /** The number of unmatched calls to acquire */
+        int count = 0;
+        /** Whether every asset in the group is loaded */
+        bool loaded = false;
+        /** Whether the group is being loaded asynchronously */
+        bool loading = false;
+    };
+
+    /** The asset manager */
+    std::shared_ptr<AssetManager> _assets;
+    /** The state of each group that has been acquired */
+    std::unordered_map<std::string, Group> _groups;
+
+    /**
+     * Unloads every asset in a group.
+     *
+     * @param name  The group name
+     */
+    void unload(const std::string& name);
+
+public:
+#pragma mark Constructors
+    /**
+     * Initializes the groups for the given asset manager.
+     *
+     * @param assets    The asset manager
+     *
+     * @return true if the groups were initialized properly
+     */
+    bool init(const std::shared_ptr<AssetManager>& assets) {
+        _assets = assets;
+        return _assets != nullptr;
+    }
+
+    /**
+     * Returns newly allocated groups for the given asset manager.
+     *
+     * @param assets    The asset manager
+     *
+     * @return newly allocated groups
+     */
+    static std::shared_ptr<AssetGroups> alloc(const std::shared_ptr<AssetManager>& assets) {
+        std::shared_ptr<AssetGroups> result = std::make_shared<AssetGroups>();
+        return (result->init(assets) ? result : nullptr);
+    }
+
+    /** Returns the group with the parallax art of a level */
+    static std::string getLevelGroup(int level) {
+        return "level-" + std::to_string(level);
+    }
+
+    /** Returns the group with the sprite sheets of a player color */
+    static std::string getColorGroup(ColorType color);
+
+    /** Returns the asset directory of a group */
+    static std::string getDirectory(const std::string& name) {
+        return ASSET_GROUP_DIRECTORY + name + ".json";
+    }
+
+#pragma mark Loading
+    /**
+     * Acquires a group, loading it if it is not loaded.
+     *
+     * A synchronous load has finished when this method returns. An asynchronous
+     * load finishes in the background (see {@link #isLoaded}).
+     *
+     * @param name  The group name
+     * @param async Whether to load the group asynchronously
+     *
+     * @return true if the group is (or is being) loaded
+     */
+    bool acquire(const std::string& name, bool async = false);
+
+    /**
+     * Releases a group, unloading it when it is no longer acquired.
+     *
+     * @param name  The group name
+     */
+    void release(const std::string& name);
+
+    /**
+     * Acquires the given groups and releases the previously held ones.
+     *
+     * The new groups are acquired first, so groups in both lists stay loaded.
+     *
+     * @param held      The held groups, replaced by the new groups
+     * @param groups    The new groups
+     * @param async     Whether to load new groups asynchronously
+     */
+    void swap(std::vector<std::string>& held, const std::vector<std::string>& groups, bool async = false);
+
+    /** Returns true if every asset in the group is loaded */
+    bool isLoaded(const std::string& name) const {
+        auto it = _groups.find(name);
+        return it != _groups.end() && it->second.loaded;
+    }
+};
+
+#endif /* __SSB_ASSET_GROUPS_H__ */
@@ -0,0 +1,195 @@
+//
+//  AtlasTextureLoader.cpp
+//  SweetSweetBetrayal
+//
+
+#include "AtlasTextureLoader.h"
+
+using namespace cugl;
+using namespace cugl::graphics;
+
+#pragma mark -
+#pragma mark Constructors
+/**
+ * Initializes the loader with the atlas manifest.
+ *
+ * The manifest has a "pages" object mapping each page key to its file, and a
+ * "regions" object mapping each packed texture key to [page, x, y, width, height].
+ *
+ * @param manifest  The atlas manifest (relative to the asset directory)
+ * @param tiers     The tier manifest (relative to the asset directory)
+ *
+ * @return true if the loader was initialized properly
+ */
+bool AtlasTextureLoader::initWithManifest(const std::string& manifest, const std::string& tiers) {
+    if (!initWithTiers(tiers)) {
+        return false;
+    }
+
+    std::shared_ptr<JsonReader> reader = JsonReader::allocWithAsset(manifest);
+    if (reader == nullptr) {
+        CULog("No texture atlases (%s not found)", manifest.c_str());
+        return true;
+    }
+    std::shared_ptr<JsonValue> json = reader->readJson();
+    reader->close();
+    if (json == nullptr || json->get("pages") == nullptr || json->get("regions") == nullptr) {
+        CULogError("Malformed atlas manifest %s", manifest.c_str());
+        return true;
+    }
+
+    for (auto& page : json->get("pages")->children()) {
+        _pages[page->key()] = page->asString();
+    }
+    for (auto& entry : json->get("regions")->children()) {
+        if (entry->size() < 5 || _pages.find(entry->get(0)->asString()) == _pages.end()) {
+            CULogError("Bad atlas region for %s", entry->key().c_str());
+            continue;
+        }
+        Region region;
+        region.page = entry->get(0)->asString();
+        region.x = entry->get(1)->asInt();
+        region.y = entry->get(2)->asInt();
+        region.width = entry->get(3)->asInt();
+        region.height = entry->get(4)->asInt();
+        _regions[entry->key()] = region;
+    }
+    CULog("Packed %zu textures into %zu atlas pages", _regions.size(), _pages.size());
+    return true;
+}
+
+#pragma mark -
+#pragma mark Loading
+/**
+ * Loads a texture from a file, or from its atlas page if it is packed.
+ *
+ * @param key       The key to access the texture after loading
+ * @param source    The pathname to the texture file
+ * @param callback  An optional callback for asynchronous loading
+ * @param async     Whether the texture is loaded asynchronously
+ *
+ * @return true if the texture was found
+ */
+bool AtlasTextureLoader::read(const std::string key, const std::string source,
+                              LoaderCallback callback, bool async) {
+    if (!isPacked(key)) {
+        return TieredTextureLoader::read(key, source, callback, async);
+    }
+    return readRegion({ key, nullptr, source, callback, async });
+}
+
+/**
+ * Loads a texture from its JSON entry, or from its atlas page if it is packed.
+ *
+ * @param json      The directory entry for the texture
+ * @param callback  An optional callback for asynchronous loading
+ * @param async     Whether the texture is loaded asynchronously
+ *
+ * @return true if the texture was found
+ */
+bool AtlasTextureLoader::read(const std::shared_ptr<JsonValue>& json,
+                              LoaderCallback callback, bool async) {
+    if (!isPacked(json->key())) {
+        return TieredTextureLoader::read(json, callback, async);
+    }
+    return readRegion({ json->key(), json, "", callback, async });
+}
+
+/**
+ * Loads a packed texture from its page (loading the page if needed).
+ *
+ * The first texture on a page starts loading the page. The others wait for
+ * it, and are all finished when it arrives.
+ *
+ * @param waiting   The texture to load
+ *
+ * @return true if the texture (or its page) was found
+ */
+bool AtlasTextureLoader::readRegion(Waiting waiting) {
+    const std::string& page = _regions[waiting.key].page;
+    std::shared_ptr<Texture> loaded = _loaded[page].lock();
+    if (loaded != nullptr) {
+        bool success = storeRegion(waiting.key, loaded);
+        if (waiting.callback) {
+            waiting.callback(waiting.key, success);
+        }
+        return success;
+    }
+
+    std::vector<Waiting>& queue = _waiting[page];
+    bool first = queue.empty();
+    queue.push_back(std::move(waiting));
+    if (!first) {
+        return true;
+    }
+    std::string pageKey = page;
+    return TieredTextureLoader::read(pageKey, _pages[pageKey], [this, pageKey](const std::string key, bool success) {
+        finishPage(pageKey, success);
+    }, queue.back().async);
+}
+
+/**
+ * Finishes every texture waiting for a page.
+ *
+ * If the page failed to load, each texture is loaded from its own file.
+ *
+ * @param page      The page key
+ * @param success   Whether the page was loaded
+ */
+void AtlasTextureLoader::finishPage(const std::string& page, bool success) {
+    std::vector<Waiting> queue = std::move(_waiting[page]);
+    _waiting.erase(page);
+
+    // The page is only kept by its subtextures
+    std::shared_ptr<Texture> loaded;
+    auto it = _assets.find(page);
+    if (it != _assets.end()) {
+        loaded = it->second;
+        _assets.erase(it);
+        _loaded[page] = loaded;
+    }
+    for (auto& waiting : queue) {
+        if (success && loaded != nullptr && storeRegion(waiting.key, loaded)) {
+            if (waiting.callback) {
+                waiting.callback(waiting.key, true);
+            }
+        } else {
+            CULogError("Atlas page %s failed, loading %s on its own", page.c_str(), waiting.key.c_str());
+            _regions.erase(waiting.key);
+            if (waiting.json != nullptr) {
+                TieredTextureLoader::read(waiting.json, waiting.callback, waiting.async);
+            } else {
+                TieredTextureLoader::read(waiting.key, waiting.source, waiting.callback, waiting.async);
+            }
+        }
+    }
+}
+
+/**
+ * Stores the subtexture of a packed texture, once its page is loaded.
+ *
+ * The subtexture shares the GL texture of the page.
+ *
+ * @param key   The texture key
+ * @param page  The loaded page
+ *
+ * @return true if the subtexture was stored
+ */
+bool AtlasTextureLoader::storeRegion(const std::string& key, const std::shared_ptr<Texture>& page) {
+    const Region& region = _regions[key];
+    float width = (float)page->getWidth();
+    float height = (float)page->getHeight();
+    if (region.x + region.width > width || region.y + region.height > height) {
+        CULogError("Atlas region for %s is outside page %s", key.c_str(), region.page.c_str());
+        return false;
+    }
+
+    std::shared_ptr<Texture> texture = page->getSubTexture(region.x / width, (region.x + region.width) / width,
+                                                           region.y / height, (region.y + region.height) / height);
+    if (texture == nullptr) {
+        return false;
+    }
+    texture->setName(key);
+    _assets[key] = texture;
+    return true;
+}
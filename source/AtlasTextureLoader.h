@@ -0,0 +1,164 @@
+//
+//  AtlasTextureLoader.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_ATLAS_TEXTURE_LOADER_H__
+#define __SSB_ATLAS_TEXTURE_LOADER_H__
+#include <cugl/cugl.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "TieredTextureLoader.h"
+
+using namespace cugl;
+using namespace cugl::graphics;
+
+/** The atlas manifest written by the atlas packer (tools/atlaspack) */
+#define ATLAS_MANIFEST  "json/atlases.json"
+
+/**
+ * A texture loader that serves packed textures from atlas pages.
+ *
+ * The atlas packer copies many small textures onto a few large pages, and
+ * writes a manifest with the page files and the region of every packed
+ * texture. When this loader is asked for a packed texture (under its usual key
+ * in assets.json), it loads the page instead, once, and stores a subtexture
+ * of the page under that key. Code that calls `_assets->get<Texture>(key)`
+ * is unchanged, but every texture on a page shares one GL texture, so the
+ * SpriteBatch no longer flushes when switching between them.
+ *
+ * Pages are not assets of their own. A page stays in memory only while one
+ * of its subtextures does, so unloading every texture on a page (such as an
+ * asset group) frees the page as well.
+ *
+ * Textures that are not in the manifest (or when there is no manifest) are
+ * loaded as usual, at their chosen tier (see {@link TieredTextureLoader}). If a page fails to load, its textures fall back to their
+ * own files.
+ */
+class AtlasTextureLoader : public TieredTextureLoader {
+private:
+    /** The region of a packed texture on its page (in pixels) */
+    struct Region {
+        /** The key of the page */
+        std::string page;
+        /** The left edge */
+        int x;
+        /** The top edge */
+        int y;
+        /** The width */
+        int width;
+        /** The height */
+        int height;
+    };
+
+    /** A packed texture waiting for its page */
+    struct Waiting {
+        /** The texture key */
+        std::string key;
+        /** The JSON entry of the texture (nullptr if loaded by file) */
+        std::shared_ptr<JsonValue> json;
+        /** The file of the texture (if loaded by file) */
+        std::string source;
+        /** The callback for the texture */
+        LoaderCallback callback;
+        /** Whether the texture was loaded asynchronously */
+        bool async;
+    };
+
+    /** The file of each page */
+    std::unordered_map<std::string, std::string> _pages;
+    /** The region of each packed texture */
+    std::unordered_map<std::string, Region> _regions;
+    /** The packed textures waiting for each page being loaded */
+    std::unordered_map<std::string, std::vector<Waiting>> _waiting;
+    /** The loaded pages, kept alive only by the subtextures that use them */
+    std::unordered_map<std::string, std::weak_ptr<Texture>> _loaded;
+
+    /**
+     * Stores the subtexture of a packed texture, once its page is loaded.
+     *
+     * @param key   The texture key
+     * @param page  The loaded page
+     *
+     * @return true if the subtexture was stored
+     */
+    bool storeRegion(const std::string& key, const std::shared_ptr<Texture>& page);
+
+    /**
+     * Loads a packed texture from its page (loading the page if needed).
+     *
+     * @param waiting   The texture to load
+     *
+     * @return true if the texture (or its page) was found
+     */
+    bool readRegion(Waiting waiting);
+
+    /**
+     * Finishes every texture waiting for a page.
+     *
+     * @param page      The page key
+     * @param success   Whether the page was loaded
+     */
+    void finishPage(const std::string& page, bool success);
+
+public:
+#pragma mark Constructors
+    /**
+     * Initializes the loader with the atlas manifest.
+     *
+     * A missing manifest is not an error: no texture is packed.
+     *
+     * @param manifest  The atlas manifest (relative to the asset directory)
+     * @param tiers     The tier manifest (relative to the asset directory)
+     *
+     * @return true if the loader was initialized properly
+     */
+    bool initWithManifest(const std::string& manifest, const std::string& tiers);
+
+    /**
+     * Returns a newly allocated loader with the atlas manifest.
+     *
+     * @param manifest  The atlas manifest (relative to the asset directory)
+     * @param tiers     The tier manifest (relative to the asset directory)
+     *
+     * @return a newly allocated loader
+     */
+    static std::shared_ptr<AtlasTextureLoader> alloc(const std::string& manifest = ATLAS_MANIFEST,
+                                                     const std::string& tiers = TEXTURE_TIERS_MANIFEST) {
+        std::shared_ptr<AtlasTextureLoader> result = std::make_shared<AtlasTextureLoader>();
+        return (result->initWithManifest(manifest, tiers) ? result : nullptr);
+    }
+
+    /** Returns true if the texture is served from an atlas page */
+    bool isPacked(const std::string& key) const { return _regions.find(key) != _regions.end(); }
+
+#pragma mark Loading
+    /**
+     * Loads a texture from a file, or from its atlas page if it is packed.
+     *
+     * @param key       The key to access the texture after loading
+     * @param source    The pathname to the texture file
+     * @param callback  An optional callback for asynchronous loading
+     * @param async     Whether the texture is loaded asynchronously
+     *
+     * @return true if the texture was found
+     */
+    virtual bool read(const std::string key, const std::string source,
+                      LoaderCallback callback, bool async) override;
+
+    /**
+     * Loads a texture from its JSON entry, or from its atlas page if it is packed.
+     *
+     * @param json      The directory entry for the texture
+     * @param callback  An optional callback for asynchronous loading
+     * @param async     Whether the texture is loaded asynchronously
+     *
+     * @return true if the texture was found
+     */
+    virtual bool read(const std::shared_ptr<JsonValue>& json,
+                      LoaderCallback callback, bool async) override;
+};
+
+#endif /* __SSB_ATLAS_TEXTURE_LOADER_H__ */
@@ -25,9 +25,72 @@ void Bomb::setPositionInit(const cugl::Vec2& position) {
 
 void Bomb::update(float timestep) {
     PolygonObstacle::update(timestep);
-    updateAnimation(timestep);
-    if (!_timeline->isActive(ACT_KEY)) {
-        dispose();
+    // The explosion plays once, and the bomb is done when it ends
+    if (!_animator.isPlaying()) {
+        if (_pooled) {
+            retire();
+        } else {
+            dispose();
+        }
+    }
+}
+
+#pragma mark -
+#pragma mark Pooling
+
+/**
+ * Takes this bomb out of play without destroying it.
+ *
+ * The body is disabled so that it stops colliding, but it stays in the
+ * world. The scene node is taken out of the scene, and it and the
+ * animation are kept so the bomb can be handed out again by its pool.
+ */
+void Bomb::retire() {
+    if (_retired) {
+        return;
+    }
+    _retired = true;
+    setEnabled(false);
+    setLinearVelocity(Vec2::ZERO);
+    setAngularVelocity(0);
+    if (_animNode) {
+        _animNode->setVisible(false);
+        _animParent = _animNode->getParent();
+        if (_animParent) {
+            _animNode->removeFromParent();
+        }
+    }
+}
+
+/**
+ * Puts a retired (or newly pooled) bomb back in play at the given position.
+ *
+ * A bomb that is still in the world gets its body enabled and moved, and
+ * its scene node is put back. A bomb that is not in the world must still
+ * be added to it (and its node to the scene).
+ *
+ * @param pos   The bottom left position of the bomb
+ * @param size  The size of the bomb in grid units
+ */
+void Bomb::reuse(const Vec2 pos, const Size size) {
+    _size = size;
+    _position = pos;
+    _retired = false;
+    markRemoved(false);
+    setPosition(pos + size/2);
+    setLinearVelocity(Vec2::ZERO);
+    setAngularVelocity(0);
+    setEnabled(true);
+
+    _sceneNode = _animNode;
+    if (_animNode) {
+        // The world was cleared since the bomb retired if its body is gone
+        if (isInWorld() && _animParent && _animNode->getParent() == nullptr) {
+            _animParent->addChild(_animNode);
+        }
+        _animParent = nullptr;
+        _animNode->setVisible(true);
+        _animator.play(DURATION, false);
     }
 }
 
@@ -38,6 +101,7 @@ string Bomb::getJsonKey() {
 void Bomb::dispose() {
     Object::dispose();
     markRemoved(true);
+    _animator.release();
 }
 
 #pragma mark -
@@ -76,49 +140,13 @@ bool Bomb::init(const Vec2 pos, const Size size, string jsonType) {
     return false;
 }
 
-void Bomb::updateAnimation(float timestep){
-    _timeline->update(timestep);
-}
-
-void Bomb::setAnimation(std::shared_ptr<scene2::SpriteNode> sprite){
+void Bomb::setAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip){
     _animNode = sprite;
     _sceneNode = _animNode;
     _animNode->setVisible(true);
-    _timeline = ActionTimeline::alloc();
-
-    // Create the frame sequence
-    const int nFrames = 14;
-
-    std::vector<int> forward;
-    for (int ii = 0; ii < nFrames; ii++) {
-        forward.push_back(ii);
-    }
-
-    // Create animation
-    _animSprite = AnimateSprite::alloc(forward);
-    _animAction = _animSprite->attach<scene2::SpriteNode>(_animNode);
-
-    doStrip(_animAction, DURATION);
-}
-
-/**
- * Performs a film strip action
- *
- * @param action The film strip action
- * @param slide  The associated movement slide
- */
-void Bomb::doStrip(cugl::ActionFunction action, float duration = DURATION) {
-    _timeline->add(ACT_KEY, action, duration);
-}
 
-std::map<std::string, std::any> Bomb::getMap() {
-    std::map<std::string, std::any> m = {
-        {"x", double(_position.x)},
-        {"y", double(_position.y)},
-        {"width", double(_size.getIWidth())},
-        {"height", double(_size.getIHeight())},
-        {"type", std::string(_jsonType)}
-    };
-    return m;
+    // The frames are shared with every bomb
+    _animator.attach(_animNode, clip);
+    _animator.play(DURATION, false);
 }
 
@@ -11,7 +11,6 @@
 #include "Object.h"
 
 #define DURATION 1.0f
-#define ACT_KEY  "current"
 
 using namespace cugl;
 using namespace std;
@@ -22,15 +21,19 @@ class Bomb : public Object {
 private:
 
 protected:
+    /** Whether this bomb belongs to an object pool */
+    bool _pooled = false;
+    /** Whether this bomb is out of play, waiting to be reused */
+    bool _retired = false;
+    /** The id of this bomb on every client (0 if it is not networked) */
+    Uint64 _serial = 0;
+    /** The scene node the animation was attached to before it was retired */
+    scene2::SceneNode* _animParent = nullptr;
 
 #pragma mark Animation Variables
-    /** Manager to process the animation actions */
-    std::shared_ptr<cugl::ActionTimeline> _timeline;
-
     /** Animation variables */
-    std::shared_ptr<AnimateSprite> _animSprite;
     std::shared_ptr<cugl::scene2::SpriteNode> _animNode;
-    cugl::ActionFunction _animAction;
+    Animator _animator;
 
 public:
     Bomb() : Object() {}
@@ -98,15 +101,48 @@ public:
         _sceneNode->setPosition(getPositionInit());
     }
 
-    void setAnimation(std::shared_ptr<scene2::SpriteNode> sprite);
+    void setAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip);
+
+#pragma mark Pooling
+    /** Returns true if this bomb belongs to an object pool */
+    bool isPooled() const { return _pooled; }
+
+    /** Sets whether this bomb belongs to an object pool */
+    void setPooled(bool value) { _pooled = value; }
+
+    /** Returns true if this bomb is out of play, waiting to be reused */
+    bool isRetired() const { return _retired; }
+
+    /** Returns the id of this bomb on every client (0 if it is not networked) */
+    Uint64 getSerial() const { return _serial; }
+
+    /** Sets the id of this bomb on every client (0 if it is not networked) */
+    void setSerial(Uint64 serial) { _serial = serial; }
+
+    /** Returns true if this bomb has a body in the physics world */
+    bool isInWorld() const { return _body != nullptr; }
 
-    void updateAnimation(float timestep);
+    /**
+     * Takes this bomb out of play without destroying it.
+     *
+     * The body is disabled so that it stops colliding, but it stays in the
+     * world. The scene node is taken out of the scene, and it and the
+     * animation are kept so the bomb can be handed out again by its pool.
+     */
+    void retire();
 
-    /** Increments an animation film strip */
-    void doStrip(cugl::ActionFunction action, float duration);
+    /**
+     * Puts a retired (or newly pooled) bomb back in play at the given position.
+     *
+     * A bomb that is still in the world gets its body enabled and moved, and
+     * its scene node is put back. A bomb that is not in the world must still
+     * be added to it (and its node to the scene).
+     *
+     * @param pos   The bottom left position of the bomb
+     * @param size  The size of the bomb in grid units
+     */
+    void reuse(const Vec2 pos, const Size size);
 
-    // Map for JSON level management
-    std::map<std::string, std::any> getMap() override;
 };
 
 #endif /* __BOMB_H__ */
@@ -0,0 +1,49 @@
+//
+//  BombEvent.cpp
+//  SweetSweetBetrayal
+//
+
+#include <stdio.h>
+
+#include "BombEvent.h"
+using namespace cugl::physics2::distrib;
+
+/**
+ * This method is used by the NetEventController to create a new event of using a
+ * reference of the same type.
+ *
+ * Not that this method is not static, it differs from the static alloc() method
+ * and all methods must implement this method.
+ */
+std::shared_ptr<NetEvent> BombEvent::newEvent() {
+    return std::make_shared<BombEvent>();
+}
+
+std::shared_ptr<NetEvent> BombEvent::allocBombEvent(Uint64 serial, Vec2 pos, Size size) {
+    auto event = std::make_shared<BombEvent>();
+    event->_serial = serial;
+    event->_pos = pos;
+    event->_size = size;
+    return event;
+}
+
+std::vector<std::byte> BombEvent::serialize() {
+    _serializer.reset();
+    _serializer.writeUint64(_serial);
+    _serializer.writeFloat(_pos.x);
+    _serializer.writeFloat(_pos.y);
+    _serializer.writeFloat(_size.width);
+    _serializer.writeFloat(_size.height);
+
+    return _serializer.serialize();
+}
+
+void BombEvent::deserialize(const std::vector<std::byte>& data) {
+    _deserializer.reset();
+    _deserializer.receive(data);
+    _serial = _deserializer.readUint64();
+    _pos.x = _deserializer.readFloat();
+    _pos.y = _deserializer.readFloat();
+    _size.width = _deserializer.readFloat();
+    _size.height = _deserializer.readFloat();
+}
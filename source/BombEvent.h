@@ -0,0 +1,75 @@
+//
+//  BombEvent.h
+//  SweetSweetBetrayal
+//
+
+#ifndef BombEvent_h
+#define BombEvent_h
+
+#include <stdio.h>
+#include <cugl/cugl.h>
+using namespace cugl;
+using namespace cugl::physics2::distrib;
+
+/**
+ * Puts a retired networked bomb back in play at a new position.
+ *
+ * A networked bomb that exploded keeps its disabled body in the world of
+ * every client. When the client that placed it places a bomb again, it
+ * reuses the bomb and sends this event, so every client enables and moves
+ * the same body instead of creating a new shared obstacle.
+ */
+class BombEvent : public NetEvent {
+    
+protected:
+    LWSerializer _serializer;
+    LWDeserializer _deserializer;
+    
+    /** The id of the bomb on every client */
+    Uint64 _serial;
+    /** The bottom left position of the bomb */
+    Vec2 _pos;
+    /** The size of the bomb in grid units */
+    Size _size;
+    
+public:
+
+    /**
+     * This method is used by the NetEventController to create a new event of using a
+     * reference of the same type.
+     *
+     * Not that this method is not static, it differs from the static alloc() method
+     * and all methods must implement this method.
+     */
+    std::shared_ptr<NetEvent> newEvent() override;
+    
+    static std::shared_ptr<NetEvent> allocBombEvent(Uint64 serial, Vec2 pos, Size size);
+    
+    /**
+     * Serialize any paramater that the event contains to a vector of bytes.
+     */
+    std::vector<std::byte> serialize() override;
+    /**
+     * Deserialize a vector of bytes and set the corresponding parameters.
+     *
+     * @param data  a byte vector packed by serialize()
+     *
+     * This function should be the "reverse" of the serialize() function: it
+     * should be able to recreate a serialized event entirely, setting all the
+     * useful parameters of this class.
+     */
+    void deserialize(const std::vector<std::byte>& data) override;
+    
+    /** Gets the id of the bomb on every client. */
+    Uint64 getSerial() { return _serial; }
+    
+    /** Gets the bottom left position of the bomb. */
+    Vec2 getPosition() { return _pos; }
+    
+    /** Gets the size of the bomb in grid units. */
+    Size getSize() { return _size; }
+
+};
+
+
+#endif /* BombEvent_h */
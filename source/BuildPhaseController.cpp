@@ -161,7 +161,7 @@ void BuildPhaseController::preUpdate(float dt) {
 //                    _selectedObject->getListener()(_selectedObject.get());
 //                }
 //            } else {
-            _gridManager->setObject(gridPosWithOffset, _selectedItem);
+            _gridManager->setObject(gridPosWithOffset, _selectedItem, _selectedObject);
 //            }
         }
         if (screenPos.x <= 200 && _buildPhaseScene.getCamera()->getPosition().x >= 600){
@@ -467,11 +467,8 @@ std::shared_ptr<Object> BuildPhaseController::placeItem(Vec2 gridPos, Item item)
     switch (item) {
         case (PLATFORM):
             return _networkController->createPlatformNetworked(gridPos, itemToSize(item), "log", _buildPhaseScene.getScale() / getSystemScale());
-        case (MOVING_PLATFORM):{
-            std::shared_ptr<Object> platform = _networkController->createMovingPlatformNetworked(gridPos, itemToSize(item), gridPos + Vec2(3, 0), 1, _buildPhaseScene.getScale() / getSystemScale());
-            platform->setOwnerId(_networkController->getNetwork()->getShortUID());
-            return platform;
-        }
+        case (MOVING_PLATFORM):
+            return _networkController->createMovingPlatformNetworked(gridPos, itemToSize(item), gridPos + Vec2(3, 0), 1, _buildPhaseScene.getScale() / getSystemScale());
         case (WIND):
             return _networkController->createWindNetworked(gridPos, itemToSize(item), 1.0f, Vec2(0,4.0f), Vec2(0,3.0f), 0);
         case (SPIKE):
@@ -8,6 +8,7 @@
 #define __CONSTANTS_H__
 #include <cugl/cugl.h>
 #include "string"
+#include <string_view>
 
 
 #pragma mark -
@@ -431,34 +432,61 @@ namespace Constants {
 
     extern std::vector<std::string> yOffsetArtObjects;
 
-extern std::map<std::string, int> jsonTypeToLayer;
-
-/** A list of art objects that should be split into multiple sub-objects for bomb purposes. */
-extern std::map<std::string, std::vector<std::string>> splitArtObjects;
-
-/** 
-* To update this, see ArtAssetMapHelper.cpp.
-* Maps each animated ArtObject (represented by its jsonType string) 
-* to the rows and cols of its animation spritesheet.
-* Important for getting the dimensions of art object animations
-* as well as for whether or not a particular art object shoudl be animated in the first place.
-*/
-extern std::map<std::string, std::pair<int, int>> animatedArtObjects;
-
-/** These are updated externally to make it easier to add new assets.
-* Check out ArtAssetMapHelper to populate these.
-* This means that you can add (most of) the information for new art assets all in one place,
-* instead of having to update every map every time you add a new art object / JSON type.
-* The remaining static maps in this file, as well as the methods in the .cpp, are for cases that
-* are important sometimes but not for all objects (layers, animations, etc.).
-*/
-extern std::map<std::string, std::string> jsonTypeToAsset;
-
-/** To update this, see ArtAssetMapHelper.cpp. */
-extern std::map<std::string, Item> jsonTypeToItemType;
-
-/** To update this, see ArtAssetMapHelper.cpp. */
-extern std::map<Item, std::string> itemToAssetNameMap;
+/**
+ * To add a new art asset, see the tables in ArtAssetTables.cpp.
+ * They are built at compile time, so there is nothing to populate at startup,
+ * and you can add (most of) the information for a new art asset all in one place,
+ * instead of having to update every lookup every time you add a new art object / JSON type.
+ */
+
+/**
+ * Returns the texture key of a json type.
+ *
+ * @param jsonType  The json type
+ *
+ * @return the texture key (empty if the json type has none)
+ */
+std::string_view jsonTypeToAsset(std::string_view jsonType);
+
+/**
+ * Returns the item type of a json type.
+ *
+ * @param jsonType  The json type
+ *
+ * @return the item type (PLATFORM if the json type has none)
+ */
+Item jsonTypeToItemType(std::string_view jsonType);
+
+/**
+ * Returns the texture key of an item.
+ *
+ * Unlike {@link #itemToAssetName}, this covers every art object and tile.
+ *
+ * @param item  The item
+ *
+ * @return the texture key (empty if the item has none)
+ */
+std::string_view itemToTexture(Item item);
+
+/**
+ * Returns the layer an art object json type is always drawn on.
+ *
+ * @param jsonType  The json type
+ *
+ * @return the layer (-1 to use the layer saved with the object)
+ */
+int jsonTypeToLayer(std::string_view jsonType);
+
+/**
+ * Returns whether an art object json type is animated, and the size of its sprite sheet.
+ *
+ * @param jsonType  The json type
+ * @param rows      Set to the rows of the sprite sheet (if animated)
+ * @param cols      Set to the columns of the sprite sheet (if animated)
+ *
+ * @return true if the json type is animated
+ */
+bool jsonTypeToAnimation(std::string_view jsonType, int& rows, int& cols);
 
 /**
  Returns whether a tag contains the player keyword.
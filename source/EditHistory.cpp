@@ -0,0 +1,139 @@
+//
+//  EditHistory.cpp
+//  SweetSweetBetrayal
+//
+
+#include "EditHistory.h"
+#include <cstring>
+
+using namespace cugl;
+
+#pragma mark -
+#pragma mark Recording
+/**
+ * Fills in the delta for adding or removing an object.
+ *
+ * @param add       Whether the object is added (or removed)
+ * @param object    The object
+ * @param delta     The delta to fill in
+ *
+ * @return true if the object is saved in levels (and so has a delta)
+ */
+bool EditHistory::createDelta(bool add, const std::shared_ptr<Object>& object, EditDelta& delta) {
+    if (object == nullptr || !levelRecordKindFromKey(object->getJsonKey(), delta.kind)) {
+        return false;
+    }
+    memset(&delta.record, 0, sizeof(LevelRecord));
+    if (!object->getRecord(delta.record)) {
+        return false;
+    }
+    delta.add = add;
+    delta.type = object->getJsonType();
+    return true;
+}
+
+/**
+ * Records a change to the level.
+ *
+ * @param delta The change to the level
+ */
+void EditHistory::record(const EditDelta& delta) {
+    if (_listener) {
+        _listener(delta);
+    }
+    // A new change makes the undone commands unreachable
+    _redo.clear();
+
+    if (delta.add && !_open.empty() && !_open.back().add && _open.back().matches(delta) &&
+        memcmp(&_open.back().record, &delta.record, sizeof(LevelRecord)) == 0) {
+        _open.pop_back();
+    } else {
+        _open.push_back(delta);
+    }
+    if (_depth == 0) {
+        commit();
+    }
+}
+
+/**
+ * Moves the open command to the undo stack, unless it is empty.
+ */
+void EditHistory::commit() {
+    if (_open.empty()) {
+        return;
+    }
+    _undo.push_back(std::move(_open));
+    _open.clear();
+    if (_undo.size() > EDIT_HISTORY_LIMIT) {
+        _undo.pop_front();
+    }
+}
+
+/**
+ * Finishes the command started by the matching call to begin.
+ */
+void EditHistory::end() {
+    if (_depth == 0) {
+        return;
+    }
+    _depth--;
+    if (_depth == 0) {
+        commit();
+    }
+}
+
+/**
+ * Forgets every command, such as when another level is loaded.
+ */
+void EditHistory::clear() {
+    _undo.clear();
+    _redo.clear();
+    _open.clear();
+}
+
+#pragma mark -
+#pragma mark Undo
+/**
+ * Undoes the most recent command.
+ *
+ * The inverse deltas are applied in reverse order.
+ *
+ * @return true if a command was undone
+ */
+bool EditHistory::undo() {
+    if (!canUndo()) {
+        return false;
+    }
+    std::vector<EditDelta> command = std::move(_undo.back());
+    _undo.pop_back();
+    for (auto it = command.rbegin(); it != command.rend(); ++it) {
+        EditDelta inverse = it->inverse();
+        _applier(inverse);
+        if (_listener) {
+            _listener(inverse);
+        }
+    }
+    _redo.push_back(std::move(command));
+    return true;
+}
+
+/**
+ * Redoes the most recently undone command.
+ *
+ * @return true if a command was redone
+ */
+bool EditHistory::redo() {
+    if (!canRedo()) {
+        return false;
+    }
+    std::vector<EditDelta> command = std::move(_redo.back());
+    _redo.pop_back();
+    for (auto& delta : command) {
+        _applier(delta);
+        if (_listener) {
+            _listener(delta);
+        }
+    }
+    _undo.push_back(std::move(command));
+    return true;
+}
@@ -0,0 +1,213 @@
+//
+//  EditHistory.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_EDIT_HISTORY_H__
+#define __SSB_EDIT_HISTORY_H__
+#include <cugl/cugl.h>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "LevelBinary.h"
+#include "Object.h"
+
+using namespace cugl;
+
+/** The most commands that can be undone */
+#define EDIT_HISTORY_LIMIT  256
+
+/**
+ * A single change to a level in the level editor.
+ *
+ * A delta adds or removes one object, described by its level record. Moving an
+ * object is a removal at the old position followed by an addition at the new
+ * one, so every change can be inverted without keeping the object around.
+ */
+struct EditDelta {
+    /** Whether the object was added (or removed) */
+    bool add;
+    /** The kind of the object */
+    LevelRecordKind kind;
+    /** The saved fields of the object */
+    LevelRecord record;
+    /** The json type of the object */
+    std::string type;
+
+    /** Returns the delta that undoes this one */
+    EditDelta inverse() const {
+        EditDelta result = *this;
+        result.add = !add;
+        return result;
+    }
+
+    /** Returns true if this delta is for the same object (kind, type and position) as the other */
+    bool matches(const EditDelta& other) const {
+        return kind == other.kind && type == other.type &&
+               record.x == other.record.x && record.y == other.record.y;
+    }
+};
+
+/**
+ * The undo and redo history of the level editor.
+ *
+ * Each command is a short list of deltas, so undoing or redoing it only costs
+ * the objects it touched. Changes made between {@link #begin} and {@link #end}
+ * are coalesced into one command, such as every object erased in a single
+ * drag, or the removal and addition that make up a move. A removal followed
+ * by the addition of the same object in the same command (an object picked up
+ * and dropped where it was) cancels out, and empty commands are dropped.
+ *
+ * Every delta that changes the level (whether recorded, undone or redone) is
+ * also passed to the listener, so the autosave journal can follow the same
+ * stream of changes.
+ */
+class EditHistory {
+public:
+    /** A function that receives a single delta */
+    typedef std::function<void(const EditDelta&)> Listener;
+
+private:
+    /** The commands that can be undone, oldest first */
+    std::deque<std::vector<EditDelta>> _undo;
+    /** The commands that can be redone, most recently undone last */
+    std::vector<std::vector<EditDelta>> _redo;
+    /** The command being coalesced */
+    std::vector<EditDelta> _open;
+    /** The number of unmatched calls to begin */
+    int _depth;
+    /** The function that applies a delta to the level on undo and redo */
+    Listener _applier;
+    /** The function told of every change to the level */
+    Listener _listener;
+
+    /**
+     * Moves the open command to the undo stack, unless it is empty.
+     */
+    void commit();
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates an empty history.
+     */
+    EditHistory() : _depth(0) {}
+
+    /**
+     * Initializes an empty history.
+     *
+     * @param applier   The function that applies a delta to the level
+     *
+     * @return true if the history was initialized properly
+     */
+    bool init(const Listener& applier) {
+        _applier = applier;
+        return true;
+    }
+
+    /**
+     * Returns a newly allocated empty history.
+     *
+     * @param applier   The function that applies a delta to the level
+     *
+     * @return a newly allocated empty history
+     */
+    static std::shared_ptr<EditHistory> alloc(const Listener& applier) {
+        std::shared_ptr<EditHistory> result = std::make_shared<EditHistory>();
+        return (result->init(applier) ? result : nullptr);
+    }
+
+    /**
+     * Sets the function told of every change to the level.
+     *
+     * @param listener  The function told of every change
+     */
+    void setListener(const Listener& listener) { _listener = listener; }
+
+#pragma mark Recording
+    /**
+     * Fills in the delta for adding or removing an object.
+     *
+     * @param add       Whether the object is added (or removed)
+     * @param object    The object
+     * @param delta     The delta to fill in
+     *
+     * @return true if the object is saved in levels (and so has a delta)
+     */
+    static bool createDelta(bool add, const std::shared_ptr<Object>& object, EditDelta& delta);
+
+    /**
+     * Starts coalescing changes into a single command.
+     *
+     * Calls may be nested. The command is finished by the matching call to end.
+     */
+    void begin() { _depth++; }
+
+    /**
+     * Finishes the command started by the matching call to begin.
+     */
+    void end();
+
+    /**
+     * Records a change to the level.
+     *
+     * If no command is being coalesced, the change is a command of its own.
+     *
+     * @param delta The change to the level
+     */
+    void record(const EditDelta& delta);
+
+    /**
+     * Records that an object was added to the level.
+     *
+     * @param object    The added object
+     */
+    void recordAdd(const std::shared_ptr<Object>& object) {
+        EditDelta delta;
+        if (createDelta(true, object, delta)) {
+            record(delta);
+        }
+    }
+
+    /**
+     * Records that an object was removed from the level.
+     *
+     * @param object    The removed object (still at its old position)
+     */
+    void recordRemove(const std::shared_ptr<Object>& object) {
+        EditDelta delta;
+        if (createDelta(false, object, delta)) {
+            record(delta);
+        }
+    }
+
+    /**
+     * Forgets every command, such as when another level is loaded.
+     */
+    void clear();
+
+#pragma mark Undo
+    /** Returns true if there is a command to undo */
+    bool canUndo() const { return _depth == 0 && !_undo.empty(); }
+
+    /** Returns true if there is a command to redo */
+    bool canRedo() const { return _depth == 0 && !_redo.empty(); }
+
+    /**
+     * Undoes the most recent command.
+     *
+     * @return true if a command was undone
+     */
+    bool undo();
+
+    /**
+     * Redoes the most recently undone command.
+     *
+     * @return true if a command was redone
+     */
+    bool redo();
+};
+
+#endif /* __SSB_EDIT_HISTORY_H__ */
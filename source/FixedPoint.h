@@ -0,0 +1,154 @@
+//
+//  FixedPoint.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_FIXED_POINT_H__
+#define __SSB_FIXED_POINT_H__
+#include <cugl/cugl.h>
+#include <cstdint>
+#include <box2d/b2_math.h>
+
+using namespace cugl;
+
+/**
+ * A signed Q16.16 fixed-point number.
+ *
+ * Float results can differ between compilers and architectures (fused
+ * multiply-add, x87 precision, fast-math flags), which makes lockstep play
+ * across Android, iOS and desktop unreliable. Fixed-point arithmetic is plain
+ * integer math, so the same inputs give the same bits on every device.
+ *
+ * Conversions from float round to the nearest 1/65536, and conversions back to
+ * float are exact, so values can pass through Box2D without drifting.
+ */
+class Fixed {
+public:
+    /** The number of fractional bits */
+    static constexpr int FRAC_BITS = 16;
+    /** The raw value of 1.0 */
+    static constexpr int32_t ONE = 1 << FRAC_BITS;
+
+    /** The raw Q16.16 value */
+    int32_t raw;
+
+#pragma mark -
+#pragma mark Constructors
+    /** Creates the fixed-point value 0 */
+    constexpr Fixed() : raw(0) {}
+
+    /** Creates the fixed-point value nearest to the given float */
+    constexpr explicit Fixed(float value) : raw((int32_t)(value * ONE + (value >= 0 ? 0.5f : -0.5f))) {}
+
+    /** Creates the fixed-point value of the given integer */
+    constexpr explicit Fixed(int value) : raw(value * ONE) {}
+
+    /** Returns the fixed-point number with the given raw value */
+    static constexpr Fixed fromRaw(int32_t raw) {
+        Fixed result;
+        result.raw = raw;
+        return result;
+    }
+
+    /** Returns this value as a float (this conversion is exact) */
+    constexpr float toFloat() const { return (float)raw / ONE; }
+
+#pragma mark -
+#pragma mark Arithmetic
+    constexpr Fixed operator-() const { return fromRaw(-raw); }
+    constexpr Fixed operator+(Fixed other) const { return fromRaw(raw + other.raw); }
+    constexpr Fixed operator-(Fixed other) const { return fromRaw(raw - other.raw); }
+    constexpr Fixed operator*(Fixed other) const {
+        return fromRaw((int32_t)(((int64_t)raw * other.raw) >> FRAC_BITS));
+    }
+    constexpr Fixed operator/(Fixed other) const {
+        return fromRaw((int32_t)(((int64_t)raw << FRAC_BITS) / other.raw));
+    }
+    Fixed& operator+=(Fixed other) { raw += other.raw; return *this; }
+    Fixed& operator-=(Fixed other) { raw -= other.raw; return *this; }
+    Fixed& operator*=(Fixed other) { *this = *this * other; return *this; }
+
+    constexpr bool operator==(Fixed other) const { return raw == other.raw; }
+    constexpr bool operator!=(Fixed other) const { return raw != other.raw; }
+    constexpr bool operator<(Fixed other) const { return raw < other.raw; }
+    constexpr bool operator<=(Fixed other) const { return raw <= other.raw; }
+    constexpr bool operator>(Fixed other) const { return raw > other.raw; }
+    constexpr bool operator>=(Fixed other) const { return raw >= other.raw; }
+
+#pragma mark -
+#pragma mark Helpers
+    /** Returns the absolute value of this number */
+    constexpr Fixed abs() const { return raw < 0 ? fromRaw(-raw) : *this; }
+
+    /** Returns -1, 0 or 1 depending on the sign of this number */
+    constexpr Fixed sign() const { return Fixed(raw > 0 ? 1 : (raw < 0 ? -1 : 0)); }
+
+    /** Returns the smaller of two numbers */
+    static constexpr Fixed min(Fixed a, Fixed b) { return a < b ? a : b; }
+};
+
+/**
+ * A two-dimensional vector of Q16.16 fixed-point numbers.
+ */
+class FixedVec2 {
+public:
+    /** The x coordinate */
+    Fixed x;
+    /** The y coordinate */
+    Fixed y;
+
+    /** Creates the zero vector */
+    constexpr FixedVec2() {}
+
+    /** Creates a vector with the given coordinates */
+    constexpr FixedVec2(Fixed x, Fixed y) : x(x), y(y) {}
+
+    /** Creates the vector nearest to the given Box2D vector */
+    explicit FixedVec2(const b2Vec2& v) : x(v.x), y(v.y) {}
+
+    /** Creates the vector nearest to the given CUGL vector */
+    explicit FixedVec2(const Vec2& v) : x(v.x), y(v.y) {}
+
+    /** Returns this vector as a Box2D vector */
+    b2Vec2 toB2() const { return b2Vec2(x.toFloat(), y.toFloat()); }
+
+    /** Returns this vector as a CUGL vector */
+    Vec2 toVec2() const { return Vec2(x.toFloat(), y.toFloat()); }
+};
+
+/**
+ * An incremental FNV-1a hash of fixed-point game state.
+ *
+ * Hashing the quantized state once per tick gives a short fingerprint that
+ * can be compared across devices running the same input stream. The first
+ * tick where two fingerprints differ is where the simulations diverged.
+ */
+class StateHash {
+private:
+    /** The running hash value */
+    uint64_t _hash;
+
+public:
+    /** Creates a hash with the FNV offset basis */
+    StateHash() : _hash(14695981039346656037ULL) {}
+
+    /** Mixes a raw 32-bit value into the hash */
+    void add(int32_t value) {
+        uint32_t bits = (uint32_t)value;
+        for (int ii = 0; ii < 4; ii++) {
+            _hash ^= (bits >> (8 * ii)) & 0xFF;
+            _hash *= 1099511628211ULL;
+        }
+    }
+
+    /** Mixes a fixed-point value into the hash */
+    void add(Fixed value) { add(value.raw); }
+
+    /** Mixes a fixed-point vector into the hash */
+    void add(const FixedVec2& value) { add(value.x); add(value.y); }
+
+    /** Returns the current hash value */
+    uint64_t get() const { return _hash; }
+};
+
+#endif /* __SSB_FIXED_POINT_H__ */
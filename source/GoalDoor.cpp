@@ -43,70 +43,42 @@ void GoalDoor::updateAnimation(float timestep) {
 //        CULog("Frame %d: %d", i, frames[i]);
 //    }
     if (_isResettingFilmstrip) {
-        doStrip(_spinAction, 1.0f);
+        doStrip(_spinClip, 1.0f);
         _isResettingFilmstrip = false;
     }
     else if (_isResetting) {
-        doStrip(_staticAction, 1.0f);
+        doStrip(_staticClip, 1.0f);
         _isResetting = false;
     }
-        
-    
-    _timeline->update(timestep);
-
-
 }
 
 
-void GoalDoor::setAnimation(std::shared_ptr<scene2::SpriteNode> sprite) {
+void GoalDoor::setAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& spin,
+                            const std::shared_ptr<AnimationClip>& still) {
     _spinSpriteNode = sprite;
 
     _node = _spinSpriteNode;
     _spinSpriteNode->setVisible(true);
     //    _node->setScale(0.065f);
 
-    _timeline = ActionTimeline::alloc();
-
-    // Create the frame sequence
-    // For an 8x8 spritesheet
-    const int span = 5;
-
-    std::vector<int> forward;
-    for (int ii = 0; ii < span; ii++) {
-        forward.push_back(ii);
-    }
-
-    // Create animation
-    _spinAnimateSprite = AnimateSprite::alloc(forward);
-    _spinAction = _spinAnimateSprite->attach<scene2::SpriteNode>(_spinSpriteNode);
-
-    const int span2 = 5;
-
-    std::vector<int> forward2;
-    for (int ii = 0; ii < span2; ii++) {
-        forward2.push_back(0);
-    }
-
-    // Create animation
-    _staticAnimateSprite = AnimateSprite::alloc(forward2);
-    _staticAction = _staticAnimateSprite->attach<scene2::SpriteNode>(_spinSpriteNode);
+    // Both clips play on the same node
+    _spinClip = spin;
+    _staticClip = still;
+    _animator.attach(_spinSpriteNode, _spinClip);
 }
 
 
 
-/**]
- * Performs a film strip action
+/**
+ * Plays the given clip, unless a clip is already playing
  *
- * @param action The film strip action
- * @param slide  The associated movement slide
+ * @param clip      The clip to play
+ * @param duration  The time to play the clip once
  */
-void GoalDoor::doStrip(cugl::ActionFunction action, float duration = 1.0f) {
-
-    if (_timeline->isActive(ACT_KEY)) {
-        // NO OP
-    }
-    else {
-        _timeline->add(ACT_KEY, action, duration);
+void GoalDoor::doStrip(const std::shared_ptr<AnimationClip>& clip, float duration = 1.0f) {
+    if (!_animator.isPlaying()) {
+        _animator.attach(_spinSpriteNode, clip);
+        _animator.play(duration, false);
     }
 }
 
@@ -120,7 +92,11 @@ void GoalDoor::setPositionInit(const cugl::Vec2& position) {
 }
 
 void GoalDoor::dispose() {
-    _node->dispose();
+    _animator.release();
+    // The node is kept, since a level snapshot may put it back in the scene
+    if (_node && _node->getParent()) {
+        _node->removeFromParent();
+    }
 }
 
 
@@ -173,16 +149,4 @@ void GoalDoor::reset() {
     _isStealable = true;
 }
 
-std::map<std::string, std::any> GoalDoor::getMap() {
-    std::map<std::string, std::any> m = {
-        {"x", double(_position.x)},
-        {"y", double(_position.y)},
-        {"width", double(_size.getIWidth())},
-        {"height", double(_size.getIHeight())},
-        {"scale", double(_drawScale)},
-         {"type", std::string(_jsonType)}
-    };
-    return m;
-}
-
 
@@ -12,7 +12,6 @@
 #include <cugl/cugl.h>
 
 #define DURATION 4.0f
-#define ACT_KEY  "current"
 
 
 using namespace cugl;
@@ -67,15 +66,11 @@ protected:
 
 
 #pragma mark Animation Variables
-    /** Manager to process the animation actions */
-    std::shared_ptr<cugl::ActionTimeline> _timeline;
-
     /** Animation variables */
-    std::shared_ptr<AnimateSprite> _spinAnimateSprite;
-    std::shared_ptr<AnimateSprite> _staticAnimateSprite;
+    std::shared_ptr<AnimationClip> _spinClip;
+    std::shared_ptr<AnimationClip> _staticClip;
     std::shared_ptr<cugl::scene2::SpriteNode> _spinSpriteNode;
-    cugl::ActionFunction _spinAction;
-    cugl::ActionFunction _staticAction;
+    Animator _animator;
 
 public:
 
@@ -148,16 +143,16 @@ public:
     }
 
     /**
-     Sets the spinning animation for the treasure.
+     Sets the spinning animation and the still animation (played while the door is closed).
      */
-    void setAnimation(std::shared_ptr<scene2::SpriteNode> sprite);
+    void setAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& spin,
+                      const std::shared_ptr<AnimationClip>& still);
 
     void updateAnimation(float timestep);
 
-    /** Increments an animation film strip */
-    void doStrip(cugl::ActionFunction action, float duration);
+    /** Plays the given clip, unless a clip is already playing */
+    void doStrip(const std::shared_ptr<AnimationClip>& clip, float duration);
 
-    std::map<std::string, std::any> getMap() override;
 
 
     void reset();
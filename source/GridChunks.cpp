@@ -0,0 +1,151 @@
+//
+//  GridChunks.cpp
+//  SweetSweetBetrayal
+//
+
+#include "GridChunks.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace cugl;
+
+#pragma mark -
+#pragma mark Constructors
+/**
+ * Initializes the grid lines for the given cells.
+ *
+ * @param columns   The number of columns in the grid
+ * @param rowStart  The first row with lines
+ * @param rowEnd    The row after the last row with lines
+ * @param cellSize  The size of a cell (in node coordinates)
+ *
+ * @return true if the grid was initialized properly
+ */
+bool GridChunks::init(int columns, int rowStart, int rowEnd, float cellSize) {
+    if (columns <= 0 || rowEnd <= rowStart) {
+        return false;
+    }
+    _columns = columns;
+    _rowStart = rowStart;
+    _rowEnd = rowEnd;
+    _cellSize = cellSize;
+    _first = -1;
+    _last = -1;
+    _node = scene2::SceneNode::alloc();
+    _node->setAnchor(Vec2::ANCHOR_BOTTOM_LEFT);
+    _node->setPosition(Vec2::ZERO);
+    _chunks.assign((columns + GRID_CHUNK_COLUMNS - 1) / GRID_CHUNK_COLUMNS, nullptr);
+    return true;
+}
+
+/**
+ * Returns a new node with the grid lines of a chunk.
+ *
+ * The mesh has a vertex at every cell corner, and its indices come in pairs,
+ * one pair for each cell edge.
+ *
+ * @param index The chunk index
+ */
+std::shared_ptr<scene2::WireNode> GridChunks::createChunk(int index) const {
+    int colStart = index * GRID_CHUNK_COLUMNS;
+    int cols = std::min(GRID_CHUNK_COLUMNS, _columns - colStart);
+    int rows = _rowEnd - _rowStart;
+
+    Poly2 mesh;
+    mesh.vertices.reserve((cols + 1) * (rows + 1));
+    for (int row = 0; row <= rows; row++) {
+        for (int col = 0; col <= cols; col++) {
+            mesh.vertices.push_back(Vec2(col * _cellSize, row * _cellSize));
+        }
+    }
+    mesh.indices.reserve(2 * (cols * (rows + 1) + rows * (cols + 1)));
+    for (int row = 0; row <= rows; row++) {
+        for (int col = 0; col <= cols; col++) {
+            Uint32 vertex = row * (cols + 1) + col;
+            if (col < cols) {
+                mesh.indices.push_back(vertex);
+                mesh.indices.push_back(vertex + 1);
+            }
+            if (row < rows) {
+                mesh.indices.push_back(vertex);
+                mesh.indices.push_back(vertex + cols + 1);
+            }
+        }
+    }
+
+    std::shared_ptr<scene2::WireNode> chunk = scene2::WireNode::allocWithPoly(mesh);
+    chunk->setColor(Color4::WHITE);
+    chunk->setAnchor(Vec2::ANCHOR_BOTTOM_LEFT);
+    chunk->setPosition(Vec2(colStart * _cellSize, _rowStart * _cellSize));
+    return chunk;
+}
+
+#pragma mark -
+#pragma mark Visibility
+/**
+ * Creates the chunks seen by the camera of the scene, and drops the rest.
+ */
+void GridChunks::update() {
+    int first, last;
+    if (!getVisibleColumns(_node.get(), _cellSize, first, last)) {
+        showColumns(0, _columns - 1);
+        return;
+    }
+    showColumns(first, last);
+}
+
+/**
+ * Computes the grid columns seen by the camera of a node's scene.
+ *
+ * @param node      A node in grid coordinates (cell (0,0) at its origin)
+ * @param cellSize  The size of a cell (in node coordinates)
+ * @param first     The first visible column
+ * @param last      The last visible column
+ *
+ * @return false if the node is not in a scene with a camera
+ */
+bool GridChunks::getVisibleColumns(scene2::SceneNode* node, float cellSize, int& first, int& last) {
+    scene2::Scene2* scene = node->getScene();
+    if (scene == nullptr || scene->getCamera() == nullptr) {
+        return false;
+    }
+
+    std::shared_ptr<Camera> camera = scene->getCamera();
+    Rect viewport = camera->getViewport();
+    Vec2 corner1 = node->worldToNodeCoords(camera->screenToWorldCoords(viewport.origin));
+    Vec2 corner2 = node->worldToNodeCoords(camera->screenToWorldCoords(viewport.origin + viewport.size));
+    first = (int)std::floor(std::min(corner1.x, corner2.x) / cellSize);
+    last = (int)std::floor(std::max(corner1.x, corner2.x) / cellSize);
+    return true;
+}
+
+/**
+ * Creates the chunks holding the given columns, and drops the rest.
+ *
+ * @param first The first visible column
+ * @param last  The last visible column
+ */
+void GridChunks::showColumns(int first, int last) {
+    int count = (int)_chunks.size();
+    int firstChunk = std::max(0, (int)std::floor((float)first / GRID_CHUNK_COLUMNS) - GRID_CHUNK_MARGIN);
+    int lastChunk = std::min(count - 1, (int)std::floor((float)last / GRID_CHUNK_COLUMNS) + GRID_CHUNK_MARGIN);
+    if (firstChunk == _first && lastChunk == _last) {
+        return;
+    }
+
+    // Drop the chunks that are no longer near, and create the ones that are
+    for (int ii = std::max(_first, 0); ii <= _last && ii < count; ii++) {
+        if ((ii < firstChunk || ii > lastChunk) && _chunks[ii] != nullptr) {
+            _node->removeChild(_chunks[ii]);
+            _chunks[ii] = nullptr;
+        }
+    }
+    for (int ii = firstChunk; ii <= lastChunk; ii++) {
+        if (_chunks[ii] == nullptr) {
+            _chunks[ii] = createChunk(ii);
+            _node->addChild(_chunks[ii]);
+        }
+    }
+    _first = firstChunk;
+    _last = lastChunk;
+}
@@ -0,0 +1,126 @@
+//
+//  GridChunks.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_GRID_CHUNKS_H__
+#define __SSB_GRID_CHUNKS_H__
+#include <cugl/cugl.h>
+#include <memory>
+#include <vector>
+
+using namespace cugl;
+
+/** The number of grid columns in each chunk */
+#define GRID_CHUNK_COLUMNS  16
+/** The number of chunks kept on each side of the visible ones */
+#define GRID_CHUNK_MARGIN   1
+
+/**
+ * The lines of a build mode grid, split into chunks of columns.
+ *
+ * Each chunk draws all of its grid lines as a single wireframe mesh, rather
+ * than one node per cell. Chunks are only created when they come near the
+ * camera, and are dropped once they are far from it, so the number of nodes
+ * (and their memory) does not grow with the width of the level.
+ */
+class GridChunks {
+private:
+    /** The node holding the chunk nodes */
+    std::shared_ptr<scene2::SceneNode> _node;
+    /** The node of each chunk (nullptr if not created) */
+    std::vector<std::shared_ptr<scene2::WireNode>> _chunks;
+    /** The number of columns in the grid */
+    int _columns;
+    /** The first row with lines */
+    int _rowStart;
+    /** The row after the last row with lines */
+    int _rowEnd;
+    /** The size of a cell (in node coordinates) */
+    float _cellSize;
+    /** The first created chunk (-1 if none) */
+    int _first;
+    /** The last created chunk (-1 if none) */
+    int _last;
+
+    /**
+     * Returns a new node with the grid lines of a chunk.
+     *
+     * @param index The chunk index
+     */
+    std::shared_ptr<scene2::WireNode> createChunk(int index) const;
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates an empty grid.
+     */
+    GridChunks() : _columns(0), _rowStart(0), _rowEnd(0), _cellSize(1.0f), _first(-1), _last(-1) {}
+
+    /**
+     * Initializes the grid lines for the given cells.
+     *
+     * No chunk is created until {@link #update} or {@link #showColumns} is called.
+     *
+     * @param columns   The number of columns in the grid
+     * @param rowStart  The first row with lines
+     * @param rowEnd    The row after the last row with lines
+     * @param cellSize  The size of a cell (in node coordinates)
+     *
+     * @return true if the grid was initialized properly
+     */
+    bool init(int columns, int rowStart, int rowEnd, float cellSize);
+
+    /**
+     * Returns newly allocated grid lines for the given cells.
+     *
+     * @param columns   The number of columns in the grid
+     * @param rowStart  The first row with lines
+     * @param rowEnd    The row after the last row with lines
+     * @param cellSize  The size of a cell (in node coordinates)
+     *
+     * @return newly allocated grid lines
+     */
+    static std::shared_ptr<GridChunks> alloc(int columns, int rowStart, int rowEnd, float cellSize) {
+        std::shared_ptr<GridChunks> result = std::make_shared<GridChunks>();
+        return (result->init(columns, rowStart, rowEnd, cellSize) ? result : nullptr);
+    }
+
+    /** Returns the node holding the grid lines (add it to the grid node) */
+    const std::shared_ptr<scene2::SceneNode>& getNode() const { return _node; }
+
+#pragma mark Visibility
+    /**
+     * Creates the chunks seen by the camera of the scene, and drops the rest.
+     *
+     * If the node is not in a scene yet, every chunk is created.
+     */
+    void update();
+
+    /**
+     * Creates the chunks holding the given columns, and drops the rest.
+     *
+     * The chunks within {@link GRID_CHUNK_MARGIN} of these are kept as well.
+     *
+     * @param first The first visible column
+     * @param last  The last visible column
+     */
+    void showColumns(int first, int last);
+
+    /**
+     * Computes the grid columns seen by the camera of a node's scene.
+     *
+     * @param node      A node in grid coordinates (cell (0,0) at its origin)
+     * @param cellSize  The size of a cell (in node coordinates)
+     * @param first     The first visible column
+     * @param last      The last visible column
+     *
+     * @return false if the node is not in a scene with a camera
+     */
+    static bool getVisibleColumns(scene2::SceneNode* node, float cellSize, int& first, int& last);
+
+    /** Returns the total number of chunks */
+    size_t getChunkCount() const { return _chunks.size(); }
+};
+
+#endif /* __SSB_GRID_CHUNKS_H__ */
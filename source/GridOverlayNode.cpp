@@ -0,0 +1,256 @@
+//
+//  GridOverlayNode.cpp
+//  SweetSweetBetrayal
+//
+
+#include "GridOverlayNode.h"
+#include "GridChunks.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+using namespace cugl;
+using namespace cugl::graphics;
+
+#pragma mark -
+#pragma mark Overlay Colors
+/** The color of the grid lines */
+#define LINE_COLOR          Color4::WHITE
+/** The tint of the safe zone, where nothing may be placed */
+#define SAFE_ZONE_COLOR     Color4(255, 90, 90, 70)
+/** The tint of occupied cells */
+#define OCCUPIED_COLOR      Color4(0, 0, 0, 50)
+/** The tint of a footprint that may be placed */
+#define LEGAL_COLOR         Color4(90, 230, 90, 90)
+/** The tint of a footprint that may not be placed */
+#define ILLEGAL_COLOR       Color4(230, 60, 60, 110)
+
+#pragma mark -
+#pragma mark Constructors
+/**
+ * Initializes the overlay for the given cells.
+ *
+ * @param columns       The number of columns in the grid
+ * @param rowStart      The first row with lines
+ * @param rowEnd        The row after the last row with lines
+ * @param cellSize      The size of a cell (in node coordinates)
+ * @param safeColumns   The number of columns where nothing may be placed
+ *
+ * @return true if the overlay was initialized properly
+ */
+bool GridOverlayNode::initWithGrid(int columns, int rowStart, int rowEnd, float cellSize, int safeColumns) {
+    if (columns <= 0 || rowEnd <= rowStart || !scene2::SceneNode::init()) {
+        return false;
+    }
+    _columns = columns;
+    _rowStart = rowStart;
+    _rowEnd = rowEnd;
+    _cellSize = cellSize;
+    _safeColumns = safeColumns;
+    _first = -1;
+    _last = -1;
+    _dirty = true;
+    _fills.command = GL_TRIANGLES;
+    _lines.command = GL_LINES;
+    setAnchor(Vec2::ANCHOR_BOTTOM_LEFT);
+    setPosition(Vec2::ZERO);
+    setContentSize(Size(columns * cellSize, rowEnd * cellSize));
+    return true;
+}
+
+#pragma mark -
+#pragma mark Cells
+/**
+ * Sets the occupied cells.
+ *
+ * @param cells The occupied cells, sorted and without duplicates
+ */
+void GridOverlayNode::setOccupied(std::vector<std::pair<int, int>>&& cells) {
+    if (cells != _occupied) {
+        _occupied = std::move(cells);
+        _dirty = true;
+    }
+}
+
+/**
+ * Shows the footprint of an object about to be placed.
+ *
+ * @param cell  The bottom left cell of the footprint
+ * @param size  The footprint size (in cells)
+ * @param legal Whether the object may be placed there
+ */
+void GridOverlayNode::setGhost(const Vec2& cell, const Size& size, bool legal) {
+    std::pair<int, int> ghostCell((int)std::floor(cell.x / _cellSize), (int)std::floor(cell.y / _cellSize));
+    std::pair<int, int> ghostSize(std::max(1, size.getIWidth()), std::max(1, size.getIHeight()));
+    if (_hasGhost && ghostCell == _ghostCell && ghostSize == _ghostSize && legal == _ghostLegal) {
+        return;
+    }
+    _ghostCell = ghostCell;
+    _ghostSize = ghostSize;
+    _ghostLegal = legal;
+    _hasGhost = true;
+    _dirty = true;
+}
+
+/**
+ * Hides the footprint.
+ */
+void GridOverlayNode::clearGhost() {
+    if (_hasGhost) {
+        _hasGhost = false;
+        _dirty = true;
+    }
+}
+
+#pragma mark -
+#pragma mark Drawing
+/**
+ * Adds a tinted rectangle of cells to the fill mesh.
+ *
+ * @param col0  The first column
+ * @param row0  The first row
+ * @param col1  The column after the last one
+ * @param row1  The row after the last one
+ * @param color The packed tint
+ */
+void GridOverlayNode::addRect(int col0, int row0, int col1, int row1, GLuint color) {
+    Uint32 base = (Uint32)_fills.vertices.size();
+    SpriteVertex vertex;
+    vertex.color = color;
+    vertex.texcoord = Vec2::ZERO;
+    vertex.gradcoord = Vec2::ZERO;
+    vertex.position = Vec2(col0 * _cellSize, row0 * _cellSize);
+    _fills.vertices.push_back(vertex);
+    vertex.position = Vec2(col1 * _cellSize, row0 * _cellSize);
+    _fills.vertices.push_back(vertex);
+    vertex.position = Vec2(col1 * _cellSize, row1 * _cellSize);
+    _fills.vertices.push_back(vertex);
+    vertex.position = Vec2(col0 * _cellSize, row1 * _cellSize);
+    _fills.vertices.push_back(vertex);
+
+    _fills.indices.push_back(base);
+    _fills.indices.push_back(base + 1);
+    _fills.indices.push_back(base + 2);
+    _fills.indices.push_back(base);
+    _fills.indices.push_back(base + 2);
+    _fills.indices.push_back(base + 3);
+}
+
+/**
+ * Adds a line to the line mesh.
+ *
+ * @param p1    The start of the line
+ * @param p2    The end of the line
+ * @param color The packed color
+ */
+void GridOverlayNode::addLine(const Vec2& p1, const Vec2& p2, GLuint color) {
+    Uint32 base = (Uint32)_lines.vertices.size();
+    SpriteVertex vertex;
+    vertex.color = color;
+    vertex.texcoord = Vec2::ZERO;
+    vertex.gradcoord = Vec2::ZERO;
+    vertex.position = p1;
+    _lines.vertices.push_back(vertex);
+    vertex.position = p2;
+    _lines.vertices.push_back(vertex);
+
+    _lines.indices.push_back(base);
+    _lines.indices.push_back(base + 1);
+}
+
+/**
+ * Rebuilds the meshes for the given columns.
+ *
+ * Each grid line spans every drawn column (or row), rather than one line per
+ * cell edge, so the line mesh only grows with the size of the view.
+ *
+ * @param first The first column to draw
+ * @param last  The last column to draw
+ */
+void GridOverlayNode::rebuild(int first, int last) {
+    _fills.vertices.clear();
+    _fills.indices.clear();
+    _lines.vertices.clear();
+    _lines.indices.clear();
+    _first = first;
+    _last = last;
+    _dirty = false;
+
+    // The safe zone, clipped to the drawn columns
+    if (first < _safeColumns) {
+        addRect(first, _rowStart, std::min(last + 1, _safeColumns), _rowEnd, SAFE_ZONE_COLOR.getPacked());
+    }
+
+    // The occupied cells (sorted by column, so the drawn ones are a single run)
+    GLuint occupied = OCCUPIED_COLOR.getPacked();
+    auto it = std::lower_bound(_occupied.begin(), _occupied.end(), std::make_pair(first, INT_MIN));
+    for (; it != _occupied.end() && it->first <= last; ++it) {
+        addRect(it->first, it->second, it->first + 1, it->second + 1, occupied);
+    }
+
+    // The grid lines
+    GLuint line = LINE_COLOR.getPacked();
+    float left = first * _cellSize;
+    float right = (last + 1) * _cellSize;
+    for (int row = _rowStart; row <= _rowEnd; row++) {
+        addLine(Vec2(left, row * _cellSize), Vec2(right, row * _cellSize), line);
+    }
+    for (int col = first; col <= last + 1; col++) {
+        addLine(Vec2(col * _cellSize, _rowStart * _cellSize), Vec2(col * _cellSize, _rowEnd * _cellSize), line);
+    }
+
+    // The footprint, with an outline drawn over the grid lines
+    if (_hasGhost) {
+        Color4 color = _ghostLegal ? LEGAL_COLOR : ILLEGAL_COLOR;
+        int col0 = _ghostCell.first;
+        int row0 = _ghostCell.second;
+        int col1 = col0 + _ghostSize.first;
+        int row1 = row0 + _ghostSize.second;
+        addRect(col0, row0, col1, row1, color.getPacked());
+
+        color.a = 255;
+        GLuint outline = color.getPacked();
+        Vec2 p0(col0 * _cellSize, row0 * _cellSize);
+        Vec2 p1(col1 * _cellSize, row0 * _cellSize);
+        Vec2 p2(col1 * _cellSize, row1 * _cellSize);
+        Vec2 p3(col0 * _cellSize, row1 * _cellSize);
+        addLine(p0, p1, outline);
+        addLine(p1, p2, outline);
+        addLine(p2, p3, outline);
+        addLine(p3, p0, outline);
+    }
+}
+
+/**
+ * Draws the grid with the given SpriteBatch.
+ *
+ * Only the columns near the camera are drawn. The meshes are rebuilt when the
+ * camera leaves the drawn columns, or when the cells or footprint change.
+ *
+ * @param batch     The SpriteBatch to draw with.
+ * @param transform The global transformation matrix.
+ * @param tint      The tint to blend with the grid colors.
+ */
+void GridOverlayNode::draw(const std::shared_ptr<SpriteBatch>& batch, const Affine2& transform, Color4 tint) {
+    int first, last;
+    if (!GridChunks::getVisibleColumns(this, _cellSize, first, last)) {
+        first = 0;
+        last = _columns - 1;
+    }
+    first = std::max(0, first);
+    last = std::min(_columns - 1, last);
+    if (last < first) {
+        return;
+    }
+
+    if (_dirty || first < _first || last > _last) {
+        rebuild(std::max(0, first - GRID_OVERLAY_MARGIN), std::min(_columns - 1, last + GRID_OVERLAY_MARGIN));
+    }
+
+    batch->setColor(tint);
+    batch->setTexture(nullptr);
+    if (!_fills.indices.empty()) {
+        batch->drawMesh(_fills, transform);
+    }
+    batch->drawMesh(_lines, transform);
+}
@@ -0,0 +1,166 @@
+//
+//  GridOverlayNode.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_GRID_OVERLAY_NODE_H__
+#define __SSB_GRID_OVERLAY_NODE_H__
+#include <cugl/cugl.h>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace cugl;
+using namespace cugl::graphics;
+
+/** The number of columns on each side of the visible ones that are also drawn */
+#define GRID_OVERLAY_MARGIN     4
+
+/**
+ * The grid of build mode, drawn by a single node.
+ *
+ * Every grid line, the tint of the safe zone and occupied cells, and the
+ * footprint of the object being placed are written into two meshes (one of
+ * triangles and one of lines) that are sent straight to the SpriteBatch. The
+ * meshes only cover the columns near the camera, and are only rebuilt when
+ * those columns, the occupied cells or the footprint change. This keeps the
+ * grid at a couple of draw calls, no matter how wide the level is.
+ *
+ * The node is in grid coordinates, with cell (0,0) at its origin.
+ */
+class GridOverlayNode : public scene2::SceneNode {
+private:
+    /** The number of columns in the grid */
+    int _columns;
+    /** The first row with lines */
+    int _rowStart;
+    /** The row after the last row with lines */
+    int _rowEnd;
+    /** The size of a cell (in node coordinates) */
+    float _cellSize;
+    /** The number of columns (from the left) where nothing may be placed */
+    int _safeColumns;
+
+    /** The occupied cells, sorted */
+    std::vector<std::pair<int, int>> _occupied;
+    /** The bottom left cell of the footprint */
+    std::pair<int, int> _ghostCell;
+    /** The footprint size (in cells) */
+    std::pair<int, int> _ghostSize;
+    /** Whether the footprint is shown */
+    bool _hasGhost;
+    /** Whether the footprint is on a legal position */
+    bool _ghostLegal;
+
+    /** The first column in the meshes */
+    int _first;
+    /** The last column in the meshes */
+    int _last;
+    /** Whether the meshes must be rebuilt */
+    bool _dirty;
+    /** The cell tints and footprint */
+    Mesh<SpriteVertex> _fills;
+    /** The grid lines and footprint outline */
+    Mesh<SpriteVertex> _lines;
+
+    /**
+     * Rebuilds the meshes for the given columns.
+     *
+     * @param first The first column to draw
+     * @param last  The last column to draw
+     */
+    void rebuild(int first, int last);
+
+    /**
+     * Adds a tinted rectangle of cells to the fill mesh.
+     *
+     * @param col0  The first column
+     * @param row0  The first row
+     * @param col1  The column after the last one
+     * @param row1  The row after the last one
+     * @param color The packed tint
+     */
+    void addRect(int col0, int row0, int col1, int row1, GLuint color);
+
+    /**
+     * Adds a line to the line mesh.
+     *
+     * @param p1    The start of the line
+     * @param p2    The end of the line
+     * @param color The packed color
+     */
+    void addLine(const Vec2& p1, const Vec2& p2, GLuint color);
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates an empty overlay.
+     */
+    GridOverlayNode() : _columns(0), _rowStart(0), _rowEnd(0), _cellSize(1.0f), _safeColumns(0),
+        _hasGhost(false), _ghostLegal(false), _first(-1), _last(-1), _dirty(true) {}
+
+    /**
+     * Initializes the overlay for the given cells.
+     *
+     * @param columns       The number of columns in the grid
+     * @param rowStart      The first row with lines
+     * @param rowEnd        The row after the last row with lines
+     * @param cellSize      The size of a cell (in node coordinates)
+     * @param safeColumns   The number of columns where nothing may be placed
+     *
+     * @return true if the overlay was initialized properly
+     */
+    bool initWithGrid(int columns, int rowStart, int rowEnd, float cellSize, int safeColumns);
+
+    /**
+     * Returns a newly allocated overlay for the given cells.
+     *
+     * @param columns       The number of columns in the grid
+     * @param rowStart      The first row with lines
+     * @param rowEnd        The row after the last row with lines
+     * @param cellSize      The size of a cell (in node coordinates)
+     * @param safeColumns   The number of columns where nothing may be placed
+     *
+     * @return a newly allocated overlay
+     */
+    static std::shared_ptr<GridOverlayNode> alloc(int columns, int rowStart, int rowEnd, float cellSize, int safeColumns) {
+        std::shared_ptr<GridOverlayNode> result = std::make_shared<GridOverlayNode>();
+        return (result->initWithGrid(columns, rowStart, rowEnd, cellSize, safeColumns) ? result : nullptr);
+    }
+
+#pragma mark Cells
+    /**
+     * Sets the occupied cells.
+     *
+     * The meshes are only rebuilt if the cells differ from the current ones.
+     *
+     * @param cells The occupied cells, sorted and without duplicates
+     */
+    void setOccupied(std::vector<std::pair<int, int>>&& cells);
+
+    /**
+     * Shows the footprint of an object about to be placed.
+     *
+     * @param cell  The bottom left cell of the footprint
+     * @param size  The footprint size (in cells)
+     * @param legal Whether the object may be placed there
+     */
+    void setGhost(const Vec2& cell, const Size& size, bool legal);
+
+    /**
+     * Hides the footprint.
+     */
+    void clearGhost();
+
+#pragma mark Drawing
+    /**
+     * Draws the grid with the given SpriteBatch.
+     *
+     * @param batch     The SpriteBatch to draw with.
+     * @param transform The global transformation matrix.
+     * @param tint      The tint to blend with the grid colors.
+     */
+    virtual void draw(const std::shared_ptr<SpriteBatch>& batch, const Affine2& transform, Color4 tint) override;
+};
+
+#endif /* __SSB_GRID_OVERLAY_NODE_H__ */
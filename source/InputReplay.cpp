@@ -0,0 +1,107 @@
+//
+//  InputReplay.cpp
+//  SweetSweetBetrayal
+//
+
+#include "InputReplay.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+using namespace cugl;
+
+#pragma mark -
+#pragma mark Recording
+/**
+ * Writes the recording to the given JSON file.
+ *
+ * The movement is written as the bits of the float, and the hash as a hex
+ * string (JSON numbers are doubles), so both read back exactly.
+ *
+ * @param file  The file to write
+ *
+ * @return true if the recording was written
+ */
+bool InputReplay::save(const std::string& file) const {
+    std::shared_ptr<JsonValue> frames = JsonValue::allocArray();
+    for (auto& frame : _frames) {
+        uint32_t bits;
+        std::memcpy(&bits, &frame.movement, sizeof(bits));
+        char hash[17];
+        snprintf(hash, sizeof(hash), "%016llx", (unsigned long long)frame.hash);
+
+        std::shared_ptr<JsonValue> value = JsonValue::allocObject();
+        value->appendValue("tick", (long)frame.tick);
+        value->appendValue("movement", (long)bits);
+        value->appendValue("jump", frame.jumpHold);
+        value->appendValue("hash", std::string(hash));
+        frames->appendChild(value);
+    }
+    std::shared_ptr<JsonValue> json = JsonValue::allocObject();
+    json->appendChild("frames", frames);
+
+    std::shared_ptr<JsonWriter> writer = JsonWriter::alloc(file);
+    if (writer == nullptr) {
+        CULogError("Could not write input replay %s", file.c_str());
+        return false;
+    }
+    writer->writeJson(json);
+    writer->close();
+    return true;
+}
+
+/**
+ * Replaces the recording with the one in the given JSON file.
+ *
+ * @param file  The file to read
+ *
+ * @return true if the recording was read
+ */
+bool InputReplay::load(const std::string& file) {
+    clear();
+    std::shared_ptr<JsonReader> reader = JsonReader::alloc(file);
+    if (reader == nullptr) {
+        return false;
+    }
+    std::shared_ptr<JsonValue> json = reader->readJson();
+    reader->close();
+    std::shared_ptr<JsonValue> frames = json ? json->get("frames") : nullptr;
+    if (frames == nullptr) {
+        CULogError("Input replay %s has no frames", file.c_str());
+        return false;
+    }
+
+    for (auto& value : frames->children()) {
+        Frame frame;
+        uint32_t bits = (uint32_t)value->getLong("movement", 0);
+        std::memcpy(&frame.movement, &bits, sizeof(bits));
+        frame.tick = (Uint64)value->getLong("tick", 0);
+        frame.jumpHold = value->getBool("jump", false);
+        frame.hash = std::strtoull(value->getString("hash", "0").c_str(), nullptr, 16);
+        _frames.push_back(frame);
+    }
+    return true;
+}
+
+#pragma mark -
+#pragma mark Playback
+/**
+ * Returns the first step where two recordings diverge.
+ *
+ * The recordings diverge where their hashes differ, or where one of them
+ * ends before the other.
+ *
+ * @param expected  The reference recording
+ * @param actual    The recording to check
+ *
+ * @return the position of the first divergent step (-1 if they match)
+ */
+long InputReplay::compare(const InputReplay& expected, const InputReplay& actual) {
+    size_t count = std::min(expected.size(), actual.size());
+    for (size_t ii = 0; ii < count; ii++) {
+        if (expected.get(ii).hash != actual.get(ii).hash) {
+            return (long)ii;
+        }
+    }
+    return expected.size() == actual.size() ? -1 : (long)count;
+}
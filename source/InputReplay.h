@@ -0,0 +1,126 @@
+//
+//  InputReplay.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_INPUT_REPLAY_H__
+#define __SSB_INPUT_REPLAY_H__
+#include <cugl/cugl.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace cugl;
+
+/** The recording written to the save directory at the end of a movement phase */
+#define INPUT_REPLAY_FILE   "input-replay.json"
+
+/**
+ * The local player input and state hash of every fixed step of a movement phase.
+ *
+ * With fixed-point movement on, the game records the input it applied to the
+ * local player on each step, together with the hash of the player state after
+ * the step. Playing the recording back from the same start state must give
+ * the same hash on every step. {@link #compare} finds the first step where two
+ * recordings (of the same run, or of two devices) diverge.
+ */
+class InputReplay {
+public:
+    /** The input and result of one fixed step */
+    struct Frame {
+        /** The moving platform tick of the step */
+        Uint64 tick;
+        /** The movement of the local player */
+        float movement;
+        /** Whether the local player held jump */
+        bool jumpHold;
+        /** The hash of the player state after the step */
+        uint64_t hash;
+    };
+
+private:
+    /** The recorded steps, in order */
+    std::vector<Frame> _frames;
+    /** The next step to play back */
+    size_t _next;
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates an empty recording.
+     */
+    InputReplay() : _next(0) {}
+
+    /**
+     * Forgets every recorded step.
+     */
+    void clear() {
+        _frames.clear();
+        _next = 0;
+    }
+
+#pragma mark Recording
+    /**
+     * Appends a step to the recording.
+     *
+     * @param tick      The moving platform tick of the step
+     * @param movement  The movement of the local player
+     * @param jumpHold  Whether the local player held jump
+     * @param hash      The hash of the player state after the step
+     */
+    void record(Uint64 tick, float movement, bool jumpHold, uint64_t hash) {
+        _frames.push_back({tick, movement, jumpHold, hash});
+    }
+
+    /**
+     * Writes the recording to the given JSON file.
+     *
+     * @param file  The file to write
+     *
+     * @return true if the recording was written
+     */
+    bool save(const std::string& file) const;
+
+    /**
+     * Replaces the recording with the one in the given JSON file.
+     *
+     * @param file  The file to read
+     *
+     * @return true if the recording was read
+     */
+    bool load(const std::string& file);
+
+#pragma mark Playback
+    /** Returns true if there is a step left to play back */
+    bool hasNext() const { return _next < _frames.size(); }
+
+    /**
+     * Returns the next step to play back, and moves past it.
+     *
+     * This should only be called if {@link #hasNext} is true.
+     *
+     * @return the next step to play back
+     */
+    const Frame& next() { return _frames[_next++]; }
+
+    /** Returns the number of recorded steps */
+    size_t size() const { return _frames.size(); }
+
+    /** Returns the recorded step at the given position */
+    const Frame& get(size_t index) const { return _frames[index]; }
+
+    /**
+     * Returns the first step where two recordings diverge.
+     *
+     * The recordings diverge where their hashes differ, or where one of them
+     * ends before the other.
+     *
+     * @param expected  The reference recording
+     * @param actual    The recording to check
+     *
+     * @return the position of the first divergent step (-1 if they match)
+     */
+    static long compare(const InputReplay& expected, const InputReplay& actual);
+};
+
+#endif /* __SSB_INPUT_REPLAY_H__ */
@@ -0,0 +1,580 @@
+//
+//  LevelBinary.cpp
+//  SweetSweetBetrayal
+//
+
+#include "LevelBinary.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace cugl;
+
+/**
+ * Returns the record kind for a JSON object group name.
+ *
+ * @param key   The JSON group name (e.g. "platforms")
+ * @param kind  Set to the matching record kind
+ *
+ * @return true if the group name has a record kind
+ */
+bool levelRecordKindFromKey(const std::string& key, LevelRecordKind& kind) {
+    if (key == "platforms") {
+        kind = LevelRecordKind::PLATFORM;
+    } else if (key == "tiles") {
+        kind = LevelRecordKind::TILE;
+    } else if (key == "spikes") {
+        kind = LevelRecordKind::SPIKE;
+    } else if (key == "treasures") {
+        kind = LevelRecordKind::TREASURE;
+    } else if (key == "windObstacles") {
+        kind = LevelRecordKind::WIND;
+    } else if (key == "artObjects") {
+        kind = LevelRecordKind::ART;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Returns the JSON group name for a record kind.
+ *
+ * @param kind  The record kind
+ *
+ * @return the JSON group name (e.g. "platforms")
+ */
+const char* levelRecordKindKey(LevelRecordKind kind) {
+    switch (kind) {
+        case LevelRecordKind::PLATFORM: return "platforms";
+        case LevelRecordKind::TILE: return "tiles";
+        case LevelRecordKind::SPIKE: return "spikes";
+        case LevelRecordKind::TREASURE: return "treasures";
+        case LevelRecordKind::WIND: return "windObstacles";
+        default: return "artObjects";
+    }
+}
+
+/**
+ * Writes the bytes to the file at the given path.
+ *
+ * @param path  The full path to the file
+ * @param data  The bytes to write
+ * @param size  The number of bytes
+ *
+ * @return true if the file was written, false otherwise.
+ */
+static bool writeFile(const std::string& path, const void* data, size_t size) {
+    SDL_RWops* file = SDL_RWFromFile(path.c_str(), "wb");
+    if (file == nullptr) {
+        CULogError("Could not open %s for writing", path.c_str());
+        return false;
+    }
+    bool success = SDL_RWwrite(file, data, 1, size) == size;
+    SDL_RWclose(file);
+    if (!success) {
+        CULogError("Could not write level %s", path.c_str());
+    }
+    return success;
+}
+
+/**
+ * Appends a string to JSON text as a quoted JSON string.
+ *
+ * @param value The string to append
+ * @param out   The JSON text to append to
+ */
+static void appendJsonString(const std::string& value, std::string& out) {
+    out.push_back('"');
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out.push_back('\\');
+        }
+        out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+#pragma mark -
+#pragma mark Level Fields
+/**
+ * Copies the fields of a JSON object into a record.
+ *
+ * @param json      The JSON object for a single level object
+ * @param fields    The set of fields to read
+ * @param record    The record to fill in
+ */
+void readLevelFields(const std::shared_ptr<JsonValue>& json, uint32_t fields, LevelRecord& record) {
+    uint8_t* base = reinterpret_cast<uint8_t*>(&record);
+    for (const LevelFieldInfo& info : LEVEL_FIELDS) {
+        if (!(fields & info.field) || !json->has(info.name)) {
+            continue;
+        }
+        if (info.integer) {
+            int32_t value = json->getInt(info.name);
+            memcpy(base + info.offset, &value, sizeof(int32_t));
+        } else {
+            float value = json->getFloat(info.name);
+            memcpy(base + info.offset, &value, sizeof(float));
+        }
+    }
+}
+
+/**
+ * Appends the fields of a record to a JSON object under construction.
+ *
+ * @param record    The record to write
+ * @param fields    The set of fields to write
+ * @param out       The JSON text to append to
+ */
+void writeLevelFields(const LevelRecord& record, uint32_t fields, std::string& out) {
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(&record);
+    char buffer[32];
+    for (const LevelFieldInfo& info : LEVEL_FIELDS) {
+        if (!(fields & info.field)) {
+            continue;
+        }
+        if (info.integer) {
+            int32_t value;
+            memcpy(&value, base + info.offset, sizeof(int32_t));
+            snprintf(buffer, sizeof(buffer), "%d", value);
+        } else {
+            float value;
+            memcpy(&value, base + info.offset, sizeof(float));
+            if (!std::isfinite(value)) {
+                // JSON has no nan or inf, and the level would not load again
+                CULogError("Writing %s = %g as 0", info.name, value);
+                value = 0;
+            }
+            // Nine significant digits always read back as the same float
+            snprintf(buffer, sizeof(buffer), "%.9g", value);
+        }
+        out.push_back('"');
+        out.append(info.name);
+        out.append("\":");
+        out.append(buffer);
+        out.push_back(',');
+    }
+}
+
+#pragma mark -
+#pragma mark Binary Level
+/**
+ * Initializes this binary level from the file at the given path.
+ *
+ * @param path  The full path to the .ssbl file
+ *
+ * @return true if the file was loaded and is well-formed, false otherwise.
+ */
+bool LevelBinary::init(const std::string& path) {
+#if !defined(_WIN32)
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* addr = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                _data = static_cast<const uint8_t*>(addr);
+                _size = (size_t)info.st_size;
+                _mapped = true;
+            }
+        }
+        close(fd);
+    }
+#endif
+    // Assets inside an app bundle (like an APK) are not plain files
+    if (_data == nullptr) {
+        SDL_RWops* file = SDL_RWFromFile(path.c_str(), "rb");
+        if (file == nullptr) {
+            return false;
+        }
+        Sint64 size = SDL_RWsize(file);
+        if (size > 0) {
+            _buffer.resize((size_t)size);
+            if (SDL_RWread(file, _buffer.data(), 1, (size_t)size) == (size_t)size) {
+                _data = _buffer.data();
+                _size = _buffer.size();
+            }
+        }
+        SDL_RWclose(file);
+    }
+
+    if (_data == nullptr || !validate()) {
+        CULogError("Invalid binary level %s", path.c_str());
+        dispose();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Initializes this binary level from a block of bytes in the .ssbl format.
+ *
+ * @param data  The bytes of the level
+ *
+ * @return true if the bytes hold a well-formed level, false otherwise.
+ */
+bool LevelBinary::initWithData(std::vector<uint8_t>&& data) {
+    _buffer = std::move(data);
+    _data = _buffer.empty() ? nullptr : _buffer.data();
+    _size = _buffer.size();
+    if (_data == nullptr || !validate()) {
+        CULogError("Invalid binary level data");
+        dispose();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Returns the modification time of the file, or 0 if it has none.
+ *
+ * @param path  The full path to the file
+ */
+time_t LevelBinary::getModifiedTime(const std::string& path) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) {
+        return 0;
+    }
+    return info.st_mtime;
+}
+
+/**
+ * Returns the full path of a level or asset file.
+ *
+ * @param file              The file name
+ * @param useAbsolutePath   Whether the file name is a full path (and not an asset)
+ */
+std::string LevelBinary::getPath(const std::string& file, bool useAbsolutePath) {
+    if (useAbsolutePath || Application::get() == nullptr) {
+        return file;
+    }
+    return Application::get()->getAssetDirectory() + file;
+}
+
+/**
+ * Returns the binary level next to the given JSON level, if it is fresh.
+ *
+ * @param jsonFile          The JSON level file name
+ * @param useAbsolutePath   Whether the file name is a full path (and not an asset)
+ *
+ * @return the fresh binary level, or nullptr if there is none.
+ */
+std::shared_ptr<LevelBinary> LevelBinary::allocForJson(const std::string& jsonFile, bool useAbsolutePath) {
+    std::string jsonPath = getPath(jsonFile, useAbsolutePath);
+    std::string binaryPath = getPath(getBinaryName(jsonFile), useAbsolutePath);
+
+    time_t jsonTime = getModifiedTime(jsonPath);
+    time_t binaryTime = getModifiedTime(binaryPath);
+    if (jsonTime != 0 && binaryTime < jsonTime) {
+        // Either there is no binary level or it is older than the JSON
+        return nullptr;
+    }
+    return alloc(binaryPath);
+}
+
+/**
+ * Returns the .ssbl file name that goes with a JSON level file name.
+ *
+ * @param jsonFile  The JSON level file name
+ */
+std::string LevelBinary::getBinaryName(const std::string& jsonFile) {
+    size_t dot = jsonFile.find_last_of('.');
+    size_t slash = jsonFile.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return jsonFile + SSBL_EXTENSION;
+    }
+    return jsonFile.substr(0, dot) + SSBL_EXTENSION;
+}
+
+/**
+ * Unmaps (or frees) the file contents.
+ */
+void LevelBinary::dispose() {
+#if !defined(_WIN32)
+    if (_mapped && _data != nullptr) {
+        munmap(const_cast<uint8_t*>(_data), _size);
+    }
+#endif
+    _buffer.clear();
+    _data = nullptr;
+    _size = 0;
+    _mapped = false;
+}
+
+/**
+ * Returns true if the contents hold a well-formed binary level.
+ */
+bool LevelBinary::validate() const {
+    if (_size < sizeof(LevelBinaryHeader)) {
+        return false;
+    }
+    const LevelBinaryHeader* head = header();
+    if (head->magic != SSBL_MAGIC || head->version != SSBL_VERSION || head->fileSize != _size) {
+        return false;
+    }
+    for (size_t ii = 0; ii < SSBL_KIND_COUNT; ii++) {
+        uint64_t end = (uint64_t)head->sectionOffset[ii] + (uint64_t)head->sectionCount[ii] * sizeof(LevelRecord);
+        if (head->sectionOffset[ii] < sizeof(LevelBinaryHeader) || end > _size) {
+            return false;
+        }
+    }
+    uint64_t tableEnd = (uint64_t)head->stringTableOffset + (uint64_t)head->stringCount * sizeof(uint32_t);
+    if (tableEnd > _size || head->stringDataOffset > _size) {
+        return false;
+    }
+
+    // The runs must cover every record of each kind exactly once
+    uint64_t runEnd = (uint64_t)head->runOffset + (uint64_t)head->runCount * sizeof(LevelRecordRun);
+    if (head->runOffset < sizeof(LevelBinaryHeader) || runEnd > _size) {
+        return false;
+    }
+    uint64_t counts[SSBL_KIND_COUNT] = { 0 };
+    const LevelRecordRun* runs = getRuns();
+    for (uint32_t ii = 0; ii < head->runCount; ii++) {
+        if (runs[ii].kind >= SSBL_KIND_COUNT) {
+            return false;
+        }
+        counts[runs[ii].kind] += runs[ii].count;
+    }
+    for (size_t ii = 0; ii < SSBL_KIND_COUNT; ii++) {
+        if (counts[ii] != head->sectionCount[ii]) {
+            return false;
+        }
+    }
+
+    // Every string must start inside the data and be terminated before the end
+    const uint32_t* table = reinterpret_cast<const uint32_t*>(_data + head->stringTableOffset);
+    size_t dataSize = _size - head->stringDataOffset;
+    const char* strings = reinterpret_cast<const char*>(_data + head->stringDataOffset);
+    for (uint32_t ii = 0; ii < head->stringCount; ii++) {
+        if (table[ii] >= dataSize || memchr(strings + table[ii], '\0', dataSize - table[ii]) == nullptr) {
+            return false;
+        }
+    }
+    for (size_t ii = 0; ii < SSBL_KIND_COUNT; ii++) {
+        const LevelRecord* records = getRecords((LevelRecordKind)ii);
+        for (uint32_t jj = 0; jj < head->sectionCount[ii]; jj++) {
+            if (records[jj].typeIndex >= head->stringCount || records[jj].assetIndex >= head->stringCount) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+#pragma mark -
+#pragma mark Binary Level Builder
+/**
+ * Returns the table index of the string, adding it if necessary.
+ *
+ * @param value The string to look up
+ */
+uint32_t LevelBinaryBuilder::intern(const std::string& value) {
+    auto it = _stringIndex.find(value);
+    if (it == _stringIndex.end()) {
+        it = _stringIndex.emplace(value, (uint32_t)_strings.size()).first;
+        _strings.push_back(value);
+    }
+    return it->second;
+}
+
+/**
+ * Adds a record to the level.
+ *
+ * @param kind      The kind of the record
+ * @param record    The record values
+ * @param type      The json type of the object
+ * @param asset     The texture key of the object (empty if unresolved)
+ */
+void LevelBinaryBuilder::addRecord(LevelRecordKind kind, LevelRecord record, const std::string& type,
+                                   const std::string& asset) {
+    record.typeIndex = intern(type);
+    record.assetIndex = intern(asset);
+    _records[(size_t)kind].push_back(record);
+    if (!_runs.empty() && _runs.back().kind == (uint32_t)kind) {
+        _runs.back().count++;
+    } else {
+        _runs.push_back({ (uint32_t)kind, 1 });
+    }
+}
+
+/**
+ * Calls the function on every record, in the order added.
+ *
+ * @param visit The function to call with the kind and record
+ */
+void LevelBinaryBuilder::forEachRecord(const std::function<void(LevelRecordKind, const LevelRecord&)>& visit) const {
+    size_t next[SSBL_KIND_COUNT] = { 0 };
+    for (const LevelRecordRun& run : _runs) {
+        const std::vector<LevelRecord>& records = _records[run.kind];
+        for (uint32_t ii = 0; ii < run.count; ii++) {
+            visit((LevelRecordKind)run.kind, records[next[run.kind]++]);
+        }
+    }
+}
+
+/**
+ * Returns a builder holding every object of a JSON level.
+ *
+ * @param json  The JSON level (with "width", "height" and "objectTypes")
+ *
+ * @return a builder holding the level, or nullptr if the JSON is malformed.
+ */
+std::shared_ptr<LevelBinaryBuilder> LevelBinaryBuilder::allocWithJson(const std::shared_ptr<JsonValue>& json) {
+    if (json == nullptr || json->get("objectTypes") == nullptr) {
+        return nullptr;
+    }
+    std::shared_ptr<LevelBinaryBuilder> result =
+        std::make_shared<LevelBinaryBuilder>(Size(json->getFloat("width"), json->getFloat("height")));
+
+    LevelRecordKind kind;
+    std::vector<std::shared_ptr<JsonValue>> objectTypes = json->get("objectTypes")->children();
+    for (auto it = objectTypes.begin(); it != objectTypes.end(); ++it) {
+        if (!levelRecordKindFromKey((*it)->getString("name"), kind) || (*it)->get("objects") == nullptr) {
+            continue;
+        }
+        std::vector<std::shared_ptr<JsonValue>> objects = (*it)->get("objects")->children();
+        for (auto it2 = objects.begin(); it2 != objects.end(); ++it2) {
+            result->addRecord(kind, *it2);
+        }
+    }
+    return result;
+}
+
+/**
+ * Adds a record built from a JSON object in the level format.
+ *
+ * @param kind  The kind of the record
+ * @param json  The JSON object for a single level object
+ */
+void LevelBinaryBuilder::addRecord(LevelRecordKind kind, const std::shared_ptr<JsonValue>& json) {
+    LevelRecord record;
+    memset(&record, 0, sizeof(LevelRecord));
+    readLevelFields(json, levelKindFields(kind), record);
+    addRecord(kind, record, json->getString("type"));
+}
+
+/**
+ * Returns the binary level as a block of bytes.
+ *
+ * @return the binary level as a block of bytes
+ */
+std::vector<uint8_t> LevelBinaryBuilder::build() const {
+    LevelBinaryHeader head;
+    memset(&head, 0, sizeof(LevelBinaryHeader));
+    head.magic = SSBL_MAGIC;
+    head.version = SSBL_VERSION;
+    head.flags = _flags;
+    head.width = _levelSize.width;
+    head.height = _levelSize.height;
+
+    // Lay out the sections, then the runs, then the string table, then the string data
+    uint32_t offset = sizeof(LevelBinaryHeader);
+    for (size_t ii = 0; ii < SSBL_KIND_COUNT; ii++) {
+        head.sectionOffset[ii] = offset;
+        head.sectionCount[ii] = (uint32_t)_records[ii].size();
+        offset += head.sectionCount[ii] * sizeof(LevelRecord);
+    }
+    head.runOffset = offset;
+    head.runCount = (uint32_t)_runs.size();
+    offset += head.runCount * sizeof(LevelRecordRun);
+    head.stringTableOffset = offset;
+    head.stringCount = (uint32_t)_strings.size();
+    offset += head.stringCount * sizeof(uint32_t);
+    head.stringDataOffset = offset;
+
+    std::vector<uint32_t> table;
+    std::string data;
+    for (auto& str : _strings) {
+        table.push_back((uint32_t)data.size());
+        data.append(str);
+        data.push_back('\0');
+    }
+    head.fileSize = offset + (uint32_t)data.size();
+
+    std::vector<uint8_t> bytes(head.fileSize);
+    memcpy(bytes.data(), &head, sizeof(LevelBinaryHeader));
+    for (size_t ii = 0; ii < SSBL_KIND_COUNT; ii++) {
+        if (!_records[ii].empty()) {
+            memcpy(bytes.data() + head.sectionOffset[ii], _records[ii].data(), _records[ii].size() * sizeof(LevelRecord));
+        }
+    }
+    if (!_runs.empty()) {
+        memcpy(bytes.data() + head.runOffset, _runs.data(), _runs.size() * sizeof(LevelRecordRun));
+    }
+    if (!table.empty()) {
+        memcpy(bytes.data() + head.stringTableOffset, table.data(), table.size() * sizeof(uint32_t));
+    }
+    if (!data.empty()) {
+        memcpy(bytes.data() + head.stringDataOffset, data.data(), data.size());
+    }
+    return bytes;
+}
+
+/**
+ * Writes the binary level to the given path.
+ *
+ * @param path  The full path to the .ssbl file
+ *
+ * @return true if the file was written, false otherwise.
+ */
+bool LevelBinaryBuilder::write(const std::string& path) const {
+    std::vector<uint8_t> bytes = build();
+    return writeFile(path, bytes.data(), bytes.size());
+}
+
+/**
+ * Returns the level in the JSON level format.
+ *
+ * @return the level in the JSON level format
+ */
+std::string LevelBinaryBuilder::buildJson() const {
+    std::string out;
+    out.reserve(256);
+    out.append("{\n\"width\":");
+    out.append(std::to_string(_levelSize.getIWidth()));
+    out.append(",\n\"height\":");
+    out.append(std::to_string(_levelSize.getIHeight()));
+    out.append(",\n\"objects\":[],\n\"objectTypes\":[");
+
+    // One group per run, so the objects keep the order they were added in
+    size_t next[SSBL_KIND_COUNT] = { 0 };
+    for (size_t ii = 0; ii < _runs.size(); ii++) {
+        LevelRecordKind kind = (LevelRecordKind)_runs[ii].kind;
+        const std::vector<LevelRecord>& records = _records[(size_t)kind];
+        uint32_t fields = levelKindFields(kind);
+        out.append(ii == 0 ? "\n{\"name\":" : ",\n{\"name\":");
+        appendJsonString(levelRecordKindKey(kind), out);
+        out.append(",\"objects\":[");
+        for (uint32_t jj = 0; jj < _runs[ii].count; jj++) {
+            const LevelRecord& record = records[next[(size_t)kind]++];
+            out.append(jj == 0 ? "\n{" : ",\n{");
+            writeLevelFields(record, fields, out);
+            out.append("\"type\":");
+            appendJsonString(_strings[record.typeIndex], out);
+            out.push_back('}');
+        }
+        out.append("]}");
+    }
+    out.append("\n]\n}\n");
+    return out;
+}
+
+/**
+ * Writes the level in the JSON level format to the given path.
+ *
+ * @param path  The full path to the JSON file
+ *
+ * @return true if the file was written, false otherwise.
+ */
+bool LevelBinaryBuilder::writeJson(const std::string& path) const {
+    std::string text = buildJson();
+    return writeFile(path, text.data(), text.size());
+}
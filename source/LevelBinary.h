@@ -0,0 +1,582 @@
+//
+//  LevelBinary.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_LEVEL_BINARY_H__
+#define __SSB_LEVEL_BINARY_H__
+#include <cugl/cugl.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace cugl;
+
+#pragma mark -
+#pragma mark Binary Level Format
+/** The magic number at the start of every .ssbl file ("SSBL" in little endian) */
+#define SSBL_MAGIC      0x4C425353
+/** The version of the .ssbl format written by this build */
+#define SSBL_VERSION    4
+/** The file extension of a binary level */
+#define SSBL_EXTENSION  ".ssbl"
+
+/**
+ * Set on levels built by the offline level compiler.
+ *
+ * In a compiled level the art object offsets are already applied, and art
+ * objects are sorted by layer.
+ */
+#define SSBL_FLAG_COMPILED  0x1
+
+/**
+ * The kinds of object stored in a binary level.
+ *
+ * Each kind matches one of the object groups in the JSON level format, and
+ * all records of a kind are stored together in one section.
+ */
+enum class LevelRecordKind : uint32_t {
+    PLATFORM = 0,
+    TILE,
+    SPIKE,
+    TREASURE,
+    WIND,
+    ART,
+    COUNT
+};
+
+/** The number of record kinds (and so sections) in a binary level */
+#define SSBL_KIND_COUNT ((size_t)LevelRecordKind::COUNT)
+
+#pragma pack(push, 1)
+/**
+ * The header at the start of a binary level.
+ *
+ * All offsets are in bytes from the start of the file.
+ */
+struct LevelBinaryHeader {
+    /** Must be SSBL_MAGIC */
+    uint32_t magic;
+    /** Must be SSBL_VERSION */
+    uint32_t version;
+    /** A combination of SSBL_FLAG values */
+    uint32_t flags;
+    /** The total size of the file in bytes */
+    uint32_t fileSize;
+    /** The level width */
+    float width;
+    /** The level height */
+    float height;
+    /** The offset of the first record of each kind */
+    uint32_t sectionOffset[SSBL_KIND_COUNT];
+    /** The number of records of each kind */
+    uint32_t sectionCount[SSBL_KIND_COUNT];
+    /** The offset of the string table (one uint32 offset per string) */
+    uint32_t stringTableOffset;
+    /** The number of strings in the string table */
+    uint32_t stringCount;
+    /** The offset of the null-terminated string data */
+    uint32_t stringDataOffset;
+    /** The offset of the record runs */
+    uint32_t runOffset;
+    /** The number of record runs */
+    uint32_t runCount;
+};
+
+/**
+ * A run of consecutive level objects of one kind.
+ *
+ * Records are stored grouped by kind, so the runs keep the order the objects
+ * had in the level. Loading takes the next count records of the kind for
+ * each run in turn, which creates the objects in their JSON order.
+ */
+struct LevelRecordRun {
+    /** The kind of the records */
+    uint32_t kind;
+    /** The number of records in the run */
+    uint32_t count;
+};
+
+/**
+ * A single level object.
+ *
+ * Every kind uses the same fixed-size record, so a section can be used in
+ * place as an array. Fields that a kind does not use are zero. The values
+ * are exactly the ones found in the JSON level, so loading a record creates
+ * the same object as loading its JSON entry.
+ */
+struct LevelRecord {
+    /** The x position of the bottom left corner */
+    float x;
+    /** The y position of the bottom left corner */
+    float y;
+    /** The object width */
+    float width;
+    /** The object height */
+    float height;
+    /** The object draw scale */
+    float scale;
+    /** The object angle */
+    float angle;
+    /** The gust direction (wind obstacles only) */
+    float gustDirX;
+    float gustDirY;
+    /** The gust force (wind obstacles only) */
+    float gustForceX;
+    float gustForceY;
+    /** The draw layer (art objects only) */
+    int32_t layer;
+    /** The index of the object's json type in the string table */
+    uint32_t typeIndex;
+    /** The index of the object's texture key in the string table */
+    uint32_t assetIndex;
+};
+#pragma pack(pop)
+
+#pragma mark -
+#pragma mark Level Fields
+/**
+ * The fields of a level record, as bits of a field set.
+ *
+ * Every kind of level object saves a fixed set of these fields (its schema).
+ */
+enum LevelField : uint32_t {
+    FIELD_X             = 1 << 0,
+    FIELD_Y             = 1 << 1,
+    FIELD_WIDTH         = 1 << 2,
+    FIELD_HEIGHT        = 1 << 3,
+    FIELD_SCALE         = 1 << 4,
+    FIELD_ANGLE         = 1 << 5,
+    FIELD_GUST_DIR_X    = 1 << 6,
+    FIELD_GUST_DIR_Y    = 1 << 7,
+    FIELD_GUST_FORCE_X  = 1 << 8,
+    FIELD_GUST_FORCE_Y  = 1 << 9,
+    FIELD_LAYER         = 1 << 10
+};
+
+/**
+ * The description of a single level record field.
+ *
+ * The table of these descriptions lets the JSON and binary readers and writers
+ * move values straight between a LevelRecord and a file, with no field names
+ * or types to look up at runtime.
+ */
+struct LevelFieldInfo {
+    /** The key of the field in the JSON level format */
+    const char* name;
+    /** The bit of the field in a field set */
+    LevelField field;
+    /** The byte offset of the field in a LevelRecord */
+    size_t offset;
+    /** Whether the field is an int32_t (and not a float) */
+    bool integer;
+};
+
+/** Every level record field, in the order they are written */
+constexpr LevelFieldInfo LEVEL_FIELDS[] = {
+    { "x",          FIELD_X,            offsetof(LevelRecord, x),           false },
+    { "y",          FIELD_Y,            offsetof(LevelRecord, y),           false },
+    { "width",      FIELD_WIDTH,        offsetof(LevelRecord, width),       false },
+    { "height",     FIELD_HEIGHT,       offsetof(LevelRecord, height),      false },
+    { "scale",      FIELD_SCALE,        offsetof(LevelRecord, scale),       false },
+    { "angle",      FIELD_ANGLE,        offsetof(LevelRecord, angle),       false },
+    { "gustDirX",   FIELD_GUST_DIR_X,   offsetof(LevelRecord, gustDirX),    false },
+    { "gustDirY",   FIELD_GUST_DIR_Y,   offsetof(LevelRecord, gustDirY),    false },
+    { "gustForceX", FIELD_GUST_FORCE_X, offsetof(LevelRecord, gustForceX),  false },
+    { "gustForceY", FIELD_GUST_FORCE_Y, offsetof(LevelRecord, gustForceY),  false },
+    { "layer",      FIELD_LAYER,        offsetof(LevelRecord, layer),       true }
+};
+
+/** The fields every level object saves */
+constexpr uint32_t FIELDS_BOX = FIELD_X | FIELD_Y | FIELD_WIDTH | FIELD_HEIGHT;
+
+/**
+ * The schema of each record kind, indexed by LevelRecordKind.
+ *
+ * This table is the only schema: the JSON and binary readers and writers all
+ * take the fields of a kind from it, so the saved fields and the loaded fields
+ * can never disagree.
+ */
+constexpr uint32_t LEVEL_KIND_FIELDS[] = {
+    /* PLATFORM */  FIELDS_BOX,
+    /* TILE */      FIELDS_BOX,
+    /* SPIKE */     FIELDS_BOX | FIELD_SCALE | FIELD_ANGLE,
+    /* TREASURE */  FIELDS_BOX | FIELD_SCALE,
+    /* WIND */      FIELDS_BOX | FIELD_SCALE | FIELD_GUST_DIR_X | FIELD_GUST_DIR_Y |
+                    FIELD_GUST_FORCE_X | FIELD_GUST_FORCE_Y | FIELD_ANGLE,
+    /* ART */       FIELDS_BOX | FIELD_SCALE | FIELD_ANGLE | FIELD_LAYER
+};
+
+/** Returns the schema of a record kind */
+constexpr uint32_t levelKindFields(LevelRecordKind kind) {
+    return LEVEL_KIND_FIELDS[(size_t)kind];
+}
+
+/** Returns the set of every field in LEVEL_FIELDS */
+constexpr uint32_t levelFieldsAll() {
+    uint32_t all = 0;
+    for (const LevelFieldInfo& info : LEVEL_FIELDS) {
+        all |= info.field;
+    }
+    return all;
+}
+
+// The record, the field table and the schemas must describe the same fields
+static_assert(levelFieldsAll() == ((uint32_t)FIELD_LAYER << 1) - 1,
+              "every LevelField needs a row in LEVEL_FIELDS");
+static_assert(sizeof(LevelRecord) == sizeof(LEVEL_FIELDS) / sizeof(LevelFieldInfo) * 4 + 2 * sizeof(uint32_t),
+              "every value of LevelRecord needs a row in LEVEL_FIELDS");
+static_assert(sizeof(LEVEL_KIND_FIELDS) / sizeof(uint32_t) == SSBL_KIND_COUNT,
+              "every LevelRecordKind needs a schema in LEVEL_KIND_FIELDS");
+
+/**
+ * Copies the fields of a JSON object into a record.
+ *
+ * Only the fields in the set are read. Missing fields are left unchanged.
+ *
+ * @param json      The JSON object for a single level object
+ * @param fields    The set of fields to read
+ * @param record    The record to fill in
+ */
+void readLevelFields(const std::shared_ptr<JsonValue>& json, uint32_t fields, LevelRecord& record);
+
+/**
+ * Appends the fields of a record to a JSON object under construction.
+ *
+ * The fields are written in schema order as "key":value pairs, each followed
+ * by a comma. No JsonValue is allocated. JSON has no nan or infinity, so a
+ * float that is not finite is written as 0.
+ *
+ * @param record    The record to write
+ * @param fields    The set of fields to write
+ * @param out       The JSON text to append to
+ */
+void writeLevelFields(const LevelRecord& record, uint32_t fields, std::string& out);
+
+/**
+ * Returns the record kind for a JSON object group name.
+ *
+ * @param key   The JSON group name (e.g. "platforms")
+ * @param kind  Set to the matching record kind
+ *
+ * @return true if the group name has a record kind
+ */
+bool levelRecordKindFromKey(const std::string& key, LevelRecordKind& kind);
+
+/**
+ * Returns the JSON group name for a record kind.
+ *
+ * @param kind  The record kind
+ *
+ * @return the JSON group name (e.g. "platforms")
+ */
+const char* levelRecordKindKey(LevelRecordKind kind);
+
+#pragma mark -
+#pragma mark Binary Level
+/**
+ * A read-only binary level.
+ *
+ * The file is memory mapped where the platform allows it (and read into a
+ * single buffer otherwise, such as for assets packed inside an Android APK).
+ * Either way, the header is validated once and the records and strings are
+ * then used in place, with no parsing.
+ */
+class LevelBinary {
+private:
+    /** The start of the file contents */
+    const uint8_t* _data;
+    /** The size of the file contents in bytes */
+    size_t _size;
+    /** Whether the contents are memory mapped (rather than owned in _buffer) */
+    bool _mapped;
+    /** The file contents, when they could not be memory mapped */
+    std::vector<uint8_t> _buffer;
+
+    /** Returns the header at the start of the file */
+    const LevelBinaryHeader* header() const { return reinterpret_cast<const LevelBinaryHeader*>(_data); }
+
+    /**
+     * Returns true if the contents hold a well-formed binary level.
+     *
+     * Every section and string offset is checked against the file size, so
+     * the accessors never read outside of the file.
+     */
+    bool validate() const;
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates an empty binary level.
+     */
+    LevelBinary() : _data(nullptr), _size(0), _mapped(false) {}
+
+    /**
+     * Disposes of this binary level, unmapping the file.
+     */
+    ~LevelBinary() { dispose(); }
+
+    /**
+     * Initializes this binary level from the file at the given path.
+     *
+     * @param path  The full path to the .ssbl file
+     *
+     * @return true if the file was loaded and is well-formed, false otherwise.
+     */
+    bool init(const std::string& path);
+
+    /**
+     * Returns a newly loaded binary level from the file at the given path.
+     *
+     * @param path  The full path to the .ssbl file
+     *
+     * @return a newly loaded binary level, or nullptr on failure.
+     */
+    static std::shared_ptr<LevelBinary> alloc(const std::string& path) {
+        std::shared_ptr<LevelBinary> result = std::make_shared<LevelBinary>();
+        return (result->init(path) ? result : nullptr);
+    }
+
+    /**
+     * Initializes this binary level from a block of bytes in the .ssbl format.
+     *
+     * This binary level takes ownership of the bytes.
+     *
+     * @param data  The bytes of the level (such as from {@link LevelBinaryBuilder#build})
+     *
+     * @return true if the bytes hold a well-formed level, false otherwise.
+     */
+    bool initWithData(std::vector<uint8_t>&& data);
+
+    /**
+     * Returns a newly allocated binary level from a block of bytes in the .ssbl format.
+     *
+     * @param data  The bytes of the level (such as from {@link LevelBinaryBuilder#build})
+     *
+     * @return a newly allocated binary level, or nullptr if the bytes are malformed.
+     */
+    static std::shared_ptr<LevelBinary> allocWithData(std::vector<uint8_t>&& data) {
+        std::shared_ptr<LevelBinary> result = std::make_shared<LevelBinary>();
+        return (result->initWithData(std::move(data)) ? result : nullptr);
+    }
+
+    /**
+     * Returns the full path of a level or asset file.
+     *
+     * Asset names are relative to the asset directory of the application.
+     * Without an application (a command line tool), there is no asset
+     * directory, so an asset name is used as a path relative to the
+     * working directory.
+     *
+     * @param file              The file name
+     * @param useAbsolutePath   Whether the file name is a full path (and not an asset)
+     */
+    static std::string getPath(const std::string& file, bool useAbsolutePath);
+
+    /**
+     * Returns the binary level next to the given JSON level, if it is fresh.
+     *
+     * The binary level is the JSON file name with a .ssbl extension. It is
+     * used only if it is at least as new as the JSON file. When the files
+     * have no modification times (assets packed in an app bundle), an
+     * existing binary level is assumed to have been built with its JSON.
+     *
+     * @param jsonFile          The JSON level file name
+     * @param useAbsolutePath   Whether the file name is a full path (and not an asset)
+     *
+     * @return the fresh binary level, or nullptr if there is none.
+     */
+    static std::shared_ptr<LevelBinary> allocForJson(const std::string& jsonFile, bool useAbsolutePath = false);
+
+    /**
+     * Returns the .ssbl file name that goes with a JSON level file name.
+     *
+     * @param jsonFile  The JSON level file name
+     */
+    static std::string getBinaryName(const std::string& jsonFile);
+
+    /**
+     * Returns the modification time of the file, or 0 if it has none.
+     *
+     * Assets packed inside an app bundle (like an APK) have no modification time.
+     *
+     * @param path  The full path to the file
+     */
+    static time_t getModifiedTime(const std::string& path);
+
+    /**
+     * Unmaps (or frees) the file contents.
+     */
+    void dispose();
+
+#pragma mark Accessors
+    /** Returns the level size */
+    Size getLevelSize() const { return Size(header()->width, header()->height); }
+
+    /** Returns true if this level was built by the offline level compiler */
+    bool isCompiled() const { return (header()->flags & SSBL_FLAG_COMPILED) != 0; }
+
+    /** Returns the number of records of the given kind */
+    size_t getRecordCount(LevelRecordKind kind) const {
+        return header()->sectionCount[(size_t)kind];
+    }
+
+    /** Returns the records of the given kind, in file order */
+    const LevelRecord* getRecords(LevelRecordKind kind) const {
+        return reinterpret_cast<const LevelRecord*>(_data + header()->sectionOffset[(size_t)kind]);
+    }
+
+    /** Returns the number of record runs */
+    size_t getRunCount() const { return header()->runCount; }
+
+    /** Returns the record runs, in level order */
+    const LevelRecordRun* getRuns() const {
+        return reinterpret_cast<const LevelRecordRun*>(_data + header()->runOffset);
+    }
+
+    /** Returns the string at the given index of the string table */
+    const char* getString(uint32_t index) const {
+        const uint32_t* table = reinterpret_cast<const uint32_t*>(_data + header()->stringTableOffset);
+        return reinterpret_cast<const char*>(_data + header()->stringDataOffset + table[index]);
+    }
+};
+
+#pragma mark -
+#pragma mark Binary Level Builder
+/**
+ * Builds a binary level file from level objects.
+ *
+ * Records may be added in any order. They are grouped by kind, with runs
+ * that keep the order they were added in, and each distinct type name or
+ * texture key is stored once in the string table.
+ */
+class LevelBinaryBuilder {
+private:
+    /** The level size */
+    Size _levelSize;
+    /** A combination of SSBL_FLAG values */
+    uint32_t _flags;
+    /** The records of each kind */
+    std::vector<LevelRecord> _records[SSBL_KIND_COUNT];
+    /** The kinds of the records, as runs in the order added */
+    std::vector<LevelRecordRun> _runs;
+    /** The distinct type names and texture keys, in table order */
+    std::vector<std::string> _strings;
+    /** The table index of each string */
+    std::map<std::string, uint32_t> _stringIndex;
+
+    /** Returns the table index of the string, adding it if necessary */
+    uint32_t intern(const std::string& value);
+
+public:
+    /**
+     * Creates a builder for a level of the given size.
+     *
+     * @param size  The level size
+     */
+    LevelBinaryBuilder(const Size& size) : _levelSize(size), _flags(0) {}
+
+    /**
+     * Returns a builder holding every object of a JSON level.
+     *
+     * Each JSON object is copied into a record as is, so nothing is lost or
+     * adjusted. Object groups with no record kind are skipped.
+     *
+     * @param json  The JSON level (with "width", "height" and "objectTypes")
+     *
+     * @return a builder holding the level, or nullptr if the JSON is malformed.
+     */
+    static std::shared_ptr<LevelBinaryBuilder> allocWithJson(const std::shared_ptr<JsonValue>& json);
+
+    /** Returns the level size */
+    const Size& getLevelSize() const { return _levelSize; }
+
+    /** Sets the SSBL_FLAG values of the level */
+    void setFlags(uint32_t flags) { _flags = flags; }
+
+    /**
+     * Adds a record to the level.
+     *
+     * The type and asset indices of the record are filled in from the names.
+     *
+     * @param kind      The kind of the record
+     * @param record    The record values
+     * @param type      The json type of the object
+     * @param asset     The texture key of the object (empty if unresolved)
+     */
+    void addRecord(LevelRecordKind kind, LevelRecord record, const std::string& type,
+                   const std::string& asset = "");
+
+    /**
+     * Adds a record built from a JSON object in the level format.
+     *
+     * Only the fields in the schema of the kind are read.
+     *
+     * @param kind  The kind of the record
+     * @param json  The JSON object for a single level object
+     */
+    void addRecord(LevelRecordKind kind, const std::shared_ptr<JsonValue>& json);
+
+    /** Returns the number of records of the given kind */
+    size_t getRecordCount(LevelRecordKind kind) const { return _records[(size_t)kind].size(); }
+
+    /** Returns the records of the given kind, in the order added */
+    std::vector<LevelRecord>& getRecords(LevelRecordKind kind) { return _records[(size_t)kind]; }
+
+    /** Returns the record runs, in the order added */
+    const std::vector<LevelRecordRun>& getRuns() const { return _runs; }
+
+    /**
+     * Calls the function on every record, in the order added.
+     *
+     * @param visit The function to call with the kind and record
+     */
+    void forEachRecord(const std::function<void(LevelRecordKind, const LevelRecord&)>& visit) const;
+
+    /** Returns the string at the given index of the string table */
+    const std::string& getString(uint32_t index) const { return _strings[index]; }
+
+    /** Returns the number of distinct strings */
+    size_t getStringCount() const { return _strings.size(); }
+
+    /**
+     * Returns the binary level as a block of bytes.
+     *
+     * @return the binary level as a block of bytes
+     */
+    std::vector<uint8_t> build() const;
+
+    /**
+     * Writes the binary level to the given path.
+     *
+     * @param path  The full path to the .ssbl file
+     *
+     * @return true if the file was written, false otherwise.
+     */
+    bool write(const std::string& path) const;
+
+    /**
+     * Returns the level in the JSON level format.
+     *
+     * The text is written straight from the records using the schema of each
+     * kind, so no JsonValue is built. Each run of records is one object group,
+     * so the objects keep the order they were added in.
+     *
+     * @return the level in the JSON level format
+     */
+    std::string buildJson() const;
+
+    /**
+     * Writes the level in the JSON level format to the given path.
+     *
+     * @param path  The full path to the JSON file
+     *
+     * @return true if the file was written, false otherwise.
+     */
+    bool writeJson(const std::string& path) const;
+};
+
+#endif /* __SSB_LEVEL_BINARY_H__ */
@@ -0,0 +1,127 @@
+//
+//  LevelCache.cpp
+//  SweetSweetBetrayal
+//
+
+#include "LevelCache.h"
+#include <sys/stat.h>
+
+using namespace cugl;
+
+/**
+ * Returns the level cache shared by the whole application.
+ */
+LevelCache* LevelCache::get() {
+    static LevelCache cache;
+    return &cache;
+}
+
+/**
+ * Returns the full path of a level or asset file.
+ *
+ * @param file              The file name
+ * @param useAbsolutePath   Whether the file name is a full path (and not an asset)
+ */
+std::string LevelCache::getPath(const std::string& file, bool useAbsolutePath) {
+    return LevelBinary::getPath(file, useAbsolutePath);
+}
+
+/**
+ * Returns the modification time and size of a file.
+ *
+ * @param path  The full path to the file
+ */
+LevelCache::FileStamp LevelCache::getStamp(const std::string& path) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) {
+        return { 0, 0 };
+    }
+    return { info.st_mtime, (int64_t)info.st_size };
+}
+
+/**
+ * Returns the parsed contents of a JSON file, read without the cache.
+ *
+ * @param file              The file name
+ * @param useAbsolutePath   Whether the file name is a full path (and not an asset)
+ */
+std::shared_ptr<JsonValue> LevelCache::readJson(const std::string& file, bool useAbsolutePath) {
+    bool asset = !useAbsolutePath && Application::get() != nullptr;
+    std::shared_ptr<JsonReader> reader = asset ? JsonReader::allocWithAsset(file) : JsonReader::alloc(file);
+    if (reader == nullptr) {
+        CULogError("Could not open %s", file.c_str());
+        return nullptr;
+    }
+    std::shared_ptr<JsonValue> json = reader->readJson();
+    reader->close();
+    return json;
+}
+
+/**
+ * Returns the parsed level in the given JSON file.
+ *
+ * @param file              The JSON level file name
+ * @param useAbsolutePath   Whether the file name is a full path (and not an asset)
+ *
+ * @return the parsed level, or nullptr if it could not be read.
+ */
+std::shared_ptr<const LevelBinary> LevelCache::getLevel(const std::string& file, bool useAbsolutePath) {
+    std::string path = getPath(file, useAbsolutePath);
+    FileStamp stamp = getStamp(path);
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _levels.find(path);
+    if (it != _levels.end() && it->second.stamp == stamp) {
+        return it->second.level;
+    }
+
+    std::shared_ptr<const LevelBinary> level = LevelBinary::allocForJson(file, useAbsolutePath);
+    if (level == nullptr) {
+        std::shared_ptr<LevelBinaryBuilder> builder = LevelBinaryBuilder::allocWithJson(readJson(file, useAbsolutePath));
+        if (builder == nullptr) {
+            CULogError("Malformed level %s", file.c_str());
+            return nullptr;
+        }
+        level = LevelBinary::allocWithData(builder->build());
+    }
+    if (level != nullptr) {
+        _levels[path] = { stamp, level };
+    }
+    return level;
+}
+
+/**
+ * Returns the parsed contents of a JSON file (such as the parallax table).
+ *
+ * @param file              The JSON file name
+ * @param useAbsolutePath   Whether the file name is a full path (and not an asset)
+ *
+ * @return the parsed JSON, or nullptr if it could not be read.
+ */
+std::shared_ptr<JsonValue> LevelCache::getJson(const std::string& file, bool useAbsolutePath) {
+    std::string path = getPath(file, useAbsolutePath);
+    FileStamp stamp = getStamp(path);
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _tables.find(path);
+    if (it != _tables.end() && it->second.stamp == stamp) {
+        return it->second.json;
+    }
+
+    std::shared_ptr<JsonValue> json = readJson(file, useAbsolutePath);
+    if (json != nullptr) {
+        _tables[path] = { stamp, json };
+    }
+    return json;
+}
+
+/**
+ * Drops any cached contents of the given file.
+ *
+ * @param file              The file name
+ * @param useAbsolutePath   Whether the file name is a full path (and not an asset)
+ */
+void LevelCache::invalidate(const std::string& file, bool useAbsolutePath) {
+    std::string path = getPath(file, useAbsolutePath);
+    std::lock_guard<std::mutex> lock(_mutex);
+    _levels.erase(path);
+    _tables.erase(path);
+}
@@ -0,0 +1,146 @@
+//
+//  LevelCache.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_LEVEL_CACHE_H__
+#define __SSB_LEVEL_CACHE_H__
+#include <cugl/cugl.h>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "LevelBinary.h"
+
+using namespace cugl;
+
+/**
+ * A process-wide cache of parsed level files.
+ *
+ * Levels are cached as read-only binary levels (see LevelBinary), whether
+ * they were mapped from a .ssbl file or parsed from JSON, so loading the same
+ * level again only costs creating its objects. Other JSON tables used to set
+ * up a level (like the parallax table) are cached as parsed JSON.
+ *
+ * Every entry remembers the modification time and size of its file, and is
+ * reloaded if either changes (modification times are only accurate to the
+ * second, so a rewrite within the same second usually changes the size).
+ * Assets packed in an app bundle have neither, so they are read once per run.
+ * Cached values are shared, and must never be modified.
+ *
+ * The cache may be used from any thread (the level saver writes levels on a
+ * worker thread).
+ */
+class LevelCache {
+private:
+    /** The version of a file that an entry was read from */
+    struct FileStamp {
+        /** The modification time of the file (0 if it has none) */
+        time_t modified;
+        /** The size of the file in bytes (0 if it has none) */
+        int64_t size;
+
+        bool operator==(const FileStamp& other) const {
+            return modified == other.modified && size == other.size;
+        }
+    };
+
+    /** A cached level */
+    struct LevelEntry {
+        /** The version of the JSON file when it was read */
+        FileStamp stamp;
+        /** The parsed level */
+        std::shared_ptr<const LevelBinary> level;
+    };
+
+    /** A cached JSON table */
+    struct JsonEntry {
+        /** The version of the file when it was read */
+        FileStamp stamp;
+        /** The parsed JSON */
+        std::shared_ptr<JsonValue> json;
+    };
+
+    /** The lock for the cached entries */
+    std::mutex _mutex;
+    /** The cached levels, by full path */
+    std::map<std::string, LevelEntry> _levels;
+    /** The cached JSON tables, by full path */
+    std::map<std::string, JsonEntry> _tables;
+
+    /**
+     * Returns the modification time and size of a file.
+     *
+     * @param path  The full path to the file
+     */
+    static FileStamp getStamp(const std::string& path);
+
+    /**
+     * Returns the full path of a level or asset file.
+     *
+     * @param file              The file name
+     * @param useAbsolutePath   Whether the file name is a full path (and not an asset)
+     */
+    static std::string getPath(const std::string& file, bool useAbsolutePath);
+
+    /**
+     * Returns the parsed contents of a JSON file, read without the cache.
+     *
+     * @param file              The file name
+     * @param useAbsolutePath   Whether the file name is a full path (and not an asset)
+     */
+    static std::shared_ptr<JsonValue> readJson(const std::string& file, bool useAbsolutePath);
+
+public:
+    /**
+     * Returns the level cache shared by the whole application.
+     */
+    static LevelCache* get();
+
+    /**
+     * Returns the parsed level in the given JSON file.
+     *
+     * A fresh .ssbl file next to the JSON is preferred over parsing the JSON.
+     *
+     * @param file              The JSON level file name
+     * @param useAbsolutePath   Whether the file name is a full path (and not an asset)
+     *
+     * @return the parsed level, or nullptr if it could not be read.
+     */
+    std::shared_ptr<const LevelBinary> getLevel(const std::string& file, bool useAbsolutePath = false);
+
+    /**
+     * Returns the parsed contents of a JSON file (such as the parallax table).
+     *
+     * The returned JSON is shared with every other caller, so do not modify it.
+     *
+     * @param file              The JSON file name
+     * @param useAbsolutePath   Whether the file name is a full path (and not an asset)
+     *
+     * @return the parsed JSON, or nullptr if it could not be read.
+     */
+    std::shared_ptr<JsonValue> getJson(const std::string& file, bool useAbsolutePath = false);
+
+    /**
+     * Drops any cached contents of the given file.
+     *
+     * Call this after writing a file, since modification times are only
+     * accurate to the second.
+     *
+     * @param file              The file name
+     * @param useAbsolutePath   Whether the file name is a full path (and not an asset)
+     */
+    void invalidate(const std::string& file, bool useAbsolutePath = false);
+
+    /**
+     * Drops every cached file.
+     */
+    void clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _levels.clear();
+        _tables.clear();
+    }
+};
+
+#endif /* __SSB_LEVEL_CACHE_H__ */
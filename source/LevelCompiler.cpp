@@ -0,0 +1,212 @@
+//
+//  LevelCompiler.cpp
+//  SweetSweetBetrayal
+//
+
+#include "LevelCompiler.h"
+#include "Constants.h"
+#include "WindObstacle.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace cugl;
+using namespace Constants;
+
+#pragma mark -
+#pragma mark Compilation
+/**
+ * Compiles a JSON level into a binary level.
+ *
+ * @param jsonFile      The full path of the JSON level
+ * @param binaryFile    The full path of the .ssbl file to write
+ *
+ * @return true if the level was compiled with no errors, false otherwise.
+ */
+bool LevelCompiler::compile(const std::string& jsonFile, const std::string& binaryFile) {
+    _stats = LevelCompilerStats();
+
+    std::shared_ptr<JsonReader> reader = JsonReader::alloc(jsonFile);
+    if (reader == nullptr) {
+        _stats.errors.push_back("could not open " + jsonFile);
+        return false;
+    }
+    std::shared_ptr<JsonValue> json = reader->readJson();
+    reader->close();
+    if (json == nullptr || json->get("objectTypes") == nullptr) {
+        _stats.errors.push_back("malformed level " + jsonFile);
+        return false;
+    }
+    if (!json->has("width") || !json->has("height")) {
+        _stats.errors.push_back("level has no width or height");
+    }
+
+    Size levelSize(json->getFloat("width"), json->getFloat("height"));
+    LevelBinaryBuilder builder(levelSize);
+    builder.setFlags(SSBL_FLAG_COMPILED);
+
+    LevelRecordKind kind;
+    LevelRecord record;
+    std::vector<std::shared_ptr<JsonValue>> groups = json->get("objectTypes")->children();
+    for (auto it = groups.begin(); it != groups.end(); ++it) {
+        std::string name = (*it)->getString("name");
+        if ((*it)->get("objects") == nullptr) {
+            continue;
+        }
+        if (!levelRecordKindFromKey(name, kind)) {
+            if (name != "emptyObjectList") {
+                _stats.errors.push_back("unknown object group " + name);
+            }
+            continue;
+        }
+
+        std::vector<std::shared_ptr<JsonValue>> objects = (*it)->get("objects")->children();
+        for (auto it2 = objects.begin(); it2 != objects.end(); ++it2) {
+            memset(&record, 0, sizeof(LevelRecord));
+            readLevelFields(*it2, levelKindFields(kind), record);
+            std::string type = (*it2)->getString("type");
+
+            if (kind == LevelRecordKind::ART) {
+                // Bake in the adjustments that createLevelFromJson makes at load time
+                if (std::find(xOffsetArtObjects.begin(), xOffsetArtObjects.end(), type) != xOffsetArtObjects.end()) {
+                    record.x -= 0.5f;
+                }
+                if (std::find(yOffsetArtObjects.begin(), yOffsetArtObjects.end(), type) != yOffsetArtObjects.end()) {
+                    record.y -= 0.5f;
+                }
+                // ObjectController overrides the saved layer with the one in jsonTypeToLayer
+                int layer = jsonTypeToLayer(type);
+                if (layer >= 0) {
+                    record.layer = layer;
+                }
+            }
+
+            checkBounds(kind, record, levelSize);
+            builder.addRecord(kind, record, type, resolveAsset(kind, type));
+            _stats.objectCount++;
+        }
+    }
+
+    // Draw order only depends on the layer, so keep file order within a layer
+    std::vector<LevelRecord>& art = builder.getRecords(LevelRecordKind::ART);
+    std::stable_sort(art.begin(), art.end(), [](const LevelRecord& a, const LevelRecord& b) {
+        return a.layer < b.layer;
+    });
+
+    computeStats(builder);
+
+    if (!builder.write(binaryFile)) {
+        _stats.errors.push_back("could not write " + binaryFile);
+    }
+    return _stats.errors.empty();
+}
+
+/**
+ * Returns the texture key used to draw a record of the given kind.
+ *
+ * An error is recorded if the json type has no texture in jsonTypeToAsset.
+ *
+ * @param kind  The record kind
+ * @param type  The json type of the object
+ */
+std::string LevelCompiler::resolveAsset(LevelRecordKind kind, const std::string& type) {
+    std::string asset = getAssetKey(kind, type);
+    if (asset.empty()) {
+        _stats.errors.push_back(std::string(levelRecordKindKey(kind)) + " type \"" + type + "\" has no texture");
+    }
+    return asset;
+}
+
+/**
+ * Returns the texture key used to draw an object of the given kind.
+ *
+ * This matches the textures chosen in ObjectController.
+ *
+ * @param kind  The record kind
+ * @param type  The json type of the object
+ *
+ * @return the texture key, or the empty string if the type has none
+ */
+std::string LevelCompiler::getAssetKey(LevelRecordKind kind, const std::string& type) {
+    switch (kind) {
+        case LevelRecordKind::PLATFORM:
+            if (type == "tile") {
+                return TILE_TEXTURE;
+            } else if (type == "platform") {
+                return PLATFORM_TILE_TEXTURE;
+            }
+            return LOG_TEXTURE;
+        case LevelRecordKind::TREASURE:
+            return TREASURE_TEXTURE;
+        case LevelRecordKind::WIND:
+            return FAN_TEXTURE_ANIMATED;
+        default:
+            break;
+    }
+
+    return std::string(jsonTypeToAsset(type));
+}
+
+/**
+ * Records an error if the record is not inside the level bounds.
+ *
+ * @param kind      The record kind
+ * @param record    The record to check
+ * @param size      The level size
+ */
+void LevelCompiler::checkBounds(LevelRecordKind kind, const LevelRecord& record, const Size& size) {
+    if (record.width <= 0 || record.height <= 0) {
+        _stats.errors.push_back(std::string(levelRecordKindKey(kind)) + " object at (" + std::to_string(record.x) + ", " +
+                                std::to_string(record.y) + ") has no size");
+    }
+    if (record.x < 0 || record.y < 0 || record.x + record.width > size.width || record.y + record.height > size.height) {
+        _stats.errors.push_back(std::string(levelRecordKindKey(kind)) + " object at (" + std::to_string(record.x) + ", " +
+                                std::to_string(record.y) + ") is outside the " + std::to_string(size.getIWidth()) +
+                                "x" + std::to_string(size.getIHeight()) + " level");
+    }
+}
+
+/**
+ * Computes the body, fan, ray and draw call statistics of the level.
+ *
+ * Every tile gets a body of its own, since bombs destroy tiles one at a
+ * time. Treasures in a level are only spawn points, so they create no
+ * bodies. Art objects keep a sensor body (see ObjectController::createArtObject).
+ *
+ * Draw calls are estimated from the texture of each object in draw order:
+ * the sprite batch is flushed every time the texture changes, so a run of
+ * objects that share a texture costs a single draw call.
+ *
+ * @param builder   The builder holding the compiled level
+ */
+void LevelCompiler::computeStats(LevelBinaryBuilder& builder) {
+    _stats.tileCount = builder.getRecordCount(LevelRecordKind::TILE);
+    _stats.fanCount = builder.getRecordCount(LevelRecordKind::WIND);
+    _stats.rayCount = _stats.fanCount * RAYS;
+    _stats.bodyCount = builder.getRecordCount(LevelRecordKind::PLATFORM) + _stats.tileCount +
+                       builder.getRecordCount(LevelRecordKind::SPIKE) + _stats.fanCount +
+                       builder.getRecordCount(LevelRecordKind::ART);
+
+    std::vector<std::string> drawOrder;
+    const LevelRecordKind drawn[] = {
+        LevelRecordKind::PLATFORM, LevelRecordKind::TILE, LevelRecordKind::SPIKE, LevelRecordKind::WIND
+    };
+    for (LevelRecordKind kind : drawn) {
+        for (auto& record : builder.getRecords(kind)) {
+            drawOrder.push_back(builder.getString(record.assetIndex));
+            if (kind == LevelRecordKind::WIND) {
+                // Only one of the gust animations is visible at a time
+                drawOrder.push_back(WIND_LVL_4);
+            }
+        }
+    }
+    for (auto& record : builder.getRecords(LevelRecordKind::ART)) {
+        drawOrder.push_back(builder.getString(record.assetIndex));
+    }
+
+    _stats.drawCalls = 0;
+    for (size_t ii = 0; ii < drawOrder.size(); ii++) {
+        if (ii == 0 || drawOrder[ii] != drawOrder[ii - 1]) {
+            _stats.drawCalls++;
+        }
+    }
+}
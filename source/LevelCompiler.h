@@ -0,0 +1,107 @@
+//
+//  LevelCompiler.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_LEVEL_COMPILER_H__
+#define __SSB_LEVEL_COMPILER_H__
+#include <cugl/cugl.h>
+#include <string>
+#include <vector>
+#include "LevelBinary.h"
+
+using namespace cugl;
+
+/**
+ * The statistics of a single compiled level.
+ */
+struct LevelCompilerStats {
+    /** The number of level objects read from the JSON */
+    size_t objectCount = 0;
+    /** The number of physics bodies the level creates at runtime */
+    size_t bodyCount = 0;
+    /** The number of tile bodies */
+    size_t tileCount = 0;
+    /** The number of fans (wind obstacles) */
+    size_t fanCount = 0;
+    /** The number of wind raycasts made every physics step */
+    size_t rayCount = 0;
+    /** The estimated number of draw calls for the level objects */
+    size_t drawCalls = 0;
+    /** The problems found in the level (empty if it is valid) */
+    std::vector<std::string> errors;
+};
+
+/**
+ * The offline level compiler.
+ *
+ * This class turns a JSON level into a compiled binary level (see LevelBinary)
+ * so that none of the level preprocessing happens at load time. The compiler:
+ *
+ *   - sorts the art objects by draw layer,
+ *   - resolves every json type to its texture key with jsonTypeToAsset,
+ *   - applies the xOffset/yOffset art object adjustments, and
+ *   - checks that every object lies inside the level bounds.
+ *
+ * It needs no window or asset manager, so it can run from the command line.
+ */
+class LevelCompiler {
+private:
+    /** The statistics of the last compiled level */
+    LevelCompilerStats _stats;
+
+    /**
+     * Returns the texture key used to draw a record of the given kind.
+     *
+     * @param kind  The record kind
+     * @param type  The json type of the object
+     */
+    std::string resolveAsset(LevelRecordKind kind, const std::string& type);
+
+    /**
+     * Records an error if the record is not inside the level bounds.
+     *
+     * @param kind      The record kind
+     * @param record    The record to check
+     * @param size      The level size
+     */
+    void checkBounds(LevelRecordKind kind, const LevelRecord& record, const Size& size);
+
+    /**
+     * Computes the body, fan, ray and draw call statistics of the level.
+     *
+     * @param builder   The builder holding the compiled level
+     */
+    void computeStats(LevelBinaryBuilder& builder);
+
+public:
+    /**
+     * Compiles a JSON level into a binary level.
+     *
+     * The binary level is written even if the level has errors, so that it
+     * can be inspected. Use getStats to read the statistics and errors.
+     *
+     * @param jsonFile      The full path of the JSON level
+     * @param binaryFile    The full path of the .ssbl file to write
+     *
+     * @return true if the level was compiled with no errors, false otherwise.
+     */
+    bool compile(const std::string& jsonFile, const std::string& binaryFile);
+
+    /**
+     * Returns the texture key used to draw an object of the given kind.
+     *
+     * This matches the textures chosen in ObjectController.
+     *
+     * @param kind  The record kind
+     * @param type  The json type of the object
+     *
+     * @return the texture key, or the empty string if the type has none
+     */
+    static std::string getAssetKey(LevelRecordKind kind, const std::string& type);
+
+    /** Returns the statistics of the last compiled level */
+    const LevelCompilerStats& getStats() const { return _stats; }
+};
+
+#endif /* __SSB_LEVEL_COMPILER_H__ */
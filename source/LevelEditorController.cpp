@@ -16,6 +16,7 @@
 #include "WindObstacle.h"
 #include "LevelModel.h"
 #include "ObjectController.h"
+#include "AnimationSystem.h"
 
 #include <ctime>
 #include <string>
@@ -46,6 +47,9 @@ using namespace Constants;
 
 #define FIXED_TIMESTEP_S 0.02f
 
+/** The size of levels made in the level editor */
+#define EDITOR_LEVEL_SIZE Size(100, 100)
+
 /** The goal door position */
 float GOAL_POSITION[] = { 47.0f, 4.0f };
 
@@ -158,9 +162,23 @@ bool LevelEditorController::init(const std::shared_ptr<AssetManager>& assets,
 #pragma mark : Level
     shared_ptr<LevelModel> level = make_shared<LevelModel>();
 
+    // Pick up where the last session left off if it left a journal
+    std::string journalFile = Application::get()->getSaveDirectory() + LEVEL_JOURNAL_FILE;
+    vector<shared_ptr<Object>> levelObjs;
+    bool recoveredObjs = false;
+    shared_ptr<LevelBinaryBuilder> recovered = LevelSaver::recover(journalFile);
+    if (recovered != nullptr) {
+        shared_ptr<LevelBinary> binary = LevelBinary::allocWithData(recovered->build());
+        if (binary != nullptr) {
+            levelObjs = level->createLevelFromBinary(binary);
+            recoveredObjs = !levelObjs.empty();
+            CULog("Recovered %zu objects from %s", levelObjs.size(), journalFile.c_str());
+        }
+    }
     // test9.json is the empty file used for the level editor
-    std::string key;
-    vector<shared_ptr<Object>> levelObjs = level->createLevelFromJson("json/test9.json");
+    if (levelObjs.empty()) {
+        levelObjs = level->createLevelFromJson("json/test9.json");
+    }
     for (auto& obj : levelObjs) {
         _objectController->processLevelObject(obj, true);
         // This is necessary to remove the object with the eraser.
@@ -168,6 +186,12 @@ bool LevelEditorController::init(const std::shared_ptr<AssetManager>& assets,
         _gridManager->addMoveableObject(obj->getPositionInit(), obj);
         CULog("new object position: (%f, %f)", obj->getPositionInit().x, obj->getPositionInit().y);
     }
+    _saver = LevelSaver::alloc(journalFile);
+    // Recovered work is in no level file, so it stays recoverable until it is saved
+    _saver->restart(EDITOR_LEVEL_SIZE, _objectController->getObjects(), !recoveredObjs);
+    _history = EditHistory::alloc([this](const EditDelta& delta) { applyDelta(delta); });
+    // Autosave follows the same changes as the history
+    _history->setListener([this](const EditDelta& delta) { _saver->journal(delta); });
 
 
     // Initialize build phase controller
@@ -209,18 +233,18 @@ bool LevelEditorController::initBuildingLogic(const std::shared_ptr<AssetManager
                        CRACK_1, CRACK_2, CRACK_3, CRACK_4, CRACK_5, CRACK_LARGE_1, MOSS_1, MOSS_2, ROCKY_1, ROCKY_2
     };
     for (auto it = inventoryItems.begin(); it != inventoryItems.end(); ++it) {
-        if (itemToAssetNameMap.find(*it) != itemToAssetNameMap.end()) {
+        if (!itemToTexture(*it).empty()) {
             
             if (*it == Item::TORCH_RIGHT || *it == Item::TORCH_LEFT) {
                 assetNames.push_back("icon-torch");
             }
             else {
-                assetNames.push_back(itemToAssetNameMap[*it]);
+                assetNames.push_back(std::string(itemToTexture(*it)));
             }
             
         }
         else {
-            CULog("You likely forgot to add the item to itemToAssetNameMap");
+            CULog("You likely forgot to add the item to ART_ASSETS");
         }
     }
 
@@ -249,6 +273,8 @@ bool LevelEditorController::initBuildingLogic(const std::shared_ptr<AssetManager
 void LevelEditorController::dispose() {
     if (_active)
     {
+        // Wait for any save in progress, and write the last edits
+        _saver->dispose();
         _world = nullptr;
         _gridManager->getGridNode() = nullptr;
 
@@ -279,6 +305,25 @@ void LevelEditorController::reset() {
  */
 void LevelEditorController::preUpdate(float dt) {
         _input->update(dt);
+        _saver->update();
+        _gridManager->updateChunks();
+
+        // Everything painted or erased in a single drag is undone together
+        bool stroking = _input->isTouchDown() && (_uiScene.isPaintMode() || _uiScene.isEraserMode());
+        if (stroking && !_stroking) {
+            _history->begin();
+        }
+        else if (!stroking && _stroking) {
+            _history->end();
+        }
+        _stroking = stroking;
+
+        if (_input->didUndo()) {
+            _history->undo();
+        }
+        else if (_input->didRedo()) {
+            _history->redo();
+        }
 
         /** The offset of finger placement to object indicator */
         Vec2 dragOffset = _input->getSystemDragOffset();
@@ -317,6 +362,7 @@ void LevelEditorController::preUpdate(float dt) {
                 std::shared_ptr<Object> obj = placeItem(gridPos, _selectedItem);
                 // might go back to addObject() for levelEditor??? just keep this in mind
                 _gridManager->addMoveableObject(gridPos, obj);
+                _history->recordAdd(obj);
 
                 _itemsPlaced += 1;
             }
@@ -345,6 +391,8 @@ void LevelEditorController::preUpdate(float dt) {
 
                     // Set the current position of the object
                     _prevPos = _selectedObject->getPosition();
+                    // The move is recorded when the object is dropped
+                    _hasPickedUp = EditHistory::createDelta(false, _selectedObject, _pickedUp);
 
                     //_gridManager->addMoveableObject(gridPos, obj);
                     _input->setInventoryStatus(PlatformInput::PLACING);
@@ -379,6 +427,13 @@ void LevelEditorController::preUpdate(float dt) {
                 if (_selectedObject->getListener()) {
                     _selectedObject->getListener()(_selectedObject.get());
                 }
+                _history->begin();
+                if (_hasPickedUp) {
+                    _history->record(_pickedUp);
+                }
+                _history->recordAdd(_selectedObject);
+                _history->end();
+                _hasPickedUp = false;
 
                 // Reset selected object
                 _selectedObject = nullptr;
@@ -392,6 +447,7 @@ void LevelEditorController::preUpdate(float dt) {
                     // might go back to addObject() for levelEditor??? just keep this in mind
                     CULog("%d is _selectedItem", _selectedItem);
                     _gridManager->addMoveableObject(gridPos, obj);
+                    _history->recordAdd(obj);
 
                     _itemsPlaced += 1;
                 }
@@ -419,11 +475,8 @@ void LevelEditorController::preUpdate(float dt) {
     }
 
     else if (_uiScene.getIsReady()) {
-        // Save the level to a file
-        shared_ptr<LevelModel> level = make_shared<LevelModel>();
-        //level->createJsonFromLevel("json/" + _uiScene.getSaveFileName() + ".json", Size(100, 100), _objectController->getObjects());
-        level->createJsonFromLevel(Application::get()->getSaveDirectory() + _uiScene.getSaveFileName() + ".json", Size(100, 100), _objectController->getObjects());
-        CULog("Saved to %s", (Application::get()->getSaveDirectory() + _uiScene.getSaveFileName().c_str() + ".json").c_str());
+        // Save the level to a file (the saver logs when it is written)
+        _saver->save(Application::get()->getSaveDirectory() + _uiScene.getSaveFileName() + ".json", EDITOR_LEVEL_SIZE, _objectController->getObjects());
         _uiScene.setIsReady(false);
     }
 
@@ -451,6 +504,10 @@ void LevelEditorController::preUpdate(float dt) {
             _objectController->processLevelObject(obj, true);
             _gridManager->addMoveableObject(obj->getPositionInit(), obj);
         }
+        if (objects.size() != 0) {
+            _history->clear();
+            _saver->restart(EDITOR_LEVEL_SIZE, _objectController->getObjects());
+        }
 
         
 
@@ -467,6 +524,7 @@ void LevelEditorController::eraseObjects(Vec2 dragOffset) {
     std::pair posPair = std::make_pair(gridPos.x, gridPos.y);
     if (_gridManager->posToObjMap.find(posPair) != _gridManager->posToObjMap.end()) {
         std::shared_ptr<Object> obj = _gridManager->posToObjMap[posPair];
+        _history->recordRemove(obj);
         _gridManager->objToPosMap.erase(obj);
         _gridManager->hasObjMap[posPair] = false;
         auto it = (*(_objectController->getObjects())).begin();
@@ -491,6 +549,7 @@ void LevelEditorController::eraseObjects(Vec2 dragOffset) {
 
         auto it1 = objs.begin();
         for (auto it = _gridManager->posToArtObjMap[posPair].begin(); it != _gridManager->posToArtObjMap[posPair].end(); it++) {
+            _history->recordRemove(*it);
             b2World& world = *_world->getWorld();
             (*it)->deactivatePhysics(world);
             _gridManager->deleteObject(*it);
@@ -515,9 +574,87 @@ void LevelEditorController::eraseObjects(Vec2 dragOffset) {
     }
 }
 
+/**
+ * Applies an undone or redone change to the level.
+ *
+ * Added objects are created from their records, just like loading a level.
+ *
+ * @param delta The change to apply
+ */
+void LevelEditorController::applyDelta(const EditDelta& delta) {
+    if (delta.add) {
+        LevelModel level;
+        std::shared_ptr<Object> obj = level.createObjectFromRecord(delta.kind, delta.record, delta.type);
+        if (obj != nullptr) {
+            _objectController->processLevelObject(obj, true);
+            _gridManager->addMoveableObject(obj->getPositionInit(), obj);
+        }
+        return;
+    }
+
+    std::shared_ptr<Object> obj = findObject(delta);
+    if (obj != nullptr) {
+        removeObject(obj);
+    }
+    else {
+        CULog("Could not find %s object to undo at (%f, %f)", delta.type.c_str(), delta.record.x, delta.record.y);
+    }
+}
+
+/**
+ * Returns the level object described by a delta.
+ *
+ * The grid cell at the position of the object is checked first, so this
+ * usually does not search the whole level.
+ *
+ * @param delta The delta for the object
+ *
+ * @return the object, or nullptr if it is not in the level
+ */
+std::shared_ptr<Object> LevelEditorController::findObject(const EditDelta& delta) {
+    EditDelta other;
+    std::pair<int, int> posPair = std::make_pair((int)delta.record.x, (int)delta.record.y);
+    auto it = _gridManager->posToObjMap.find(posPair);
+    if (it != _gridManager->posToObjMap.end() && EditHistory::createDelta(false, it->second, other) && other.matches(delta)) {
+        return it->second;
+    }
+    auto art = _gridManager->posToArtObjMap.find(posPair);
+    if (art != _gridManager->posToArtObjMap.end()) {
+        for (auto& obj : art->second) {
+            if (EditHistory::createDelta(false, obj, other) && other.matches(delta)) {
+                return obj;
+            }
+        }
+    }
+    for (auto& obj : *(_objectController->getObjects())) {
+        if (EditHistory::createDelta(false, obj, other) && other.matches(delta)) {
+            return obj;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Removes a moveable object from the grid, the world and the object list.
+ *
+ * @param obj   The object to remove
+ */
+void LevelEditorController::removeObject(const std::shared_ptr<Object>& obj) {
+    _gridManager->removeMoveableObject(obj);
+    std::vector<std::shared_ptr<Object>>* objects = _objectController->getObjects();
+    objects->erase(std::remove(objects->begin(), objects->end(), obj), objects->end());
+    b2World& world = *_world->getWorld();
+    obj->deactivatePhysics(world);
+    _gridManager->deleteObject(obj);
+    _world->removeObstacle(obj);
+}
+
 void LevelEditorController::fixedUpdate(float dt) {
     // Turn the physics engine crank.
     _world->update(FIXED_TIMESTEP_S);
+
+    // Objects chose their animations in the world step, so advance them all now
+    AnimationSystem::update(FIXED_TIMESTEP_S);
 }
 
 void LevelEditorController::postUpdate(float remain)
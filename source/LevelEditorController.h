@@ -19,6 +19,8 @@
 #include "ObjectController.h"
 #include "LevelEditorScene.h"
 #include "LevelEditorUIScene.h"
+#include "EditHistory.h"
+#include "LevelSaver.h"
 #include "SoundController.h"
 
 using namespace cugl;
@@ -48,6 +50,16 @@ protected:
     LevelEditorUIScene _uiScene;
 
     std::vector<std::shared_ptr<Object>> _objects;
+    /** Writes saved levels and the edit journal in the background */
+    std::shared_ptr<LevelSaver> _saver;
+    /** The undo and redo history */
+    std::shared_ptr<EditHistory> _history;
+    /** Whether a paint or erase drag is in progress */
+    bool _stroking = false;
+    /** Where the selected object was picked up (for the undo history) */
+    EditDelta _pickedUp;
+    /** Whether _pickedUp holds the selected object */
+    bool _hasPickedUp = false;
 
 
 
@@ -128,6 +140,29 @@ public:
 
     void eraseObjects(Vec2 dragOffset);
 
+    /**
+     * Applies an undone or redone change to the level.
+     *
+     * @param delta The change to apply
+     */
+    void applyDelta(const EditDelta& delta);
+
+    /**
+     * Returns the level object described by a delta.
+     *
+     * @param delta The delta for the object
+     *
+     * @return the object, or nullptr if it is not in the level
+     */
+    std::shared_ptr<Object> findObject(const EditDelta& delta);
+
+    /**
+     * Removes a moveable object from the grid, the world and the object list.
+     *
+     * @param obj   The object to remove
+     */
+    void removeObject(const std::shared_ptr<Object>& obj);
+
 #pragma mark -
 #pragma mark Helpers
 
@@ -192,7 +192,7 @@ void LevelEditorScene::linkSceneToObs(const std::shared_ptr<physics2::Obstacle>&
     (*_worldnode)->addChild(node);
 
     // Dynamic objects need constant updating
-    if (obj->getBodyType() == b2_dynamicBody) {
+    if (obj->getBodyType() != b2_staticBody) {
         scene2::SceneNode* weak = node.get(); // No need for smart pointer in callback
         obj->setListener([=, this](physics2::Obstacle* obs) {
             float leftover = Application::get()->getFixedRemainder() / 1000000.f;
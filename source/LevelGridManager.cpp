@@ -26,25 +26,11 @@ using namespace Constants;
 void LevelGridManager::initGrid(bool isLevelEditor) {
     _grid->removeAllChildren();
 
-    std::shared_ptr<scene2::GridLayout> gridLayout = scene2::GridLayout::alloc();
-    gridLayout->setGridSize(_columns, MAX_ROWS);
-
-    for (int row = 0; row < MAX_ROWS; ++row) {
-        for (int col = 0; col < _columns; ++col) {
-            if (!isLevelEditor && (row < ROW_OFFSET_BOT || row >= MAX_ROWS - ROW_OFFSET_TOP)) {
-                continue;
-            }
-
-            Vec2 cellPos(col * CELL_SIZE, row * CELL_SIZE);
-
-            std::shared_ptr<scene2::WireNode> cellNode = scene2::WireNode::allocWithPath(Rect(cellPos, Size(CELL_SIZE, CELL_SIZE)));
-            cellNode->setColor(Color4::WHITE);
-            cellNode->setAnchor(Vec2::ANCHOR_BOTTOM_LEFT);
-            cellNode->setPosition(cellPos);
-
-            _grid->addChild(cellNode);
-        }
-    }
+    // The grid lines are created a chunk at a time as the camera nears them
+    int rowStart = isLevelEditor ? 0 : ROW_OFFSET_BOT;
+    int rowEnd = isLevelEditor ? MAX_ROWS : MAX_ROWS - ROW_OFFSET_TOP;
+    _lines = GridChunks::alloc((int)_columns, rowStart, rowEnd, CELL_SIZE);
+    _grid->addChild(_lines->getNode());
 
     // Set grid to be shown initially
     _grid->setVisible(true);
@@ -77,9 +63,9 @@ void LevelGridManager::initGrid(bool isLevelEditor) {
  */
 void LevelGridManager::setObject(Vec2 cellPos, Item item) {
     if (_spriteNode) {
-        auto image = _assets->get<Texture>(itemToAssetNameMap[item]);
+        auto image = _assets->get<Texture>(std::string(itemToTexture(item)));
         if (image == nullptr) {
-            CULog("You likely forgot to add this item to itemToAssetNameMap");
+            CULog("You likely forgot to add this item to ART_ASSETS");
             return;
         }
 
@@ -233,6 +219,39 @@ std::shared_ptr<Object> LevelGridManager::moveObject(Vec2 cellPos) {
     return obj;
 };
 
+/**
+ * Removes the given moveable object from every object map.
+ *
+ *@param obj    the object
+ */
+void LevelGridManager::removeMoveableObject(std::shared_ptr<Object> obj) {
+    auto origin = objToPosMap.find(obj);
+    if (origin == objToPosMap.end()) {
+        return;
+    }
+    Size size = itemToGridSize(obj->getItemType());
+    for (int i = 0; i < size.getIWidth(); i++) {
+        for (int j = 0; j < size.getIHeight(); j++) {
+            auto posPair = std::make_pair(origin->second.first + i, origin->second.second + j);
+            auto art = posToArtObjMap.find(posPair);
+            if (art != posToArtObjMap.end()) {
+                art->second.erase(std::remove(art->second.begin(), art->second.end(), obj), art->second.end());
+                if (art->second.empty()) {
+                    posToArtObjMap.erase(art);
+                }
+            }
+            auto it = posToObjMap.find(posPair);
+            if (it != posToObjMap.end() && it->second == obj) {
+                posToObjMap.erase(it);
+                posToWorldObjMap.erase(posPair);
+                hasObjMap.erase(posPair);
+            }
+        }
+    }
+    objToPosMap.erase(origin);
+    worldObjToPosMap.erase(obj);
+}
+
 /**
  * Removes the object from the world object map, if it exists.
  *
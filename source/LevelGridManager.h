@@ -9,6 +9,7 @@
 
 #include <cugl/cugl.h>
 #include "Object.h"
+#include "GridChunks.h"
 
 
 using namespace cugl;
@@ -48,6 +49,8 @@ private:
     float _columns;
     /** The size of the cell in Box2d units */
     const float CELL_SIZE = 1.0f;
+    /** The grid lines */
+    std::shared_ptr<GridChunks> _lines;
 
 
 protected:
@@ -92,6 +95,15 @@ public:
     /** Clears the object maps */
     void clear();
 
+    /**
+     * Creates the grid lines near the camera, and drops the rest.
+     *
+     * Call this every frame the grid is visible.
+     */
+    void updateChunks() {
+        _lines->update();
+    }
+
 #pragma mark -
 #pragma mark Attribute Properties
     /**
@@ -156,6 +168,16 @@ public:
      */
     std::shared_ptr<Object> moveObject(Vec2 cellPos);
 
+    /**
+     * Removes the given moveable object from every object map.
+     *
+     * Unlike moveObject, this works for art objects, and leaves any other
+     * object sharing the cells alone.
+     *
+     *@param obj    the object
+     */
+    void removeMoveableObject(std::shared_ptr<Object> obj);
+
     /**
      * Removes the object from the world object map, if it exists.
      *
@@ -0,0 +1,289 @@
+//
+//  LevelLinter.cpp
+//  SweetSweetBetrayal
+//
+
+#include "LevelLinter.h"
+#include "ArtObject.h"
+#include "LevelBinary.h"
+#include "LevelCompiler.h"
+#include "LevelModel.h"
+#include "WindObstacle.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <set>
+
+using namespace cugl;
+using namespace Constants;
+
+/** The bytes per texel of a loaded texture (RGBA) */
+#define TEXEL_BYTES     4
+/** The size of a PNG header up to the end of the image height */
+#define PNG_HEADER_SIZE 24
+
+#pragma mark -
+#pragma mark Setup
+/**
+ * Reads the textures listed in an asset directory.
+ *
+ * @param directory The asset directory (holding json/assets.json)
+ *
+ * @return true if the asset list was read
+ */
+bool LevelLinter::loadAssets(const std::string& directory) {
+    std::string root = directory;
+    if (!root.empty() && root.back() != '/') {
+        root += "/";
+    }
+    std::shared_ptr<JsonReader> reader = JsonReader::alloc(root + "json/assets.json");
+    if (reader == nullptr) {
+        CULogError("Could not open the asset list in %s", directory.c_str());
+        return false;
+    }
+    std::shared_ptr<JsonValue> json = reader->readJson();
+    reader->close();
+    if (json == nullptr || json->get("textures") == nullptr) {
+        CULogError("Malformed asset list in %s", directory.c_str());
+        return false;
+    }
+
+    // A texture entry is either its file name or an object with the file name
+    for (auto& texture : json->get("textures")->children()) {
+        std::string file = texture->isString() ? texture->asString() : texture->getString("file");
+        if (!file.empty()) {
+            _textureFiles[texture->key()] = root + file;
+        }
+    }
+    return true;
+}
+
+/**
+ * Reads the budget that levels are checked against.
+ *
+ * @param budgetFile    The full path of the budget JSON
+ *
+ * @return true if the budget was read
+ */
+bool LevelLinter::loadBudget(const std::string& budgetFile) {
+    std::shared_ptr<JsonReader> reader = JsonReader::alloc(budgetFile);
+    if (reader == nullptr) {
+        CULogError("Could not open budget %s", budgetFile.c_str());
+        return false;
+    }
+    std::shared_ptr<JsonValue> json = reader->readJson();
+    reader->close();
+    if (json == nullptr || !json->isObject()) {
+        CULogError("Malformed budget %s", budgetFile.c_str());
+        return false;
+    }
+
+    _budget.clear();
+    _itemBudget.clear();
+    for (auto& entry : json->children()) {
+        if (entry->key() == "items") {
+            for (auto& item : entry->children()) {
+                _itemBudget[item->key()] = item->asDouble();
+            }
+        } else if (entry->isNumber()) {
+            _budget[entry->key()] = entry->asDouble();
+        }
+    }
+    return true;
+}
+
+#pragma mark -
+#pragma mark Linting
+/**
+ * Measures a JSON level and checks it against the budget.
+ *
+ * @param jsonFile  The full path of the JSON level
+ *
+ * @return true if the level has no errors and is within budget
+ */
+bool LevelLinter::lint(const std::string& jsonFile) {
+    _stats = LevelLintStats();
+
+    LevelModel model;
+    std::vector<std::shared_ptr<Object>> objects = model.createLevelFromJson(jsonFile, true);
+    Size size = model.getLevelSize();
+    if (objects.empty() && size.width <= 0) {
+        _stats.errors.push_back("could not load " + jsonFile);
+        return false;
+    }
+
+    // Count the objects, their draw layers and their textures
+    std::set<std::string> textures;
+    float artArea = 0;
+    LevelRecordKind kind;
+    for (auto& object : objects) {
+        if (object == nullptr) {
+            continue;
+        }
+        _stats.objectCount++;
+        _stats.itemCounts[object->getItemType()]++;
+        if (levelRecordKindFromKey(object->getJsonKey(), kind)) {
+            std::string key = LevelCompiler::getAssetKey(kind, object->getJsonType());
+            auto it = _textureFiles.find(key);
+            if (it != _textureFiles.end()) {
+                textures.insert(it->second);
+            }
+            if (kind == LevelRecordKind::WIND) {
+                _stats.rayCount += RAYS;
+            } else if (kind == LevelRecordKind::ART) {
+                _stats.layerCounts[std::static_pointer_cast<ArtObject>(object)->getLayer()]++;
+                artArea += object->getSize().width * object->getSize().height;
+            }
+        }
+    }
+    _stats.textureCount = textures.size();
+    for (auto& file : textures) {
+        _stats.textureBytes += getTextureBytes(file);
+    }
+    if (size.width > 0 && size.height > 0) {
+        _stats.overdraw = artArea / (size.width * size.height);
+    }
+
+    checkPlacement(objects, size);
+    countBodies(objects, size);
+
+    checkBudget("objects", (double)_stats.objectCount, _budget);
+    checkBudget("bodies", (double)_stats.bodyCount, _budget);
+    checkBudget("fixtures", (double)_stats.fixtureCount, _budget);
+    checkBudget("rays", (double)_stats.rayCount, _budget);
+    checkBudget("overdraw", _stats.overdraw, _budget);
+    checkBudget("peakOverdraw", (double)_stats.peakOverdraw, _budget);
+    checkBudget("textures", (double)_stats.textureCount, _budget);
+    checkBudget("textureMB", _stats.textureBytes / (1024.0 * 1024.0), _budget);
+    for (auto& entry : _stats.itemCounts) {
+        checkBudget(itemToString(entry.first), (double)entry.second, _itemBudget);
+    }
+    return _stats.errors.empty() && _stats.overBudget.empty();
+}
+
+/**
+ * Returns the estimated memory (in bytes) of a texture file.
+ *
+ * Only the PNG header is read, for the image size. Each texel of a loaded
+ * texture takes {@link TEXEL_BYTES} bytes.
+ *
+ * @param file  The full path of the texture file
+ */
+size_t LevelLinter::getTextureBytes(const std::string& file) {
+    auto it = _textureBytes.find(file);
+    if (it != _textureBytes.end()) {
+        return it->second;
+    }
+
+    size_t bytes = 0;
+    SDL_RWops* source = SDL_RWFromFile(file.c_str(), "rb");
+    if (source != nullptr) {
+        Uint8 header[PNG_HEADER_SIZE];
+        if (SDL_RWread(source, header, 1, PNG_HEADER_SIZE) == PNG_HEADER_SIZE && header[1] == 'P' && header[2] == 'N' && header[3] == 'G') {
+            Uint32 width = (header[16] << 24) | (header[17] << 16) | (header[18] << 8) | header[19];
+            Uint32 height = (header[20] << 24) | (header[21] << 16) | (header[22] << 8) | header[23];
+            bytes = (size_t)width * height * TEXEL_BYTES;
+        } else {
+            CULog("Could not measure texture %s", file.c_str());
+        }
+        SDL_RWclose(source);
+    }
+    _textureBytes[file] = bytes;
+    return bytes;
+}
+
+/**
+ * Records an error for every object outside the level or overlapping another.
+ *
+ * The cells of an object are found as in GridManager::addObject. Also counts
+ * the art objects covering each cell for the peak overdraw.
+ *
+ * @param objects   The level objects
+ * @param size      The level size
+ */
+void LevelLinter::checkPlacement(const std::vector<std::shared_ptr<Object>>& objects, const Size& size) {
+    std::map<std::pair<int, int>, std::shared_ptr<Object>> worldCells;
+    std::map<std::pair<int, int>, std::vector<std::shared_ptr<Object>>> artCells;
+    for (auto& object : objects) {
+        if (object == nullptr) {
+            continue;
+        }
+        Vec2 cellPos = object->getPosition() - object->getSize()/2;
+        Size objSize = object->getSize();
+        std::string name = itemToString(object->getItemType()) + " \"" + object->getJsonType() + "\" at (" +
+                           std::to_string(cellPos.x) + ", " + std::to_string(cellPos.y) + ")";
+
+        if (cellPos.x < 0 || cellPos.y < 0 || cellPos.x + objSize.width > size.width || cellPos.y + objSize.height > size.height) {
+            _stats.errors.push_back(name + " is outside the " + std::to_string(size.getIWidth()) + "x" +
+                                    std::to_string(size.getIHeight()) + " level");
+        }
+
+        bool art = itemIsArtObject(object->getItemType());
+        bool overlaps = false;
+        for (int i = 0; i < std::max(1, objSize.getIWidth()); i++) {
+            for (int j = 0; j < std::max(1, objSize.getIHeight()); j++) {
+                auto cell = std::make_pair((int)std::floor(cellPos.x) + i, (int)std::floor(cellPos.y) + j);
+                if (art) {
+                    auto& others = artCells[cell];
+                    for (auto& other : others) {
+                        overlaps |= other->getItemType() == object->getItemType() && other->getJsonType() == object->getJsonType();
+                    }
+                    others.push_back(object);
+                    _stats.peakOverdraw = std::max(_stats.peakOverdraw, others.size());
+                } else {
+                    auto it = worldCells.find(cell);
+                    overlaps |= it != worldCells.end() && it->second != object;
+                    worldCells[cell] = object;
+                }
+            }
+        }
+        if (overlaps) {
+            _stats.errors.push_back(name + " overlaps another object");
+        }
+    }
+}
+
+/**
+ * Counts the bodies and fixtures the objects create in a physics world.
+ *
+ * Treasures in a level are only spawn points, so they are not added (as in
+ * LevelCompiler).
+ *
+ * @param objects   The level objects
+ * @param size      The level size
+ */
+void LevelLinter::countBodies(const std::vector<std::shared_ptr<Object>>& objects, const Size& size) {
+    std::shared_ptr<physics2::ObstacleWorld> world = physics2::ObstacleWorld::alloc(Rect(Vec2::ZERO, size), Vec2::ZERO);
+    if (world == nullptr) {
+        _stats.errors.push_back("could not create a physics world");
+        return;
+    }
+    for (auto& object : objects) {
+        if (object != nullptr && object->getItemType() != TREASURE) {
+            world->addObstacle(object);
+        }
+    }
+    for (b2Body* body = world->getWorld()->GetBodyList(); body != nullptr; body = body->GetNext()) {
+        _stats.bodyCount++;
+        for (b2Fixture* fixture = body->GetFixtureList(); fixture != nullptr; fixture = fixture->GetNext()) {
+            _stats.fixtureCount++;
+        }
+    }
+    world->clear();
+}
+
+/**
+ * Records the budget entry if the value is over it.
+ *
+ * @param name      The statistic name
+ * @param value     The value of the statistic
+ * @param budget    The budgeted statistics
+ */
+void LevelLinter::checkBudget(const std::string& name, double value, const std::map<std::string, double>& budget) {
+    auto it = budget.find(name);
+    if (it != budget.end() && value > it->second) {
+        char buffer[128];
+        snprintf(buffer, sizeof(buffer), "%s is %.2f (budget %.2f)", name.c_str(), value, it->second);
+        _stats.overBudget.push_back(buffer);
+    }
+}
@@ -0,0 +1,145 @@
+//
+//  LevelLinter.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_LEVEL_LINTER_H__
+#define __SSB_LEVEL_LINTER_H__
+#include <cugl/cugl.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "Constants.h"
+#include "Object.h"
+
+using namespace cugl;
+
+/**
+ * The cost of a single level, as measured by the level linter.
+ */
+struct LevelLintStats {
+    /** The number of level objects */
+    size_t objectCount = 0;
+    /** The number of level objects of each item type */
+    std::map<Constants::Item, size_t> itemCounts;
+    /** The number of Box2D bodies the objects create */
+    size_t bodyCount = 0;
+    /** The number of Box2D fixtures the objects create */
+    size_t fixtureCount = 0;
+    /** The number of wind raycasts made every physics step */
+    size_t rayCount = 0;
+    /** The number of art objects on each draw layer */
+    std::map<int, size_t> layerCounts;
+    /** The art object area divided by the level area */
+    float overdraw = 0;
+    /** The most art objects covering a single grid cell */
+    size_t peakOverdraw = 0;
+    /** The number of distinct textures the objects are drawn with */
+    size_t textureCount = 0;
+    /** The estimated memory (in bytes) of those textures */
+    size_t textureBytes = 0;
+    /** The out-of-bounds and overlapping objects */
+    std::vector<std::string> errors;
+    /** The budget entries the level exceeds */
+    std::vector<std::string> overBudget;
+};
+
+/**
+ * The headless level linter.
+ *
+ * This class loads a level through LevelModel, exactly as the game does, but
+ * never renders it. The objects are added to a private physics world to count
+ * their bodies and fixtures, and the textures they reference are measured from
+ * the image headers listed in the asset directory, so no window or asset
+ * manager is needed.
+ *
+ * Objects are placed on the grid with the same rules as GridManager: no two
+ * objects (other than art objects) may share a cell, and no two art objects
+ * of the same type may share a cell.
+ *
+ * A budget is a JSON object that maps statistic names (objects, bodies,
+ * fixtures, rays, overdraw, peakOverdraw, textures, textureMB) to their
+ * maximum values. The optional "items" object maps item names (as given by
+ * itemToString) to the maximum count of that item. Statistics missing from
+ * the budget are not checked.
+ */
+class LevelLinter {
+private:
+    /** The statistics of the last linted level */
+    LevelLintStats _stats;
+    /** The maximum value of each budgeted statistic */
+    std::map<std::string, double> _budget;
+    /** The maximum count of each budgeted item (by item name) */
+    std::map<std::string, double> _itemBudget;
+    /** The file of each texture key in the asset directory */
+    std::map<std::string, std::string> _textureFiles;
+    /** The memory of each texture file already measured (0 if unreadable) */
+    std::map<std::string, size_t> _textureBytes;
+
+    /**
+     * Returns the estimated memory (in bytes) of a texture file.
+     *
+     * @param file  The full path of the texture file
+     */
+    size_t getTextureBytes(const std::string& file);
+
+    /**
+     * Records an error for every object outside the level or overlapping another.
+     *
+     * @param objects   The level objects
+     * @param size      The level size
+     */
+    void checkPlacement(const std::vector<std::shared_ptr<Object>>& objects, const Size& size);
+
+    /**
+     * Counts the bodies and fixtures the objects create in a physics world.
+     *
+     * @param objects   The level objects
+     * @param size      The level size
+     */
+    void countBodies(const std::vector<std::shared_ptr<Object>>& objects, const Size& size);
+
+    /**
+     * Records the budget entry if the value is over it.
+     *
+     * @param name      The statistic name
+     * @param value     The value of the statistic
+     * @param budget    The budgeted statistics
+     */
+    void checkBudget(const std::string& name, double value, const std::map<std::string, double>& budget);
+
+public:
+    /**
+     * Reads the textures listed in an asset directory.
+     *
+     * Without an asset directory, texture memory is not measured.
+     *
+     * @param directory The asset directory (holding json/assets.json)
+     *
+     * @return true if the asset list was read
+     */
+    bool loadAssets(const std::string& directory);
+
+    /**
+     * Reads the budget that levels are checked against.
+     *
+     * @param budgetFile    The full path of the budget JSON
+     *
+     * @return true if the budget was read
+     */
+    bool loadBudget(const std::string& budgetFile);
+
+    /**
+     * Measures a JSON level and checks it against the budget.
+     *
+     * @param jsonFile  The full path of the JSON level
+     *
+     * @return true if the level has no errors and is within budget
+     */
+    bool lint(const std::string& jsonFile);
+
+    /** Returns the statistics of the last linted level */
+    const LevelLintStats& getStats() const { return _stats; }
+};
+
+#endif /* __SSB_LEVEL_LINTER_H__ */
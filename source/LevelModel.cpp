@@ -1,62 +1,26 @@
 #include "LevelModel.h"
 #include "ArtObject.h"
+#include "LevelCache.h"
+#include <cstring>
 
-template <typename T>
-shared_ptr<JsonValue> LevelModel::createJsonObjectList(string name, vector<shared_ptr<T>>& objects) {
-	shared_ptr<JsonValue> json = JsonValue::allocObject();
-	shared_ptr<JsonValue> innerArray = JsonValue::allocArray();
-	map<string, any> objData;
-	if (objects.size () == 0) {
-		json->appendValue("name", std::string("emptyObjectList"));
-	}
-	else {
-		json->appendValue("name", name);
-	}
+/**
+* Adds a record for every level object to the builder.
+*
+* Each object fills in the fields of its kind's schema, so the JSON and binary
+* writers see exactly the same values.
+*/
+void LevelModel::createRecordsFromLevel(LevelBinaryBuilder& builder, vector<shared_ptr<Object>>& objects) {
+	LevelRecordKind kind;
+	LevelRecord record;
 	for (auto it = objects.begin(); it != objects.end(); ++it) {
-		objData = (*it)->getMap();
-		if (name == "artObjects") {
-			if (std::find(xOffsetArtObjects.begin(), xOffsetArtObjects.end(), (*it)->getJsonType()) != xOffsetArtObjects.end()) {
-				//(*it)->setPosition(Vec2((*it)->getPosition().x - 32, (*it)->getPosition().y));
-
-			}
-			if (std::find(yOffsetArtObjects.begin(), yOffsetArtObjects.end(), (*it)->getJsonType()) != yOffsetArtObjects.end()) {
-				//(*it)->setPosition(Vec2((*it)->getPosition().x, (*it)->getPosition().y - 32));
-			}
+		if (!levelRecordKindFromKey((*it)->getJsonKey(), kind)) {
+			continue;
 		}
-		innerArray->appendChild(createJsonObject(objData));
-		if (name == "artObjects") {
-			if (std::find(xOffsetArtObjects.begin(), xOffsetArtObjects.end(), (*it)->getJsonType()) != xOffsetArtObjects.end()) {
-				//(*it)->setPosition(Vec2((*it)->getPosition().x + 32, (*it)->getPosition().y));
-
-			}
-			if (std::find(yOffsetArtObjects.begin(), yOffsetArtObjects.end(), (*it)->getJsonType()) != yOffsetArtObjects.end()) {
-				//(*it)->setPosition(Vec2((*it)->getPosition().x, (*it)->getPosition().y + 32));
-			}
+		memset(&record, 0, sizeof(LevelRecord));
+		if ((*it)->getRecord(record)) {
+			builder.addRecord(kind, record, (*it)->getJsonType());
 		}
 	}
-	json->appendChild("objects", innerArray);
-	return json;
-
-}
-
-shared_ptr<JsonValue> LevelModel::createJsonObject(map<std::string, std::any>& dict) {
-	shared_ptr<JsonValue> json = JsonValue::allocObject();
-	for (auto it = dict.begin(); it != dict.end(); ++it) {
-		if ((it->second).type() == typeid(bool)) {
-			json->appendValue(it->first, std::any_cast<bool>(it->second));
-		}
-		else if ((it->second).type() == typeid(std::string)) {
-			json->appendValue(it->first, std::any_cast<std::string>(it->second));
-		}
-		else if ((it->second).type() == typeid(double)) {
-			json->appendValue(it->first, std::any_cast<double>(it->second));
-		}
-		else if ((it->second).type() == typeid(long)) {
-			json->appendValue(it->first, std::any_cast<long>(it->second));
-		}
-		// Add other types here if necessary
-	}
-	return json;
 }
 
 /** 
@@ -67,56 +31,57 @@ shared_ptr<JsonValue> LevelModel::createJsonObject(map<std::string, std::any>& d
 void LevelModel::createJsonFromLevel(string fileName, Size levelSize, vector<shared_ptr<Platform>>& platforms, vector<shared_ptr<Spike>>& spikes,
 	vector<shared_ptr<Treasure>>& treasures, vector<shared_ptr<WindObstacle>>& windObstacles, vector<shared_ptr<Tile>>& tiles,
 	vector<shared_ptr<ArtObject>>& artObjects) {
-	shared_ptr<JsonValue> json = JsonValue::allocObject();
-	shared_ptr<JsonValue> innerArray = JsonValue::allocArray();
-	json->appendValue("width", double(levelSize.getIWidth()));
-	json->appendValue("height", double(levelSize.getIHeight()));
-	json->appendArray("objects");
-	innerArray->appendChild(createJsonObjectList("platforms", platforms));
-	innerArray->appendChild(createJsonObjectList("tiles", tiles));
-	innerArray->appendChild(createJsonObjectList("spikes", spikes));
-	innerArray->appendChild(createJsonObjectList("treasures", treasures));
-	innerArray->appendChild(createJsonObjectList("windObstacles", windObstacles));
-	innerArray->appendChild(createJsonObjectList("artObjects", artObjects));
-	json->appendChild("objectTypes", innerArray);
-
-	shared_ptr<JsonWriter> jsonWriter = JsonWriter::alloc(fileName);
-	jsonWriter->writeJson(json);
-	jsonWriter->close();
+	vector<shared_ptr<Object>> objects;
+	objects.insert(objects.end(), platforms.begin(), platforms.end());
+	objects.insert(objects.end(), tiles.begin(), tiles.end());
+	objects.insert(objects.end(), spikes.begin(), spikes.end());
+	objects.insert(objects.end(), treasures.begin(), treasures.end());
+	objects.insert(objects.end(), windObstacles.begin(), windObstacles.end());
+	objects.insert(objects.end(), artObjects.begin(), artObjects.end());
+	createJsonFromLevel(fileName, levelSize, &objects);
 }
 
 void LevelModel::createJsonFromLevel(string fileName, Size levelSize, vector<shared_ptr<Object>>* objects) {
-	vector<shared_ptr<Platform>> platforms;
-	vector<shared_ptr<Tile>> tiles;
-	vector<shared_ptr<Spike>> spikes;
-	vector<shared_ptr<WindObstacle>> windObstacles;
-	vector<shared_ptr<Treasure>> treasures;
-	vector<shared_ptr<ArtObject>> artObjects;
-	string key;
-	for (auto it = (*objects).begin(); it != (*objects).end(); ++it) {
-		key = (*it)->getJsonKey();
-		// Apparently you can't use a switch statement with strings in C++...
-		if (key == "platforms") {
-			platforms.push_back(dynamic_pointer_cast<Platform>(*it));
-		}
-		else if (key == "tiles") {
-			tiles.push_back(dynamic_pointer_cast<Tile>(*it));
-		}
-		else if (key == "spikes") {
-			spikes.push_back(dynamic_pointer_cast<Spike>(*it));
-		}
-		else if (key == "treasures") {
-			treasures.push_back(dynamic_pointer_cast<Treasure>(*it));
-		}
-		else if (key == "windObstacles") {
-			windObstacles.push_back(dynamic_pointer_cast<WindObstacle>(*it));
-		}
-		else if (key == "artObjects") {
-			auto artObj = dynamic_pointer_cast<ArtObject>(*it);
-			artObjects.push_back(artObj);
-		}
+	LevelBinaryBuilder builder(Size(levelSize.getIWidth(), levelSize.getIHeight()));
+	createRecordsFromLevel(builder, *objects);
+	builder.writeJson(fileName);
+	// Keep the binary level next to the JSON fresh so it is preferred on load
+	builder.write(LevelBinary::getBinaryName(fileName));
+	// File times are only accurate to the second, so drop the cached level now
+	LevelCache::get()->invalidate(fileName, true);
+}
+
+/**
+* Creates a binary level from the in-game objects.
+*
+* The records hold the same values that createJsonFromLevel would write, so the
+* binary level loads into the same objects as the JSON.
+*/
+bool LevelModel::createBinaryFromLevel(string fileName, Size levelSize, vector<shared_ptr<Object>>* objects) {
+	LevelBinaryBuilder builder(Size(levelSize.getIWidth(), levelSize.getIHeight()));
+	createRecordsFromLevel(builder, *objects);
+	return builder.write(fileName);
+}
+
+/**
+* Creates a binary level from a JSON level file.
+*
+* Each JSON object is copied into a record as is, so nothing is lost or adjusted.
+*/
+bool LevelModel::createBinaryFromJson(string jsonFile, string binaryFile, bool useAbsolutePath) {
+	bool asset = !useAbsolutePath && Application::get() != nullptr;
+	shared_ptr<JsonReader> jsonReader = asset ? JsonReader::allocWithAsset(jsonFile) : JsonReader::alloc(jsonFile);
+	if (jsonReader == nullptr) {
+		return false;
+	}
+	shared_ptr<JsonValue> json = jsonReader->readJson();
+	jsonReader->close();
+	shared_ptr<LevelBinaryBuilder> builder = LevelBinaryBuilder::allocWithJson(json);
+	if (builder == nullptr) {
+		CULogError("Malformed level %s", jsonFile.c_str());
+		return false;
 	}
-	createJsonFromLevel(fileName, levelSize, platforms, spikes, treasures, windObstacles, tiles, artObjects);
+	return builder->write(binaryFile);
 }
 
 /**
@@ -126,98 +91,83 @@ void LevelModel::createJsonFromLevel(string fileName, Size levelSize, vector<sha
 * @param fileName The name of the JSON file containing the level information
 */
 vector<shared_ptr<Object>> LevelModel::createLevelFromJson(string fileName, bool useAbsolutePath) {
-	vector<shared_ptr<Object>> allLevelObjects;
-	shared_ptr<JsonReader> jsonReader;
-	if (useAbsolutePath) { // for the load button in the level editor
-		jsonReader = JsonReader::alloc(fileName);
-	}
-	else { // this happens everywhere else
-		jsonReader = JsonReader::allocWithAsset(fileName);
+	// The cache only reads and parses the file the first time (or after it changes)
+	shared_ptr<const LevelBinary> level = LevelCache::get()->getLevel(fileName, useAbsolutePath);
+	if (level == nullptr) {
+		return vector<shared_ptr<Object>>();
 	}
-	if (jsonReader == nullptr) {
-		return allLevelObjects;
-	}
-	shared_ptr<JsonValue> json = jsonReader->readJson();
-	vector<shared_ptr<JsonValue>> objectTypes = json->get("objectTypes")->children();
-	string name;
-
-	_levelSize = Size(
-		json->get("width")->asFloat(),
-		json->get("height")->asFloat()
-	);
+	return createLevelFromBinary(level);
+}
 
-	for (auto it = objectTypes.begin(); it != objectTypes.end(); ++it) {
-		vector<shared_ptr<JsonValue>> objects = (*it)->get("objects")->children();
-		for (auto it2 = objects.begin(); it2 != objects.end(); ++it2) {
-			if ((*it)->get("name")->_stringValue == string("platforms")) {
-				Size theSize = Size((*it2)->get("width")->asFloat(), (*it2)->get("height")->asFloat());
-				allLevelObjects.push_back(Platform::alloc(
-					Vec2((*it2)->get("x")->asFloat(), (*it2)->get("y")->asFloat()),
-					theSize,
-					(*it2)->get("type")->asString()
-				));
-			}
-			else if ((*it)->get("name")->_stringValue == string("tiles")) {
-				Size theSize = Size((*it2)->get("width")->asFloat(), (*it2)->get("height")->asFloat());
-				allLevelObjects.push_back(Tile::alloc(
-					Vec2((*it2)->get("x")->asFloat(), (*it2)->get("y")->asFloat()),
-					theSize,
-					(*it2)->get("type")->asString(), _scale
-				));
-			}
-			else if ((*it)->get("name")->_stringValue == string("spikes")) {
-				allLevelObjects.push_back(Spike::alloc(
-					Vec2((*it2)->get("x")->asFloat(), (*it2)->get("y")->asFloat()),
-					Size((*it2)->get("width")->asFloat(), (*it2)->get("height")->asFloat()),
-					(*it2)->get("scale")->asFloat(),
-					(*it2)->get("angle")->asFloat(),
-					(*it2)->get("type")->asString()
-				));
-			}
-			else if ((*it)->get("name")->_stringValue == string("treasures")) {
-				allLevelObjects.push_back(Treasure::alloc(
-					Vec2((*it2)->get("x")->asFloat(), (*it2)->get("y")->asFloat()),
-					Size((*it2)->get("width")->asFloat(), (*it2)->get("height")->asFloat()),
-					(*it2)->get("scale")->asFloat(),
-					(*it2)->get("type")->asString()
-				));
-			}
-			else if ((*it)->get("name")->_stringValue == string("windObstacles")) {
+/**
+* Creates a single level object from its level record.
+*
+* The record is used as is, with no art offsets.
+*/
+shared_ptr<Object> LevelModel::createObjectFromRecord(LevelRecordKind kind, const LevelRecord& rec, const string& type) {
+	Vec2 pos = Vec2(rec.x, rec.y);
+	Size size = Size(rec.width, rec.height);
+	switch (kind) {
+	case LevelRecordKind::PLATFORM:
+		return Platform::alloc(pos, size, type);
+	case LevelRecordKind::TILE:
+		return Tile::alloc(pos, size, type, _scale);
+	case LevelRecordKind::SPIKE:
+		return Spike::alloc(pos, size, rec.scale, rec.angle, type);
+	case LevelRecordKind::TREASURE:
+		return Treasure::alloc(pos, size, rec.scale, type);
+	case LevelRecordKind::WIND:
+		return WindObstacle::alloc(pos, size, rec.scale, Vec2(rec.gustDirX, rec.gustDirY),
+			Vec2(rec.gustForceX, rec.gustForceY), rec.angle, type);
+	case LevelRecordKind::ART:
+		return ArtObject::alloc(pos, size, rec.scale, rec.angle, rec.layer, type);
+	default:
+		return nullptr;
+	}
+}
 
-				allLevelObjects.push_back(WindObstacle::alloc(
-					Vec2((*it2)->get("x")->asFloat(), (*it2)->get("y")->asFloat()),
-					Size((*it2)->get("width")->asFloat(), (*it2)->get("height")->asFloat()), (*it2)->get("scale")->asFloat(),
-					Vec2((*it2)->get("gustDirX")->asFloat(), (*it2)->get("gustDirY")->asFloat()), 
-					Vec2((*it2)->get("gustForceX")->asFloat(), (*it2)->get("gustForceY")->asFloat()),
-					(*it2)->get("angle")->asFloat(),
-					(*it2)->get("type")->asString()
-				));
-			}
-			else if ((*it)->get("name")->_stringValue == string("artObjects")) {
-				Vec2 pos = Vec2((*it2)->get("x")->asFloat(), (*it2)->get("y")->asFloat());
-				if (std::find(xOffsetArtObjects.begin(), xOffsetArtObjects.end(), (*it2)->get("type")->asString()) != xOffsetArtObjects.end()) {
-					pos.x -= 0.5;
+/**
+* Creates a level from a binary level and returns the objects within it.
+*
+* The records are read in place. Objects are created in the order of the level file,
+* and art objects get their x/y offsets here unless the level compiler has already
+* applied them.
+* These objects have NOT been added to the physics world.
+* @param binary The loaded binary level
+*/
+vector<shared_ptr<Object>> LevelModel::createLevelFromBinary(const shared_ptr<const LevelBinary>& binary) {
+	vector<shared_ptr<Object>> allLevelObjects;
+	_levelSize = binary->getLevelSize();
 
+	size_t total = 0;
+	for (size_t ii = 0; ii < SSBL_KIND_COUNT; ii++) {
+		total += binary->getRecordCount((LevelRecordKind)ii);
+	}
+	allLevelObjects.reserve(total);
+
+	// The runs give the records in the order of the level file
+	size_t next[SSBL_KIND_COUNT] = { 0 };
+	const LevelRecordRun* runs = binary->getRuns();
+	for (size_t rr = 0; rr < binary->getRunCount(); rr++) {
+		LevelRecordKind kind = (LevelRecordKind)runs[rr].kind;
+		const LevelRecord* records = binary->getRecords(kind);
+		for (uint32_t ii = 0; ii < runs[rr].count; ii++) {
+			LevelRecord rec = records[next[runs[rr].kind]++];
+			std::string type = binary->getString(rec.typeIndex);
+			// The level compiler has already applied the offsets
+			if (kind == LevelRecordKind::ART && !binary->isCompiled()) {
+				if (std::find(xOffsetArtObjects.begin(), xOffsetArtObjects.end(), type) != xOffsetArtObjects.end()) {
+					rec.x -= 0.5f;
 				}
-				if (std::find(yOffsetArtObjects.begin(), yOffsetArtObjects.end(), (*it2)->get("type")->asString()) != yOffsetArtObjects.end()) {
-					pos.y -= 0.5;
-
+				if (std::find(yOffsetArtObjects.begin(), yOffsetArtObjects.end(), type) != yOffsetArtObjects.end()) {
+					rec.y -= 0.5f;
 				}
-				auto artObj = ArtObject::alloc(
-					pos,
-					Size((*it2)->get("width")->asFloat(), (*it2)->get("height")->asFloat()),
-					(*it2)->get("scale")->asFloat(),
-					(*it2)->get("angle")->asFloat(),
-					(*it2)->get("layer")->asInt(),
-					(*it2)->get("type")->asString()
-				);
-
-				allLevelObjects.push_back(artObj);
 			}
+			allLevelObjects.push_back(createObjectFromRecord(kind, rec, type));
 		}
 	}
+
 	// These objects have NOT been added to the physics world.
 	_objects = allLevelObjects;
-	jsonReader->close();
 	return allLevelObjects;
 }
@@ -9,7 +9,6 @@
 #define __LEVEL_MODEL_H__
 #include <cugl/cugl.h>
 #include <vector>
-#include <any>
 #include "Object.h"
 #include "Platform.h"
 #include "Tile.h"
@@ -17,6 +16,7 @@
 #include "WindObstacle.h"
 #include "Treasure.h"
 #include "ArtObject.h"
+#include "LevelBinary.h"
 
 class LevelModel {
 
@@ -28,16 +28,20 @@ private:
 	
 public: 
 
-	shared_ptr<JsonValue> createJsonObject(map<std::string, std::any>& dict);
-
-	template <typename T>
-	shared_ptr <JsonValue> createJsonObjectList(string name, vector<shared_ptr<T>>& objects);
-
 	void createJsonFromLevel(string fileName, Size size, vector<shared_ptr<Platform>>& platforms, vector<shared_ptr<Spike>>& spikes,
 		vector<shared_ptr<Treasure>>& treasures, vector<shared_ptr<WindObstacle>>& windObstacles,
 		vector<shared_ptr<Tile>>& tiles, vector<shared_ptr<ArtObject>>& artObjects);
 
+	/** Adds a level record for every saved object in an in-game level.
+	* This only copies a few numbers per object, so it is cheap enough to call every frame.
+	* @param builder The builder to add the records to.
+	* @param objects A list of all objects in the level.
+	*/
+	static void createRecordsFromLevel(LevelBinaryBuilder& builder, vector<shared_ptr<Object>>& objects);
+
 	/** Creates a JSON file based on an in-game level. 
+	* The JSON text is written straight from the field schema of each object kind (see LevelBinary.h),
+	* and the .ssbl file next to it is written from the same records.
 	* @param size The size (width, height) of the level.
 	* @param objects A list of all objects in the level.
 	*/
@@ -47,10 +51,43 @@ public:
 	* This method creates the objects in the level and defines its size.
 	* Note that only one level can be stored in this class at a time.
 	* If you call createLevelFromJson a second time, all the original level information will be overwritten.
+	* The parsed file is kept in the LevelCache, so loading the same level again does not reread it.
 	* @param fileName The name of the JSON file containing the level information.
 	*/
 	vector<shared_ptr<Object>> createLevelFromJson(string fileName, bool useAbsolutePath=false);
 
+	/** Initializes the in-game level from a binary (.ssbl) level.
+	* This creates exactly the same objects as loading the JSON the binary level was built from.
+	* @param binary The loaded binary level.
+	*/
+	vector<shared_ptr<Object>> createLevelFromBinary(const shared_ptr<const LevelBinary>& binary);
+
+	/** Creates a single level object from its level record.
+	* Unlike createLevelFromBinary, no art offsets are applied, so this recreates an object
+	* exactly as createRecordsFromLevel saw it.
+	* @param kind The record kind.
+	* @param record The record values.
+	* @param type The json type of the object.
+	* @return the object, or nullptr if the kind is not a level object.
+	*/
+	shared_ptr<Object> createObjectFromRecord(LevelRecordKind kind, const LevelRecord& record, const string& type);
+
+	/** Creates a binary (.ssbl) level file based on an in-game level.
+	* @param fileName The full path of the .ssbl file to write.
+	* @param size The size (width, height) of the level.
+	* @param objects A list of all objects in the level.
+	* @return true if the file was written.
+	*/
+	bool createBinaryFromLevel(string fileName, Size size, vector<shared_ptr<Object>>* objects);
+
+	/** Creates a binary (.ssbl) level file from a JSON level file.
+	* @param jsonFile The JSON level file name.
+	* @param binaryFile The full path of the .ssbl file to write.
+	* @param useAbsolutePath Whether the JSON file name is a full path (and not an asset).
+	* @return true if the file was written.
+	*/
+	bool createBinaryFromJson(string jsonFile, string binaryFile, bool useAbsolutePath=false);
+
 	/** Returns the level size */
 	Size getLevelSize() {
 		return _levelSize;
@@ -0,0 +1,445 @@
+//
+//  LevelSaver.cpp
+//  SweetSweetBetrayal
+//
+
+#include "LevelSaver.h"
+#include "LevelCache.h"
+#include "LevelModel.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace cugl;
+
+/** The first word of every journal */
+#define JOURNAL_MAGIC   "SSBJ"
+/** The journal format version */
+#define JOURNAL_VERSION 2
+
+#pragma mark -
+#pragma mark Files
+/**
+ * Writes the text to the file at the given path.
+ *
+ * @param path  The full path to the file
+ * @param text  The text to write
+ * @param mode  The SDL file mode ("wb" to replace, "ab" to append)
+ *
+ * @return true if the file was written, false otherwise.
+ */
+static bool writeText(const std::string& path, const std::string& text, const char* mode) {
+    SDL_RWops* file = SDL_RWFromFile(path.c_str(), mode);
+    if (file == nullptr) {
+        return false;
+    }
+    bool success = SDL_RWwrite(file, text.data(), 1, text.size()) == text.size();
+    SDL_RWclose(file);
+    return success;
+}
+
+/**
+ * Replaces a file with a temporary file written next to it.
+ *
+ * On POSIX systems the rename is atomic, so the file is always either the old
+ * one or the new one. Windows will not rename over an existing file, so there
+ * the old file is removed first.
+ *
+ * @param temp  The full path to the temporary file
+ * @param path  The full path to the file to replace
+ *
+ * @return true if the file was replaced, false otherwise.
+ */
+static bool replaceFile(const std::string& temp, const std::string& path) {
+    if (std::rename(temp.c_str(), path.c_str()) == 0) {
+        return true;
+    }
+    std::remove(path.c_str());
+    if (std::rename(temp.c_str(), path.c_str()) != 0) {
+        CULogError("Could not replace %s", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Writes the text to a temporary file, and then renames it over the given path.
+ *
+ * @param path  The full path to the file
+ * @param text  The text to write
+ *
+ * @return true if the file was replaced, false otherwise.
+ */
+static bool replaceText(const std::string& path, const std::string& text) {
+    std::string temp = path + ".tmp";
+    return writeText(temp, text, "wb") && replaceFile(temp, path);
+}
+
+#pragma mark -
+#pragma mark Journal Lines
+/**
+ * Appends a journal line for a level record.
+ *
+ * Every field in LEVEL_FIELDS is written (in that order), so a line can be
+ * read back without knowing the kind's schema. The type comes last, as it is
+ * the only field that is not a number.
+ *
+ * @param op        '+' if the object was added, '-' if it was removed
+ * @param kind      The record kind
+ * @param record    The record
+ * @param type      The json type of the object
+ * @param out       The journal text to append to
+ */
+static void appendJournalLine(char op, LevelRecordKind kind, const LevelRecord& record,
+                              const std::string& type, std::string& out) {
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(&record);
+    char buffer[32];
+    out.push_back(op);
+    out.push_back(' ');
+    out.append(std::to_string((int)kind));
+    for (const LevelFieldInfo& info : LEVEL_FIELDS) {
+        if (info.integer) {
+            int32_t value;
+            memcpy(&value, base + info.offset, sizeof(int32_t));
+            snprintf(buffer, sizeof(buffer), " %d", value);
+        } else {
+            float value;
+            memcpy(&value, base + info.offset, sizeof(float));
+            snprintf(buffer, sizeof(buffer), " %.9g", value);
+        }
+        out.append(buffer);
+    }
+    out.push_back(' ');
+    out.append(type);
+    out.push_back('\n');
+}
+
+/**
+ * Reads a journal line written by appendJournalLine.
+ *
+ * @param line      The line (without its newline)
+ * @param op        The operation of the line
+ * @param kind      The record kind of the line
+ * @param record    The record to fill in
+ * @param type      The json type of the object
+ *
+ * @return true if the line was read, false if it is malformed.
+ */
+static bool readJournalLine(const std::string& line, char& op, LevelRecordKind& kind,
+                            LevelRecord& record, std::string& type) {
+    if (line.size() < 2 || (line[0] != '+' && line[0] != '-')) {
+        return false;
+    }
+    op = line[0];
+    const char* start = line.c_str() + 1;
+    char* end = nullptr;
+    long value = strtol(start, &end, 10);
+    if (end == start || value < 0 || value >= (long)SSBL_KIND_COUNT) {
+        return false;
+    }
+    kind = (LevelRecordKind)value;
+
+    uint8_t* base = reinterpret_cast<uint8_t*>(&record);
+    memset(&record, 0, sizeof(LevelRecord));
+    for (const LevelFieldInfo& info : LEVEL_FIELDS) {
+        start = end;
+        if (info.integer) {
+            int32_t number = (int32_t)strtol(start, &end, 10);
+            memcpy(base + info.offset, &number, sizeof(int32_t));
+        } else {
+            float number = strtof(start, &end);
+            memcpy(base + info.offset, &number, sizeof(float));
+        }
+        if (end == start) {
+            return false;
+        }
+    }
+    while (*end == ' ') {
+        end++;
+    }
+    type = end;
+    return !type.empty();
+}
+
+#pragma mark -
+#pragma mark Constructors
+/**
+ * Initializes the saver and starts its worker thread.
+ *
+ * @param journalFile   The full path of the edit journal
+ *
+ * @return true if the saver was initialized properly
+ */
+bool LevelSaver::init(const std::string& journalFile) {
+    _journalFile = journalFile;
+    _stopping = false;
+    _worker = std::thread([this]() { run(); });
+    return true;
+}
+
+/**
+ * Writes every pending save, stops the worker thread, and deletes the journal.
+ *
+ * The journal is only for recovering from a crash, so leaving the editor
+ * normally must not bring its edits back in the next session.
+ */
+void LevelSaver::dispose() {
+    if (!_worker.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _wake.notify_one();
+    _worker.join();
+    update();
+    std::remove(_journalFile.c_str());
+}
+
+#pragma mark -
+#pragma mark Saving
+/**
+ * Returns a builder holding the saved objects of a level.
+ *
+ * @param size      The level size
+ * @param objects   The objects in the level
+ */
+std::shared_ptr<LevelBinaryBuilder> LevelSaver::snapshot(const Size& size, std::vector<std::shared_ptr<Object>>* objects) {
+    std::shared_ptr<LevelBinaryBuilder> level = std::make_shared<LevelBinaryBuilder>(Size(size.getIWidth(), size.getIHeight()));
+    LevelModel::createRecordsFromLevel(*level, *objects);
+    return level;
+}
+
+/**
+ * Saves the level in the background.
+ *
+ * @param fileName  The full path of the JSON level to write
+ * @param size      The level size
+ * @param objects   The objects in the level
+ */
+void LevelSaver::save(const std::string& fileName, const Size& size, std::vector<std::shared_ptr<Object>>* objects) {
+    queue({ fileName, snapshot(size, objects), true });
+}
+
+/**
+ * Restarts the journal from the given level without saving it.
+ *
+ * @param size      The level size
+ * @param objects   The objects in the level
+ * @param saved     Whether the level matches a level file
+ */
+void LevelSaver::restart(const Size& size, std::vector<std::shared_ptr<Object>>* objects, bool saved) {
+    queue({ "", snapshot(size, objects), saved });
+}
+
+/**
+ * Queues a snapshot for the worker.
+ *
+ * @param job   The snapshot to write
+ */
+void LevelSaver::queue(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        // The snapshot already has every edit in the pending journal
+        _journal.clear();
+        _jobs.push_back(std::move(job));
+    }
+    _wake.notify_one();
+}
+
+/**
+ * Adds a change to the level to the journal.
+ *
+ * @param delta The change to the level
+ */
+void LevelSaver::journal(const EditDelta& delta) {
+    std::string line;
+    appendJournalLine(delta.add ? '+' : '-', delta.kind, delta.record, delta.type, line);
+    std::lock_guard<std::mutex> lock(_mutex);
+    _journal.append(line);
+}
+
+/**
+ * Reports the saves the worker has finished since the last call.
+ */
+void LevelSaver::update() {
+    std::vector<std::string> saved;
+    std::vector<std::string> failed;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        saved.swap(_saved);
+        failed.swap(_failed);
+    }
+    for (auto& file : saved) {
+        // File times are only accurate to the second, so drop the cached level now
+        LevelCache::get()->invalidate(file, true);
+        CULog("Saved to %s", file.c_str());
+    }
+    for (auto& file : failed) {
+        CULogError("Could not save %s", file.c_str());
+    }
+}
+
+#pragma mark -
+#pragma mark Worker
+/**
+ * The body of the worker thread.
+ *
+ * Each pass takes every queued snapshot and pending journal line at once, so
+ * the lock is never held while writing. Snapshots are written before journal
+ * lines, since every pending line was added after the last snapshot.
+ */
+void LevelSaver::run() {
+    std::chrono::duration<float> interval(LEVEL_JOURNAL_INTERVAL);
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _wake.wait_for(lock, interval, [this]() { return _stopping || !_jobs.empty(); });
+        std::deque<Job> jobs;
+        std::string journal;
+        jobs.swap(_jobs);
+        journal.swap(_journal);
+        bool stopping = _stopping;
+        lock.unlock();
+
+        std::vector<std::string> saved;
+        std::vector<std::string> failed;
+        for (auto& job : jobs) {
+            bool success = write(job);
+            if (!job.levelFile.empty()) {
+                (success ? saved : failed).push_back(job.levelFile);
+            }
+        }
+        if (!journal.empty() && !writeText(_journalFile, journal, "ab")) {
+            CULogError("Could not append to %s", _journalFile.c_str());
+        }
+
+        lock.lock();
+        _saved.insert(_saved.end(), saved.begin(), saved.end());
+        _failed.insert(_failed.end(), failed.begin(), failed.end());
+        if (stopping && _jobs.empty() && _journal.empty()) {
+            break;
+        }
+    }
+}
+
+/**
+ * Writes a level snapshot and restarts the journal from it.
+ *
+ * The header counts the snapshot objects as saved only if they match a level
+ * file. If the save failed, they are all kept as work to recover.
+ *
+ * @param job   The snapshot to write
+ *
+ * @return true if the level (if any) was written, false otherwise.
+ */
+bool LevelSaver::write(const Job& job) {
+    bool success = true;
+    if (!job.levelFile.empty()) {
+        // Replace the .ssbl last, so it is never older than the JSON
+        std::string binaryFile = LevelBinary::getBinaryName(job.levelFile);
+        success = replaceText(job.levelFile, job.level->buildJson()) &&
+                  job.level->write(binaryFile + ".tmp") && replaceFile(binaryFile + ".tmp", binaryFile);
+    }
+
+    size_t saved = 0;
+    if (job.saved && success) {
+        for (size_t ii = 0; ii < SSBL_KIND_COUNT; ii++) {
+            saved += job.level->getRecordCount((LevelRecordKind)ii);
+        }
+    }
+    const Size& size = job.level->getLevelSize();
+    std::string text = std::string(JOURNAL_MAGIC) + " " + std::to_string(JOURNAL_VERSION) + " " +
+                       std::to_string(size.getIWidth()) + " " + std::to_string(size.getIHeight()) + " " +
+                       std::to_string(saved) + "\n";
+    job.level->forEachRecord([&](LevelRecordKind kind, const LevelRecord& record) {
+        appendJournalLine('+', kind, record, job.level->getString(record.typeIndex), text);
+    });
+    if (!replaceText(_journalFile, text)) {
+        CULogError("Could not restart %s", _journalFile.c_str());
+    }
+    return success;
+}
+
+#pragma mark -
+#pragma mark Recovery
+/**
+ * Returns the level described by a journal.
+ *
+ * A line cut short by a crash is ignored, as is anything after it. The
+ * first lines of the journal are the saved objects counted in its header,
+ * and a journal with no lines after them has nothing to recover.
+ *
+ * @param journalFile   The full path of the edit journal
+ *
+ * @return the level records, or nullptr if there is no readable journal with unsaved work.
+ */
+std::shared_ptr<LevelBinaryBuilder> LevelSaver::recover(const std::string& journalFile) {
+    SDL_RWops* file = SDL_RWFromFile(journalFile.c_str(), "rb");
+    if (file == nullptr) {
+        return nullptr;
+    }
+    Sint64 length = SDL_RWsize(file);
+    std::string text(length > 0 ? (size_t)length : 0, '\0');
+    size_t read = text.empty() ? 0 : SDL_RWread(file, &text[0], 1, text.size());
+    SDL_RWclose(file);
+    text.resize(read);
+
+    size_t end = text.find('\n');
+    char magic[8] = { 0 };
+    int version = 0;
+    int width = 0;
+    int height = 0;
+    long saved = 0;
+    if (end == std::string::npos ||
+        sscanf(text.substr(0, end).c_str(), "%7s %d %d %d %ld", magic, &version, &width, &height, &saved) != 5 ||
+        strcmp(magic, JOURNAL_MAGIC) != 0 || version != JOURNAL_VERSION) {
+        CULogError("Ignoring malformed journal %s", journalFile.c_str());
+        return nullptr;
+    }
+
+    struct Entry {
+        LevelRecordKind kind;
+        LevelRecord record;
+        std::string type;
+    };
+    std::vector<Entry> entries;
+    Entry entry;
+    char op;
+    long lines = 0;
+    size_t start = end + 1;
+    while ((end = text.find('\n', start)) != std::string::npos) {
+        if (!readJournalLine(text.substr(start, end - start), op, entry.kind, entry.record, entry.type)) {
+            CULogError("Journal %s is cut short", journalFile.c_str());
+            break;
+        }
+        start = end + 1;
+        lines++;
+        if (op == '+') {
+            entries.push_back(entry);
+            continue;
+        }
+        // Remove the latest matching object
+        for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+            if (it->kind == entry.kind && it->type == entry.type &&
+                it->record.x == entry.record.x && it->record.y == entry.record.y) {
+                entries.erase(std::next(it).base());
+                break;
+            }
+        }
+    }
+
+    if (lines <= saved) {
+        // Everything in the journal is already in a level file
+        return nullptr;
+    }
+
+    std::shared_ptr<LevelBinaryBuilder> level = std::make_shared<LevelBinaryBuilder>(Size(width, height));
+    // Journal positions come from objects in the editor, so the art offsets are already applied
+    level->setFlags(SSBL_FLAG_COMPILED);
+    for (auto& saved : entries) {
+        level->addRecord(saved.kind, saved.record, saved.type);
+    }
+    return level;
+}
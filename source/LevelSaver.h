@@ -0,0 +1,198 @@
+//
+//  LevelSaver.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_LEVEL_SAVER_H__
+#define __SSB_LEVEL_SAVER_H__
+#include <cugl/cugl.h>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "EditHistory.h"
+#include "LevelBinary.h"
+#include "Object.h"
+
+using namespace cugl;
+
+/** The longest time (in seconds) that a journaled edit waits before it is written */
+#define LEVEL_JOURNAL_INTERVAL  1.0f
+/** The name of the level editor journal in the save directory */
+#define LEVEL_JOURNAL_FILE      "editor.journal"
+
+/**
+ * A background writer for levels made in the level editor.
+ *
+ * Saving only copies the level records of the objects on the calling thread
+ * (see LevelModel::createRecordsFromLevel). The JSON text and the .ssbl file are
+ * written by a worker thread, each to a temporary file that is then renamed over
+ * the old one, so a crash during a save never leaves a half-written level.
+ *
+ * Between full saves, edits are appended to a journal. The journal starts with
+ * every object of the level (written whenever the level is saved or replaced)
+ * followed by one line per EditDelta (the same changes kept by EditHistory).
+ * The worker appends pending edits at least every {@link LEVEL_JOURNAL_INTERVAL}
+ * seconds, so a crash loses at most that much work. {@link #recover} rebuilds
+ * the level from the journal, but only if it holds work that was never saved.
+ *
+ * The journal header counts the objects that are already saved, so a journal
+ * that was just restarted by a save holds nothing to recover. The journal is
+ * deleted when the saver is disposed, so only a crash leaves one behind.
+ */
+class LevelSaver {
+private:
+    /** A full snapshot of the level to write */
+    struct Job {
+        /** The full path of the JSON level to write (empty to only restart the journal) */
+        std::string levelFile;
+        /** The level records */
+        std::shared_ptr<LevelBinaryBuilder> level;
+        /** Whether the records match a level file (and so need no recovery) */
+        bool saved;
+    };
+
+    /** The full path of the journal */
+    std::string _journalFile;
+    /** The worker thread */
+    std::thread _worker;
+    /** The lock for everything shared with the worker */
+    std::mutex _mutex;
+    /** Wakes the worker when there is a job or it should stop */
+    std::condition_variable _wake;
+    /** The snapshots waiting to be written */
+    std::deque<Job> _jobs;
+    /** The journal lines waiting to be written */
+    std::string _journal;
+    /** The levels written since the last call to update */
+    std::vector<std::string> _saved;
+    /** The levels that failed since the last call to update */
+    std::vector<std::string> _failed;
+    /** Whether the worker should finish its work and exit */
+    bool _stopping;
+
+    /** The body of the worker thread */
+    void run();
+
+    /**
+     * Queues a snapshot for the worker.
+     *
+     * @param job   The snapshot to write
+     */
+    void queue(Job job);
+
+    /**
+     * Writes a level snapshot and restarts the journal from it.
+     *
+     * @param job   The snapshot to write
+     *
+     * @return true if the level (if any) was written, false otherwise.
+     */
+    bool write(const Job& job);
+
+    /**
+     * Returns a builder holding the saved objects of a level.
+     *
+     * @param size      The level size
+     * @param objects   The objects in the level
+     */
+    static std::shared_ptr<LevelBinaryBuilder> snapshot(const Size& size, std::vector<std::shared_ptr<Object>>* objects);
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates a level saver with no worker.
+     */
+    LevelSaver() : _stopping(false) {}
+
+    /**
+     * Deletes this level saver, waiting for any pending writes.
+     */
+    ~LevelSaver() { dispose(); }
+
+    /**
+     * Initializes the saver and starts its worker thread.
+     *
+     * @param journalFile   The full path of the edit journal
+     *
+     * @return true if the saver was initialized properly
+     */
+    bool init(const std::string& journalFile);
+
+    /**
+     * Returns a newly allocated level saver.
+     *
+     * @param journalFile   The full path of the edit journal
+     *
+     * @return a newly allocated level saver
+     */
+    static std::shared_ptr<LevelSaver> alloc(const std::string& journalFile) {
+        std::shared_ptr<LevelSaver> result = std::make_shared<LevelSaver>();
+        return (result->init(journalFile) ? result : nullptr);
+    }
+
+    /**
+     * Writes every pending save, stops the worker thread, and deletes the journal.
+     */
+    void dispose();
+
+#pragma mark Saving
+    /**
+     * Saves the level in the background.
+     *
+     * The objects are copied into level records before this method returns, so
+     * they may be changed right away. The .ssbl file next to the JSON is written
+     * too, and the journal restarts from this snapshot.
+     *
+     * @param fileName  The full path of the JSON level to write
+     * @param size      The level size
+     * @param objects   The objects in the level
+     */
+    void save(const std::string& fileName, const Size& size, std::vector<std::shared_ptr<Object>>* objects);
+
+    /**
+     * Restarts the journal from the given level without saving it.
+     *
+     * Call this whenever the edited level is replaced (such as on load). A
+     * level that was recovered from the journal is not saved anywhere, so it
+     * stays in the journal as work to recover.
+     *
+     * @param size      The level size
+     * @param objects   The objects in the level
+     * @param saved     Whether the level matches a level file
+     */
+    void restart(const Size& size, std::vector<std::shared_ptr<Object>>* objects, bool saved = true);
+
+    /**
+     * Adds a change to the level to the journal.
+     *
+     * The change is written by the worker within {@link LEVEL_JOURNAL_INTERVAL}
+     * seconds, without rewriting the level.
+     *
+     * @param delta The change to the level
+     */
+    void journal(const EditDelta& delta);
+
+    /**
+     * Reports the saves the worker has finished since the last call.
+     *
+     * This must be called on the main thread, as it drops the saved levels
+     * from the LevelCache.
+     */
+    void update();
+
+#pragma mark Recovery
+    /**
+     * Returns the level described by a journal.
+     *
+     * @param journalFile   The full path of the edit journal
+     *
+     * @return the level records, or nullptr if there is no readable journal with unsaved work.
+     */
+    static std::shared_ptr<LevelBinaryBuilder> recover(const std::string& journalFile);
+};
+
+#endif /* __SSB_LEVEL_SAVER_H__ */
@@ -0,0 +1,83 @@
+//
+//  LevelStreamer.cpp
+//  SweetSweetBetrayal
+//
+
+#include "LevelStreamer.h"
+#include <algorithm>
+#include <limits>
+
+using namespace cugl;
+
+/**
+ * Initializes the streamer with the objects of a level.
+ *
+ * @param objects   The level objects to create
+ * @param focus     The points (in world units) to create objects around first
+ * @param processor The function that instantiates a single object
+ *
+ * @return true if the streamer was initialized properly
+ */
+bool LevelStreamer::init(const std::vector<std::shared_ptr<Object>>& objects,
+                         const std::vector<Vec2>& focus, const Processor& processor) {
+    _processor = processor;
+    _next = 0;
+    _startCount = 0;
+
+    // Sort on precomputed distances so each object is only measured once
+    std::vector<std::pair<float, size_t>> order;
+    order.reserve(objects.size());
+    for (size_t ii = 0; ii < objects.size(); ii++) {
+        Vec2 center = objects[ii]->getPositionInit() + objects[ii]->getSize() / 2;
+        float nearest = std::numeric_limits<float>::max();
+        for (auto& point : focus) {
+            nearest = std::min(nearest, center.distance(point));
+        }
+        order.push_back(std::make_pair(nearest, ii));
+        if (nearest <= LEVEL_START_RADIUS) {
+            _startCount++;
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [](const std::pair<float, size_t>& a, const std::pair<float, size_t>& b) {
+        return a.first < b.first;
+    });
+
+    _pending.clear();
+    _pending.reserve(objects.size());
+    for (auto& entry : order) {
+        _pending.push_back(objects[entry.second]);
+    }
+    return true;
+}
+
+/**
+ * Creates level objects until the time budget is used up.
+ *
+ * @param budget    The time (in seconds) this call may take
+ *
+ * @return the number of objects created
+ */
+size_t LevelStreamer::step(float budget) {
+    Timestamp start;
+    Uint64 limit = (Uint64)(budget * 1000000.0f);
+    size_t created = 0;
+    while (_next < _pending.size()) {
+        _processor(_pending[_next++]);
+        created++;
+
+        Timestamp now;
+        if (Timestamp::ellapsedMicros(start, now) >= limit) {
+            break;
+        }
+    }
+    return created;
+}
+
+/**
+ * Creates every remaining level object at once.
+ */
+void LevelStreamer::finish() {
+    while (_next < _pending.size()) {
+        _processor(_pending[_next++]);
+    }
+}
@@ -0,0 +1,122 @@
+//
+//  LevelStreamer.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_LEVEL_STREAMER_H__
+#define __SSB_LEVEL_STREAMER_H__
+#include <cugl/cugl.h>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "Object.h"
+
+using namespace cugl;
+
+/** The default time (in seconds) that level streaming may take each frame */
+#define LEVEL_STREAM_BUDGET 0.004f
+/** The distance (in world units) around a focus point that counts as the start area */
+#define LEVEL_START_RADIUS  20.0f
+
+/**
+ * An incremental job that instantiates level objects over several frames.
+ *
+ * Creating a level object builds its physics body, scene nodes and animation
+ * timelines, which is too much to do for a whole level in a single frame. This
+ * class orders the objects by their distance to a set of focus points (such as
+ * the spawn and the camera), and then creates as many of them as fit in a time
+ * budget each time {@link #step} is called.
+ *
+ * The objects within {@link LEVEL_START_RADIUS} of a focus point form the start
+ * area. Once those exist, the game can be played while the rest streams in.
+ */
+class LevelStreamer {
+public:
+    /** The function that instantiates a single level object */
+    typedef std::function<void(const std::shared_ptr<Object>&)> Processor;
+
+private:
+    /** The objects still to create, nearest first */
+    std::vector<std::shared_ptr<Object>> _pending;
+    /** The index of the next object to create */
+    size_t _next;
+    /** The number of objects in the start area */
+    size_t _startCount;
+    /** The function that instantiates an object */
+    Processor _processor;
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates an empty level streamer.
+     */
+    LevelStreamer() : _next(0), _startCount(0) {}
+
+    /**
+     * Initializes the streamer with the objects of a level.
+     *
+     * The objects are sorted by the distance from their center to the nearest
+     * focus point. Equal distances keep their level order, so every client
+     * creates the objects in the same order.
+     *
+     * @param objects   The level objects to create
+     * @param focus     The points (in world units) to create objects around first
+     * @param processor The function that instantiates a single object
+     *
+     * @return true if the streamer was initialized properly
+     */
+    bool init(const std::vector<std::shared_ptr<Object>>& objects,
+              const std::vector<Vec2>& focus, const Processor& processor);
+
+    /**
+     * Returns a newly allocated level streamer for the objects of a level.
+     *
+     * @param objects   The level objects to create
+     * @param focus     The points (in world units) to create objects around first
+     * @param processor The function that instantiates a single object
+     *
+     * @return a newly allocated level streamer
+     */
+    static std::shared_ptr<LevelStreamer> alloc(const std::vector<std::shared_ptr<Object>>& objects,
+                                                const std::vector<Vec2>& focus, const Processor& processor) {
+        std::shared_ptr<LevelStreamer> result = std::make_shared<LevelStreamer>();
+        return (result->init(objects, focus, processor) ? result : nullptr);
+    }
+
+#pragma mark Streaming
+    /**
+     * Creates level objects until the time budget is used up.
+     *
+     * At least one object is created per call (if any are left), so the level
+     * always finishes loading however small the budget is.
+     *
+     * @param budget    The time (in seconds) this call may take
+     *
+     * @return the number of objects created
+     */
+    size_t step(float budget);
+
+    /**
+     * Creates every remaining level object at once.
+     */
+    void finish();
+
+    /** Returns true if every object in the start area has been created */
+    bool isStartReady() const { return _next >= _startCount; }
+
+    /** Returns true if every level object has been created */
+    bool isComplete() const { return _next >= _pending.size(); }
+
+    /** Returns the fraction of level objects created so far (between 0 and 1) */
+    float getProgress() const {
+        return _pending.empty() ? 1.0f : (float)_next / (float)_pending.size();
+    }
+
+    /** Returns the number of level objects created so far */
+    size_t getCreatedCount() const { return _next; }
+
+    /** Returns the total number of level objects */
+    size_t getTotalCount() const { return _pending.size(); }
+};
+
+#endif /* __SSB_LEVEL_STREAMER_H__ */
@@ -23,7 +23,9 @@ enum class Message {
     MAKE_UNSTEALABLE, // Signal to make treasure unstealable
     SCORE_UPDATE,     // Signal a score update
     RESET_LEVEL,      // Signal a level to reset
-    HOST_PICK         // Signal that host has picked a level
+    HOST_PICK,        // Signal that host has picked a level
+    FIXED_MATH_ON,    // Signal that the host turned fixed-point movement on
+    FIXED_MATH_OFF    // Signal that the host turned fixed-point movement off
 };
 
 /**
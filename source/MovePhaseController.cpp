@@ -139,6 +139,7 @@ void MovePhaseController::resetRound() {
 
     _movePhaseScene.resetPlayerProperties();
     _movePhaseScene.resetCameraPos();
+    _movePhaseScene.restoreLevelTransforms();
 
 //    _movePhaseScene.reset();
 //    _uiScene.reset();
@@ -209,7 +210,10 @@ void MovePhaseController::preUpdate(float dt) {
     }
 
     if (_movePhaseScene.getLocalPlayer() != nullptr) {
-        if (_controlEnabled) {
+        if (_replaying) {
+            // The input replay sets the movement every fixed step
+        }
+        else if (_controlEnabled) {
             //Check if we have held down the right side of the screen. If we have
             if (_input->getRightTapped()) {
                 _input->setRightTapped(false);
@@ -645,8 +649,14 @@ void MovePhaseController::beginContact(b2Contact *contact)
         if (bomb && other && !other->isRemoved() && other->getName() != "goalDoor" && other->getName() != "treasure" && other->getName() != "parallaxObject") {
             CULog("Trigger bomb explosion");
             _sound->playSound("bomb");
-            other->markRemoved(true);
-            other->dispose();
+            Bomb* otherBomb = dynamic_cast<Bomb*>(other);
+            if (otherBomb && otherBomb->isPooled()) {
+                // Pooled bombs keep their node and animation for reuse
+                otherBomb->retire();
+            } else {
+                other->markRemoved(true);
+                other->dispose();
+            }
             
         }
     }
@@ -90,6 +90,8 @@ protected:
     /** Whether the controls and scene elements are active */
     bool _isActive = true;
     bool _controlEnabled = true;
+    /** Whether an input replay drives the local player instead of the input */
+    bool _replaying = false;
 
     cugl::ActionFunction _goalDoorAction;
     /** Manager to process the animation actions */
@@ -149,6 +151,20 @@ public:
      */
     void preUpdate(float dt);
 
+    /**
+     * Creates more of the level objects, within the given time budget.
+     *
+     * @param budget    The time (in seconds) this call may take
+     *
+     * @return true if the start area of the level is ready to play
+     */
+    bool streamLevel(float budget) { return _movePhaseScene.streamLevel(budget); }
+
+    /**
+     * Returns the fraction of the level objects created so far (between 0 and 1).
+     */
+    float getLoadProgress() const { return _movePhaseScene.getLoadProgress(); }
+
     /**
      * The method called to indicate the end of a deterministic loop.
      *
@@ -288,6 +304,15 @@ public:
      */
     void setDebug(bool value) { _debug = value; _movePhaseScene.setDebugVisible(value); }
 
+    /**
+     * Sets whether an input replay drives the local player.
+     *
+     * While replaying, the live input does not move the local player.
+     *
+     * @param value whether an input replay drives the local player
+     */
+    void setReplaying(bool value) { _replaying = value; }
+
     /**
      * Returns true if the level is completed.
      *
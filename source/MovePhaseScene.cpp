@@ -16,6 +16,7 @@
 #include "LevelModel.h"
 #include "ObjectController.h"
 #include "Mushroom.h"
+#include "GoalDoor.h"
 
 #include <ctime>
 #include <string>
@@ -78,6 +79,9 @@ MovePhaseScene::MovePhaseScene() : Scene2(),
  * Disposes of all (non-static) resources allocated to this mode.
  */
 void MovePhaseScene::dispose() {
+    cancelLevelStream();
+    _staticLayers = nullptr;
+    _culler = nullptr;
     _worldnode = nullptr;
     _debugnode = nullptr;
 };
@@ -126,6 +130,10 @@ bool MovePhaseScene::init(const std::shared_ptr<AssetManager>& assets, const std
 
     // Initialize object controller
     _objectController = std::make_shared<ObjectController>(_assets, _world, _scale, _worldnode, _debugnode, _objects);
+    _culler = SceneCuller::alloc(_worldnode);
+    _objectController->setCuller(_culler);
+    _staticLayers = StaticLayers::alloc(_worldnode, _culler);
+    _objectController->setStaticLayers(_staticLayers);
 
     addChild(_gridManager->getGridNode());
 
@@ -185,6 +193,10 @@ bool MovePhaseScene::rebuildLevel(std::vector<std::shared_ptr<Object>>* objects)
 
     // Initialize object controller
     _objectController = std::make_shared<ObjectController>(_assets, _world, _scale, _worldnode, _debugnode, objects);
+    _culler = SceneCuller::alloc(_worldnode);
+    _objectController->setCuller(_culler);
+    _staticLayers = StaticLayers::alloc(_worldnode, _culler);
+    _objectController->setStaticLayers(_staticLayers);
 
     addChild(_gridManager->getGridNode());
 
@@ -205,49 +217,14 @@ bool MovePhaseScene::rebuildLevel(std::vector<std::shared_ptr<Object>>* objects)
  * with your serialization loader, which would process a level file.
  */
 void MovePhaseScene::populate() {
-#pragma mark : Goal door
-    Vec2 goalDoorPos;
-    if (_levelNum == 1) {
-        _goalDoor = _objectController->createGoalDoor(Vec2(47, 4));
-    }
-    else if (_levelNum == 2) {
-        _goalDoor = _objectController->createGoalDoor(Vec2(58, 4));
-    }
-    else if (_levelNum == 3) {
-        _goalDoor = _objectController->createGoalDoor(Vec2(47, 4));
-    }
-    
-
-#pragma mark : Level
-    shared_ptr<LevelModel> level = make_shared<LevelModel>();
-    level->setScale(_scale);
-    std::string key;
-    
-    // Pick the level based on levelNum
-    string levelName;
-    
-    if (_levelNum == 1){
-        levelName = "json/party.json";
-    }
-    else if (_levelNum == 2){
-        levelName = "json/gorges.json";
-    }
-    else if (_levelNum == 3){
-        levelName = "json/wind.json";
-        //
-    }
-    else{
-        CULog("NO LEVEL SET");
-    }
-    
-    vector<shared_ptr<Object>> levelObjs = level->createLevelFromJson(levelName);
-    _gridManager->clear();
     _objectController->setNetworkController(_networkController);
-    for (auto& obj : levelObjs) {
-        _objectController->processLevelObject(obj);
-        _gridManager->addObject(obj);
-        CULog("new object position: (%f, %f)", obj->getPositionInit().x, obj->getPositionInit().y);
+    _objectController->prewarmPools();
+    if (_levelSnapshot && _levelSnapshot->getLevelNum() == _levelNum) {
+        restoreLevel();
+    } else {
+        loadLevel();
     }
+
 #pragma mark : Dude
     std::shared_ptr<scene2::SceneNode> node = scene2::SceneNode::alloc();
     std::shared_ptr<Texture> image = _assets->get<Texture>(PLAYER_TEXTURE);
@@ -306,6 +283,148 @@ void MovePhaseScene::populate() {
     CULog("CHUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUUCCCCCCCCCK");
 }
 
+/**
+ * Loads the level file and records the loaded world into a new snapshot.
+ */
+void MovePhaseScene::loadLevel() {
+    _levelSnapshot = WorldSnapshot::alloc(_levelNum);
+    _objectController->beginSnapshot(_levelSnapshot);
+
+#pragma mark : Goal door
+    if (_levelNum == 1) {
+        _goalDoor = _objectController->createGoalDoor(Vec2(47, 4));
+    }
+    else if (_levelNum == 2) {
+        _goalDoor = _objectController->createGoalDoor(Vec2(58, 4));
+    }
+    else if (_levelNum == 3) {
+        _goalDoor = _objectController->createGoalDoor(Vec2(47, 4));
+    }
+    
+
+#pragma mark : Level
+    shared_ptr<LevelModel> level = make_shared<LevelModel>();
+    level->setScale(_scale);
+    std::string key;
+    
+    // Pick the level based on levelNum
+    string levelName;
+    
+    if (_levelNum == 1){
+        levelName = "json/party.json";
+    }
+    else if (_levelNum == 2){
+        levelName = "json/gorges.json";
+    }
+    else if (_levelNum == 3){
+        levelName = "json/wind.json";
+        //
+    }
+    else{
+        CULog("NO LEVEL SET");
+    }
+    
+    vector<shared_ptr<Object>> levelObjs = level->createLevelFromJson(levelName);
+    _gridManager->clear();
+
+    // Treasures are only spawn points, and the host picks one during populate
+    vector<shared_ptr<Object>> streamed;
+    streamed.reserve(levelObjs.size());
+    for (auto& obj : levelObjs) {
+        if (obj->getJsonKey() == "treasures") {
+            _objectController->processLevelObject(obj);
+            _gridManager->addObject(obj);
+        } else {
+            streamed.push_back(obj);
+        }
+    }
+
+    _levelSnapshot->setLevelObjects(levelObjs);
+    _levelSnapshot->setGoalDoor(_goalDoor);
+    _objectController->suspendSnapshot();
+
+    // Everything else is created over the next frames, nearest the players first
+    std::vector<Vec2> focus;
+    focus.push_back(Vec2(DUDE_POS));
+    focus.push_back(getCamera()->getPosition() / _scale);
+    _levelStreamer = LevelStreamer::alloc(streamed, focus, [this](const std::shared_ptr<Object>& obj) {
+        _objectController->processLevelObject(obj);
+        _gridManager->addObject(obj);
+    });
+}
+
+/**
+ * Creates more of the level objects, within the given time budget.
+ *
+ * @param budget    The time (in seconds) this call may take
+ *
+ * @return true if the start area of the level is ready to play
+ */
+bool MovePhaseScene::streamLevel(float budget) {
+    if (_levelStreamer == nullptr) {
+        return true;
+    }
+
+    _objectController->beginSnapshot(_levelSnapshot);
+    _levelStreamer->step(budget);
+    if (!_levelStreamer->isComplete()) {
+        _objectController->suspendSnapshot();
+        return _levelStreamer->isStartReady();
+    }
+
+    _objectController->endSnapshot();
+    CULog("Level %d loaded (%zu objects)", _levelNum, _levelStreamer->getTotalCount());
+    _levelStreamer = nullptr;
+    return true;
+}
+
+/**
+ * Stops a level that is still streaming in.
+ */
+void MovePhaseScene::cancelLevelStream() {
+    if (_levelStreamer == nullptr) {
+        return;
+    }
+    if (_objectController) {
+        _objectController->suspendSnapshot();
+    }
+    _levelStreamer = nullptr;
+    _levelSnapshot = nullptr;
+}
+
+/**
+ * Puts the level geometry back from the snapshot of the last load.
+ *
+ * This re-adds the existing obstacles and scene nodes to the new world in a
+ * single pass, so "play again" on the same level does not touch the level file.
+ */
+void MovePhaseScene::restoreLevel() {
+    _objectController->restoreSnapshot(_levelSnapshot);
+    _goalDoor = _levelSnapshot->getGoalDoor();
+    std::shared_ptr<GoalDoor> door = std::dynamic_pointer_cast<GoalDoor>(_goalDoor);
+    if (door) {
+        door->reset();
+        door->setAnimating(false);
+        door->setResetting(true);
+    }
+
+    _gridManager->clear();
+    for (auto& obj : _levelSnapshot->getLevelObjects()) {
+        _gridManager->addObject(obj);
+    }
+    CULog("Restored level %d from snapshot (%zu obstacles)", _levelNum, _levelSnapshot->getEntries().size());
+}
+
+/**
+ * Puts every surviving level obstacle back to its post-load transform.
+ */
+void MovePhaseScene::restoreLevelTransforms() {
+    // Transforms are only captured once the level has finished streaming in
+    if (_levelStreamer == nullptr && _levelSnapshot && _levelSnapshot->getLevelNum() == _levelNum) {
+        _levelSnapshot->restoreTransforms();
+    }
+}
+
 
 #pragma mark -
 #pragma mark Gameplay Handling
@@ -315,7 +434,11 @@ void MovePhaseScene::populate() {
  * This method disposes of the world and creates a new one.
  */
 void MovePhaseScene::reset() {
+    cancelLevelStream();
     resetPlayerProperties();
+    if (_objectController) {
+        _objectController->logPoolStats();
+    }
     
     _localPlayer = nullptr;
     _goalDoor = nullptr;
@@ -324,6 +447,12 @@ void MovePhaseScene::reset() {
     
     _levelNum = 0;
 
+    if (_staticLayers) {
+        _staticLayers->clear();
+    }
+    if (_culler) {
+        _culler->clear();
+    }
     _worldnode->removeAllChildren();
     _debugnode->removeAllChildren();
 
@@ -362,6 +491,24 @@ void MovePhaseScene::preUpdate(float dt) {
     _camera->update();
 }
 
+/**
+ * Draws the scene, skipping the world nodes outside the camera view.
+ *
+ * Tiles and still art queued while the level loaded are baked first.
+ *
+ * The build phase draws the level through this scene as well, as both
+ * phases share its camera.
+ */
+void MovePhaseScene::render() {
+    if (_staticLayers) {
+        _staticLayers->update();
+    }
+    if (_culler) {
+        _culler->update();
+    }
+    Scene2::render();
+}
+
 
 #pragma mark -
 #pragma mark Helpers
@@ -441,7 +588,7 @@ void MovePhaseScene::linkSceneToObs(const std::shared_ptr<physics2::Obstacle>& o
 
     _worldnode->addChild(node);
     // Dynamic objects need constant updating
-    if (obj->getBodyType() == b2_dynamicBody) {
+    if (obj->getBodyType() != b2_staticBody) {
         scene2::SceneNode* weak = node.get(); // No need for smart pointer in callback
         obj->setListener([=,this](physics2::Obstacle* obs) {
             float leftover = Application::get()->getFixedRemainder() / 1000000.f;
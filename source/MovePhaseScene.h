@@ -19,6 +19,7 @@
 #include "ObjectController.h"
 #include "MovePhaseScene.h"
 #include "MovePhaseUIScene.h"
+#include "LevelStreamer.h"
 
 using namespace cugl;
 using namespace Constants;
@@ -43,6 +44,10 @@ protected:
     /** The Box2D world */
     std::shared_ptr<cugl::physics2::distrib::NetWorld> _world;
     std::shared_ptr<ObjectController> _objectController;
+    /** The culler that hides world nodes outside the camera view */
+    std::shared_ptr<SceneCuller> _culler;
+    /** The baked layers of tiles and still art */
+    std::shared_ptr<StaticLayers> _staticLayers;
     std::shared_ptr<GridManager> _gridManager;
     /** The network controller */
     std::shared_ptr<NetworkController> _networkController;
@@ -57,6 +62,10 @@ protected:
     std::shared_ptr<scene2::SceneNode> _debugnode;
     /** Reference to the goalDoor (for collision detection) */
     std::shared_ptr<Object>    _goalDoor;
+    /** The world as it was right after the current level was loaded */
+    std::shared_ptr<WorldSnapshot> _levelSnapshot;
+    /** The job creating the level objects (nullptr once the level is loaded) */
+    std::shared_ptr<LevelStreamer> _levelStreamer;
     /** Reference to the local player */
     std::shared_ptr<PlayerModel> _localPlayer;
     /** Reference to the treasure */
@@ -116,8 +125,57 @@ public:
      *
      * This method is really, really long.  In practice, you would replace this
      * with your serialization loader, which would process a level file.
+     *
+     * If a snapshot of the same level was taken the last time it was loaded,
+     * the level geometry is restored from it instead of re-reading the level
+     * file. Players and the treasure are always created fresh.
      */
     void populate();
+
+    /**
+     * Loads the level file and records the loaded world into a new snapshot.
+     */
+    void loadLevel();
+
+    /**
+     * Puts the level geometry back from the snapshot of the last load.
+     */
+    void restoreLevel();
+
+    /**
+     * Puts every surviving level obstacle back to its post-load transform.
+     */
+    void restoreLevelTransforms();
+
+    /**
+     * Creates more of the level objects, within the given time budget.
+     *
+     * Level objects are created over several frames, starting with those
+     * around the spawn and the camera. When the last object is created, the
+     * level snapshot is finished.
+     *
+     * @param budget    The time (in seconds) this call may take
+     *
+     * @return true if the start area of the level is ready to play
+     */
+    bool streamLevel(float budget);
+
+    /**
+     * Stops a level that is still streaming in.
+     *
+     * The partial snapshot is dropped, so the next load reads the level file.
+     */
+    void cancelLevelStream();
+
+    /**
+     * Returns the fraction of the level objects created so far (between 0 and 1).
+     */
+    float getLoadProgress() const { return _levelStreamer ? _levelStreamer->getProgress() : 1.0f; }
+
+    /**
+     * Returns true if every level object has been created.
+     */
+    bool isLevelLoaded() const { return _levelStreamer == nullptr; }
     
     /** Rebuilding a level when a game has already been completed. */
     bool rebuildLevel(std::vector<std::shared_ptr<Object>>* objects);
@@ -138,6 +196,16 @@ public:
      */
     void preUpdate(float dt);
 
+    /**
+     * Draws the scene, skipping the world nodes outside the camera view.
+     *
+     * Tiles and still art queued while the level loaded are baked first.
+     *
+     * The build phase draws the level through this scene as well, as both
+     * phases share its camera.
+     */
+    void render() override;
+
 #pragma mark -
 #pragma mark Attribute Functions
     /**
@@ -165,6 +233,16 @@ public:
      */
     std::shared_ptr<ObjectController> getObjectController() { return _objectController; };
 
+    /**
+     * Gets the culler of the world nodes
+     */
+    std::shared_ptr<SceneCuller> getCuller() { return _culler; };
+
+    /**
+     * Gets the baked layers of tiles and still art
+     */
+    std::shared_ptr<StaticLayers> getStaticLayers() { return _staticLayers; };
+
     /**
      * Gets the local player
      */
@@ -12,6 +12,7 @@ void Mushroom::setPositionInit(const Vec2 &position) {
 void Mushroom::dispose() {
     Object::dispose();
     markRemoved(true);
+    _mushroomAnimator.release();
 }
 
 bool Mushroom::init(const Vec2 pos, const Size size, std::string jsonType) {
@@ -50,7 +51,7 @@ bool Mushroom::init(const Vec2 pos, const Size size, float scale) {
     return true;
 }
 
-void Mushroom::setMushroomAnimation(std::shared_ptr<scene2::SpriteNode> sprite, int nFrames) {
+void Mushroom::setMushroomAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip) {
     _mushroomSpriteNode = sprite;
     _mushroomSpriteNode->setPosition(Vec2());
     _mushroomSpriteNode->setVisible(true);
@@ -62,34 +63,20 @@ void Mushroom::setMushroomAnimation(std::shared_ptr<scene2::SpriteNode> sprite,
     }
     _sceneNode->addChild(_mushroomSpriteNode);
 
-    std::vector<int> frames;
-    frames.reserve(nFrames);
-    for (int i = 1; i < nFrames; ++i) {
-        frames.push_back(i);
-    }
-    frames.push_back(0);
-
-    _mushroomTimeline      = ActionTimeline::alloc();
-    _mushroomAnimateSprite = AnimateSprite::alloc(frames);
-    _mushroomAction        = _mushroomAnimateSprite->attach<scene2::SpriteNode>(_mushroomSpriteNode);
+    _mushroomAnimator.attach(_mushroomSpriteNode, clip);
 }
 
 void Mushroom::updateAnimation(float dt) {
     if (!_shouldAnimate) {
-        _mushroomSpriteNode->setFrame(0);
+        // Only touches the node if the frame changed
+        _mushroomAnimator.show(0);
         return;
     }
 
-    // start action if it’s not already running
-    if (!_mushroomTimeline->isActive("current")) {
-        _mushroomTimeline->add("current", _mushroomAction, 1.0f);
-    }
-    _mushroomTimeline->update(dt);
-
     // only plays one cycle and sets back to frame 0
-    if (!_mushroomTimeline->isActive("current")) {
+    if (!_mushroomAnimator.isPlaying()) {
         _shouldAnimate = false;
-        _mushroomSpriteNode->setFrame(0);
+        _mushroomAnimator.show(0);
     }
 }
 
@@ -13,10 +13,8 @@ private:
     std::shared_ptr<cugl::physics2::PolygonObstacle> _sensor;
 
     // Animations
-    std::shared_ptr<cugl::ActionTimeline>    _mushroomTimeline;
     std::shared_ptr<cugl::scene2::SpriteNode> _mushroomSpriteNode;
-    std::shared_ptr<cugl::AnimateSprite>      _mushroomAnimateSprite;
-    cugl::ActionFunction                      _mushroomAction;
+    Animator                                  _mushroomAnimator;
 
     bool _shouldAnimate = false;
 
@@ -31,13 +29,12 @@ public:
     void update(float timestep) override;
     void dispose() override;
 
-    void setMushroomAnimation(std::shared_ptr<scene2::SpriteNode> sprite, int nFrames);
+    void setMushroomAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip);
     void updateAnimation(float timestep);
 
     void triggerAnimation() { 
-        _mushroomTimeline->remove("current");
         _shouldAnimate = true;
-        _mushroomTimeline->add("current", _mushroomAction, 1.0f);
+        _mushroomAnimator.play(1.0f, false);
     }
     void stopAnimation()    { _shouldAnimate = false; }
 
@@ -52,9 +49,6 @@ public:
         std::shared_ptr<Mushroom> result = std::make_shared<Mushroom>();
         return (result->init(position, size, scale) ? result : nullptr);
     }
-    std::shared_ptr<cugl::ActionTimeline> getTimeline() { return _mushroomTimeline; }
-
-    cugl::ActionFunction getActionFunction() { return _mushroomAction; }
 };
 
 #endif /* __MUSHROOM_H__ */
@@ -11,6 +11,7 @@
 
 #include <ctime>
 #include <string>
+#include <array>
 #include <iostream>
 #include <sstream>
 #include <random>
@@ -55,6 +56,8 @@ bool NetworkController::init(const std::shared_ptr<AssetManager>& assets)
     _network->attachEventType<AnimationEvent>();
     _network->attachEventType<AnimationStateEvent>();
     _network->attachEventType<MushroomBounceEvent>();
+    _network->attachEventType<PlatformTickEvent>();
+    _network->attachEventType<BombEvent>();
     _localID = _network->getShortUID();
     _scoreController = ScoreController::alloc(_assets);
     
@@ -90,6 +93,8 @@ void NetworkController::resetNetwork(){
     _network->attachEventType<AnimationEvent>();
     _network->attachEventType<AnimationStateEvent>();
     _network->attachEventType<MushroomBounceEvent>();
+    _network->attachEventType<PlatformTickEvent>();
+    _network->attachEventType<BombEvent>();
     _localID = _network->getShortUID();
 }
 
@@ -223,6 +228,16 @@ void NetworkController::fixedUpdate(float step){
         if(auto mbEvent = std::dynamic_pointer_cast<MushroomBounceEvent>(e)){
             processMushroomBounceEvent(mbEvent);
         }
+
+        // Check for PlatformTickEvent
+        if(auto ptEvent = std::dynamic_pointer_cast<PlatformTickEvent>(e)){
+            processPlatformTickEvent(ptEvent);
+        }
+
+        // Check for BombEvent
+        if(auto bEvent = std::dynamic_pointer_cast<BombEvent>(e)){
+            processBombEvent(bEvent);
+        }
         
         CULog("No event matched");
 
@@ -290,6 +305,10 @@ void NetworkController::reset(){
     _usedSpawns.clear();
     
     _playerList.clear();
+    
+    _hasHostPlatformTick = false;
+    _platformPhaseStamp = 0;
+    _fixedMath = false;
 }
 
 
@@ -369,6 +388,12 @@ void NetworkController::processMessageEvent(const std::shared_ptr<MessageEvent>&
             CULog("Reset received");
             _resetLevel = true;
             break;
+        case Message::FIXED_MATH_ON:
+            _fixedMath = true;
+            break;
+        case Message::FIXED_MATH_OFF:
+            _fixedMath = false;
+            break;
         case Message::HOST_PICK:
             CULog("Host picked message received by client");
             _levelSelected = 1;
@@ -475,6 +500,98 @@ void NetworkController::processAnimationStateEvent(const std::shared_ptr<Animati
     }
 }
 
+/**
+ * This method takes a PlatformTickEvent and processes it.
+ */
+void NetworkController::processPlatformTickEvent(const std::shared_ptr<PlatformTickEvent>& event) {
+    // The host started the movement phase of this tick at (stamp - tick)
+    if (_isHost || event->getEventTimeStamp() < _platformPhaseStamp + event->getTick()) {
+        return;
+    }
+    _hostPlatformTick = event->getTick();
+    _hostPlatformStamp = event->getEventTimeStamp();
+    _hasHostPlatformTick = true;
+}
+
+/**
+ * This method takes a BombEvent and processes it.
+ *
+ * The bomb is one that exploded on this client too, so it is waiting in the
+ * pool with its body still in the world.
+ */
+void NetworkController::processBombEvent(const std::shared_ptr<BombEvent>& event) {
+    if (_bombPool == nullptr) {
+        return;
+    }
+    Uint64 serial = event->getSerial();
+    std::shared_ptr<Bomb> bomb = _bombPool->findFree([serial](const std::shared_ptr<Bomb>& bomb) {
+        return bomb->getSerial() == serial && bomb->isInWorld();
+    });
+    if (bomb == nullptr || !_bombPool->claim(bomb)) {
+        CULogError("No retired bomb %llx to put back in play", (unsigned long long)serial);
+        return;
+    }
+    bomb->reuse(event->getPosition(), event->getSize());
+}
+
+/**
+ * Sends the moving platform tick of the host to the other clients.
+ *
+ * @param tick  The platform tick of this (host) client
+ */
+void NetworkController::sendPlatformTick(Uint64 tick) {
+    _network->pushOutEvent(PlatformTickEvent::allocPlatformTickEvent(tick));
+}
+
+/**
+ * Sets whether player movement runs in fixed point on every client.
+ *
+ * Only the host decides this, so that every client steps the players with
+ * the same math.
+ *
+ * @param value whether to use fixed-point movement math
+ */
+void NetworkController::sendFixedMath(bool value) {
+    if (!_isHost) {
+        return;
+    }
+    _fixedMath = value;
+    _network->pushOutEvent(MessageEvent::allocMessageEvent(value ? Message::FIXED_MATH_ON : Message::FIXED_MATH_OFF));
+}
+
+/**
+ * Drops the host platform ticks of the last movement phase.
+ *
+ * This is called when the building phase starts. A tick whose movement
+ * phase started before then is from the last round, and is dropped even if
+ * it arrives later. A tick of the next movement phase is kept, even if it
+ * arrives before this client starts that phase.
+ */
+void NetworkController::clearHostPlatformTick() {
+    _platformPhaseStamp = _network->getGameTick();
+    _hasHostPlatformTick = false;
+}
+
+/**
+ * Returns the host's moving platform tick, if a new one arrived.
+ *
+ * The tick is advanced by the game ticks that passed since the host sent
+ * it, so it is the host's tick now.
+ *
+ * @param tick  Set to the host's platform tick
+ *
+ * @return true if a tick arrived since the last call
+ */
+bool NetworkController::popHostPlatformTick(Uint64& tick) {
+    if (!_hasHostPlatformTick) {
+        return false;
+    }
+    _hasHostPlatformTick = false;
+    Uint64 now = _network->getGameTick();
+    tick = _hostPlatformTick + (now > _hostPlatformStamp ? now - _hostPlatformStamp : 0);
+    return true;
+}
+
 void NetworkController::processMushroomBounceEvent(const std::shared_ptr<MushroomBounceEvent>& event) {
     CULog("entering here");
     Vec2 pos = event->getPosition();
@@ -487,7 +604,6 @@ void NetworkController::processMushroomBounceEvent(const std::shared_ptr<Mushroo
             CULog("Checking Mushroom at (%.2f,%.2f)", mushPos.x, mushPos.y);
             if (mushPos == pos) {
                 CULog("processing mushroom bounce");
-                mush->getTimeline()->add("current", mush->getActionFunction(), 1.0f);
                 mush->triggerAnimation();
                 break;
             }
@@ -585,8 +701,8 @@ std::shared_ptr<Object> NetworkController::createMushroomNetworked(Vec2 pos, Siz
     auto pair = _network->getPhysController()->addSharedObstacle(_mushroomFactID, params);
     std::shared_ptr<Mushroom> mushroom = std::dynamic_pointer_cast<Mushroom>(pair.first);
     
-    auto animNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(MUSHROOM_BOUNCE), 1, 9, 9);
-    mushroom->setMushroomAnimation(animNode, 9);
+    auto clip = AnimationClips::get(MUSHROOM_BOUNCE, 1, 9, 9);
+    mushroom->setMushroomAnimation(clip->allocNode(_assets), clip);
 
     _objects->push_back(mushroom);
     return mushroom;
@@ -610,7 +726,22 @@ std::shared_ptr<Object> NetworkController::createWindNetworked(Vec2 pos, Size si
 }
 
 std::shared_ptr<Object> NetworkController::createBombNetworked(Vec2 pos, Size size) {
-    auto params = _bombFact->serializeParams(pos, size);
+    // Only this client puts its own bombs back in play, so two never take the same one
+    Uint64 owner = _network->getShortUID();
+    if (_bombPool) {
+        std::shared_ptr<Bomb> bomb = _bombPool->findFree([owner](const std::shared_ptr<Bomb>& bomb) {
+            return bomb->getSerial() != 0 && (bomb->getSerial() >> 32) == owner && bomb->isInWorld();
+        });
+        if (bomb && _bombPool->claim(bomb)) {
+            bomb->reuse(pos, size);
+            _network->pushOutEvent(BombEvent::allocBombEvent(bomb->getSerial(), pos, size));
+            _objects->push_back(bomb);
+            return bomb;
+        }
+    }
+
+    Uint64 serial = (owner << 32) | ++_bombSerial;
+    auto params = _bombFact->serializeParams(pos, size, serial);
     auto pair = _network->getPhysController()->addSharedObstacle(_bombFactID, params);
     std::shared_ptr<Bomb> bomb = std::dynamic_pointer_cast<Bomb>(pair.first);
     _objects->push_back(bomb);
@@ -706,6 +837,7 @@ void NetworkController::setWorld(const std::shared_ptr<cugl::physics2::distrib::
     _windFactID = _network->getPhysController()->attachFactory(_windFact);
 
     _bombFact = BombFactory::alloc(_assets);
+    _bombFact->setPool(_bombPool);
     _bombFactID = _network->getPhysController()->attachFactory(_bombFact);
 }
 
@@ -775,6 +907,18 @@ void NetworkController::trySetFilters(){
 #pragma mark -
 #pragma mark Dude Factory
 
+/** The idle, walk, glide, jump and death sheets of each player color */
+static const std::map<ColorType, std::array<std::string, 5>> PLAYER_SHEETS = {
+    { ColorType::RED,    { PLAYER_RED_IDLE_TEXTURE, PLAYER_RED_WALK_TEXTURE, PLAYER_RED_GLIDE_TEXTURE,
+                           PLAYER_RED_JUMP_TEXTURE, PLAYER_RED_DEATH_TEXTURE } },
+    { ColorType::BLUE,   { PLAYER_BLUE_IDLE_TEXTURE, PLAYER_BLUE_WALK_TEXTURE, PLAYER_BLUE_GLIDE_TEXTURE,
+                           PLAYER_BLUE_JUMP_TEXTURE, PLAYER_BLUE_DEATH_TEXTURE } },
+    { ColorType::GREEN,  { PLAYER_GREEN_IDLE_TEXTURE, PLAYER_GREEN_WALK_TEXTURE, PLAYER_GREEN_GLIDE_TEXTURE,
+                           PLAYER_GREEN_JUMP_TEXTURE, PLAYER_GREEN_DEATH_TEXTURE } },
+    { ColorType::YELLOW, { PLAYER_YELLOW_IDLE_TEXTURE, PLAYER_YELLOW_WALK_TEXTURE, PLAYER_YELLOW_GLIDE_TEXTURE,
+                           PLAYER_YELLOW_JUMP_TEXTURE, PLAYER_YELLOW_DEATH_TEXTURE } }
+};
+
 /**
  * Generate a pair of Obstacle and SceneNode using the given parameters
  */
@@ -786,71 +930,24 @@ std::pair<std::shared_ptr<physics2::Obstacle>, std::shared_ptr<scene2::SceneNode
     player->setShared(true);
     player->setDebugColor(DEBUG_COLOR);
     
-    if (color == ColorType::RED){
-        auto idleSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_RED_IDLE_TEXTURE), 1, 7, 7);
-        player->setIdleAnimation(idleSpriteNode, 7);
-
-        auto walkSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_RED_WALK_TEXTURE), 1, 3, 3);
-        player->setWalkAnimation(walkSpriteNode, 3);
-
-        auto glideSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_RED_GLIDE_TEXTURE), 1, 4, 4);
-        player->setGlideAnimation(glideSpriteNode, 4);
-
-        auto jumpSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_RED_JUMP_TEXTURE), 1, 5, 5);
-        player->setJumpAnimation(jumpSpriteNode, 5);
-
-        auto deathSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_RED_DEATH_TEXTURE), 1, 4, 4);
-        player->setDeathAnimation(deathSpriteNode, 4);
-    }
-    else if (color == ColorType::BLUE){
-        auto idleSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_BLUE_IDLE_TEXTURE), 1, 7, 7);
-        player->setIdleAnimation(idleSpriteNode, 7);
+    auto sheets = PLAYER_SHEETS.find(color);
+    if (sheets != PLAYER_SHEETS.end()) {
+        const std::array<std::string, 5>& sheet = sheets->second;
+        auto idle = AnimationClips::get(sheet[0], 1, 7, 7);
+        player->setIdleAnimation(idle->allocNode(_assets), idle);
 
-        auto walkSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_BLUE_WALK_TEXTURE), 1, 3, 3);
-        player->setWalkAnimation(walkSpriteNode, 3);
+        auto walk = AnimationClips::get(sheet[1], 1, 3, 3);
+        player->setWalkAnimation(walk->allocNode(_assets), walk);
 
-        auto glideSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_BLUE_GLIDE_TEXTURE), 1, 4, 4);
-        player->setGlideAnimation(glideSpriteNode, 4);
+        auto glide = AnimationClips::get(sheet[2], 1, 4, 4);
+        player->setGlideAnimation(glide->allocNode(_assets), glide);
 
-        auto jumpSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_BLUE_JUMP_TEXTURE), 1, 5, 5);
-        player->setJumpAnimation(jumpSpriteNode, 5);
+        auto jump = AnimationClips::get(sheet[3], 1, 5, 5, AnimationClip::Playback::FORWARD);
+        player->setJumpAnimation(jump->allocNode(_assets), jump);
 
-        auto deathSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_BLUE_DEATH_TEXTURE), 1, 4, 4);
-        player->setDeathAnimation(deathSpriteNode, 4);
+        auto death = AnimationClips::get(sheet[4], 1, 4, 4, AnimationClip::Playback::SKIP_FIRST);
+        player->setDeathAnimation(death->allocNode(_assets), death);
     }
-    else if (color == ColorType::GREEN){
-        auto idleSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_GREEN_IDLE_TEXTURE), 1, 7, 7);
-        player->setIdleAnimation(idleSpriteNode, 7);
-
-        auto walkSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_GREEN_WALK_TEXTURE), 1, 3, 3);
-        player->setWalkAnimation(walkSpriteNode, 3);
-
-        auto glideSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_GREEN_GLIDE_TEXTURE), 1, 4, 4);
-        player->setGlideAnimation(glideSpriteNode, 4);
-
-        auto jumpSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_GREEN_JUMP_TEXTURE), 1, 5, 5);
-        player->setJumpAnimation(jumpSpriteNode, 5);
-
-        auto deathSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_GREEN_DEATH_TEXTURE), 1, 4, 4);
-        player->setDeathAnimation(deathSpriteNode, 4);
-    }
-    else if (color == ColorType::YELLOW){
-        auto idleSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_YELLOW_IDLE_TEXTURE), 1, 7, 7);
-        player->setIdleAnimation(idleSpriteNode, 7);
-
-        auto walkSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_YELLOW_WALK_TEXTURE), 1, 3, 3);
-        player->setWalkAnimation(walkSpriteNode, 3);
-
-        auto glideSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_YELLOW_GLIDE_TEXTURE), 1, 4, 4);
-        player->setGlideAnimation(glideSpriteNode, 4);
-
-        auto jumpSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_YELLOW_JUMP_TEXTURE), 1, 5, 5);
-        player->setJumpAnimation(jumpSpriteNode, 5);
-
-        auto deathSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(PLAYER_YELLOW_DEATH_TEXTURE), 1, 4, 4);
-        player->setDeathAnimation(deathSpriteNode, 4);
-    }
-    
     
     return std::make_pair(player, player->getSceneNode());
 }
@@ -972,11 +1069,12 @@ std::pair<std::shared_ptr<physics2::Obstacle>, std::shared_ptr<scene2::SceneNode
     
     std::shared_ptr<Platform> movPlat = Platform::allocMoving(pos, size, pos, end, speed);
 
-    auto animNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(GLIDING_LOG_ANIMATED), 1, 15, 15);
+    auto clip = AnimationClips::get(GLIDING_LOG_ANIMATED, 1, 15, 15);
+    auto animNode = clip->allocNode(_assets);
     animNode->setAnchor(Vec2::ANCHOR_CENTER);
-    movPlat->setPlatformAnimation(animNode, 15);
+    movPlat->setPlatformAnimation(animNode, clip);
     
-    movPlat->setBodyType(b2_dynamicBody);   // Must be dynamic for position to update
+    movPlat->setBodyType(b2_kinematicBody);   // Position comes from the path, see Platform::updatePath
     movPlat->setDensity(BASIC_DENSITY);
     movPlat->setFriction(BASIC_FRICTION);
     movPlat->setRestitution(BASIC_RESTITUTION);
@@ -1038,8 +1136,8 @@ TreasureFactory::createObstacle(Vec2 pos, Size size, float scale, bool taken) {
     std::shared_ptr<Texture> image = _assets->get<Texture>("treasure");
     auto treasure = Treasure::alloc(pos, image->getSize() / scale, scale);
     
-    auto animNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>("treasure-sheet"), 1, 32, 32);
-    treasure->setAnimation(animNode);
+    auto clip = AnimationClips::get("treasure-sheet", 1, 32, 32);
+    treasure->setAnimation(clip->allocNode(_assets), clip);
 
     treasure->setName("treasure");
     treasure->setDebugColor(Color4::YELLOW);
@@ -1112,10 +1210,8 @@ std::pair<std::shared_ptr<physics2::Obstacle>, std::shared_ptr<scene2::SceneNode
 MushroomFactory::createObstacle(Vec2 pos, Size size, float scale) {
     
     auto mush = Mushroom::alloc(pos, size, scale);
-    auto animNode = scene2::SpriteNode::allocWithSheet(
-        _assets->get<Texture>(MUSHROOM_BOUNCE), 1, 9, 9
-    );
-    mush->setMushroomAnimation(animNode, 9);
+    auto clip = AnimationClips::get(MUSHROOM_BOUNCE, 1, 9, 9);
+    mush->setMushroomAnimation(clip->allocNode(_assets), clip);
     
     mush->setDensity(BASIC_DENSITY);
     mush->setFriction(BASIC_FRICTION);
@@ -1208,7 +1304,9 @@ ThornFactory::createObstacle(const std::vector<std::byte>& params) {
     float height = _deserializer.readFloat();
     Size size(width, height);
 
-    return createObstacle(pos, size);
+    Uint64 serial = _deserializer.readUint64();
+
+    return createObstacle(pos, size, serial);
 }
 
 
@@ -1221,20 +1319,20 @@ WindFactory::createObstacle(Vec2 pos, Size size,float scale, const Vec2 windDire
     std::shared_ptr<WindObstacle> wind = WindObstacle::alloc(pos, size, scale, windDirection, windStrength, angle);
     wind->setName("fan");
 
-    auto animNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(FAN_TEXTURE_ANIMATED), 1, 4, 4);
-    wind->setFanAnimation(animNode, 4);
-    auto animNode1 = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(WIND_LVL_1), 1, 14, 14);
-    auto animNode2 = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(WIND_LVL_2), 1, 14, 14);
-    auto animNode3 = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(WIND_LVL_3), 1, 14, 14);
-    auto animNode4 = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(WIND_LVL_4), 1, 14, 14);
+    auto fan = AnimationClips::get(FAN_TEXTURE_ANIMATED, 1, 4, 4);
+    wind->setFanAnimation(fan->allocNode(_assets), fan);
+    std::vector<std::shared_ptr<AnimationClip>> clips = {
+        AnimationClips::get(WIND_LVL_1, 1, 14, 14),
+        AnimationClips::get(WIND_LVL_2, 1, 14, 14),
+        AnimationClips::get(WIND_LVL_3, 1, 14, 14),
+        AnimationClips::get(WIND_LVL_4, 1, 14, 14)
+    };
     std::vector<std::shared_ptr<scene2::SpriteNode>> gusts;
+    for (auto& clip : clips) {
+        gusts.push_back(clip->allocNode(_assets));
+    }
 
-    gusts.push_back(animNode1);
-    gusts.push_back(animNode2);
-    gusts.push_back(animNode3);
-    gusts.push_back(animNode4);
-
-    wind->setGustAnimation(gusts, 14);
+    wind->setGustAnimation(gusts, clips);
 //    wind->setPositionInit(pos);
 
     return std::make_pair(wind, wind->getSceneNode());
@@ -1290,10 +1388,24 @@ WindFactory::createObstacle(const std::vector<std::byte>& params) {
 #pragma mark Bomb Factory
 
 std::pair<std::shared_ptr<physics2::Obstacle>, std::shared_ptr<scene2::SceneNode>>
-BombFactory::createObstacle(Vec2 pos, Size size) {
+BombFactory::createObstacle(Vec2 pos, Size size, Uint64 serial) {
+    if (_pool) {
+        // The shared obstacle is added to the world, so it must not be in it yet
+        std::shared_ptr<Bomb> bomb = _pool->obtain([](const std::shared_ptr<Bomb>& bomb) {
+            return !bomb->isInWorld();
+        });
+        if (bomb) {
+            bomb->reuse(pos, size);
+            bomb->setSerial(serial);
+            bomb->setShared(true);
+            return std::make_pair(bomb, bomb->getSceneNode());
+        }
+    }
+
     std::shared_ptr<Texture> texture = _assets->get<Texture>(BOMB_TEXTURE);
 
     std::shared_ptr<Bomb> bomb = Bomb::alloc(pos, size);
+    bomb->setSerial(serial);
 
     bomb->setBodyType(b2_dynamicBody);
     bomb->setDensity(BASIC_DENSITY);
@@ -1303,20 +1415,21 @@ BombFactory::createObstacle(Vec2 pos, Size size) {
     bomb->setDebugColor(DEBUG_COLOR);
     bomb->setShared(true);
 
-    auto animNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(BOMB_TEXTURE_ANIMATED), 1, 14, 14);
-    bomb->setAnimation(animNode);
+    auto clip = AnimationClips::get(BOMB_TEXTURE_ANIMATED, 1, 14, 14, AnimationClip::Playback::FORWARD);
+    bomb->setAnimation(clip->allocNode(_assets), clip);
 
     return std::make_pair(bomb, bomb->getSceneNode());
 }
 
 
 std::shared_ptr<std::vector<std::byte>>
-BombFactory::serializeParams(Vec2 pos, Size size) {
+BombFactory::serializeParams(Vec2 pos, Size size, Uint64 serial) {
     _serializer.reset();
     _serializer.writeFloat(pos.x);
     _serializer.writeFloat(pos.y);
     _serializer.writeFloat(size.width);
     _serializer.writeFloat(size.height);
+    _serializer.writeUint64(serial);
 
     return std::make_shared<std::vector<std::byte>>(_serializer.serialize());
 }
@@ -1334,5 +1447,7 @@ BombFactory::createObstacle(const std::vector<std::byte>& params) {
     float height = _deserializer.readFloat();
     Size size(width, height);
 
-    return createObstacle(pos, size);
+    Uint64 serial = _deserializer.readUint64();
+
+    return createObstacle(pos, size, serial);
 }
@@ -22,12 +22,15 @@
 #include "TreasureEvent.h"
 #include "AnimationEvent.h"
 #include "AnimationStateEvent.h"
+#include "PlatformTickEvent.h"
+#include "BombEvent.h"
 #include "ScoreController.h"
 #include "Treasure.h"
 #include "Mushroom.h"
 #include "WindObstacle.h"
 #include "Thorn.h"
 #include "Bomb.h"
+#include "ObjectPool.h"
 #include "Message.h"
 
 using namespace cugl;
@@ -345,6 +348,10 @@ class WindFactory : public ObstacleFactory {
  * The factory class for bomb objects.
  */
 class BombFactory : public ObstacleFactory {
+private:
+    /** The pool to draw bombs from (bombs are allocated directly if this is null) */
+    std::shared_ptr<ObjectPool<Bomb>> _pool;
+
 public:
     std::shared_ptr<AssetManager> _assets;
     LWSerializer _serializer;
@@ -360,9 +367,22 @@ public:
         _assets = assets;
     }
 
-    std::pair<std::shared_ptr<physics2::Obstacle>, std::shared_ptr<scene2::SceneNode>> createObstacle(Vec2 pos, Size size);
+    /** Returns the pool to draw bombs from (null if bombs are allocated directly) */
+    const std::shared_ptr<ObjectPool<Bomb>>& getPool() const { return _pool; }
+
+    /**
+     * Sets the pool to draw bombs from.
+     *
+     * Only bombs that are not in the world are drawn from it. A retired bomb
+     * that is still in the world is put back in play with a {@link BombEvent}.
+     *
+     * @param pool  the bomb pool, or nullptr to allocate bombs directly
+     */
+    void setPool(const std::shared_ptr<ObjectPool<Bomb>>& pool) { _pool = pool; }
+
+    std::pair<std::shared_ptr<physics2::Obstacle>, std::shared_ptr<scene2::SceneNode>> createObstacle(Vec2 pos, Size size, Uint64 serial);
 
-    std::shared_ptr<std::vector<std::byte>> serializeParams(Vec2 pos, Size size);
+    std::shared_ptr<std::vector<std::byte>> serializeParams(Vec2 pos, Size size, Uint64 serial);
 
     std::pair<std::shared_ptr<physics2::Obstacle>, std::shared_ptr<scene2::SceneNode>> createObstacle(const std::vector<std::byte>& params) override;
 };
@@ -388,6 +408,17 @@ protected:
     
     /** The network controller */
     std::shared_ptr<NetEventController> _network;
+
+    /** The host's moving platform tick from the last PlatformTickEvent */
+    Uint64 _hostPlatformTick = 0;
+    /** The game tick when the last PlatformTickEvent was sent */
+    Uint64 _hostPlatformStamp = 0;
+    /** Whether a PlatformTickEvent arrived that was not applied yet */
+    bool _hasHostPlatformTick = false;
+    /** The game tick when the last building phase started */
+    Uint64 _platformPhaseStamp = 0;
+    /** Whether player movement runs in fixed point (set by the host) */
+    bool _fixedMath = false;
     
     /** The treasure */
     std::shared_ptr<Treasure> _treasure; 
@@ -488,6 +519,10 @@ protected:
     /** Variables for Bomb Factory */
     std::shared_ptr<BombFactory> _bombFact;
     Uint32 _bombFactID;
+    /** The pool of bombs used by the bomb factory */
+    std::shared_ptr<ObjectPool<Bomb>> _bombPool;
+    /** The number of networked bombs this client has created */
+    Uint32 _bombSerial = 0;
 
 public:
 #pragma mark -
@@ -570,6 +605,18 @@ public:
     void setObjects(std::vector<std::shared_ptr<Object>>* objects){
         _objects = objects;
     }
+
+    /**
+     * Sets the pool that networked bombs are drawn from.
+     *
+     * @param pool  the bomb pool, or nullptr to allocate bombs directly
+     */
+    void setBombPool(const std::shared_ptr<ObjectPool<Bomb>>& pool) {
+        _bombPool = pool;
+        if (_bombFact) {
+            _bombFact->setPool(pool);
+        }
+    }
     
     /**
      * Sets the networked treasure
@@ -683,7 +730,14 @@ public:
     ColorType getPlayerColor(int ID){
         return _playerColorsById[ID];
     }
-    
+
+    /**
+     * Returns the color of every player, by their shortUID
+     */
+    const std::unordered_map<int, ColorType>& getPlayerColors(){
+        return _playerColorsById;
+    }
+
     /**
      * Returns the color of the local player.
      */
@@ -843,6 +897,58 @@ public:
      * This method takes a MushroomBounceEvent and processes it.
      */
     void processMushroomBounceEvent(const std::shared_ptr<MushroomBounceEvent>& event);
+
+    /**
+     * This method takes a PlatformTickEvent and processes it.
+     */
+    void processPlatformTickEvent(const std::shared_ptr<PlatformTickEvent>& event);
+
+    /**
+     * This method takes a BombEvent and processes it.
+     */
+    void processBombEvent(const std::shared_ptr<BombEvent>& event);
+
+    /**
+     * Sends the moving platform tick of the host to the other clients.
+     *
+     * @param tick  The platform tick of this (host) client
+     */
+    void sendPlatformTick(Uint64 tick);
+
+    /**
+     * Returns the host's moving platform tick, if a new one arrived.
+     *
+     * The tick is advanced by the game ticks that passed since the host sent
+     * it, so it is the host's tick now.
+     *
+     * @param tick  Set to the host's platform tick
+     *
+     * @return true if a tick arrived since the last call
+     */
+    bool popHostPlatformTick(Uint64& tick);
+
+    /**
+     * Sets whether player movement runs in fixed point on every client.
+     *
+     * Only the host decides this, so that every client steps the players with
+     * the same math.
+     *
+     * @param value whether to use fixed-point movement math
+     */
+    void sendFixedMath(bool value);
+
+    /** Returns whether player movement runs in fixed point (as set by the host) */
+    bool getFixedMath() const { return _fixedMath; }
+
+    /**
+     * Drops the host platform ticks of the last movement phase.
+     *
+     * This is called when the building phase starts. A tick whose movement
+     * phase started before then is from the last round, and is dropped even if
+     * it arrives later. A tick of the next movement phase is kept, even if it
+     * arrives before this client starts that phase.
+     */
+    void clearHostPlatformTick();
     
 #pragma mark -
 #pragma mark Create Networked Objects
@@ -903,6 +1009,9 @@ public:
     /**
      * Creates a networked bomb.
      *
+     * A bomb this client placed before that has exploded still has its body
+     * in the world of every client, so it is put back in play instead.
+     *
      * @return the bomb being created
      */
     std::shared_ptr<Object> createBombNetworked(Vec2 pos, Size size);
@@ -1,5 +1,6 @@
 #include "Object.h"
 #include "Constants.h"
+#include <cstring>
 
 using namespace cugl;
 using namespace cugl::graphics;
@@ -73,6 +74,66 @@ std::string Object::getJsonKey() {
 	return "objects";
 }
 
+/**
+ * Fills in the level record of this object.
+ *
+ * @param record	The record to fill in
+ *
+ * @return true if this object is saved in levels
+ */
+bool Object::getRecord(LevelRecord& record) {
+	LevelRecordKind kind;
+	if (!levelRecordKindFromKey(getJsonKey(), kind)) {
+		return false;
+	}
+	uint8_t* base = reinterpret_cast<uint8_t*>(&record);
+	uint32_t fields = levelKindFields(kind);
+	for (const LevelFieldInfo& info : LEVEL_FIELDS) {
+		if (!(fields & info.field)) {
+			continue;
+		}
+		double value = 0;
+		if (!getLevelField(info.field, value)) {
+			CUAssertLog(false, "%s have no value for \"%s\"", levelRecordKindKey(kind), info.name);
+		}
+		if (info.integer) {
+			int32_t number = (int32_t)value;
+			memcpy(base + info.offset, &number, sizeof(int32_t));
+		} else {
+			float number = (float)value;
+			memcpy(base + info.offset, &number, sizeof(float));
+		}
+	}
+	return true;
+}
+
+/**
+ * Returns the value of a level field of this object.
+ *
+ * @param field	The field
+ * @param value	The value of the field
+ *
+ * @return true if this object has the field
+ */
+bool Object::getLevelField(LevelField field, double& value) const {
+	switch (field) {
+	case FIELD_X:
+		value = _position.x;
+		return true;
+	case FIELD_Y:
+		value = _position.y;
+		return true;
+	case FIELD_WIDTH:
+		value = _size.getIWidth();
+		return true;
+	case FIELD_HEIGHT:
+		value = _size.getIHeight();
+		return true;
+	default:
+		return false;
+	}
+}
+
 void Object::draw(const std::shared_ptr<cugl::graphics::SpriteBatch>& batch,
 	cugl::Size size) {
 
@@ -87,14 +148,6 @@ void Object::draw(const std::shared_ptr<cugl::graphics::SpriteBatch>& batch,
 		ALSO, if you use a string literal as a VALUE (keys seem to be fine), you should cast it to an std::string.
 		It will become a boolean in the JSON somehow if you don't.
 */
-std::map<std::string, std::any> Object::getMap() {
-	std::map<std::string, std::any> m = {
-		{"x", double(_position.x)},
-		{"y", double(_position.y)}
-	};
-	return m;
-}
-
 bool operator==(Object self, Object other) {
 	return self.getPositionInit() == other.getPositionInit() && self.getSize() == other.getSize();
 }
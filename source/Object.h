@@ -1,8 +1,9 @@
 #ifndef __OBJECT_H__
 #define __OBJECT_H__
 #include <cugl/cugl.h>
-#include <any>
 #include "Constants.h"
+#include "LevelBinary.h"
+#include "AnimationSystem.h"
 
 using namespace cugl;
 using namespace Constants;
@@ -153,7 +154,33 @@ public:
 	void draw(const std::shared_ptr<cugl::graphics::SpriteBatch>& batch,
 		cugl::Size size);
 
-	virtual std::map<std::string, std::any> getMap();
+	/**
+	 * Fills in the level record of this object.
+	 *
+	 * The record is filled from LEVEL_FIELDS: every field in the schema of the
+	 * object's kind (see LEVEL_KIND_FIELDS) is read with {@link #getLevelField},
+	 * so the saved fields always match the ones that are loaded. Objects that
+	 * are not saved in levels leave the record alone.
+	 *
+	 * @param record	The record to fill in
+	 *
+	 * @return true if this object is saved in levels
+	 */
+	bool getRecord(LevelRecord& record);
+
+	/**
+	 * Returns the value of a level field of this object.
+	 *
+	 * This covers the fields every level object saves (FIELDS_BOX). Objects
+	 * with more fields in their schema override this, and call it for the
+	 * rest. Integer fields are returned as whole numbers.
+	 *
+	 * @param field	The field
+	 * @param value	The value of the field
+	 *
+	 * @return true if this object has the field
+	 */
+	virtual bool getLevelField(LevelField field, double& value) const;
 
 	friend bool operator==(Object self, Object other);
 
@@ -64,7 +64,7 @@ std::shared_ptr<Object> ObjectController::createTile(Vec2 pos, Size size, string
 
 std::shared_ptr<Object> ObjectController::createTile(std::shared_ptr<Tile> tile) {
     std::shared_ptr<Texture> image;
-    image = _assets->get<Texture>(jsonTypeToAsset[tile->getJsonType()]);
+    image = _assets->get<Texture>(std::string(jsonTypeToAsset(tile->getJsonType())));
 
     // Set the physics attributes
     tile->setBodyType(b2_dynamicBody);   // Must be dynamic for position to update
@@ -152,8 +152,8 @@ std::shared_ptr<Object> ObjectController::createMovingPlatform(shared_ptr<Platfo
     std::shared_ptr<Texture> image = _assets->get<Texture>(GLIDING_LOG_TEXTURE);
     std::shared_ptr<scene2::SpriteNode> glidingPlatSprite = scene2::SpriteNode::allocWithSheet(image, 1, 1);
 
-    auto animNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(GLIDING_LOG_ANIMATED), 1, 15, 15);
-    plat->setPlatformAnimation(animNode, 15);
+    auto clip = AnimationClips::get(GLIDING_LOG_ANIMATED, 1, 15, 15);
+    plat->setPlatformAnimation(clip->allocNode(_assets), clip);
 
     // Removes the black lines that display from wrapping
     float blendingOffset = 0.01f;
@@ -196,9 +196,9 @@ std::shared_ptr<Object> ObjectController::createSpike(Vec2 pos, Size size, float
 
 std::shared_ptr<Object> ObjectController::createSpike(std::shared_ptr<Spike> spk)
 {
-    std::shared_ptr<Texture> image = _assets->get<Texture>(jsonTypeToAsset[spk->getJsonType()]);
+    std::shared_ptr<Texture> image = _assets->get<Texture>(std::string(jsonTypeToAsset(spk->getJsonType())));
     std::string temp2 = spk->getJsonType();
-    std::string temp = jsonTypeToAsset[spk->getJsonType()];
+    std::string temp = std::string(jsonTypeToAsset(spk->getJsonType()));
 
     // Set the physics attributes
     spk->setBodyType(b2_staticBody);
@@ -237,20 +237,20 @@ std::shared_ptr<Object> ObjectController::createWindObstacle(std::shared_ptr<Win
     std::shared_ptr<scene2::SpriteNode> animNode;
 
     if (!isLevelEditorMode) {
-        auto animNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(FAN_TEXTURE_ANIMATED), 1, 4, 4);
-        wind->setFanAnimation(animNode, 4);
-        auto animNode1 = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(WIND_LVL_1), 1, 14, 14);
-        auto animNode2 = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(WIND_LVL_2), 1, 14, 14);
-        auto animNode3 = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(WIND_LVL_3), 1, 14, 14);
-        auto animNode4 = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(WIND_LVL_4), 1, 14, 14);
+        auto fan = AnimationClips::get(FAN_TEXTURE_ANIMATED, 1, 4, 4);
+        wind->setFanAnimation(fan->allocNode(_assets), fan);
+        std::vector<std::shared_ptr<AnimationClip>> clips = {
+            AnimationClips::get(WIND_LVL_1, 1, 14, 14),
+            AnimationClips::get(WIND_LVL_2, 1, 14, 14),
+            AnimationClips::get(WIND_LVL_3, 1, 14, 14),
+            AnimationClips::get(WIND_LVL_4, 1, 14, 14)
+        };
         std::vector<std::shared_ptr<scene2::SpriteNode>> gusts;
+        for (auto& clip : clips) {
+            gusts.push_back(clip->allocNode(_assets));
+        }
 
-        gusts.push_back(animNode1);
-        gusts.push_back(animNode2);
-        gusts.push_back(animNode3);
-        gusts.push_back(animNode4);
-
-        wind->setGustAnimation(gusts, 14);
+        wind->setGustAnimation(gusts, clips);
         wind->setPositionInit(wind->getPosition());
         wind->setName("fan");
     }
@@ -281,10 +281,8 @@ std::shared_ptr<Object> ObjectController::createMushroom(Vec2 pos, Size size, fl
 }
 
 std::shared_ptr<Object> ObjectController::createMushroom(std::shared_ptr<Mushroom> mush, bool isLevelEditorMode) {
-    auto animNode = scene2::SpriteNode::allocWithSheet(
-        _assets->get<Texture>(MUSHROOM_BOUNCE), 1, 9, 9
-    );
-    mush->setMushroomAnimation(animNode, 9);
+    auto clip = AnimationClips::get(MUSHROOM_BOUNCE, 1, 9, 9);
+    mush->setMushroomAnimation(clip->allocNode(_assets), clip);
 
     mush->setDensity(BASIC_DENSITY);
     mush->setFriction(BASIC_FRICTION);
@@ -307,6 +305,21 @@ std::shared_ptr<Object> ObjectController::createMushroom(std::shared_ptr<Mushroo
 * @param size The dimensions (width, height) of the platform.
 */
 std::shared_ptr<Object> ObjectController::createBomb(Vec2 pos, Size size, float scale, std::string jsonType, bool isLevelEditorMode) {
+    if (_bombPool) {
+        // Networked bombs can only be put back in play on every client
+        std::shared_ptr<Bomb> bomb = _bombPool->obtain([](const std::shared_ptr<Bomb>& bomb) {
+            return bomb->getSerial() == 0;
+        });
+        if (bomb) {
+            bool inWorld = bomb->isInWorld();
+            bomb->reuse(pos, size);
+            if (!inWorld) {
+                addObstacle(bomb, bomb->getSceneNode());
+            }
+            _gameObjects->push_back(bomb);
+            return bomb;
+        }
+    }
     std::shared_ptr<Bomb> bomb = Bomb::alloc(pos, size, jsonType);
     return createBomb(bomb, isLevelEditorMode);
 }
@@ -321,8 +334,8 @@ std::shared_ptr<Object> ObjectController::createBomb(std::shared_ptr<Bomb> bomb,
     bomb->setName("bomb");
     bomb->setDebugColor(DEBUG_COLOR);
 
-    auto animNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>(BOMB_TEXTURE_ANIMATED), 1, 14, 14);
-    bomb->setAnimation(animNode);
+    auto clip = AnimationClips::get(BOMB_TEXTURE_ANIMATED, 1, 14, 14, AnimationClip::Playback::FORWARD);
+    bomb->setAnimation(clip->allocNode(_assets), clip);
 
     addObstacle(bomb, bomb->getSceneNode());
     _gameObjects->push_back(bomb);
@@ -340,8 +353,10 @@ std::shared_ptr<Object> ObjectController::createTreasure(std::shared_ptr<Treasur
     std::shared_ptr<scene2::PolygonNode> sprite;
     std::shared_ptr<scene2::SpriteNode> animNode;
     if (!isLevelEditorMode) {
-        animNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>("treasure-sheet"), 8, 8, 64);
-        _treasure->setAnimation(animNode);
+        // Only the first half of the sheet is played
+        auto clip = AnimationClips::get("treasure-sheet", 8, 8, 64, AnimationClip::Playback::LOOP, 32);
+        animNode = clip->allocNode(_assets);
+        _treasure->setAnimation(animNode, clip);
         _treasure->setName("treasure");
     }
     else {
@@ -372,17 +387,14 @@ std::shared_ptr<Object> ObjectController::createParallaxArtObject(Vec2 pos, Size
 /* DO NOT call this overload directly. If you do, it will not have a proper scroll rate. Use the other overload instead. */
 std::shared_ptr<Object> ObjectController::createParallaxArtObject(std::shared_ptr<ArtObject> art) {
     std::shared_ptr<Texture> image;
-    bool isAnimated = animatedArtObjects.find(art->getJsonType()) != animatedArtObjects.end();
-    image = _assets->get<Texture>(jsonTypeToAsset[art->getJsonType()]);
+    int rows = 1;
+    int cols = 1;
+    bool isAnimated = jsonTypeToAnimation(art->getJsonType(), rows, cols);
+    image = _assets->get<Texture>(std::string(jsonTypeToAsset(art->getJsonType())));
     if (image == nullptr) {
         image = _assets->get<Texture>("earth");
     }
-    int rows = 1;
-    int cols = 1;
     if (isAnimated) {
-        auto pair = animatedArtObjects[art->getJsonType()];
-        rows = pair.first;
-        cols = pair.second;
         // TODO: fix this. Maybe use same system as ArtAssetHelperMaps?
         art->setAnimationDuration(1.0f);
     }
@@ -420,26 +432,24 @@ std::shared_ptr<Object> ObjectController::createArtObject(Vec2 pos, Size size, f
 
 std::shared_ptr<Object> ObjectController::createArtObject(std::shared_ptr<ArtObject> art) {
     std::shared_ptr<Texture> image;
-    bool isAnimated = animatedArtObjects.find(art->getJsonType()) != animatedArtObjects.end();
-    image = _assets->get<Texture>(jsonTypeToAsset[art->getJsonType()]);
+    int rows = 1;
+    int cols = 1;
+    bool isAnimated = jsonTypeToAnimation(art->getJsonType(), rows, cols);
+    image = _assets->get<Texture>(std::string(jsonTypeToAsset(art->getJsonType())));
     if (image == nullptr) {
         image = _assets->get<Texture>("earth");
     }
-    int rows = 1;
-    int cols = 1;
     if (isAnimated) {
-        auto pair = animatedArtObjects[art->getJsonType()];
-        rows = pair.first;
-        cols = pair.second;
         // TODO: fix this. Maybe use same system as ArtAssetHelperMaps?
         art->setAnimationDuration(1.0f);
     }
     std::shared_ptr<scene2::SpriteNode> sprite = scene2::SpriteNode::allocWithSheet(image, rows, cols);
     art->setSceneNode(sprite);
     art->setAnimated(isAnimated);
-    if (jsonTypeToLayer.find(art->getJsonType()) != jsonTypeToLayer.end()) {
-        // jsonType IS in the map
-        art->setLayer(jsonTypeToLayer[art->getJsonType()]);
+    int layer = jsonTypeToLayer(art->getJsonType());
+    if (layer >= 0) {
+        // jsonType IS in the table
+        art->setLayer(layer);
     }
     /* ArtObjects are still objects, and thus still have BoxObstacles.
      * They also need this to be rendered properly in the physics world.
@@ -464,7 +474,8 @@ std::shared_ptr<Object> ObjectController::createArtObject(std::shared_ptr<ArtObj
     art->setFilterData(filter);
     addObstacle(art, sprite);
     if (isAnimated) {
-        art->setAnimation(sprite);
+        std::string texture(jsonTypeToAsset(art->getJsonType()));
+        art->setAnimation(sprite, AnimationClips::get(texture, rows, cols, rows * cols));
     }
     _gameObjects->push_back(art);
 
@@ -477,7 +488,9 @@ std::shared_ptr<Object> ObjectController::createGoalDoor(Vec2 goalPos) {
 
 
 
-    sprite = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>("goal-spritesheet"), 1, 5, 5);
+    auto spin = AnimationClips::get("goal-spritesheet", 1, 5, 5, AnimationClip::Playback::FORWARD);
+    auto still = AnimationClips::get("goal-spritesheet", 1, 5, 5, AnimationClip::Playback::HOLD);
+    sprite = spin->allocNode(_assets);
     
 
     _goalPos = goalPos;
@@ -486,7 +499,7 @@ std::shared_ptr<Object> ObjectController::createGoalDoor(Vec2 goalPos) {
     
     std::shared_ptr<GoalDoor> goalDoor = GoalDoor::alloc(goalPos, goalSize, _scale);
 
-    goalDoor->setAnimation(sprite);
+    goalDoor->setAnimation(sprite, spin, still);
 
     goalDoor->setBodyType(b2_staticBody);
     goalDoor->setDensity(0.0f);
@@ -503,6 +516,19 @@ std::shared_ptr<Object> ObjectController::createGoalDoor(Vec2 goalPos) {
 
     return goalDoor;
 }
+/**
+ * Returns true if the obstacle is level art that never moves or animates.
+ *
+ * @param obj   The physics object
+ */
+static bool isStaticArt(const std::shared_ptr<physics2::Obstacle>& obj) {
+    if (std::dynamic_pointer_cast<Tile>(obj)) {
+        return true;
+    }
+    std::shared_ptr<ArtObject> art = std::dynamic_pointer_cast<ArtObject>(obj);
+    return art && !art->isAnimated() && !art->isParallax();
+}
+
 /**
  * Adds the physics object to the physics world and loosely couples it to the scene graph
  *
@@ -529,6 +555,19 @@ void ObjectController::addObstacle(const std::shared_ptr<physics2::Obstacle> &ob
         node->setPosition(obj->getPosition() * _scale);
     }
     _worldnode->addChild(node);
+    if (_recording) {
+        _recording->record(obj, node, useObjPosition);
+    }
+    if (_levelObjects && _staticLayers && isStaticArt(obj) && _staticLayers->add(node)) {
+        // The node is drawn by its baked layer instead
+    } else if (_culler) {
+        // Only level geometry is sure to stay put, so only it is indexed
+        if (_levelObjects && obj->getBodyType() == b2_staticBody) {
+            _culler->addStatic(node);
+        } else {
+            _culler->addMoving(node);
+        }
+    }
 
     // Dynamic objects need constant updating
     if (obj->getBodyType() != b2_staticBody)
@@ -541,6 +580,7 @@ void ObjectController::addObstacle(const std::shared_ptr<physics2::Obstacle> &ob
 }
 void ObjectController::processLevelObject(std::shared_ptr<Object> obj, bool levelEditing) {
     std::string key = obj->getJsonKey();
+    _levelObjects = true;
 
     if (key == "platforms") {
         createPlatform(std::dynamic_pointer_cast<Platform>(obj));
@@ -557,6 +597,9 @@ void ObjectController::processLevelObject(std::shared_ptr<Object> obj, bool leve
         else {
             createTreasure(std::dynamic_pointer_cast<Treasure>(obj), true);
         }
+        if (_recording) {
+            _recording->addTreasureSpawn(obj->getPositionInit());
+        }
         
     }
     else if (key == "windObstacles") {
@@ -568,6 +611,7 @@ void ObjectController::processLevelObject(std::shared_ptr<Object> obj, bool leve
     else if (key == "tiles") {
         createTile(std::dynamic_pointer_cast<Tile>(obj));
     }
+    _levelObjects = false;
 }
 
 void ObjectController::removeObject(std::shared_ptr<Object> object){
@@ -581,6 +625,115 @@ void ObjectController::removeObject(std::shared_ptr<Object> object){
     }
 }
 
+#pragma mark -
+#pragma mark World Snapshots
+
+/**
+ * Stops recording and captures the transform of every recorded obstacle.
+ */
+void ObjectController::endSnapshot() {
+    if (_recording == nullptr) {
+        return;
+    }
+    _recording->setGoalPos(_goalPos);
+    _recording->captureTransforms();
+    _recording = nullptr;
+}
+
+/**
+ * Puts a previously recorded level back into the (empty) world.
+ *
+ * @param snapshot  The snapshot of the level to restore
+ */
+void ObjectController::restoreSnapshot(const std::shared_ptr<WorldSnapshot>& snapshot) {
+    snapshot->revive();
+    _levelObjects = true;
+    for (auto& entry : snapshot->getEntries()) {
+        addObstacle(entry.obstacle, entry.node, entry.useObjPosition);
+        std::shared_ptr<Object> obj = std::dynamic_pointer_cast<Object>(entry.obstacle);
+        // The goal door is never tracked as a game object
+        if (obj && obj != snapshot->getGoalDoor()) {
+            _gameObjects->push_back(obj);
+        }
+    }
+    _levelObjects = false;
+    _goalPos = snapshot->getGoalPos();
+    if (_networkController) {
+        for (auto& spawn : snapshot->getTreasureSpawns()) {
+            _networkController->addTreasureSpawn(spawn);
+        }
+    }
+    snapshot->restoreTransforms();
+    if (_culler) {
+        // Index the static nodes again now that they are back in place
+        for (auto& entry : snapshot->getEntries()) {
+            if (entry.node && _culler->hasStatic(entry.node)) {
+                _culler->addStatic(entry.node);
+            }
+        }
+    }
+}
+
+#pragma mark -
+#pragma mark Object Pools
+
+/**
+ * Builds a bomb ready to be handed out by the bomb pool.
+ *
+ * This uses the same physics settings as {@link #createBomb}, but does not
+ * add the bomb to the world.
+ */
+std::shared_ptr<Bomb> ObjectController::allocPooledBomb() {
+    std::shared_ptr<Bomb> bomb = Bomb::alloc(Vec2::ZERO, itemToSize(BOMB));
+    if (bomb == nullptr) {
+        return nullptr;
+    }
+    bomb->setBodyType(b2_dynamicBody);
+    bomb->setDensity(BASIC_DENSITY);
+    bomb->setFriction(BASIC_FRICTION);
+    bomb->setRestitution(BASIC_RESTITUTION);
+    bomb->setName("bomb");
+    bomb->setDebugColor(DEBUG_COLOR);
+    bomb->setPooled(true);
+
+    auto clip = AnimationClips::get(BOMB_TEXTURE_ANIMATED, 1, 14, 14, AnimationClip::Playback::FORWARD);
+    bomb->setAnimation(clip->allocNode(_assets), clip);
+    return bomb;
+}
+
+/**
+ * Builds the hazard pools for the level being loaded.
+ *
+ * @param bombs         The number of bombs to build up front
+ */
+void ObjectController::prewarmPools(size_t bombs) {
+    _bombPool = ObjectPool<Bomb>::alloc(bombs, [this]() { return allocPooledBomb(); });
+    if (_networkController) {
+        _networkController->setBombPool(_bombPool);
+    }
+}
+
+/**
+ * Returns retired hazards to their pools.
+ *
+ * A retired bomb keeps its (disabled) body in the world, so it is only taken
+ * out of the list of game objects.
+ */
+void ObjectController::recyclePools() {
+    if (_bombPool) {
+        _bombPool->reclaim([](const std::shared_ptr<Bomb>& bomb) { return bomb->isRetired(); },
+                           [this](const std::shared_ptr<Bomb>& bomb) { removeObject(bomb); });
+    }
+}
+
+/** Logs the size and high-water mark of each hazard pool */
+void ObjectController::logPoolStats() const {
+    if (_bombPool) {
+        CULog("Bomb pool: %zu built, high-water mark %zu, %zu built after prewarm",
+              _bombPool->getCapacity(), _bombPool->getHighWaterMark(), _bombPool->getMissCount());
+    }
+}
+
 /**
  * Create the growing wall if not created. Otherwise, increase its width
  *
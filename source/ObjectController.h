@@ -21,6 +21,10 @@
 #include "Spike.h"
 #include "Tile.h"
 #include "Bomb.h"
+#include "ObjectPool.h"
+#include "WorldSnapshot.h"
+#include "SceneCuller.h"
+#include "StaticLayers.h"
 #include <cugl/cugl.h>
 #include <box2d/b2_world.h>
 #include <box2d/b2_body.h>
@@ -31,6 +35,9 @@ using namespace cugl;
 using namespace Constants;
 using namespace cugl::physics2::distrib;
 
+/** The number of bombs built when a level loads */
+#define BOMB_POOL_SIZE 8
+
 
 class ObjectController {
 private:
@@ -56,8 +63,21 @@ private:
    
     std::shared_ptr<NetworkController> _networkController;
 
-    
-    
+    /** The pool of reusable bombs (null until the pools are prewarmed) */
+    std::shared_ptr<ObjectPool<Bomb>> _bombPool;
+
+    /** The snapshot that records level obstacles as they are added (null when not recording) */
+    std::shared_ptr<WorldSnapshot> _recording;
+    /** The culler that hides nodes outside the camera view (null if none) */
+    std::shared_ptr<SceneCuller> _culler;
+    /** The baked layers of level art that never moves (null if none) */
+    std::shared_ptr<StaticLayers> _staticLayers;
+    /** Whether the obstacles being added come from the level file */
+    bool _levelObjects = false;
+
+    /** Builds a bomb ready to be handed out by the bomb pool */
+    std::shared_ptr<Bomb> allocPooledBomb();
+
 public:
     ObjectController(const std::shared_ptr<AssetManager>& assets,
                      const std::shared_ptr<cugl::physics2::distrib::NetWorld> world,
@@ -204,6 +224,91 @@ public:
     Vec2 getGoalPos() {return _goalPos;}
     
     void removeObject(std::shared_ptr<Object> object);
+
+#pragma mark -
+#pragma mark World Snapshots
+    /**
+     * Starts recording every obstacle added to the world into the snapshot.
+     *
+     * This should be called before the level objects are processed, so that
+     * the snapshot holds the whole level once {@link #endSnapshot} is called.
+     *
+     * @param snapshot  The snapshot to record into
+     */
+    void beginSnapshot(const std::shared_ptr<WorldSnapshot>& snapshot) { _recording = snapshot; }
+
+    /**
+     * Stops recording obstacles without finishing the snapshot.
+     *
+     * Call {@link #beginSnapshot} with the same snapshot to resume recording.
+     * This keeps objects created between two streamed batches of a level out
+     * of the level snapshot.
+     */
+    void suspendSnapshot() { _recording = nullptr; }
+
+    /**
+     * Stops recording and captures the transform of every recorded obstacle.
+     */
+    void endSnapshot();
+
+    /**
+     * Puts a previously recorded level back into the (empty) world.
+     *
+     * Every captured obstacle is re-added with its original scene node and
+     * transform, and the goal position and treasure spawns are restored. This
+     * replaces reading and instantiating the level file again.
+     *
+     * @param snapshot  The snapshot of the level to restore
+     */
+    void restoreSnapshot(const std::shared_ptr<WorldSnapshot>& snapshot);
+
+#pragma mark -
+#pragma mark Object Pools
+    /**
+     * Builds the hazard pools for the level being loaded.
+     *
+     * Bombs are expensive to allocate (body, sprite node and animation), so
+     * they are built once here and recycled afterwards. The bomb pool is
+     * shared with the network controller so that networked bombs are drawn
+     * from it as well.
+     *
+     * @param bombs         The number of bombs to build up front
+     */
+    void prewarmPools(size_t bombs = BOMB_POOL_SIZE);
+
+    /**
+     * Returns retired hazards to their pools.
+     *
+     * A retired bomb keeps its (disabled) body in the world, so it is only taken
+     * out of the list of game objects.
+     */
+    void recyclePools();
+
+    /**
+     * Sets the culler that hides nodes outside the camera view.
+     *
+     * Static obstacles from the level file are indexed once, and every
+     * other obstacle is checked each frame.
+     */
+    void setCuller(const std::shared_ptr<SceneCuller>& culler) {
+        _culler = culler;
+    }
+
+    /**
+     * Sets the baked layers of level art that never moves.
+     *
+     * Tiles and still art objects from the level file are drawn by these
+     * layers instead of their own nodes.
+     */
+    void setStaticLayers(const std::shared_ptr<StaticLayers>& layers) {
+        _staticLayers = layers;
+    }
+
+    /** Logs the size and high-water mark of each hazard pool */
+    void logPoolStats() const;
+
+    /** Returns the pool of reusable bombs */
+    std::shared_ptr<ObjectPool<Bomb>> getBombPool() const { return _bombPool; }
     
 //    /**
 //    * Create the growing wall if not created. Otherwise, increase its width
@@ -0,0 +1,240 @@
+//
+//  ObjectPool.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_OBJECT_POOL_H__
+#define __SSB_OBJECT_POOL_H__
+#include <cugl/cugl.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * A pool of reusable game objects of a single type.
+ *
+ * Transient hazards (such as bombs) are expensive to build: each one
+ * allocates a physics wrapper, a sprite node, an animation and a timeline.
+ * A pool builds a fixed number of them at level load and hands them out
+ * with {@link #obtain}. When a hazard is done, {@link #reclaim} moves it
+ * back to the free list instead of letting it be destroyed.
+ *
+ * The pool grows on demand if it runs dry, and remembers the most objects
+ * that were ever in use at once so that the prewarm size can be tuned.
+ */
+template <typename T>
+class ObjectPool {
+private:
+    /** The function used to build a new object */
+    std::function<std::shared_ptr<T>()> _allocator;
+    /** The objects that are ready to be handed out */
+    std::vector<std::shared_ptr<T>> _free;
+    /** The objects currently in use */
+    std::vector<std::shared_ptr<T>> _active;
+    /** The most objects that have been in use at once */
+    size_t _highWater;
+    /** The number of objects built after the prewarm */
+    size_t _misses;
+
+public:
+#pragma mark -
+#pragma mark Constructors
+    /**
+     * Creates an empty pool with no allocator.
+     */
+    ObjectPool() : _highWater(0), _misses(0) {}
+
+    /**
+     * Disposes of this pool, releasing all objects.
+     */
+    ~ObjectPool() { dispose(); }
+
+    /**
+     * Initializes this pool with the given allocator.
+     *
+     * The allocator is called capacity times immediately. Any object that
+     * fails to allocate causes the initialization to fail.
+     *
+     * @param capacity  The number of objects to build up front
+     * @param allocator The function to build a new object
+     *
+     * @return true if the pool was initialized properly, false otherwise.
+     */
+    bool init(size_t capacity, std::function<std::shared_ptr<T>()> allocator) {
+        _allocator = allocator;
+        _free.reserve(capacity);
+        for (size_t ii = 0; ii < capacity; ii++) {
+            std::shared_ptr<T> obj = _allocator();
+            if (obj == nullptr) {
+                CULogError("Failed to prewarm object pool at %zu of %zu", ii, capacity);
+                return false;
+            }
+            _free.push_back(obj);
+        }
+        return true;
+    }
+
+    /**
+     * Returns a newly allocated pool with the given allocator.
+     *
+     * @param capacity  The number of objects to build up front
+     * @param allocator The function to build a new object
+     *
+     * @return a newly allocated pool with the given allocator.
+     */
+    static std::shared_ptr<ObjectPool<T>> alloc(size_t capacity, std::function<std::shared_ptr<T>()> allocator) {
+        std::shared_ptr<ObjectPool<T>> result = std::make_shared<ObjectPool<T>>();
+        return (result->init(capacity, allocator) ? result : nullptr);
+    }
+
+    /**
+     * Releases every object, active or free, held by this pool.
+     */
+    void dispose() {
+        _free.clear();
+        _active.clear();
+    }
+
+#pragma mark -
+#pragma mark Pooling
+    /**
+     * Returns an object from the pool, building a new one if none are free.
+     *
+     * The object is tracked as active until it is returned by {@link #reclaim}.
+     * It is the caller's job to reset the object's state.
+     *
+     * @return an object from the pool, or nullptr if allocation failed
+     */
+    std::shared_ptr<T> obtain() {
+        std::shared_ptr<T> obj;
+        if (_free.empty()) {
+            obj = _allocator ? _allocator() : nullptr;
+            if (obj == nullptr) {
+                return nullptr;
+            }
+            _misses++;
+        } else {
+            obj = _free.back();
+            _free.pop_back();
+        }
+        _active.push_back(obj);
+        if (_active.size() > _highWater) {
+            _highWater = _active.size();
+        }
+        return obj;
+    }
+
+    /**
+     * Returns a free object accepted by the given test, building a new one if none is.
+     *
+     * The object is tracked as active until it is returned by {@link #reclaim}.
+     * It is the caller's job to reset the object's state.
+     *
+     * @param usable    Returns true if a free object can be handed out
+     *
+     * @return an object from the pool, or nullptr if allocation failed
+     */
+    std::shared_ptr<T> obtain(const std::function<bool(const std::shared_ptr<T>&)>& usable) {
+        std::shared_ptr<T> obj = findFree(usable);
+        if (obj == nullptr) {
+            obj = _allocator ? _allocator() : nullptr;
+            if (obj == nullptr) {
+                return nullptr;
+            }
+            _misses++;
+            _free.push_back(obj);
+        }
+        claim(obj);
+        return obj;
+    }
+
+    /**
+     * Returns the first free object accepted by the given test.
+     *
+     * The object stays free until it is handed out with {@link #claim}.
+     *
+     * @param usable    Returns true if a free object is the one wanted
+     *
+     * @return the first free object accepted by the test, or nullptr if none is
+     */
+    std::shared_ptr<T> findFree(const std::function<bool(const std::shared_ptr<T>&)>& usable) const {
+        for (auto it = _free.rbegin(); it != _free.rend(); ++it) {
+            if (usable(*it)) {
+                return *it;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Hands out the given free object.
+     *
+     * The object is tracked as active until it is returned by {@link #reclaim}.
+     *
+     * @param obj   A free object of this pool
+     *
+     * @return true if the object was free in this pool
+     */
+    bool claim(const std::shared_ptr<T>& obj) {
+        auto it = std::find(_free.begin(), _free.end(), obj);
+        if (it == _free.end()) {
+            return false;
+        }
+        _free.erase(it);
+        _active.push_back(obj);
+        if (_active.size() > _highWater) {
+            _highWater = _active.size();
+        }
+        return true;
+    }
+
+    /**
+     * Returns every active object that is done back to the free list.
+     *
+     * The predicate is checked once for each active object. Objects for which
+     * it returns true are handed to the (optional) release function and then
+     * moved to the free list.
+     *
+     * @param done      Returns true if an active object can be reused
+     * @param release   Called on each object as it leaves the active list
+     *
+     * @return the number of objects reclaimed
+     */
+    size_t reclaim(const std::function<bool(const std::shared_ptr<T>&)>& done,
+                   const std::function<void(const std::shared_ptr<T>&)>& release = nullptr) {
+        size_t count = 0;
+        for (auto it = _active.begin(); it != _active.end(); ) {
+            if (done(*it)) {
+                if (release) {
+                    release(*it);
+                }
+                _free.push_back(*it);
+                it = _active.erase(it);
+                count++;
+            } else {
+                ++it;
+            }
+        }
+        return count;
+    }
+
+#pragma mark -
+#pragma mark Statistics
+    /** Returns the number of objects currently in use */
+    size_t getActiveCount() const { return _active.size(); }
+
+    /** Returns the number of objects ready to be handed out */
+    size_t getFreeCount() const { return _free.size(); }
+
+    /** Returns the total number of objects owned by this pool */
+    size_t getCapacity() const { return _active.size() + _free.size(); }
+
+    /** Returns the most objects that have been in use at once */
+    size_t getHighWaterMark() const { return _highWater; }
+
+    /** Returns the number of objects that had to be built after the prewarm */
+    size_t getMissCount() const { return _misses; }
+};
+
+#endif /* __SSB_OBJECT_POOL_H__ */
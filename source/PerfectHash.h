@@ -0,0 +1,176 @@
+//
+//  PerfectHash.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_PERFECT_HASH_H__
+#define __SSB_PERFECT_HASH_H__
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Returns the hash of a string for the given seed.
+ *
+ * This is FNV-1a with the seed mixed into the offset basis, followed by the
+ * MurmurHash3 finalizer so that different seeds give unrelated hashes.
+ *
+ * @param key   The string to hash
+ * @param seed  The seed
+ */
+constexpr uint32_t perfectHash(std::string_view key, uint32_t seed) {
+    uint32_t hash = 2166136261u ^ (seed * 0x9e3779b9u);
+    for (char c : key) {
+        hash ^= (uint8_t)c;
+        hash *= 16777619u;
+    }
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+/**
+ * A string-keyed table built at compile time, with a perfect hash.
+ *
+ * The entries are structs with a std::string_view `key`. The constructor uses
+ * hash and displace: keys are split into buckets by one hash, and each bucket
+ * gets the first seed that sends all of its keys to free slots. A lookup is
+ * then two hashes, two array reads and one string compare, with no probing
+ * and no allocation.
+ *
+ * Define a table as a constexpr global, and static_assert that it is
+ * {@link #isValid}. It is not if two entries have the same key, or if the
+ * seeds run out before every bucket is placed. The number of seeds tried in
+ * all is capped, so a bad table fails the static_assert rather than running
+ * into the compiler's limit on constant evaluation.
+ */
+template <typename T, size_t N>
+class PerfectHashTable {
+private:
+    /** The number of buckets */
+    static constexpr size_t BUCKETS = N / 2 + 1;
+    /** The number of slots (a load factor of one half keeps the seeds small) */
+    static constexpr size_t SLOTS = 2 * N;
+    /** The number of seeds tried for all buckets together */
+    static constexpr uint32_t MAX_TRIES = 1 << 12;
+
+    /** The entries, in their original order */
+    std::array<T, N> _entries{};
+    /** The seed of each bucket */
+    std::array<uint32_t, BUCKETS> _seeds{};
+    /** The entry in each slot (N if empty) */
+    std::array<size_t, SLOTS> _slots{};
+    /** Whether the keys are distinct and every key found a slot */
+    bool _valid = true;
+
+public:
+    /**
+     * Builds the table for the given entries.
+     *
+     * @param entries   The entries (with distinct keys)
+     */
+    constexpr PerfectHashTable(const T (&entries)[N]) {
+        std::array<size_t, N> bucket{};
+        std::array<size_t, BUCKETS + 1> starts{};
+        for (size_t ii = 0; ii < N; ii++) {
+            _entries[ii] = entries[ii];
+            bucket[ii] = perfectHash(entries[ii].key, 0) % BUCKETS;
+            starts[bucket[ii] + 1]++;
+        }
+        for (size_t ii = 0; ii < SLOTS; ii++) {
+            _slots[ii] = N;
+        }
+
+        // The entries grouped by bucket, so a seed only hashes its own bucket
+        for (size_t bb = 0; bb < BUCKETS; bb++) {
+            starts[bb + 1] += starts[bb];
+        }
+        std::array<size_t, N> members{};
+        std::array<size_t, BUCKETS> filled{};
+        for (size_t ii = 0; ii < N; ii++) {
+            members[starts[bucket[ii]] + filled[bucket[ii]]++] = ii;
+        }
+
+        // Duplicate keys can never be placed, so do not search for seeds. Equal
+        // keys always share a bucket, so only keys in a bucket are compared.
+        for (size_t bb = 0; bb < BUCKETS && _valid; bb++) {
+            for (size_t ii = starts[bb]; ii < starts[bb + 1] && _valid; ii++) {
+                for (size_t jj = ii + 1; jj < starts[bb + 1] && _valid; jj++) {
+                    _valid = entries[members[ii]].key != entries[members[jj]].key;
+                }
+            }
+        }
+
+        // Place the largest buckets first, while there is the most room
+        size_t largest = 0;
+        for (size_t bb = 0; bb < BUCKETS; bb++) {
+            largest = filled[bb] > largest ? filled[bb] : largest;
+        }
+        std::array<size_t, N> chosen{};
+        uint32_t tries = 0;
+        for (size_t count = largest; count > 0 && _valid; count--) {
+            for (size_t next = 0; next < BUCKETS && _valid; next++) {
+                if (filled[next] != count) {
+                    continue;
+                }
+
+                bool found = false;
+                for (uint32_t seed = 1; tries < MAX_TRIES && !found; seed++, tries++) {
+                    bool fits = true;
+                    for (size_t ii = 0; ii < count && fits; ii++) {
+                        size_t slot = perfectHash(entries[members[starts[next] + ii]].key, seed) % SLOTS;
+                        fits = _slots[slot] == N;
+                        for (size_t jj = 0; jj < ii && fits; jj++) {
+                            fits = chosen[jj] != slot;
+                        }
+                        chosen[ii] = slot;
+                    }
+                    if (fits) {
+                        for (size_t ii = 0; ii < count; ii++) {
+                            _slots[chosen[ii]] = members[starts[next] + ii];
+                        }
+                        _seeds[next] = seed;
+                        found = true;
+                    }
+                }
+                _valid = found;
+            }
+        }
+    }
+
+    /** Returns true if the keys are distinct and every key found a slot */
+    constexpr bool isValid() const { return _valid; }
+
+    /**
+     * Returns the entry with the given key, or nullptr if there is none.
+     *
+     * @param key   The key
+     */
+    constexpr const T* find(std::string_view key) const {
+        uint32_t seed = _seeds[perfectHash(key, 0) % BUCKETS];
+        size_t index = _slots[perfectHash(key, seed) % SLOTS];
+        return (index < N && _entries[index].key == key) ? &_entries[index] : nullptr;
+    }
+
+    /** Returns the number of entries */
+    constexpr size_t size() const { return N; }
+
+    /** Returns the entry at the given position (in the original order) */
+    constexpr const T& operator[](size_t index) const { return _entries[index]; }
+};
+
+/**
+ * Returns a perfect hash table for the given entries.
+ *
+ * @param entries   The entries (with distinct keys)
+ */
+template <typename T, size_t N>
+constexpr PerfectHashTable<T, N> makePerfectHashTable(const T (&entries)[N]) {
+    return PerfectHashTable<T, N>(entries);
+}
+
+#endif /* __SSB_PERFECT_HASH_H__ */
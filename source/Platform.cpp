@@ -2,6 +2,8 @@
 
 #include "Platform.h"
 #include "Object.h"
+#include <algorithm>
+#include <cmath>
 
 #define JSON_KEY  "platforms";
 
@@ -19,51 +21,81 @@ void Platform::setPositionInit(const cugl::Vec2& position) {
 }
 
 void Platform::updateAnimation(float timestep) {
-    if (_platTimeline->isActive("current")) {
-        // NO OP
-//        CULog("PlatformAnimationPrepping");
+    // The platform only animates (and loops) while it moves
+    if (_moving && !_platAnimator.isPlaying()) {
+        _platAnimator.play(1.0f, true);
     }
-    else {
-        _platTimeline->add("current", _platAction, 1.0f);
+    else if (!_moving && _platAnimator.isPlaying()) {
+        _platAnimator.stop();
     }
-    _platTimeline->update(timestep);
 }
 
 void Platform::update(float timestep) {
     PolygonObstacle::update(timestep);
-    if (_moving){
-        updateAnimation(timestep);
+    updateAnimation(timestep);
+}
+
+Vec2 Platform::evaluatePath(Uint64 tick, float step) const {
+    if (_waypoints.empty()) {
+        return getPosition();
+    }
+    float length = _waypointDist.back();
+    if (_waypoints.size() == 1 || length <= 0 || _speed <= 0) {
+        return _waypoints.front();
     }
+
+    // Ping-pong along the path, so a full cycle covers it twice
+    double travelled = std::fmod((double)tick * step * _speed, 2.0 * length);
+    float dist = (float)(travelled > length ? 2.0 * length - travelled : travelled);
+
+    auto upper = std::upper_bound(_waypointDist.begin(), _waypointDist.end(), dist);
+    size_t ii = (upper == _waypointDist.end()) ? _waypoints.size() - 1 : (size_t)(upper - _waypointDist.begin());
+    ii = std::max(ii, (size_t)1);
+    float segment = _waypointDist[ii] - _waypointDist[ii-1];
+    float alpha = segment > 0 ? (dist - _waypointDist[ii-1]) / segment : 0.0f;
+    return _waypoints[ii-1] + (_waypoints[ii] - _waypoints[ii-1]) * alpha;
 }
 
-void Platform::updateMovingPlatform(float timestep) {
-    _turnCount++;
+void Platform::updatePath(Uint64 tick, float step) {
     if (!_moving) return;
 
-    Vec2 pos = getPosition();
-    Vec2 target = _forward ? _endPos : _startPos;
-    Vec2 toTarget = target - pos;
-    float distance = toTarget.length();
-    Vec2 direction = toTarget;
-    direction.normalize();
-    Vec2 step = direction * (_speed * timestep);
-
-    // If next step will move over the end_pos
-    if (_turnCount==150) {
-        CULog("turning");
-        pos = target;
-        setPosition(pos);
-        _forward = !_forward;
-        
-        Vec2 newTarget = _forward ? _endPos : _startPos;
-        Vec2 direction = newTarget - pos;
-        direction.normalize();
-        Vec2 velocity = direction * _speed;
-        setLinearVelocity(velocity);
-
-        // Optionally log the turn count for debugging
-        CULog("Platform has turned %d times", _turnCount);
-        _turnCount=0;
+    Vec2 pos = evaluatePath(tick, step);
+    Vec2 next = evaluatePath(tick + 1, step);
+    setPosition(pos);
+    setLinearVelocity((next - pos) / step);
+}
+
+void Platform::anchorPath(const Vec2& position) {
+    if (_waypoints.empty()) return;
+
+    Vec2 delta = position - _waypoints.front();
+    for (auto it = _waypoints.begin(); it != _waypoints.end(); ++it) {
+        *it += delta;
+    }
+    _startPos = _waypoints.front();
+    _endPos = _waypoints.back();
+}
+
+void Platform::setWaypoints(const std::vector<Vec2>& waypoints) {
+    _waypoints.clear();
+    for (auto it = waypoints.begin(); it != waypoints.end(); ++it) {
+        _waypoints.push_back(*it + _size/2);
+    }
+    if (!_waypoints.empty()) {
+        _startPos = _waypoints.front();
+        _endPos = _waypoints.back();
+    }
+    computePathLengths();
+}
+
+void Platform::computePathLengths() {
+    _waypointDist.clear();
+    float total = 0;
+    for (size_t ii = 0; ii < _waypoints.size(); ii++) {
+        if (ii > 0) {
+            total += _waypoints[ii].distance(_waypoints[ii-1]);
+        }
+        _waypointDist.push_back(total);
     }
 }
 
@@ -74,6 +106,7 @@ string Platform::getJsonKey() {
 
 void Platform::dispose() {
     Object::dispose();
+    _platAnimator.release();
 
     markRemoved(true);
 }
@@ -117,13 +150,11 @@ bool Platform::init(const Vec2 pos, const Size size, string jsonType) {
 bool Platform::initMoving(const Vec2 pos, const Size size, const Vec2 start, const Vec2 end, float speed) {
     if (!init(pos, size)) return false;
     _moving = true;
-    _startPos = start + size/2;
-    _endPos   = end + size/2;
     _speed    = speed;
-    _forward  = true;
     _position = pos;
     _size = size;
     _itemType = Item::MOVING_PLATFORM;
+    setWaypoints({start, end});
 
     PolyFactory factory;
     Poly2 rect = factory.makeRect(Vec2(-1.5f, 0), Size(_size.width, _size.height * 0.5));
@@ -131,10 +162,6 @@ bool Platform::initMoving(const Vec2 pos, const Size size, const Vec2 start, con
     if (PolygonObstacle::init(rect)){
         setPosition(pos + size/2);
         setBodyType(b2_kinematicBody);
-        Vec2 direction = _endPos - _startPos;
-        direction.normalize();
-        setLinearVelocity(direction * _speed);
-        
         return true;
     }
     
@@ -142,41 +169,19 @@ bool Platform::initMoving(const Vec2 pos, const Size size, const Vec2 start, con
     return false;
 }
 
-std::map<std::string, std::any> Platform::getMap() {
-    std::map<std::string, std::any> m = {
-        {"x", double(_position.x)},
-        {"y", double(_position.y)},
-        {"width", double(_size.getIWidth())},
-        {"height", double(_size.getIHeight())},
-         {"type", std::string(_jsonType)}
-    };
-    return m;
-}
 bool Platform::updateMoving(Vec2 gridpos) {
-    CULog("update moving");
     if (_moving) {
-        Vec2 oldStartPos = _startPos;
-        Vec2 oldEndPos = _endPos;
-
-        _endPos = gridpos + (_endPos - _startPos) + _size/2;
-        _startPos = gridpos + _size/2;
-        _forward = true;
-        
-        Vec2 direction = _endPos - _startPos;
-        direction.normalize();
-        setLinearVelocity(direction * _speed);
-        CULog("Platform Moved | Start: (%.2f, %.2f) -> (%.2f, %.2f) | End: (%.2f, %.2f) -> (%.2f, %.2f) | Velocity: (%.2f, %.2f)",
-              oldStartPos.x, oldStartPos.y, _startPos.x, _startPos.y,
-              oldEndPos.x, oldEndPos.y, _endPos.x, _endPos.y,
-              direction.x * _speed, direction.y * _speed);
-        
+        anchorPath(gridpos + _size/2);
+        setLinearVelocity(Vec2::ZERO);
+        CULog("Platform Moved | Start: (%.2f, %.2f) | End: (%.2f, %.2f)",
+              _startPos.x, _startPos.y, _endPos.x, _endPos.y);
         return true;
     }
         
     return false;
 }
 
-void Platform::setPlatformAnimation(std::shared_ptr<scene2::SpriteNode> sprite, int nFrames) {
+void Platform::setPlatformAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip) {
     //Create sprite object
     _platSpriteNode = sprite;
     _platSpriteNode->setAnchor(0.0f, 0.0f);
@@ -188,18 +193,7 @@ void Platform::setPlatformAnimation(std::shared_ptr<scene2::SpriteNode> sprite,
     _sceneNode->addChild(_platSpriteNode);
     _platSpriteNode->setPriority(-1);
 
-    //Create the spritesheet
-    _platTimeline = ActionTimeline::alloc();
-
-    std::vector<int> forward;
-    for (int ii = 1; ii < nFrames; ii++) {
-        forward.push_back(ii);
-    }
-    // Loop back to beginning
-    forward.push_back(0);
-
-    // Create animations
-    _platAnimateSprite = AnimateSprite::alloc(forward);
-    _platAction = _platAnimateSprite->attach<scene2::SpriteNode>(_platSpriteNode);
+    // The frames are shared with every moving platform
+    _platAnimator.attach(_platSpriteNode, clip);
 }
 
@@ -14,9 +14,14 @@ private:
     Vec2   _startPos;
     Vec2   _endPos;
     float  _speed = 0;
-    bool   _forward = true;
     bool _wall = false;
-    int _turnCount = 0;
+    /** The path of a moving platform, as obstacle positions in world coordinates */
+    std::vector<Vec2> _waypoints;
+    /** The path length from the first waypoint to each waypoint */
+    std::vector<float> _waypointDist;
+
+    /** Recomputes the cumulative waypoint distances after the path changes */
+    void computePathLengths();
 
 public:
 	Platform() : Object() {}
@@ -26,7 +31,54 @@ public:
 	/** The update method for the platform */
 	void update(float timestep) override;
 
-    void updateMovingPlatform(float timestep); 
+    /**
+     * Returns the position of this moving platform at the given tick.
+     *
+     * The platform travels along its waypoints at a constant speed and then
+     * back again, so the position is a closed-form function of elapsed time.
+     * Every client evaluating the same tick gets the same position, with no
+     * integration drift and no network traffic.
+     *
+     * @param tick  The number of fixed steps since the path started
+     * @param step  The length of a fixed step in seconds
+     *
+     * @return the position of this moving platform at the given tick.
+     */
+    Vec2 evaluatePath(Uint64 tick, float step) const;
+
+    /**
+     * Moves this platform to its path position at the given tick.
+     *
+     * The linear velocity is set to reach the position for the next tick, so
+     * that anything standing on the platform is carried along with it.
+     *
+     * @param tick  The number of fixed steps since the path started
+     * @param step  The length of a fixed step in seconds
+     */
+    void updatePath(Uint64 tick, float step);
+
+    /**
+     * Translates the waypoints so that the path starts at the given position.
+     *
+     * @param position  The new obstacle position of the first waypoint
+     */
+    void anchorPath(const Vec2& position);
+
+    /**
+     * Sets the waypoints of this moving platform.
+     *
+     * Waypoints are given as bottom left positions, like {@link #setPositionInit}.
+     * The platform moves through them in order and then back in reverse.
+     *
+     * @param waypoints The bottom left position of each waypoint
+     */
+    void setWaypoints(const std::vector<Vec2>& waypoints);
+
+    /** Returns the waypoints of this moving platform as obstacle positions */
+    const std::vector<Vec2>& getWaypoints() const { return _waypoints; }
+
+    /** Returns true if this is a moving platform */
+    bool isMoving() const { return _moving; }
 
     string getJsonKey() override;
 
@@ -76,9 +128,6 @@ public:
     bool initMoving(const Vec2 pos, const Size size, const Vec2 start, const Vec2 end, float speed);
 
 
-    // Map for JSON level management
-    std::map<std::string, std::any> getMap() override;
-
     // Gets if this is a wall
     bool isWall() { return _wall; }
     /**update start.end pos**/
@@ -88,13 +137,11 @@ public:
         return (_position.y + _size.height*0.5);
          }
 
-    void setPlatformAnimation(std::shared_ptr<scene2::SpriteNode> sprite, int nFrames);
+    void setPlatformAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip);
     void updateAnimation(float timestep);
 
-    std::shared_ptr<cugl::ActionTimeline> _platTimeline;
     std::shared_ptr<cugl::scene2::SpriteNode> _platSpriteNode;
-    std::shared_ptr<AnimateSprite> _platAnimateSprite;
-    cugl::ActionFunction _platAction;
+    Animator _platAnimator;
 
     const std::shared_ptr<scene2::SceneNode>& getSceneNode() const { return _sceneNode; }
 };
@@ -0,0 +1,39 @@
+//
+//  PlatformTickEvent.cpp
+//  SweetSweetBetrayal
+//
+
+#include <stdio.h>
+
+#include "PlatformTickEvent.h"
+using namespace cugl::physics2::distrib;
+
+/**
+ * This method is used by the NetEventController to create a new event of using a
+ * reference of the same type.
+ *
+ * Not that this method is not static, it differs from the static alloc() method
+ * and all methods must implement this method.
+ */
+std::shared_ptr<NetEvent> PlatformTickEvent::newEvent() {
+    return std::make_shared<PlatformTickEvent>();
+}
+
+std::shared_ptr<NetEvent> PlatformTickEvent::allocPlatformTickEvent(Uint64 tick) {
+    auto event = std::make_shared<PlatformTickEvent>();
+    event->_tick = tick;
+    return event;
+}
+
+std::vector<std::byte> PlatformTickEvent::serialize() {
+    _serializer.reset();
+    _serializer.writeUint64(_tick);
+
+    return _serializer.serialize();
+}
+
+void PlatformTickEvent::deserialize(const std::vector<std::byte>& data) {
+    _deserializer.reset();
+    _deserializer.receive(data);
+    _tick = _deserializer.readUint64();
+}
@@ -0,0 +1,67 @@
+//
+//  PlatformTickEvent.h
+//  SweetSweetBetrayal
+//
+
+#ifndef PlatformTickEvent_h
+#define PlatformTickEvent_h
+
+#include <stdio.h>
+#include <cugl/cugl.h>
+using namespace cugl;
+using namespace cugl::physics2::distrib;
+
+/** The number of platform ticks between two corrections from the host (one second) */
+#define PLATFORM_SYNC_TICKS 50
+
+/**
+ * The moving platform tick of the host, sent at the start of the movement
+ * phase and then every {@link PLATFORM_SYNC_TICKS} ticks.
+ *
+ * Clients add the game ticks that passed since the event was sent, so their
+ * platforms follow the host's clock instead of the moment they got the phase
+ * change, and steps they dropped are made up.
+ */
+class PlatformTickEvent : public NetEvent {
+    
+protected:
+    LWSerializer _serializer;
+    LWDeserializer _deserializer;
+    
+    Uint64 _tick;
+    
+public:
+
+    /**
+     * This method is used by the NetEventController to create a new event of using a
+     * reference of the same type.
+     *
+     * Not that this method is not static, it differs from the static alloc() method
+     * and all methods must implement this method.
+     */
+    std::shared_ptr<NetEvent> newEvent() override;
+    
+    static std::shared_ptr<NetEvent> allocPlatformTickEvent(Uint64 tick);
+    
+    /**
+     * Serialize any paramater that the event contains to a vector of bytes.
+     */
+    std::vector<std::byte> serialize() override;
+    /**
+     * Deserialize a vector of bytes and set the corresponding parameters.
+     *
+     * @param data  a byte vector packed by serialize()
+     *
+     * This function should be the "reverse" of the serialize() function: it
+     * should be able to recreate a serialized event entirely, setting all the
+     * useful parameters of this class.
+     */
+    void deserialize(const std::vector<std::byte>& data) override;
+    
+    /** Gets the platform tick of the host when the event was sent. */
+    Uint64 getTick() { return _tick; }
+
+};
+
+
+#endif /* PlatformTickEvent_h */
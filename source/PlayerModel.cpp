@@ -78,16 +78,12 @@
 #pragma mark Animation Constants
 /** Define the time settings for animation */
 #define DURATION 1.0f
-/** Action key for idle */
-#define IDLE_ACTION_KEY     "idle"
-/** Action key for walk */
-#define WALK_ACTION_KEY     "walk"
-/** Action key for glide */
-#define GLIDE_ACTION_KEY    "glide"
-/** Action key for jump */
-#define JUMP_ACTION_KEY     "jump"
-/** Action key for death */
-#define DEATH_ACTION_KEY    "death"
+/** Duration of a walk cycle */
+#define WALK_ANIM_DURATION  0.3f
+/** Duration of a jump cycle */
+#define JUMP_ANIM_DURATION  0.85f
+/** Duration of the death animation (played once) */
+#define DEATH_ANIM_DURATION 0.3f
 
 using namespace cugl;
 using namespace cugl::scene2;
@@ -172,7 +168,7 @@ bool PlayerModel::init(const Vec2 &pos, const Size &size, float scale, ColorType
 #pragma mark Animation
 
 /** Sets the idle animation and adds the idle sprite node to the scene node (_node) */
-void PlayerModel::setIdleAnimation(std::shared_ptr<scene2::SpriteNode> sprite, int nFrames) {
+void PlayerModel::setIdleAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip) {
     _idleSpriteNode = sprite;
     
     if (!_node) {
@@ -184,23 +180,18 @@ void PlayerModel::setIdleAnimation(std::shared_ptr<scene2::SpriteNode> sprite, i
     _node->addChild(_idleSpriteNode);
     _idleSpriteNode->setVisible(true);
     _idleSpriteNode->setRelativeColor(false);
-    
-    _timeline = ActionTimeline::alloc();
-    
-    std::vector<int> forward;
-    for (int ii = 1; ii < nFrames; ii++) {
-        forward.push_back(ii);
-    }
-    // Loop back to beginning
-    forward.push_back(0);
 
-    // Create animations
-    _idleAnimateSprite = AnimateSprite::alloc(forward);
-    _idleAction = _idleAnimateSprite->attach<scene2::SpriteNode>(_idleSpriteNode);
+    // The frames are shared with every player using this clip
+    _idleClip = clip;
+
+    // The player starts idle
+    _visibleSpriteNode = _idleSpriteNode;
+    _animator.attach(_idleSpriteNode, _idleClip);
+    _animator.play(DURATION, true);
 }
 
 /** Sets the walk animation and adds the walk sprite node to the scene node (_node) */
-void PlayerModel::setWalkAnimation(std::shared_ptr<scene2::SpriteNode> sprite, int nFrames) {
+void PlayerModel::setWalkAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip) {
     _walkSpriteNode = sprite;
     
     if (!_node) {
@@ -211,23 +202,13 @@ void PlayerModel::setWalkAnimation(std::shared_ptr<scene2::SpriteNode> sprite, i
     _node->addChild(_walkSpriteNode);
     _walkSpriteNode->setVisible(false);
     _walkSpriteNode->setRelativeColor(false);
-    
-    _timeline = ActionTimeline::alloc();
-    
-    std::vector<int> forward;
-    for (int ii = 1; ii < nFrames; ii++) {
-        forward.push_back(ii);
-    }
-    // Loop back to beginning
-    forward.push_back(0);
 
-    // Create animations
-    _walkAnimateSprite = AnimateSprite::alloc(forward);
-    _walkAction = _walkAnimateSprite->attach<scene2::SpriteNode>(_walkSpriteNode);
+    // The frames are shared with every player using this clip
+    _walkClip = clip;
 }
 
 /** Sets the glide animation and adds the glide sprite node to the scene node (_node) */
-void PlayerModel::setGlideAnimation(std::shared_ptr<scene2::SpriteNode> sprite, int nFrames) {
+void PlayerModel::setGlideAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip) {
     _glideSpriteNode = sprite;
     
     if (!_node) {
@@ -239,23 +220,13 @@ void PlayerModel::setGlideAnimation(std::shared_ptr<scene2::SpriteNode> sprite,
     _node->addChild(_glideSpriteNode);
     _glideSpriteNode->setVisible(false);
     _glideSpriteNode->setRelativeColor(false);
-    
-    _timeline = ActionTimeline::alloc();
-    
-    std::vector<int> forward;
-    for (int ii = 1; ii < nFrames; ii++) {
-        forward.push_back(ii);
-    }
-    // Loop back to beginning
-    forward.push_back(0);
 
-    // Create animations
-    _glideAnimateSprite = AnimateSprite::alloc(forward);
-    _glideAction = _glideAnimateSprite->attach<scene2::SpriteNode>(_glideSpriteNode);
+    // The frames are shared with every player using this clip
+    _glideClip = clip;
 }
 
 /** Sets the jump animation and adds the jump sprite node to the scene node (_node) */
-void PlayerModel::setJumpAnimation(std::shared_ptr<scene2::SpriteNode> sprite, int nFrames) {
+void PlayerModel::setJumpAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip) {
     _jumpSpriteNode = sprite;
     
     if (!_node) {
@@ -266,23 +237,13 @@ void PlayerModel::setJumpAnimation(std::shared_ptr<scene2::SpriteNode> sprite, i
     _node->addChild(_jumpSpriteNode);
     _jumpSpriteNode->setVisible(false);
     _jumpSpriteNode->setRelativeColor(false);
-    
-    _timeline = ActionTimeline::alloc();
-    
-    std::vector<int> forward;
-    for (int ii = 0; ii < nFrames - 1; ii++) {
-        forward.push_back(ii);
-    }
-    // Loop back to beginning
-    forward.push_back(nFrames - 1);
 
-    // Create animations
-    _jumpAnimateSprite = AnimateSprite::alloc(forward);
-    _jumpAction = _jumpAnimateSprite->attach<scene2::SpriteNode>(_jumpSpriteNode);
+    // The frames are shared with every player using this clip
+    _jumpClip = clip;
 }
 
 /** Sets the death animation and adds the death sprite node to the scene node (_node) */
-void PlayerModel::setDeathAnimation(std::shared_ptr<scene2::SpriteNode> sprite, int nFrames) {
+void PlayerModel::setDeathAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip) {
     _deathSpriteNode = sprite;
 
     if (!_node) {
@@ -292,33 +253,40 @@ void PlayerModel::setDeathAnimation(std::shared_ptr<scene2::SpriteNode> sprite,
     _deathSpriteNode->setAnchor(SPRITE_ANCHOR.x, SPRITE_ANCHOR.y);
     _deathSpriteNode->setPosition(SPRITE_POSITION);
     _node->addChild(_deathSpriteNode);
-    _deathSpriteNode->setVisible(true);
+    _deathSpriteNode->setVisible(false);
     _deathSpriteNode->setRelativeColor(false);
 
-    _timeline = ActionTimeline::alloc();
-
-    std::vector<int> forward;
-    for (int ii = 1; ii < nFrames; ii++) {
-        forward.push_back(ii);
-    }
-
-    // Create animations
-    _deathAnimateSprite = AnimateSprite::alloc(forward);
-    _deathAction = _deathAnimateSprite->attach<scene2::SpriteNode>(_deathSpriteNode);
+    // The frames are shared with every player using this clip
+    _deathClip = clip;
 }
 
 /**
- * Performs a film strip action
+ * Shows the given animation, hiding the one that was visible.
  *
- * @param key   The action key
- * @param action The film strip action
- * @param slide  The associated movement slide
+ * Nothing changes if the animation is already visible. Otherwise the
+ * playhead moves to its node, and a looped animation starts playing.
+ *
+ * @param node      The sprite node of the animation
+ * @param clip      The clip of the animation
+ * @param duration  The time to play the clip once
+ * @param loop      Whether the animation loops (a single play is started by the caller)
  */
-void PlayerModel::doStrip(std::string key, cugl::ActionFunction action, float duration = DURATION) {
-    if (_timeline->isActive(key)) {
-        // NO OP
+void PlayerModel::showAnimation(const std::shared_ptr<scene2::SpriteNode>& node, const std::shared_ptr<AnimationClip>& clip,
+                                float duration, bool loop) {
+    if (_visibleSpriteNode == node) {
+        return;
+    }
+    if (_visibleSpriteNode) {
+        _visibleSpriteNode->setVisible(false);
+    }
+    node->setVisible(true);
+    _visibleSpriteNode = node;
+
+    _animator.attach(node, clip);
+    if (loop) {
+        _animator.play(duration, true);
     } else {
-        _timeline->add(key, action, duration);
+        _animator.stop();
     }
 }
 
@@ -331,19 +299,16 @@ void PlayerModel::processNetworkAnimation(AnimationType animation, bool activate
 
     if (animation == AnimationType::DEATH) {
         CULog("playing dead animation");
-        _timeline->add(DEATH_ACTION_KEY, _deathAction, 0.3f);   
+        if (_deathClip) {
+            showAnimation(_deathSpriteNode, _deathClip, DEATH_ANIM_DURATION, false);
+            _animator.play(DEATH_ANIM_DURATION, false);
+            _canDie = false;
+        }
         setDead(true);
         setGhost(_node, true);
     }
     else if (animation == AnimationType::GLIDE) {
-        if (!_glideSpriteNode->isVisible()) {
-            _idleSpriteNode ->setVisible(false);
-            _walkSpriteNode ->setVisible(false);
-            _glideSpriteNode->setVisible(true);
-            _jumpSpriteNode->setVisible(false);
-            _deathSpriteNode->setVisible(false);
-        }
-        doStrip(GLIDE_ACTION_KEY, _glideAction);
+        showAnimation(_glideSpriteNode, _glideClip, DURATION, true);
         //_isGliding = true; TODO FIX
     }
 }
@@ -356,14 +321,7 @@ void PlayerModel::processNetworkState(State state, bool faceRight) {
     _faceRight = faceRight;
     updateFacing();
     if (state == State::GLIDING) {
-        if (!_glideSpriteNode->isVisible()) {
-            _idleSpriteNode->setVisible(false);
-            _walkSpriteNode->setVisible(false);
-            _glideSpriteNode->setVisible(true);
-            _jumpSpriteNode->setVisible(false);
-            _deathSpriteNode->setVisible(false);
-        }
-        doStrip(GLIDE_ACTION_KEY, _glideAction);
+        showAnimation(_glideSpriteNode, _glideClip, DURATION, true);
     }
 }
 
@@ -520,6 +478,10 @@ void PlayerModel::updateFacing(){
  */
 void PlayerModel::applyForce()
 {
+    if (_fixedMath) {
+        applyForceFixed();
+        return;
+    }
     if (!isEnabled())
     {
         return;
@@ -570,6 +532,10 @@ void PlayerModel::applyForce()
 }
 
 void PlayerModel::handleFriction() {
+    if (_fixedMath) {
+        handleFrictionFixed();
+        return;
+    }
 
     //First apply state based frictions
     switch (_state) {
@@ -601,10 +567,11 @@ void PlayerModel::handleFriction() {
     }
 
     //Handle more universal velocity stuff here.
+    //The velocity is written back at the end, so the caps below change it directly.
     b2Vec2 vel = _body->GetLinearVelocity();
-    if (fabs(getVY()) >= PLAYER_MAX_Y_SPEED)
+    if (fabs(vel.y) >= PLAYER_MAX_Y_SPEED)
     {
-        setVY(SIGNUM(getVY()) * PLAYER_MAX_Y_SPEED);
+        vel.y = SIGNUM(vel.y) * PLAYER_MAX_Y_SPEED;
     }
 
     if (getMovement() == 0.0f || _justFlipped)
@@ -621,7 +588,7 @@ void PlayerModel::handleFriction() {
     }
 
     if (_justExitedGlide) {
-        setVY(0);
+        vel.y = 0;
     }
 
     _body->SetLinearVelocity(vel);
@@ -639,62 +606,27 @@ void PlayerModel::update(float dt)
     
     _prevPos = getPosition();
     // ANIMATION
-    // TODO: Move to method updateAnimation
-    _timeline->update(dt);
+    // The playhead is advanced by the AnimationSystem after the world step
     
     // Change player facing
     //TODO-FIX THIS SHIT TO RESPECT CONTROLS
     updateFacing();
 
-    if (_isDead && _deathAction) {
-        if (!_deathSpriteNode->isVisible()) {
-            _idleSpriteNode->setVisible(false);
-            _walkSpriteNode->setVisible(false);
-            _glideSpriteNode->setVisible(false);
-            _jumpSpriteNode->setVisible(false);
-            _deathSpriteNode->setVisible(true);
-        }
+    if (_isDead && _deathClip) {
+        showAnimation(_deathSpriteNode, _deathClip, DEATH_ANIM_DURATION, false);
         // Only play the animation once
-        if (_canDie && !_timeline->isActive(DEATH_ACTION_KEY)) {
-            _timeline->add(DEATH_ACTION_KEY, _deathAction, 0.3f);
+        if (_canDie && !_animator.isPlaying()) {
+            _animator.play(DEATH_ANIM_DURATION, false);
             _canDie = false;
         }
-    } else if (_state == State::GLIDING && _glideAction){
-        if (!_glideSpriteNode->isVisible()) {
-            _idleSpriteNode->setVisible(false);
-            _walkSpriteNode->setVisible(false);
-            _glideSpriteNode->setVisible(true);
-            _jumpSpriteNode->setVisible(false);
-            _deathSpriteNode->setVisible(false);
-        }
-        doStrip(GLIDE_ACTION_KEY, _glideAction);
-    } else if (_state==State::MIDDAIR && _jumpAction){
-        if (!_jumpSpriteNode->isVisible()) {
-            _idleSpriteNode->setVisible(false);
-            _walkSpriteNode->setVisible(false);
-            _glideSpriteNode->setVisible(false);
-            _jumpSpriteNode->setVisible(true);
-            _deathSpriteNode->setVisible(false);
-        }
-        doStrip(JUMP_ACTION_KEY, _jumpAction, 0.85f);
-    } else if (abs(getVX()) < 0.1f  && _idleAction) {
-        if (!_idleSpriteNode->isVisible()) {
-            _idleSpriteNode->setVisible(true);
-            _walkSpriteNode->setVisible(false);
-            _glideSpriteNode->setVisible(false);
-            _jumpSpriteNode->setVisible(false);
-            _deathSpriteNode->setVisible(false);
-        }
-        doStrip(IDLE_ACTION_KEY, _idleAction);
-    } else if (_walkAction) {
-        if (!_walkSpriteNode->isVisible()) {
-            _walkSpriteNode->setVisible(true);
-            _idleSpriteNode->setVisible(false);
-            _glideSpriteNode->setVisible(false);
-            _jumpSpriteNode->setVisible(false);
-            _deathSpriteNode->setVisible(false);
-        }
-        doStrip(WALK_ACTION_KEY, _walkAction, 0.3f);
+    } else if (_state == State::GLIDING && _glideClip){
+        showAnimation(_glideSpriteNode, _glideClip, DURATION, true);
+    } else if (_state==State::MIDDAIR && _jumpClip){
+        showAnimation(_jumpSpriteNode, _jumpClip, JUMP_ANIM_DURATION, true);
+    } else if (abs(getVX()) < 0.1f  && _idleClip) {
+        showAnimation(_idleSpriteNode, _idleClip, DURATION, true);
+    } else if (_walkClip) {
+        showAnimation(_walkSpriteNode, _walkClip, WALK_ANIM_DURATION, true);
     }
 
 //     Should not move when immobile
@@ -840,6 +772,10 @@ void PlayerModel::handlePlayerState() {
 
 void PlayerModel::glideUpdate(float dt)
 {
+    if (_fixedMath) {
+        glideUpdateFixed();
+        return;
+    }
     
     if (_state == State::GLIDING){
         b2Vec2 motion = _body->GetLinearVelocity();
@@ -856,8 +792,12 @@ void PlayerModel::glideUpdate(float dt)
         //Scales with how long the player has been middair, and how long since the player has last glided.
         if (_justGlided) {
             CULog("Boost");
-            float thrust_mult = min(_glideBoostTimer, _glideBoostDelay);
-            b2Vec2 force(0, GLIDE_UPWARD_THRUST * (thrust_mult / _glideBoostDelay));
+            //Without a delay, the boost is at full strength at once
+            float thrust_ratio = 1.0f;
+            if (_glideBoostDelay > 0) {
+                thrust_ratio = min(_glideBoostTimer, _glideBoostDelay) / _glideBoostDelay;
+            }
+            b2Vec2 force(0, GLIDE_UPWARD_THRUST * thrust_ratio);
             _body->ApplyLinearImpulse(force, _body->GetPosition(), true);
             //Also slightly slow down the player-
             b2Vec2 vel = _body->GetLinearVelocity();
@@ -876,6 +816,10 @@ Inflicts an appropriate force to the player based on _windspeed
 */
 void PlayerModel::windUpdate(float dt)
 {
+    if (_fixedMath) {
+        windUpdateFixed();
+        return;
+    }
     float mult = WIND_FACTOR_GLIDING;
 
     switch (_state) {
@@ -907,6 +851,164 @@ void PlayerModel::windUpdate(float dt)
     _windVel = Vec2(0, 0);
 }
 
+#pragma mark -
+#pragma mark Fixed-Point Movement
+/**
+ * Applies the force to the body of this dude, using fixed-point math.
+ *
+ * This mirrors {@link #applyForce}. Velocities are quantized to Q16.16 when
+ * read from the body, and every product is computed on integers.
+ */
+void PlayerModel::applyForceFixed()
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+    FixedVec2 vel(_body->GetLinearVelocity());
+    // Slow down briefly when we turn around on the ground
+    if (_state == State::GROUNDED && (_justFlipped || _justMoved)) {
+        if (_faceRight) {
+            vel.x -= Fixed(STARTING_VELOCITY);
+        }
+        else {
+            vel.x += Fixed(STARTING_VELOCITY);
+        }
+    }
+    _body->SetLinearVelocity(vel.toB2());
+
+    // More powerful horizontal movement while gliding to counteract damping
+    Fixed factor = (_state == State::GLIDING ? Fixed(GLIDE_BOOST_FACTOR) : Fixed(MORE_VELOCITY));
+    FixedVec2 force(Fixed(getMovement()) * factor, Fixed());
+    _body->ApplyForce(force.toB2(), _body->GetPosition(), true);
+
+    handleFrictionFixed();
+
+    _justMoved = false;
+}
+
+/**
+ * Clamps and damps the player velocity, using fixed-point math.
+ *
+ * This mirrors {@link #handleFriction}.
+ */
+void PlayerModel::handleFrictionFixed() {
+    FixedVec2 vel(_body->GetLinearVelocity());
+    Fixed maxSpeed(getMaxSpeed());
+
+    // First apply state based frictions
+    if (_state == State::GLIDING) {
+        if (vel.y <= Fixed(GLIDE_FALL_SPEED)) {
+            vel.y = Fixed(GLIDE_FALL_SPEED);
+        }
+        if (vel.x.abs() >= maxSpeed * Fixed(1.4f)) {
+            vel.x = vel.x.sign() * maxSpeed;
+        }
+    }
+    else if (vel.x.abs() >= maxSpeed) {
+        vel.x = vel.x.sign() * maxSpeed;
+    }
+
+    // Then the universal vertical cap
+    Fixed maxSpeedY(PLAYER_MAX_Y_SPEED);
+    if (vel.y.abs() >= maxSpeedY) {
+        vel.y = vel.y.sign() * maxSpeedY;
+    }
+
+    if (getMovement() == 0.0f || _justFlipped)
+    {
+        if (_state == State::GROUNDED)
+        {
+            // Instant friction on the ground or when we flip on the ground
+            vel.x = vel.x * Fixed(GROUND_DAMPING);
+        }
+        // Friction middair, but less
+        else if (_state == State::MIDDAIR) {
+            vel.x = vel.x * Fixed(MIDDAIR_DAMPING);
+        }
+    }
+
+    if (_justExitedGlide) {
+        vel.y = Fixed();
+    }
+
+    _body->SetLinearVelocity(vel.toB2());
+}
+
+/**
+ * Applies the glide damping and boosts, using fixed-point math.
+ *
+ * This mirrors {@link #glideUpdate}.
+ */
+void PlayerModel::glideUpdateFixed()
+{
+    if (_state != State::GLIDING) {
+        _body->SetLinearDamping(0);
+        return;
+    }
+    _body->SetLinearDamping(GLIDE_DAMPING);
+
+    // If we just flipped while gliding, or just entered gliding, apply a small linear impulse.
+    if (_justFlipped || _justGlided) {
+        FixedVec2 force(Fixed(_movement).sign() * Fixed(GLIDE_BOOST_FACTOR), Fixed());
+        _body->ApplyLinearImpulse(force.toB2(), _body->GetPosition(), true);
+    }
+
+    // Upwards boost that scales with how long since the player last glided
+    if (_justGlided) {
+        // Without a delay, the boost is at full strength at once
+        Fixed delay(_glideBoostDelay);
+        Fixed thrustRatio(1);
+        if (delay > Fixed()) {
+            thrustRatio = Fixed::min(Fixed(_glideBoostTimer), delay) / delay;
+        }
+        FixedVec2 force(Fixed(), Fixed(GLIDE_UPWARD_THRUST) * thrustRatio);
+        _body->ApplyLinearImpulse(force.toB2(), _body->GetPosition(), true);
+
+        // Also slightly slow down the player
+        FixedVec2 vel(_body->GetLinearVelocity());
+        vel.x = vel.x * Fixed(0.75f);
+        _body->SetLinearVelocity(vel.toB2());
+
+        _glideBoostTimer = 0.0f;
+    }
+}
+
+/**
+ * Applies the current wind gust to the player, using fixed-point math.
+ *
+ * This mirrors {@link #windUpdate}.
+ */
+void PlayerModel::windUpdateFixed()
+{
+    Fixed mult = (_state == State::GLIDING ? Fixed(WIND_FACTOR_GLIDING) : Fixed(WIND_FACTOR_AIR));
+
+    if (Fixed(_windDist) < Fixed(WIND_DIST_THRESHOLD) || _state == State::GLIDING) {
+        FixedVec2 vel(_body->GetLinearVelocity());
+        FixedVec2 wind(_windVel);
+        vel.x += wind.x * mult;
+        vel.y += wind.y * mult;
+        if (vel.y <= Fixed() && wind.y > Fixed() && _state != State::GLIDING) {
+            vel.y += Fixed(3) * wind.y * mult;
+        }
+        _body->SetLinearVelocity(vel.toB2());
+    }
+
+    _windVel = Vec2(0, 0);
+}
+
+/**
+ * Mixes the quantized movement state of this player into the hash.
+ *
+ * @param hash  The hash of the world state for this tick
+ */
+void PlayerModel::hashState(StateHash& hash) const
+{
+    hash.add(FixedVec2(getPosition()));
+    hash.add(FixedVec2(getLinearVelocity()));
+    hash.add((int32_t)_state);
+}
+
 #pragma mark -
 #pragma mark Scene Graph Methods
 /**
@@ -48,6 +48,7 @@
 #include "Constants.h"
 #include "Message.h"
 #include "AnimationEvent.h"
+#include "FixedPoint.h"
 
 using namespace cugl;
 using namespace Constants;
@@ -206,6 +207,8 @@ protected:
     bool _isDampEnabled = true;
     //Stores the player's previous position. Used for platform logic
     Vec2 _prevPos;
+    /** Whether the movement code runs in Q16.16 fixed point (for lockstep play) */
+    bool _fixedMath = false;
 
 	/** Ground sensor to represent our feet */
 	b2Fixture*  _sensorFixture;
@@ -221,33 +224,30 @@ protected:
 	float _drawScale;
 
 #pragma mark Animation Variables
-    /** Manager to process the animation actions */
-    std::shared_ptr<cugl::ActionTimeline> _timeline;
+    /** The playhead of the visible animation */
+    Animator _animator;
+    /** The sprite node that is currently visible (and animated) */
+    std::shared_ptr<cugl::scene2::SpriteNode> _visibleSpriteNode;
     
     /** Idle animation variables */
-    std::shared_ptr<AnimateSprite> _idleAnimateSprite;
+    std::shared_ptr<AnimationClip> _idleClip;
     std::shared_ptr<cugl::scene2::SpriteNode> _idleSpriteNode;
-    cugl::ActionFunction _idleAction;
     
     /** Walk animation variables */
-    std::shared_ptr<AnimateSprite> _walkAnimateSprite;
+    std::shared_ptr<AnimationClip> _walkClip;
     std::shared_ptr<cugl::scene2::SpriteNode> _walkSpriteNode;
-    cugl::ActionFunction _walkAction;
     
     /** Glide animation variables */
-    std::shared_ptr<AnimateSprite> _glideAnimateSprite;
+    std::shared_ptr<AnimationClip> _glideClip;
     std::shared_ptr<cugl::scene2::SpriteNode> _glideSpriteNode;
-    cugl::ActionFunction _glideAction;
     
     /** Jump animation variables */
-    std::shared_ptr<AnimateSprite> _jumpAnimateSprite;
+    std::shared_ptr<AnimationClip> _jumpClip;
     std::shared_ptr<cugl::scene2::SpriteNode> _jumpSpriteNode;
-    cugl::ActionFunction _jumpAction;
 
     /** Death animation variables */
-    std::shared_ptr<AnimateSprite> _deathAnimateSprite;
+    std::shared_ptr<AnimationClip> _deathClip;
     std::shared_ptr<cugl::scene2::SpriteNode> _deathSpriteNode;
-    cugl::ActionFunction _deathAction;
 
 	/**
 	* Redraws the outline of the physics fixtures to the debug node
@@ -477,28 +477,33 @@ public:
     }
     
     /** Sets the idle animation and adds the idle sprite node to the scene node (_node) */
-    void setIdleAnimation(std::shared_ptr<scene2::SpriteNode> sprite, int nFrames);
+    void setIdleAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip);
 
     /** Sets the walk animation and adds the walk sprite node to the scene node (_node) */
-    void setWalkAnimation(std::shared_ptr<scene2::SpriteNode> sprite, int nFrames);
+    void setWalkAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip);
 
     /** Sets the glide animation and adds the glide sprite node to the scene node (_node) */
-    void setGlideAnimation(std::shared_ptr<scene2::SpriteNode> sprite, int nFrames);
+    void setGlideAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip);
 
     /** Sets the jump animation and adds the jump sprite node to the scene node (_node) */
-    void setJumpAnimation(std::shared_ptr<scene2::SpriteNode> sprite, int nFrames);
+    void setJumpAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip);
 
     /** Sets the death animation and adds the death sprite node to the scene node (_node) */
-    void setDeathAnimation(std::shared_ptr<scene2::SpriteNode> sprite, int nFrames);
+    void setDeathAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip);
 
     /**
-     * Performs a film strip action
+     * Shows the given animation, hiding the one that was visible.
      *
-     * @param key   The action key
-     * @param action The film strip action
-     * @param slide  The associated movement slide
+     * Nothing changes if the animation is already visible. Otherwise the
+     * playhead moves to its node, and a looped animation starts playing.
+     *
+     * @param node      The sprite node of the animation
+     * @param clip      The clip of the animation
+     * @param duration  The time to play the clip once
+     * @param loop      Whether the animation loops (a single play is started by the caller)
      */
-    void doStrip(std::string key, cugl::ActionFunction action, float duration);
+    void showAnimation(const std::shared_ptr<scene2::SpriteNode>& node, const std::shared_ptr<AnimationClip>& clip,
+                       float duration, bool loop);
 
     /** Sets which animation color strip to use for the player */
     void setAnimationColors(ColorType color);
@@ -780,6 +785,42 @@ public:
     */
     void windUpdate(float dt);
 
+#pragma mark -
+#pragma mark Fixed-Point Movement
+    /**
+     * Sets whether the movement code runs in Q16.16 fixed point.
+     *
+     * When enabled, {@link #applyForce}, {@link #handleFriction},
+     * {@link #glideUpdate} and {@link #windUpdate} do all of their arithmetic
+     * in fixed point, so every platform computes the same velocities from the
+     * same inputs. This is off by default.
+     *
+     * @param value whether to use fixed-point movement math
+     */
+    void setFixedMath(bool value) { _fixedMath = value; }
+
+    /** Returns true if the movement code runs in Q16.16 fixed point */
+    bool isFixedMath() const { return _fixedMath; }
+
+    /**
+     * Mixes the quantized movement state of this player into the hash.
+     *
+     * @param hash  The hash of the world state for this tick
+     */
+    void hashState(StateHash& hash) const;
+
+private:
+    /** The fixed-point version of {@link #applyForce} */
+    void applyForceFixed();
+    /** The fixed-point version of {@link #handleFriction} */
+    void handleFrictionFixed();
+    /** The fixed-point version of {@link #glideUpdate} */
+    void glideUpdateFixed();
+    /** The fixed-point version of {@link #windUpdate} */
+    void windUpdateFixed();
+
+public:
+
     /** Reset the player's movements in between rounds by setting it all to zero and to face the right */
     void resetMovement();
     
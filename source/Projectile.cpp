@@ -43,18 +43,6 @@ bool Projectile::init(const Vec2 pos, const Size size, float scale, string jsonT
     return false;
 }
 
-std::map<std::string, std::any> Projectile::getMap() {
-    std::map<std::string, std::any> m = {
-        {"x", double(_position.x)},
-        {"y", double(_position.y)},
-        {"width", double(_size.getIWidth())},
-        {"height", double(_size.getIHeight())},
-        {"scale", double(_drawScale)},
-         {"type", std::string(_jsonType)}
-    };
-    return m;
-}
-
 void Projectile::update(float timestep) {
     //    Vec2 currPos = getPosition();
     //    currPos += Vec2(1,1);
@@ -89,7 +77,7 @@ string Projectile::getJsonKey() {
 }
 
 void Projectile::updateAnimation(float timestep) {
-    doStrip(_spinAction, DURATION);
+    doStrip(_spinAction, SPIN_DURATION);
     _timeline->update(timestep);
 }
 
@@ -99,7 +87,7 @@ void Projectile::updateAnimation(float timestep) {
  * @param action The film strip action
  * @param slide  The associated movement slide
  */
-void Projectile::doStrip(cugl::ActionFunction action, float duration = DURATION) {
+void Projectile::doStrip(cugl::ActionFunction action, float duration = SPIN_DURATION) {
 
     if (_timeline->isActive(ACT_KEY)) {
         // NO OP
@@ -11,7 +11,7 @@
 #define __PROJECTILE_H__
 #include <cugl/cugl.h>
 
-#define DURATION 8.0f
+#define SPIN_DURATION 8.0f
 #define ACT_KEY  "current"
 
 
@@ -114,7 +114,6 @@ public:
     /** Increments an animation film strip */
     void doStrip(cugl::ActionFunction action, float duration);
 
-    std::map<std::string, std::any> getMap() override;
     /**
      * Sets the taken status of the Projectile.
      * @param taken Whether the Projectile has been taken by a player.
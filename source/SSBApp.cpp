@@ -1,7 +1,10 @@
 #include "SSBApp.h"
 #include "SSBInput.h"
 #include "Constants.h"
-#include "ArtAssetMapHelper.h"
+#include "AtlasTextureLoader.h"
+#include "StartupTrace.h"
+#include "AnimationClips.h"
+#include <algorithm>
 
 using namespace cugl;
 using namespace cugl::graphics;
@@ -23,6 +26,7 @@ using namespace cugl::audio;
  */
 void SSBApp::onStartup()
 {
+    StartupTrace::begin("onStartup");
     _assets = AssetManager::alloc();
     _batch = SpriteBatch::alloc();
 
@@ -36,30 +40,52 @@ void SSBApp::onStartup()
     Input::activate<Keyboard>();
     Input::activate<TextInput>();
 
-    _assets->attach<Font>(FontLoader::alloc()->getHook());
-    _assets->attach<Texture>(TextureLoader::alloc()->getHook());
-    _assets->attach<Sound>(SoundLoader::alloc()->getHook());
-    _assets->attach<scene2::SceneNode>(Scene2Loader::alloc()->getHook());
-    _assets->attach<JsonValue>(JsonLoader::alloc()->getHook());
-    _assets->attach<WidgetValue>(WidgetLoader::alloc()->getHook());
+    StartupTrace::begin("attach loaders");
+    attachLoaders(_assets);
+    StartupTrace::end("attach loaders");
+    StartupTrace::begin("load json/loading.json");
     _assets->loadDirectory("json/loading.json");
+    StartupTrace::end("load json/loading.json");
+    _groups = AssetGroups::alloc(_assets);
 
-    // Create a "loading" screen
+    // Create a "loading" screen (for the core assets; the rest are groups)
     _loaded = false;
     _loading.init(_assets, "json/assets.json");
     _loading.setSpriteBatch(_batch);
 
     // Queue up the other assets
+    StartupTrace::begin("load json/assets.json");
     _loading.start();
     _status = LOAD;
+    StartupTrace::begin("AudioEngine::start");
     AudioEngine::start();
+    StartupTrace::end("AudioEngine::start");
 
+    StartupTrace::begin("NetworkLayer::start");
     NetworkLayer::start(NetworkLayer::Log::INFO);
+    StartupTrace::end("NetworkLayer::start");
+    StartupTrace::end("onStartup");
     Application::onStartup(); // YOU MUST END with call to parent
 
     setDeterministic(true);
 }
 
+/**
+ * Attaches the loaders the game uses to the given asset manager.
+ *
+ * @param assets    The asset manager to attach the loaders to
+ */
+void SSBApp::attachLoaders(const std::shared_ptr<AssetManager>& assets)
+{
+    assets->attach<Font>(FontLoader::alloc()->getHook());
+    // Packed textures are served from the atlas pages listed in json/atlases.json
+    assets->attach<Texture>(AtlasTextureLoader::alloc()->getHook());
+    assets->attach<Sound>(SoundLoader::alloc()->getHook());
+    assets->attach<scene2::SceneNode>(Scene2Loader::alloc()->getHook());
+    assets->attach<JsonValue>(JsonLoader::alloc()->getHook());
+    assets->attach<WidgetValue>(WidgetLoader::alloc()->getHook());
+}
+
 /**
  * The method called when the application is ready to quit.
  *
@@ -89,6 +115,8 @@ void SSBApp::onShutdown()
     // Is this correct way of diposing networkController?
     _networkController->dispose();
     _networkController = nullptr;
+    _groups = nullptr;
+    AnimationClips::clear();
     _assets = nullptr;
     _batch = nullptr;
 
@@ -194,17 +222,19 @@ void SSBApp::preUpdate(float dt)
     {
         _loading.update(0.01f);
         if (_loading.isComplete()){
+            StartupTrace::end("load json/assets.json");
             _loading.setActive(false);
         }
     }
     else if (_status == LOAD)
     {
-
+        StartupTrace::begin("controllers");
         _networkController = NetworkController::alloc(_assets);
         _network = _networkController->getNetwork();
         _sound = SoundController::alloc(_assets);
+        StartupTrace::end("controllers");
 
-        populateMaps();
+        StartupTrace::begin("init scenes");
         _loading.dispose();
         _startscreen.init(_assets, _sound);
         _startscreen.setActive(true);
@@ -240,6 +270,7 @@ void SSBApp::preUpdate(float dt)
         _doTransition = true;
         _transition.setActive(true);
         _transition.startFadeIn();
+        StartupTrace::end("init scenes");
 
         _status = START;
         _sound->loadAudioPreferences();
@@ -247,6 +278,8 @@ void SSBApp::preUpdate(float dt)
     }
     else
     {
+        // A new game holds its fade in until the level has streamed in
+        _transition.setLoadProgress(_status == GAME ? _gameController.getLoadProgress() : 1.0f);
         _transition.preUpdate(dt);
         switch (_status)
         {
@@ -648,6 +681,7 @@ void SSBApp::updateHostScene(float timestep)
             _hostgame.setActive(false);
             _mainmenu.setActive(true);
             _gameController.dispose();
+            releaseGameGroups();
             _status = MENU;
         }
     }
@@ -671,6 +705,7 @@ void SSBApp::updateLevelSelectScene(float timestep){
         setTransition(true);
         if (_transition.getFadingOutDone()){
             _gameController.setLevelNum(levelChoice);
+            acquireGameGroups(levelChoice);
             
             // Check if we are playing another game, or we are starting from very beginning
 //            if (_networkController->getPlayAgain()){
@@ -937,6 +972,7 @@ void SSBApp::resetScenes(){
     _gameController.reset();
     _network->disconnect();
     _gameController.dispose();
+    releaseGameGroups();
     
     _startscreen.reset();
     _settingscreen.reset();
@@ -971,6 +1007,10 @@ void SSBApp::draw()
         break;
     case START:
         _startscreen.render();
+        if (!StartupTrace::isFinished()) {
+            StartupTrace::mark("first menu frame");
+            StartupTrace::finish(Application::get()->getSaveDirectory() + STARTUP_TRACE_FILE);
+        }
         break;
     case SETTING:
         _settingscreen.render();
@@ -1024,10 +1064,6 @@ void SSBApp::draw()
     }
 }
 
-void SSBApp::populateMaps() {
-    ArtAssetMapHelper::populateConstantsMaps();
-}
-
 /**
  Resets the entire state of the application. Disposes of all scenes and the network and re-initializes them.
  */
@@ -1046,6 +1082,7 @@ void SSBApp::resetApplication(){
     _disconnectedscreen.dispose();
     
     _gameController.dispose();
+    releaseGameGroups();
     
     // Clear network variables
     _networkController->setPlayAgain(false);
@@ -1061,7 +1098,6 @@ void SSBApp::resetApplication(){
     _network = _networkController->getNetwork();
     _sound = SoundController::alloc(_assets);
 
-    populateMaps();
     _startscreen.init(_assets, _sound);
     _startscreen.setActive(true);
 
@@ -1098,3 +1134,34 @@ void SSBApp::resetLevel(){
     _networkController->setPlayAgain(true);
     _gameController.disposeLevel();
 }
+
+/**
+ * Loads the asset groups for a game on the given level.
+ *
+ * These are the level art, the sprite sheets of every player color, and
+ * the victory screens. Groups held by the previous game that are still
+ * needed are not reloaded, and the rest are unloaded.
+ *
+ * @param level The level number
+ */
+void SSBApp::acquireGameGroups(int level){
+    std::vector<std::string> groups = { AssetGroups::getLevelGroup(level), VICTORY_GROUP };
+    groups.push_back(AssetGroups::getColorGroup(_networkController->getLocalColor()));
+    for (auto& player : _networkController->getPlayerColors()) {
+        groups.push_back(AssetGroups::getColorGroup(player.second));
+    }
+    std::sort(groups.begin(), groups.end());
+    groups.erase(std::unique(groups.begin(), groups.end()), groups.end());
+
+    // Loaded behind the transition, before the level is built
+    _groups->swap(_heldGroups, groups);
+}
+
+/**
+ * Unloads the asset groups held by the current game.
+ */
+void SSBApp::releaseGameGroups(){
+    if (_groups != nullptr) {
+        _groups->swap(_heldGroups, {});
+    }
+}
@@ -23,6 +23,7 @@
 #include "DisconnectedScene.h"
 #include <cugl/physics2/distrib/CUNetEventController.h>
 #include "Constants.h"
+#include "AssetGroups.h"
 
 
 using namespace cugl::physics2::distrib;
@@ -39,6 +40,10 @@ protected:
     std::shared_ptr<cugl::graphics::SpriteBatch> _batch;
     /** The global asset manager */
     std::shared_ptr<cugl::AssetManager> _assets;
+    /** The asset groups loaded on demand (level art, characters, victory) */
+    std::shared_ptr<AssetGroups> _groups;
+    /** The asset groups held by the current game */
+    std::vector<std::string> _heldGroups;
     
     StartScene _startscreen;
 
@@ -138,6 +143,16 @@ public:
      */
     virtual void onStartup() override;
     
+    /**
+     * Attaches the loaders the game uses to the given asset manager.
+     *
+     * This is the loader setup of {@link #onStartup}, shared with the
+     * startup benchmark so that it loads assets exactly like the game.
+     *
+     * @param assets    The asset manager to attach the loaders to
+     */
+    static void attachLoaders(const std::shared_ptr<cugl::AssetManager>& assets);
+    
     /**
      * The method called when the application is ready to quit.
      *
@@ -270,6 +285,22 @@ public:
      Resets the entire state of the level controllers. Used when a party is still connected and wants to play another game.
      */
     void resetLevel();
+
+    /**
+     * Loads the asset groups for a game on the given level.
+     *
+     * These are the level art, the sprite sheets of every player color, and
+     * the victory screens. Groups held by the previous game that are still
+     * needed are not reloaded, and the rest are unloaded.
+     *
+     * @param level The level number
+     */
+    void acquireGameGroups(int level);
+
+    /**
+     * Unloads the asset groups held by the current game.
+     */
+    void releaseGameGroups();
     
     /**
      Disposes all scenes necessary to create a clean slate. 
@@ -343,15 +374,5 @@ public:
      Resets all properties of the scene prior to joining a game.
      */
     void resetScenes();
-    
-    /**
-    * Sets up the asset, item, and JSON maps in Constants.
-    * Had to this here because updating the static variables from within Constants does not work.
-    */
-    void populateMaps();
-    
-   // std::map<string, string> jsonTypeToAsset = {};
-    //std::map<string, Item> jsonTypeToItemType = {};
-    //std::map<Item, string> itemToAssetNameMap = {};
 };
 #endif /* __PF_APP_H__ */
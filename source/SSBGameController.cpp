@@ -15,7 +15,9 @@
 #include "PlayerModel.h"
 #include "WindObstacle.h"
 #include "LevelModel.h"
+#include "LevelCache.h"
 #include "ObjectController.h"
+#include "AnimationSystem.h"
 
 #include <ctime>
 #include <string>
@@ -218,9 +220,11 @@ void SSBGameController::createParallaxObjects() {
             "parallax-ww-6"
         };
     }
-    shared_ptr<JsonReader> jsonReader;
-    jsonReader = JsonReader::allocWithAsset("json/parallax/parallax.json");
-    shared_ptr<JsonValue> json = jsonReader->readJson();
+    // The parallax table is parsed once and shared across rounds and replays
+    shared_ptr<JsonValue> json = LevelCache::get()->getJson("json/parallax/parallax.json");
+    if (json == nullptr) {
+        return;
+    }
     for (size_t itemNo = 0; itemNo < jsonTypes.size(); itemNo++) {
         auto objData = json->get(jsonTypes[itemNo]);
         obj = _objectController->createParallaxArtObject(
@@ -324,6 +328,7 @@ void SSBGameController::reset()
     _beforeScoreBoard = 15;
     _nextInRoundDelay = 30;
     _nextInRoundIndex = 0;
+    _platformTick = 0;
     _hasVictory = false;
     
     // Reset all controllers
@@ -385,6 +390,28 @@ void SSBGameController::preUpdate(float dt)
     // Overall game logic
     _networkController->preUpdate(dt);
     _input->update(dt);
+
+    // The level streams in over several frames (the transition holds at black),
+    // and nothing is playable until the area around the spawn exists
+    if (!_movePhaseController->streamLevel(LEVEL_STREAM_BUDGET)) {
+        return;
+    }
+
+    // The host picks the movement math for every client
+    if (_input->didFixedMath()) {
+        if (_networkController->getIsHost()) {
+            _networkController->sendFixedMath(!_fixedMath);
+        } else {
+            CULog("Only the host can toggle fixed-point movement");
+        }
+    }
+    if (_networkController->getFixedMath() != _fixedMath) {
+        setFixedMath(_networkController->getFixedMath());
+    }
+    if (_input->didReplay()) {
+        _replayNext = !_replayNext;
+        CULog("Input replay %s for the next movement phase", _replayNext ? "on" : "off");
+    }
     
 
 //    if (_networkController->getIsHost() && _networkController->getTreasure() != nullptr){
@@ -453,17 +480,6 @@ void SSBGameController::preUpdate(float dt)
         _scoreCountdown -= 1;
     }
     
-    auto objects = _networkController->getObjects();
-    for (auto it = objects->begin(); it != objects->end(); ++it) {
-        std::shared_ptr<Object> obj = *it;
-        if (obj && obj->getItemType() == Item::MOVING_PLATFORM) {
-            auto platform = std::dynamic_pointer_cast<Platform>(obj);
-            if (platform && platform->getOwnerId() == _networkController->getNetwork()->getShortUID()) {
-//                CULog("Updating moving platform owned by %d with dt = %.4f", platform->getOwnerId(), dt);
-                platform->updateMovingPlatform(dt);
-            }
-        }
-    }
     // Update parallax objects
     for (auto it = _parallaxObjects.begin(); it != _parallaxObjects.end(); ++it) {
         auto artObj = (dynamic_pointer_cast<ArtObject>((*it)));
@@ -511,9 +527,50 @@ void SSBGameController::preUpdate(float dt)
  */
 void SSBGameController::fixedUpdate(float step)
 {
+    // Moving platforms follow their paths from the host's tick
+    if (!_buildingMode) {
+        syncPlatformTick();
+        updateMovingPlatforms();
+        _platformTick++;
+    }
+
+    // A replay sets the local player's input for this step, which is recorded
+    std::shared_ptr<PlayerModel> player = _movePhaseController->getLocalPlayer();
+    bool recording = _isRecording && !_buildingMode && player != nullptr;
+    float movement = 0;
+    bool jumpHold = false;
+    if (recording) {
+        if (_isReplaying && _playback.hasNext()) {
+            const InputReplay::Frame& frame = _playback.next();
+            player->setMovement(frame.movement);
+            if (player->getJumpHold() != frame.jumpHold) {
+                player->setJumpHold(frame.jumpHold);
+            }
+        }
+        movement = player->getMovement();
+        jumpHold = player->getJumpHold();
+    }
+
     // Turn the physics engine crank.
     _world->update(FIXED_TIMESTEP_S);
 
+    // Objects chose their animations in the world step, so advance them all now
+    AnimationSystem::update(FIXED_TIMESTEP_S);
+
+    if (_fixedMath && !_buildingMode) {
+        uint64_t hash = hashPlayerState();
+        if (_movePhaseController->isDebug()) {
+            CULog("Tick %llu state %016llx", (unsigned long long)_platformTick, (unsigned long long)hash);
+        }
+        if (recording) {
+            _recording.record(_platformTick, movement, jumpHold, hash);
+            // The check ends with the recording, and the input is live again
+            if (_isReplaying && !_playback.hasNext()) {
+                finishRecording();
+            }
+        }
+    }
+
     // Update all controllers
     _networkController->fixedUpdate(step);
 
@@ -549,6 +606,10 @@ void SSBGameController::postUpdate(float remain)
 {
     // Since items may be deleted, garbage collect
     _world->garbageCollect();
+    // Retired hazards go back to their pools
+    if (_objectController) {
+        _objectController->recyclePools();
+    }
 
     // Update all controllers
     _networkController->fixedUpdate(remain);
@@ -598,6 +659,12 @@ void SSBGameController::setBuildingMode(bool value) {
     _camera->setPosition(_initialCameraPos);
 
     _movePhaseController->processModeChange(value);
+    resetMovingPlatforms(value);
+    if (value) {
+        finishRecording();
+    } else {
+        startRecording();
+    }
     
     std::vector<std::shared_ptr<PlayerModel>> players = _networkController->getPlayerList();
     for (auto player : players){
@@ -607,6 +674,186 @@ void SSBGameController::setBuildingMode(bool value) {
     }
 }
 
+/**
+ * Sets whether player movement runs in Q16.16 fixed point.
+ *
+ * The host toggles this with the fixed math key, and the network controller
+ * sets it on every client. While enabled, a hash of the
+ * quantized player state is logged every fixed step in debug mode, and
+ * each movement phase is recorded to {@link INPUT_REPLAY_FILE}. The replay
+ * key plays the recording back in the next movement phase, and checks the
+ * hash of every step against it.
+ *
+ * A phase that was not run in fixed point from its start is not recorded.
+ *
+ * @param value whether to use fixed-point movement math
+ */
+void SSBGameController::setFixedMath(bool value) {
+    _fixedMath = value;
+    for (auto& player : _networkController->getPlayerList()) {
+        if (player != nullptr) {
+            player->setFixedMath(value);
+        }
+    }
+    _isRecording = false;
+    _isReplaying = false;
+    _recording.clear();
+    _movePhaseController->setReplaying(false);
+    CULog("Fixed-point movement %s", value ? "on" : "off");
+}
+
 #pragma mark -
 #pragma mark Helpers
+/**
+ * Keeps the moving platform tick on the host's clock.
+ *
+ * Each client starts its tick when it gets the phase change, and only
+ * advances it on the steps it runs. So the host sends its tick when the
+ * movement phase starts and every {@link PLATFORM_SYNC_TICKS} ticks after,
+ * and clients take it (advanced by the game ticks since it was sent).
+ */
+void SSBGameController::syncPlatformTick() {
+    if (_networkController->getIsHost()) {
+        if (_platformTick % PLATFORM_SYNC_TICKS == 0) {
+            _networkController->sendPlatformTick(_platformTick);
+        }
+        return;
+    }
+    Uint64 tick;
+    if (_networkController->popHostPlatformTick(tick)) {
+        _platformTick = tick;
+    }
+}
+
+/**
+ * Moves every moving platform to its path position for the current tick.
+ *
+ * Every client evaluates the same closed-form path from the host's tick (see
+ * {@link #syncPlatformTick}), so platform positions are never sent.
+ */
+void SSBGameController::updateMovingPlatforms() {
+    auto objects = _networkController->getObjects();
+    if (objects == nullptr) {
+        return;
+    }
+    for (auto it = objects->begin(); it != objects->end(); ++it) {
+        if (*it && (*it)->getItemType() == Item::MOVING_PLATFORM) {
+            auto platform = std::dynamic_pointer_cast<Platform>(*it);
+            if (platform) {
+                platform->updatePath(_platformTick, FIXED_TIMESTEP_S);
+            }
+        }
+    }
+}
+
+/**
+ * Restarts the moving platform paths at a mode change.
+ *
+ * Entering the movement phase anchors each path at the platform's current
+ * (build phase) position and restarts the tick, which the host then keeps
+ * in step. While building, the
+ * platforms stay shared so placement is synced, and they are held still.
+ *
+ * @param building  whether the level is entering building mode
+ */
+void SSBGameController::resetMovingPlatforms(bool building) {
+    _platformTick = 0;
+    // A correction from the last round would be far ahead of this one, but
+    // the host's first tick of this round may arrive before the phase change
+    if (building) {
+        _networkController->clearHostPlatformTick();
+    }
+    auto objects = _networkController->getObjects();
+    if (objects == nullptr) {
+        return;
+    }
+    for (auto it = objects->begin(); it != objects->end(); ++it) {
+        if (*it && (*it)->getItemType() == Item::MOVING_PLATFORM) {
+            auto platform = std::dynamic_pointer_cast<Platform>(*it);
+            if (!platform) {
+                continue;
+            }
+            if (building) {
+                platform->updatePath(0, FIXED_TIMESTEP_S);
+                platform->setLinearVelocity(Vec2::ZERO);
+            } else {
+                platform->anchorPath(platform->getPosition());
+            }
+            platform->setShared(building);
+        }
+    }
+}
+
+/**
+ * Returns the hash of the quantized state of every player.
+ *
+ * Players are hashed in list order, which is the same on every client.
+ *
+ * @return the hash of the quantized player state for this tick
+ */
+uint64_t SSBGameController::hashPlayerState() {
+    StateHash hash;
+    hash.add((int32_t)_platformTick);
+    for (auto& player : _networkController->getPlayerList()) {
+        if (player != nullptr) {
+            player->hashState(hash);
+        }
+    }
+    return hash.get();
+}
+
+/**
+ * Starts recording (or playing back) the movement phase that begins.
+ *
+ * Players can join after fixed math is toggled, so every player is set to
+ * the current mode here. Only a phase run in fixed point from its start is
+ * recorded, since a replay starts from the same place.
+ */
+void SSBGameController::startRecording() {
+    for (auto& player : _networkController->getPlayerList()) {
+        if (player != nullptr) {
+            player->setFixedMath(_fixedMath);
+        }
+    }
+    _recording.clear();
+    _isRecording = _fixedMath;
+    _isReplaying = false;
+    if (_isRecording && _replayNext) {
+        _isReplaying = _playback.load(Application::get()->getSaveDirectory() + INPUT_REPLAY_FILE);
+        if (!_isReplaying) {
+            CULogError("There is no input replay to play back");
+        }
+    }
+    _movePhaseController->setReplaying(_isReplaying);
+}
+
+/**
+ * Saves (or checks) the recording of the movement phase that ends.
+ *
+ * A phase played back is not saved. Its hashes are checked against the
+ * recording it played, and the first step where they differ is logged.
+ */
+void SSBGameController::finishRecording() {
+    _movePhaseController->setReplaying(false);
+    if (!_isRecording) {
+        return;
+    }
+    _isRecording = false;
+
+    if (_isReplaying) {
+        _isReplaying = false;
+        long step = InputReplay::compare(_playback, _recording);
+        if (step < 0) {
+            CULog("Input replay matched all %zu steps", _recording.size());
+        } else {
+            Uint64 tick = (size_t)step < _playback.size() ? _playback.get(step).tick : _platformTick;
+            CULogError("Input replay diverged at step %ld (tick %llu)", step, (unsigned long long)tick);
+        }
+    } else if (_recording.size() > 0) {
+        std::string file = Application::get()->getSaveDirectory() + INPUT_REPLAY_FILE;
+        if (_recording.save(file)) {
+            CULog("Recorded %zu steps to %s", _recording.size(), file.c_str());
+        }
+    }
+}
 
@@ -27,6 +27,7 @@
 #include "SoundController.h"
 #include "ObjectController.h"
 #include "PauseScene.h"
+#include "InputReplay.h"
 //#include <cmath>
 
 using namespace cugl;
@@ -98,6 +99,21 @@ protected:
     // next index to show up in scoreboard
     size_t _nextInRoundIndex = 0;
 
+    /** The number of fixed steps since the movement phase started (drives moving platforms) */
+    Uint64 _platformTick = 0;
+    /** Whether player movement runs in fixed point (toggled by the host with the fixed math key) */
+    bool _fixedMath = false;
+    /** The local player input and state hash of every step of this movement phase */
+    InputReplay _recording;
+    /** Whether this movement phase is recorded (from its start) */
+    bool _isRecording = false;
+    /** The recording played back in this movement phase */
+    InputReplay _playback;
+    /** Whether the next movement phase plays back the last recording */
+    bool _replayNext = false;
+    /** Whether this movement phase plays back the last recording */
+    bool _isReplaying = false;
+
 public:
 #pragma mark -
 #pragma mark Constructors
@@ -311,6 +327,11 @@ public:
      */
     bool getHasVictory() {return _hasVictory;};
 
+    /**
+     * Returns the fraction of the level objects created so far (between 0 and 1).
+     */
+    float getLoadProgress() const { return _movePhaseController->getLoadProgress(); }
+
     /**
      * @return true if the game is paused
      */
@@ -325,6 +346,20 @@ public:
         _movePhaseController->setIsPaused(value);
     }
 
+    /**
+     * Sets whether player movement runs in Q16.16 fixed point.
+     *
+     * The host toggles this with the fixed math key, and the network controller
+     * sets it on every client. While enabled, a hash of the
+     * quantized player state is logged every fixed step in debug mode, and
+     * each movement phase is recorded to {@link INPUT_REPLAY_FILE}. The
+     * replay key plays the recording back in the next movement phase, and
+     * checks the hash of every step against it.
+     *
+     * @param value whether to use fixed-point movement math
+     */
+    void setFixedMath(bool value);
+
 #pragma mark -
 #pragma mark Helpers
     /**
@@ -338,6 +373,40 @@ public:
      */
     Vec2 convertScreenToBox2d(const Vec2& screenPos, float scale, const Vec2& offset);
 
+    /**
+     * Keeps the moving platform tick on the host's clock.
+     */
+    void syncPlatformTick();
+
+    /**
+     * Moves every moving platform to its path position for the current tick.
+     */
+    void updateMovingPlatforms();
+
+    /**
+     * Restarts the moving platform paths at a mode change.
+     *
+     * @param building  whether the level is entering building mode
+     */
+    void resetMovingPlatforms(bool building);
+
+    /**
+     * Returns the hash of the quantized state of every player.
+     *
+     * @return the hash of the quantized player state for this tick
+     */
+    uint64_t hashPlayerState();
+
+    /**
+     * Starts recording (or playing back) the movement phase that begins.
+     */
+    void startRecording();
+
+    /**
+     * Saves (or checks) the recording of the movement phase that ends.
+     */
+    void finishRecording();
+
 
   };
 
@@ -5,6 +5,8 @@
 //  Created by Caitlyn Jin on 2/22/25.
 //
 #include "SSBGridManager.h"
+#include <algorithm>
+#include <cmath>
 
 
 using namespace cugl;
@@ -25,31 +27,12 @@ using namespace Constants;
  */
 void GridManager::initGrid(bool isLevelEditor) {
     _grid->removeAllChildren();
-    _illegal_background = scene2::PolygonNode::allocWithTexture(_assets->get<Texture>("safezone"));
-    _illegal_background->setAnchor(Vec2::ANCHOR_BOTTOM_LEFT);
-    _illegal_background->setPosition(Vec2(0, 2));
-    _illegal_background->setScale(0.0314f);
-    _grid->addChild(_illegal_background);
-
-    std::shared_ptr<scene2::GridLayout> gridLayout = scene2::GridLayout::alloc();
-    gridLayout->setGridSize(_columns, MAX_ROWS);
-
-    for (int row = 0; row < MAX_ROWS; ++row) {
-        for (int col = 0; col < _columns; ++col) {
-            if (!isLevelEditor && (row < ROW_OFFSET_BOT || row >= MAX_ROWS - ROW_OFFSET_TOP)) {
-                continue;
-            }
-
-            Vec2 cellPos(col * CELL_SIZE, row * CELL_SIZE);
 
-            std::shared_ptr<scene2::WireNode> cellNode = scene2::WireNode::allocWithPath(Rect(cellPos, Size(CELL_SIZE, CELL_SIZE)));
-            cellNode->setColor(Color4::WHITE);
-            cellNode->setAnchor(Vec2::ANCHOR_BOTTOM_LEFT);
-            cellNode->setPosition(cellPos);
-
-            _grid->addChild(cellNode);
-        }
-    }
+    // The grid lines, safe zone and cell tints are drawn as a couple of meshes
+    int rowStart = isLevelEditor ? 0 : ROW_OFFSET_BOT;
+    int rowEnd = isLevelEditor ? MAX_ROWS : MAX_ROWS - ROW_OFFSET_TOP;
+    _overlay = GridOverlayNode::alloc((int)_columns, rowStart, rowEnd, CELL_SIZE, SAFE_ZONE_COLUMNS);
+    _grid->addChild(_overlay);
 
     // Set grid to be shown initially
     _grid->setVisible(true);
@@ -67,8 +50,11 @@ void GridManager::initGrid(bool isLevelEditor) {
     _spriteNode->setScale(CELL_SIZE / textureWidth, CELL_SIZE / textureHeight);
     _spriteNode->setPosition(cellPos);
     _spriteNode->setVisible(false);
+    _spriteCell = cellPos;
+    _spriteItem = NONE;
 
     _grid->addChild(_spriteNode);
+    _occupiedDirty = true;
 }
 
 /**
@@ -118,6 +104,32 @@ void GridManager::update(float timestep) {
             deleteObject(obj);
         }
     }
+
+    updateOverlay();
+}
+
+/**
+ * Sends the cells with world objects to the overlay.
+ *
+ * The cells are only collected and sorted again after an object was added,
+ * moved or deleted, and the overlay only rebuilds its meshes if they changed.
+ */
+void GridManager::updateOverlay() {
+    if (!_occupiedDirty) {
+        return;
+    }
+    _occupiedDirty = false;
+
+    std::vector<std::pair<int, int>> cells;
+    cells.reserve(posToWorldObjMap.size());
+    for (const auto& entry : posToWorldObjMap) {
+        if (entry.second != nullptr) {
+            cells.emplace_back((int)std::floor(entry.first.first / CELL_SIZE), (int)std::floor(entry.first.second / CELL_SIZE));
+        }
+    }
+    std::sort(cells.begin(), cells.end());
+    cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+    _overlay->setOccupied(std::move(cells));
 }
 
 #pragma mark -
@@ -128,13 +140,17 @@ void GridManager::update(float timestep) {
  *
  * @param cellPos   the cell position
  * @param item          the item of the corresponding object
+ * @param moved     the existing object being dragged, or nullptr for a new one
  */
-void GridManager::setObject(Vec2 cellPos, Item item) {
-    if (_spriteNode) {
-        
-        auto image = _assets->get<Texture>(itemToAssetNameMap[item]);
+void GridManager::setObject(Vec2 cellPos, Item item, std::shared_ptr<Object> moved) {
+    Size size = moved ? moved->getSize() : itemToGridSize(item);
+    _overlay->setGhost(cellPos, size, isFree(cellPos, size, item, moved));
+
+    // The sprite is only changed when it moves to another cell or item
+    if (_spriteNode && (_spriteNode->isVisible() == false || cellPos != _spriteCell || item != _spriteItem)) {
+        auto image = _assets->get<Texture>(std::string(itemToTexture(item)));
         if (image == nullptr) {
-            CULog("You likely forgot to add this item to itemToAssetNameMap");
+            CULog("You likely forgot to add this item to ART_ASSETS");
             return;
         }
 
@@ -147,6 +163,8 @@ void GridManager::setObject(Vec2 cellPos, Item item) {
         _spriteNode->setContentSize(image->getSize());
         _spriteNode->setScale(itemSize.width / textureWidth, itemSize.height / textureHeight);
         _spriteNode->setVisible(true);
+        _spriteCell = cellPos;
+        _spriteItem = item;
     }
 }
 
@@ -162,6 +180,7 @@ std::shared_ptr<Object> GridManager::getObject(Vec2 cellPos) {
  */
 void GridManager::setSpriteInvisible(){
     _spriteNode->setVisible(false);
+    _overlay->clearGhost();
 }
 
 #pragma mark -
@@ -180,6 +199,7 @@ void GridManager::addObject(std::shared_ptr<Object> obj) {
 
     // Add the origin position of the object
     worldObjToPosMap[obj] = originPosPair;
+    _occupiedDirty = true;
 
     // Add the object to every position it exists in
     for (int i = 0; i < size.getIWidth(); i++) {
@@ -232,6 +252,7 @@ void GridManager::addMoveableObject(Vec2 cellPos, std::shared_ptr<Object> obj) {
     auto originPosPair = std::make_pair(cellPos.x, cellPos.y);
     objToPosMap[obj] = originPosPair;
     worldObjToPosMap[obj] = originPosPair;
+    _occupiedDirty = true;
 
     // Add the object to every position it exists in
     for (int i = 0; i < size.getIWidth(); i++) {
@@ -304,54 +325,70 @@ std::shared_ptr<Object> GridManager::moveWorldObject(std::shared_ptr<Object> obj
     }
 
     // DO NOT remove the object from the `worldObjToPos` map
+    _occupiedDirty = true;
 
     return obj;
 }
 
 /**
- * Checks whether we can place the object in the cell position.
+ * Returns true if an item could be placed at the cell position.
  *
- * @return false if there exists an object
+ * This is the one placement rule for new and existing objects. Nothing may be
+ * placed in the safe zone. An art object only conflicts with art of the same
+ * type, and any other object with every world object. The object being moved
+ * never conflicts with itself.
  *
- * @param cellPos    the cell position
- * @param size          the amount of area this object takes up (including its movement)
+ * @param cellPos   the cell position
+ * @param size      the amount of area the object takes up
  * @param item      the item type
+ * @param moved     the existing object being moved, or nullptr for a new one
  */
-bool GridManager::canPlace(Vec2 cellPos, Size size, Item item) {
-    if (cellPos.x < 8 * CELL_SIZE) {
-        CULog("Cannot place object in the first 8 columns.");
+bool GridManager::isFree(Vec2 cellPos, Size size, Item item, const std::shared_ptr<Object>& moved) const {
+    if (cellPos.x < SAFE_ZONE_COLUMNS * CELL_SIZE) {
         return false;
     }
+    bool isArt = itemIsArtObject(item);
     for (int i = 0; i < size.getIWidth(); i++) {
         for (int j = 0; j < size.getIHeight(); j++) {
-            // Find object in object map
             auto posPair = std::make_pair(cellPos.x + i, cellPos.y + j);
 
-            if (posToWorldObjMap[posPair] != nullptr && !itemIsArtObject(item)) {
-                return false;   // Object exists in position
-                // TODO: if it's an art object, instead check if artobjmap has that itemtype in it at that spot
+            if (!isArt) {
+                auto it = posToWorldObjMap.find(posPair);
+                if (it != posToWorldObjMap.end() && it->second != nullptr && it->second != moved) {
+                    return false;   // Object exists in position
+                }
             }
-            
-            if (posToArtObjMap.find(posPair) != posToArtObjMap.end()) { // there is an art object there
-                // loop through objs and make sure none of them have same itemType
-                auto objs = posToArtObjMap[posPair];
-                for (auto it = objs.begin(); it != objs.end(); ++it) {
-                    if ((*it)->getItemType() == item) {
+
+            auto art = posToArtObjMap.find(posPair);
+            if (art != posToArtObjMap.end()) {
+                // Art may not overlap art of the same type
+                for (const auto& obj : art->second) {
+                    if (obj != moved && obj->getItemType() == item) {
                         return false;
                     }
-                    if ((*it)->getItemType() == Item::ART_OBJECT) {
-                        auto e = 4;
-                    }
-                    if (item == Item::ART_OBJECT) {
-                        auto e = 5;
-                    }
                 }
             }
         }
     }
-
     return true;
-};
+}
+
+/**
+ * Checks whether we can place the object in the cell position.
+ *
+ * @return false if there exists an object
+ *
+ * @param cellPos    the cell position
+ * @param size          the amount of area this object takes up (including its movement)
+ * @param item      the item type
+ */
+bool GridManager::canPlace(Vec2 cellPos, Size size, Item item) {
+    if (cellPos.x < SAFE_ZONE_COLUMNS * CELL_SIZE) {
+        CULog("Cannot place object in the first %d columns.", SAFE_ZONE_COLUMNS);
+        return false;
+    }
+    return isFree(cellPos, size, item, nullptr);
+}
 
 /**
  * Checks whether we can place an existing object in the cell position.
@@ -361,21 +398,11 @@ bool GridManager::canPlace(Vec2 cellPos, Size size, Item item) {
  * @param cellPos    the cell position
  */
 bool GridManager::canPlaceExisting(Vec2 cellPos, std::shared_ptr<Object> obj) {
-    Size size = obj->getSize();
-
-    for (int i = 0; i < size.getIWidth(); i++) {
-        for (int j = 0; j < size.getIHeight(); j++) {
-            // Find object in object map
-            auto posPair = std::make_pair(cellPos.x + i, cellPos.y + j);
-
-            // Check if object exists in the position AND it's not the same object being moved
-            if (posToWorldObjMap[posPair] != nullptr && posToWorldObjMap[posPair] != obj) {
-                return false;
-            }
-        }
+    if (cellPos.x < SAFE_ZONE_COLUMNS * CELL_SIZE) {
+        CULog("Cannot place object in the first %d columns.", SAFE_ZONE_COLUMNS);
+        return false;
     }
-
-    return true;
+    return isFree(cellPos, obj->getSize(), obj->getItemType(), obj);
 }
 
 void GridManager::clear() {
@@ -384,6 +411,7 @@ void GridManager::clear() {
     posToWorldObjMap.clear();
     objToPosMap.clear();
     worldObjToPosMap.clear();
+    _occupiedDirty = true;
 }
 
 void GridManager::clearRound() {
@@ -416,6 +444,7 @@ void GridManager::deleteObject(std::shared_ptr<Object> obj) {
     // Clears maps and returns the object
     objToPosMap.erase(obj);
     worldObjToPosMap.erase(obj);
+    _occupiedDirty = true;
 
     if (obj) {
         obj->dispose();
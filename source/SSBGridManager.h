@@ -9,11 +9,15 @@
 
 #include <cugl/cugl.h>
 #include "Object.h"
+#include "GridOverlayNode.h"
 
 
 using namespace cugl;
 using namespace cugl::graphics;
 
+/** The number of columns (from the left) where nothing may be placed */
+#define SAFE_ZONE_COLUMNS   8
+
 #pragma mark -
 #pragma mark Grid Manager
 /**
@@ -33,8 +37,6 @@ public:
     std::map<std::shared_ptr<Object>, std::pair<float, float>> worldObjToPosMap;
     /** Maps moveable world objects to bottom left position of objects */
     std::map<std::shared_ptr<Object>, std::pair<float, float>> objToPosMap;
-    /** Textuer of illegal background*/
-    std::shared_ptr<scene2::PolygonNode> _illegal_background;
 
 private:
     /** Reference to building mode grid */
@@ -52,6 +54,32 @@ private:
     float _columns;
     /** The size of the cell in Box2d units */
     const float CELL_SIZE = 1.0f;
+    /** The grid lines, cell tints and placement footprint */
+    std::shared_ptr<GridOverlayNode> _overlay;
+    /** The cell the sprite node was last moved to */
+    Vec2 _spriteCell;
+    /** The item the sprite node last showed */
+    Item _spriteItem;
+    /** Whether an object was added, moved or deleted since the overlay was updated */
+    bool _occupiedDirty = true;
+
+    /**
+     * Returns true if an item could be placed at the cell position.
+     *
+     * This is the placement rule of {@link #canPlace} and {@link #canPlaceExisting},
+     * without logging, so it can run every frame for the placement footprint.
+     *
+     * @param cellPos   the cell position
+     * @param size      the amount of area the object takes up
+     * @param item      the item type
+     * @param moved     the existing object being moved, or nullptr for a new one
+     */
+    bool isFree(Vec2 cellPos, Size size, Item item, const std::shared_ptr<Object>& moved) const;
+
+    /**
+     * Sends the cells with world objects to the overlay, if they changed.
+     */
+    void updateOverlay();
 
 
 protected:
@@ -132,8 +160,9 @@ public:
      *
      * @param cellPos   the cell position
      * @param item          the item of the corresponding object
+     * @param moved     the existing object being dragged, or nullptr for a new one
      */
-    void setObject(Vec2 cellPos, Item item);
+    void setObject(Vec2 cellPos, Item item, std::shared_ptr<Object> moved = nullptr);
 
     /** Gets the object in the cell at this row and column.
      * Does NOT work for ArtObjects - use a separate method for that.
@@ -201,8 +230,8 @@ public:
      * @param item      the item type
      */
     bool canPlaceBomb(Vec2 cellPos) {
-        if (cellPos.x < 8 * CELL_SIZE) {
-            CULog("Cannot place object in the first 8 columns.");
+        if (cellPos.x < SAFE_ZONE_COLUMNS * CELL_SIZE) {
+            CULog("Cannot place object in the first %d columns.", SAFE_ZONE_COLUMNS);
             return false;
         }
         return true;
@@ -28,6 +28,14 @@ using namespace cugl;
 #define FIRE_KEY KeyCode::SPACE
 /** The key for jumping up */
 #define JUMP_KEY KeyCode::ARROW_UP
+/** The key (with control or command) for undoing a level editor change */
+#define UNDO_KEY KeyCode::Z
+/** The key (with control or command) for redoing a level editor change */
+#define REDO_KEY KeyCode::Y
+/** The key for toggling fixed-point player movement */
+#define FIXED_KEY KeyCode::F
+/** The key for replaying the last recorded movement phase */
+#define REPLAY_KEY KeyCode::P
 
 /** How close we need to be for a multi touch */
 #define NEAR_TOUCH      100
@@ -76,6 +84,10 @@ _debugPressed(false),
 _exitPressed(false),
 _firePressed(false),
 _jumpPressed(false),
+_undoPressed(false),
+_redoPressed(false),
+_fixedPressed(false),
+_replayPressed(false),
 _keyJump(false),
 _keyFire(false),
 _keyReset(false),
@@ -218,6 +230,13 @@ void PlatformInput::update(float dt) {
 
     _keyLeft = keys->keyDown(KeyCode::ARROW_LEFT);
     _keyRight = keys->keyDown(KeyCode::ARROW_RIGHT);
+
+    bool command = keys->keyDown(KeyCode::LEFT_CTRL) || keys->keyDown(KeyCode::RIGHT_CTRL) ||
+                   keys->keyDown(KeyCode::LEFT_META) || keys->keyDown(KeyCode::RIGHT_META);
+    _undoPressed = command && keys->keyPressed(UNDO_KEY);
+    _redoPressed = command && keys->keyPressed(REDO_KEY);
+    _fixedPressed = keys->keyPressed(FIXED_KEY);
+    _replayPressed = keys->keyPressed(REPLAY_KEY);
 #endif
 
     _resetPressed = _keyReset;
@@ -256,6 +275,10 @@ void PlatformInput::clear() {
     _exitPressed  = false;
     _jumpPressed = false;
     _firePressed = false;
+    _undoPressed = false;
+    _redoPressed = false;
+    _fixedPressed = false;
+    _replayPressed = false;
     _currDown = false;
     
 }
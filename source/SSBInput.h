@@ -110,6 +110,14 @@ protected:
     bool _firePressed;
     /** Whether the jump action was chosen. */
     bool _jumpPressed;
+    /** Whether the undo shortcut was pressed. */
+    bool _undoPressed;
+    /** Whether the redo shortcut was pressed. */
+    bool _redoPressed;
+    /** Whether the fixed-point movement toggle was pressed. */
+    bool _fixedPressed;
+    /** Whether the replay toggle was pressed. */
+    bool _replayPressed;
     /** How much did we move horizontally? */
     float _horizontal;
     /** Touch position on screen */
@@ -422,6 +430,34 @@ public:
      */
 	bool didDebug() const { return _debugPressed; }
 
+	/**
+	 * Returns true if the undo shortcut (control or command Z) was pressed.
+	 *
+	 * @return true if the undo shortcut was pressed.
+	 */
+	bool didUndo() const { return _undoPressed; }
+
+	/**
+	 * Returns true if the redo shortcut (control or command Y) was pressed.
+	 *
+	 * @return true if the redo shortcut was pressed.
+	 */
+	bool didRedo() const { return _redoPressed; }
+
+	/**
+	 * Returns true if the player wants to toggle fixed-point movement.
+	 *
+	 * @return true if the player wants to toggle fixed-point movement.
+	 */
+	bool didFixedMath() const { return _fixedPressed; }
+
+	/**
+	 * Returns true if the player wants to toggle replaying the last recording.
+	 *
+	 * @return true if the player wants to toggle replaying the last recording.
+	 */
+	bool didReplay() const { return _replayPressed; }
+
 	/**
 	 * Returns true if the exit button was pressed.
 	 *
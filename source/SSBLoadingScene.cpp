@@ -10,6 +10,7 @@
 #include <cugl/graphics/loaders/CUFontLoader.h>
 #include <cugl/scene2/CUScene2Loader.h>
 #include <cugl/core/assets/CUWidgetLoader.h>
+#include "TieredTextureLoader.h"
 
 using namespace cugl;
 using namespace cugl::scene2;
@@ -53,7 +54,7 @@ bool SSBLoadingScene::init(const std::string scene, const std::string directory)
     }
     
     _assets->attach<Font>(FontLoader::alloc()->getHook());
-    _assets->attach<Texture>(TextureLoader::alloc()->getHook());
+    _assets->attach<Texture>(TieredTextureLoader::alloc()->getHook());
     _assets->attach<WidgetValue>(WidgetLoader::alloc()->getHook());
     _assets->attach<scene2::SceneNode>(Scene2Loader::alloc()->getHook());
     
@@ -97,6 +98,8 @@ bool SSBLoadingScene::init(const std::shared_ptr<cugl::AssetManager>& assets,
 //    auto loadImage = assets->get<Texture>("loading-anim");
     
     _loadSpriteNode = scene2::SpriteNode::allocWithSheet(_assets->get<Texture>("loading-anim"), 1, 20, 20);
+    // Draw the frames at their full size, whatever tier the sheet was loaded at
+    _loadSpriteNode->setScale(1.0f / TieredTextureLoader::getScale("loading-anim"));
     
         
     _timeline = ActionTimeline::alloc();
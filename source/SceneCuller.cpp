@@ -0,0 +1,258 @@
+//
+//  SceneCuller.cpp
+//  SweetSweetBetrayal
+//
+
+#include "SceneCuller.h"
+#include <algorithm>
+
+using namespace cugl;
+
+#pragma mark -
+#pragma mark Constructors
+/**
+ * Initializes a culler for the children of the given node.
+ *
+ * @param root          The node whose children are culled
+ * @param columnWidth   The width of a column of the static index (in node coordinates)
+ *
+ * @return true if the culler was initialized properly
+ */
+bool SceneCuller::init(const std::shared_ptr<scene2::SceneNode>& root, float columnWidth) {
+    if (root == nullptr || columnWidth <= 0) {
+        return false;
+    }
+    _root = root;
+    _columnWidth = columnWidth;
+    return true;
+}
+
+#pragma mark -
+#pragma mark Nodes
+/**
+ * Adds a node that does not move.
+ *
+ * The node is indexed by its current bounds. Adding a node again
+ * indexes it by its new bounds.
+ *
+ * @param node  A child of the root
+ */
+void SceneCuller::addStatic(const std::shared_ptr<scene2::SceneNode>& node) {
+    if (node == nullptr) {
+        return;
+    }
+    int index;
+    auto it = _staticIndex.find(node.get());
+    if (it != _staticIndex.end()) {
+        index = it->second;
+        unindexStatic(index);
+        show(_statics[index]);
+    } else {
+        index = (int)_statics.size();
+        Entry entry;
+        entry.node = node;
+        entry.seen = 0;
+        entry.shown = 0;
+        entry.culled = false;
+        _statics.push_back(entry);
+        _staticIndex[node.get()] = index;
+    }
+    _statics[index].bounds = node->getBoundingRect();
+    indexStatic(index);
+
+    // Treat the node as in view, so the next pass hides it if it is not
+    _shown.push_back(index);
+}
+
+/**
+ * Adds a node that may move.
+ *
+ * @param node  A child of the root
+ */
+void SceneCuller::addMoving(const std::shared_ptr<scene2::SceneNode>& node) {
+    if (node == nullptr) {
+        return;
+    }
+    for (Entry& entry : _moving) {
+        if (entry.node == node) {
+            show(entry);
+            return;
+        }
+    }
+    Entry entry;
+    entry.node = node;
+    entry.first = 0;
+    entry.last = -1;
+    entry.seen = 0;
+    entry.shown = 0;
+    entry.culled = false;
+    _moving.push_back(entry);
+}
+
+/**
+ * Shows every node the culler hid, and forgets all nodes.
+ */
+void SceneCuller::clear() {
+    for (Entry& entry : _statics) {
+        show(entry);
+    }
+    for (Entry& entry : _moving) {
+        show(entry);
+    }
+    _statics.clear();
+    _staticIndex.clear();
+    _columns.clear();
+    _firstColumn = 0;
+    _shown.clear();
+    _wasShown.clear();
+    _moving.clear();
+    _visibleCount = 0;
+}
+
+/** Adds a static node to the columns overlapping its bounds */
+void SceneCuller::indexStatic(int index) {
+    Entry& entry = _statics[index];
+    entry.first = getColumn(entry.bounds.getMinX());
+    entry.last = getColumn(entry.bounds.getMaxX());
+
+    // Grow the index to hold the columns of the node
+    if (_columns.empty()) {
+        _firstColumn = entry.first;
+    } else if (entry.first < _firstColumn) {
+        _columns.insert(_columns.begin(), _firstColumn - entry.first, std::vector<int>());
+        _firstColumn = entry.first;
+    }
+    if (entry.last - _firstColumn >= (int)_columns.size()) {
+        _columns.resize(entry.last - _firstColumn + 1);
+    }
+
+    for (int col = entry.first; col <= entry.last; col++) {
+        _columns[col - _firstColumn].push_back(index);
+    }
+}
+
+/** Removes a static node from the columns it was indexed in */
+void SceneCuller::unindexStatic(int index) {
+    Entry& entry = _statics[index];
+    for (int col = entry.first; col <= entry.last; col++) {
+        std::vector<int>& column = _columns[col - _firstColumn];
+        auto it = std::find(column.begin(), column.end(), index);
+        if (it != column.end()) {
+            *it = column.back();
+            column.pop_back();
+        }
+    }
+}
+
+/** Hides the node of an entry, if it is visible */
+void SceneCuller::hide(Entry& entry) {
+    if (entry.node->isVisible()) {
+        entry.node->setVisible(false);
+        entry.culled = true;
+    }
+}
+
+/** Shows the node of an entry, if the culler hid it */
+void SceneCuller::show(Entry& entry) {
+    if (entry.culled) {
+        entry.node->setVisible(true);
+        entry.culled = false;
+    }
+}
+
+#pragma mark -
+#pragma mark Culling
+/**
+ * Hides the nodes outside the camera view, and shows those back inside it.
+ *
+ * If the root is not in a scene with a camera, every node is shown.
+ */
+void SceneCuller::update() {
+    Rect view;
+    if (!getVisibleRect(_root.get(), view)) {
+        for (Entry& entry : _statics) {
+            show(entry);
+        }
+        for (Entry& entry : _moving) {
+            show(entry);
+        }
+        _visibleCount = getNodeCount();
+        return;
+    }
+    view.origin -= Vec2(CULL_MARGIN, CULL_MARGIN);
+    view.size += Size(2 * CULL_MARGIN, 2 * CULL_MARGIN);
+
+    _pass++;
+    _visibleCount = 0;
+    std::swap(_shown, _wasShown);
+    _shown.clear();
+
+    // Show the static nodes in the columns in view
+    int first = std::max(getColumn(view.getMinX()), _firstColumn);
+    int last = std::min(getColumn(view.getMaxX()), _firstColumn + (int)_columns.size() - 1);
+    for (int col = first; col <= last; col++) {
+        for (int index : _columns[col - _firstColumn]) {
+            Entry& entry = _statics[index];
+            if (entry.seen == _pass) {
+                continue;
+            }
+            entry.seen = _pass;
+            if (isAttached(entry) && entry.bounds.doesIntersect(view)) {
+                entry.shown = _pass;
+                show(entry);
+                _shown.push_back(index);
+                _visibleCount++;
+            }
+        }
+    }
+
+    // Hide the static nodes that were in view and are not anymore
+    for (int index : _wasShown) {
+        Entry& entry = _statics[index];
+        if (entry.shown != _pass && isAttached(entry)) {
+            hide(entry);
+        }
+    }
+
+    // Moving nodes are checked one by one
+    for (size_t ii = 0; ii < _moving.size(); ) {
+        Entry& entry = _moving[ii];
+        if (!isAttached(entry)) {
+            // Its owner took it out of the scene, so give it back as it was
+            show(entry);
+            entry = std::move(_moving.back());
+            _moving.pop_back();
+            continue;
+        }
+        if (entry.node->getBoundingRect().doesIntersect(view)) {
+            show(entry);
+            _visibleCount++;
+        } else {
+            hide(entry);
+        }
+        ii++;
+    }
+}
+
+/**
+ * Computes the rectangle of a node seen by the camera of its scene.
+ *
+ * @param node  The node
+ * @param rect  The rectangle (in node coordinates)
+ *
+ * @return false if the node is not in a scene with a camera
+ */
+bool SceneCuller::getVisibleRect(scene2::SceneNode* node, Rect& rect) {
+    scene2::Scene2* scene = node->getScene();
+    if (scene == nullptr || scene->getCamera() == nullptr) {
+        return false;
+    }
+
+    std::shared_ptr<Camera> camera = scene->getCamera();
+    Rect viewport = camera->getViewport();
+    Vec2 corner1 = node->worldToNodeCoords(camera->screenToWorldCoords(viewport.origin));
+    Vec2 corner2 = node->worldToNodeCoords(camera->screenToWorldCoords(viewport.origin + viewport.size));
+    rect.origin = Vec2(std::min(corner1.x, corner2.x), std::min(corner1.y, corner2.y));
+    rect.size = Size(std::abs(corner2.x - corner1.x), std::abs(corner2.y - corner1.y));
+    return true;
+}
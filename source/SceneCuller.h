@@ -0,0 +1,178 @@
+//
+//  SceneCuller.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_SCENE_CULLER_H__
+#define __SSB_SCENE_CULLER_H__
+#include <cugl/cugl.h>
+#include <cmath>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+using namespace cugl;
+
+/** The width of a column of the static index (in node coordinates) */
+#define CULL_COLUMN_WIDTH   512.0f
+/** The distance around the camera view that still counts as visible (in node coordinates) */
+#define CULL_MARGIN         64.0f
+
+/**
+ * Hides the children of a node that the camera of its scene cannot see.
+ *
+ * A hidden node is skipped by the scene graph, so it never reaches the
+ * sprite batch. Static nodes (the level geometry) are indexed once by
+ * the columns their bounds overlap, so a pass only looks at the columns in
+ * view and at the nodes that were visible the pass before. Moving nodes
+ * (bodies, parallax layers and player placed objects) are few, and their
+ * bounds are checked every pass.
+ *
+ * The culler only hides nodes that are visible, and only shows nodes it hid
+ * itself, so objects can still hide their own nodes. A node that is taken
+ * out of the root is left alone (a moving node is shown again and dropped).
+ */
+class SceneCuller {
+private:
+    /** A node tracked by the culler */
+    struct Entry {
+        /** The node (a child of the root) */
+        std::shared_ptr<scene2::SceneNode> node;
+        /** The bounds of the node when it was indexed (static nodes only) */
+        Rect bounds;
+        /** The first and last column of the bounds (static nodes only) */
+        int first, last;
+        /** The last pass that looked at this node */
+        Uint32 seen;
+        /** The last pass that found this node in view */
+        Uint32 shown;
+        /** Whether the culler hid this node */
+        bool culled;
+    };
+
+    /** The node whose children are culled */
+    std::shared_ptr<scene2::SceneNode> _root;
+    /** The width of a column (in node coordinates) */
+    float _columnWidth;
+    /** The static nodes */
+    std::vector<Entry> _statics;
+    /** The position in _statics of each static node */
+    std::unordered_map<scene2::SceneNode*, int> _staticIndex;
+    /** The static nodes overlapping each column, starting at column _firstColumn */
+    std::vector<std::vector<int>> _columns;
+    /** The column of _columns[0] */
+    int _firstColumn;
+    /** The static nodes found in view by the last pass */
+    std::vector<int> _shown;
+    /** The static nodes found in view by the pass before (reused storage) */
+    std::vector<int> _wasShown;
+    /** The moving nodes */
+    std::vector<Entry> _moving;
+    /** The number of passes so far */
+    Uint32 _pass;
+    /** The number of nodes found in view by the last pass */
+    size_t _visibleCount;
+
+    /** Returns the column holding the given x coordinate */
+    int getColumn(float x) const { return (int)std::floor(x / _columnWidth); }
+
+    /** Adds a static node to the columns overlapping its bounds */
+    void indexStatic(int index);
+
+    /** Removes a static node from the columns it was indexed in */
+    void unindexStatic(int index);
+
+    /** Returns true if the node is still a child of the root */
+    bool isAttached(const Entry& entry) const { return entry.node->getParent() == _root.get(); }
+
+    /** Hides the node of an entry, if it is visible */
+    static void hide(Entry& entry);
+
+    /** Shows the node of an entry, if the culler hid it */
+    static void show(Entry& entry);
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates a culler with no root.
+     */
+    SceneCuller() : _columnWidth(CULL_COLUMN_WIDTH), _firstColumn(0), _pass(0), _visibleCount(0) {}
+
+    /**
+     * Initializes a culler for the children of the given node.
+     *
+     * @param root          The node whose children are culled
+     * @param columnWidth   The width of a column of the static index (in node coordinates)
+     *
+     * @return true if the culler was initialized properly
+     */
+    bool init(const std::shared_ptr<scene2::SceneNode>& root, float columnWidth = CULL_COLUMN_WIDTH);
+
+    /**
+     * Returns a newly allocated culler for the children of the given node.
+     *
+     * @param root          The node whose children are culled
+     * @param columnWidth   The width of a column of the static index (in node coordinates)
+     *
+     * @return a newly allocated culler
+     */
+    static std::shared_ptr<SceneCuller> alloc(const std::shared_ptr<scene2::SceneNode>& root,
+                                              float columnWidth = CULL_COLUMN_WIDTH) {
+        std::shared_ptr<SceneCuller> result = std::make_shared<SceneCuller>();
+        return (result->init(root, columnWidth) ? result : nullptr);
+    }
+
+#pragma mark Nodes
+    /**
+     * Adds a node that does not move.
+     *
+     * The node is indexed by its current bounds. Adding a node again
+     * indexes it by its new bounds.
+     *
+     * @param node  A child of the root
+     */
+    void addStatic(const std::shared_ptr<scene2::SceneNode>& node);
+
+    /**
+     * Adds a node that may move.
+     *
+     * @param node  A child of the root
+     */
+    void addMoving(const std::shared_ptr<scene2::SceneNode>& node);
+
+    /** Returns true if the node was added as a static node */
+    bool hasStatic(const std::shared_ptr<scene2::SceneNode>& node) const {
+        return _staticIndex.find(node.get()) != _staticIndex.end();
+    }
+
+    /**
+     * Shows every node the culler hid, and forgets all nodes.
+     */
+    void clear();
+
+#pragma mark Culling
+    /**
+     * Hides the nodes outside the camera view, and shows those back inside it.
+     *
+     * If the root is not in a scene with a camera, every node is shown.
+     */
+    void update();
+
+    /**
+     * Computes the rectangle of a node seen by the camera of its scene.
+     *
+     * @param node  The node
+     * @param rect  The rectangle (in node coordinates)
+     *
+     * @return false if the node is not in a scene with a camera
+     */
+    static bool getVisibleRect(scene2::SceneNode* node, Rect& rect);
+
+    /** Returns the number of nodes tracked */
+    size_t getNodeCount() const { return _statics.size() + _moving.size(); }
+
+    /** Returns the number of nodes found in view by the last pass */
+    size_t getVisibleCount() const { return _visibleCount; }
+};
+
+#endif /* __SSB_SCENE_CULLER_H__ */
@@ -80,17 +80,25 @@ bool Spike::init(const Vec2 pos, const Size size, float scale, float angle, stri
     return false;
 }
 
-std::map<std::string, std::any> Spike::getMap() {
-    std::map<std::string, std::any> m = {
-        {"x", double(_position.x)},
-        {"y", double(_position.y)},
-        {"width", double(_size.getIWidth())},
-        {"height", double(_size.getIHeight())},
-        {"scale", double(_drawScale)},
-        {"angle", double(_angle)},
-        {"type", std::string(_jsonType)}
-    };
-    return m;
+/**
+ * Returns the value of a level field of this object.
+ *
+ * @param field The field
+ * @param value The value of the field
+ *
+ * @return true if this object has the field
+ */
+bool Spike::getLevelField(LevelField field, double& value) const {
+    switch (field) {
+        case FIELD_SCALE:
+            value = _drawScale;
+            return true;
+        case FIELD_ANGLE:
+            value = _angle;
+            return true;
+        default:
+            return Object::getLevelField(field, value);
+    }
 }
 
 
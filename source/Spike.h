@@ -79,7 +79,15 @@ public:
         _node->setAngle(angle);
     }
 
-    std::map<std::string, std::any> getMap() override;
+    /**
+     * Returns the value of a level field of this object.
+     *
+     * @param field The field
+     * @param value The value of the field
+     *
+     * @return true if this object has the field
+     */
+    bool getLevelField(LevelField field, double& value) const override;
 
     /* Gets the angle for the hitbox.
     * @return the angle for the hitbox */
@@ -0,0 +1,159 @@
+//
+//  StartupTrace.cpp
+//  SweetSweetBetrayal
+//
+
+#include "StartupTrace.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+using namespace cugl;
+
+/** The process start (as close as we can get: static initialization) */
+static const std::chrono::steady_clock::time_point PROCESS_START = std::chrono::steady_clock::now();
+
+/** The lock for the spans */
+static std::mutex TRACE_MUTEX;
+/** The finished spans */
+static std::vector<StartupTrace::Span> TRACE_SPANS;
+/** The open spans, by thread and name */
+static std::unordered_map<std::string, Uint64> TRACE_OPEN;
+/** Whether the trace has been finished */
+static std::atomic<bool> TRACE_FINISHED(false);
+/** The next thread number */
+static std::atomic<int> TRACE_THREADS(0);
+
+/** Returns the number of this thread (0 for the first thread to record) */
+static int getThread() {
+    thread_local int thread = TRACE_THREADS++;
+    return thread;
+}
+
+/** Returns the time since the process started (in microseconds) */
+Uint64 StartupTrace::now() {
+    auto time = std::chrono::steady_clock::now() - PROCESS_START;
+    return (Uint64)std::chrono::duration_cast<std::chrono::microseconds>(time).count();
+}
+
+/**
+ * Starts a span on this thread.
+ *
+ * @param name  The span name
+ */
+void StartupTrace::begin(const std::string& name) {
+    if (TRACE_FINISHED) {
+        return;
+    }
+    Uint64 time = now();
+    std::lock_guard<std::mutex> lock(TRACE_MUTEX);
+    TRACE_OPEN[std::to_string(getThread()) + ":" + name] = time;
+}
+
+/**
+ * Ends the span on this thread with the given name.
+ *
+ * @param name  The span name
+ */
+void StartupTrace::end(const std::string& name) {
+    if (TRACE_FINISHED) {
+        return;
+    }
+    Uint64 time = now();
+    int thread = getThread();
+    std::lock_guard<std::mutex> lock(TRACE_MUTEX);
+    auto it = TRACE_OPEN.find(std::to_string(thread) + ":" + name);
+    if (it == TRACE_OPEN.end()) {
+        return;
+    }
+    TRACE_SPANS.push_back({ name, it->second, time - it->second, thread });
+    TRACE_OPEN.erase(it);
+}
+
+/**
+ * Records a span that has already ended.
+ *
+ * @param name  The span name
+ * @param start The start time (from {@link #now})
+ * @param end   The end time (from {@link #now})
+ */
+void StartupTrace::record(const std::string& name, Uint64 start, Uint64 end) {
+    if (TRACE_FINISHED) {
+        return;
+    }
+    int thread = getThread();
+    std::lock_guard<std::mutex> lock(TRACE_MUTEX);
+    TRACE_SPANS.push_back({ name, start, end > start ? end - start : 0, thread });
+}
+
+/**
+ * Records an instant, such as the first menu frame.
+ *
+ * @param name  The instant name
+ */
+void StartupTrace::mark(const std::string& name) {
+    Uint64 time = now();
+    record(name, time, time);
+}
+
+/** Returns a copy of the finished spans, in the order they ended */
+std::vector<StartupTrace::Span> StartupTrace::getSpans() {
+    std::lock_guard<std::mutex> lock(TRACE_MUTEX);
+    return TRACE_SPANS;
+}
+
+/** Returns true if the trace has been finished */
+bool StartupTrace::isFinished() {
+    return TRACE_FINISHED;
+}
+
+/**
+ * Finishes the trace and writes it as Chrome trace JSON.
+ *
+ * Spans become complete ("X") events and instants become global instant
+ * ("i") events, all in one process.
+ *
+ * @param file  The full path of the trace file (empty to not write it)
+ *
+ * @return true if the trace was written
+ */
+bool StartupTrace::finish(const std::string& file) {
+    if (TRACE_FINISHED.exchange(true)) {
+        return false;
+    }
+    std::vector<Span> spans = getSpans();
+    if (file.empty()) {
+        return false;
+    }
+
+    std::shared_ptr<JsonValue> events = JsonValue::allocArray();
+    for (auto& span : spans) {
+        std::shared_ptr<JsonValue> event = JsonValue::allocObject();
+        event->appendValue("name", span.name);
+        event->appendValue("cat", std::string("startup"));
+        event->appendValue("ph", std::string(span.duration > 0 ? "X" : "i"));
+        event->appendValue("ts", (double)span.start);
+        if (span.duration > 0) {
+            event->appendValue("dur", (double)span.duration);
+        } else {
+            event->appendValue("s", std::string("g"));
+        }
+        event->appendValue("pid", (long)1);
+        event->appendValue("tid", (long)span.thread);
+        events->appendChild(event);
+    }
+    std::shared_ptr<JsonValue> trace = JsonValue::allocObject();
+    trace->appendChild("traceEvents", events);
+    trace->appendValue("displayTimeUnit", std::string("ms"));
+
+    std::shared_ptr<JsonWriter> writer = JsonWriter::alloc(file);
+    if (writer == nullptr) {
+        CULogError("Could not write startup trace %s", file.c_str());
+        return false;
+    }
+    writer->writeJson(trace);
+    writer->close();
+    CULog("Wrote startup trace %s (%zu spans)", file.c_str(), spans.size());
+    return true;
+}
@@ -0,0 +1,115 @@
+//
+//  StartupTrace.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_STARTUP_TRACE_H__
+#define __SSB_STARTUP_TRACE_H__
+#include <cugl/cugl.h>
+#include <string>
+#include <vector>
+
+using namespace cugl;
+
+/** The trace written to the save directory at the first menu frame */
+#define STARTUP_TRACE_FILE  "startup-trace.json"
+
+/**
+ * A timeline of named spans from process start to the first menu frame.
+ *
+ * Spans are timed in microseconds since the process started, and may be
+ * recorded from any thread. {@link #finish} writes them as a Chrome trace
+ * (open it in chrome://tracing or Perfetto), after which nothing more is
+ * recorded, so tracing costs nothing once the game is running.
+ *
+ * Spans with the same name must not overlap on one thread. Use a
+ * {@link StartupSpan} to time a block.
+ */
+class StartupTrace {
+public:
+    /** A finished span */
+    struct Span {
+        /** The span name */
+        std::string name;
+        /** The start time (in microseconds since process start) */
+        Uint64 start;
+        /** The duration (in microseconds; 0 for an instant) */
+        Uint64 duration;
+        /** A small number for the recording thread */
+        int thread;
+    };
+
+    /** Returns the time since the process started (in microseconds) */
+    static Uint64 now();
+
+    /**
+     * Starts a span on this thread.
+     *
+     * @param name  The span name
+     */
+    static void begin(const std::string& name);
+
+    /**
+     * Ends the span on this thread with the given name.
+     *
+     * @param name  The span name
+     */
+    static void end(const std::string& name);
+
+    /**
+     * Records a span that has already ended.
+     *
+     * @param name  The span name
+     * @param start The start time (from {@link #now})
+     * @param end   The end time (from {@link #now})
+     */
+    static void record(const std::string& name, Uint64 start, Uint64 end);
+
+    /**
+     * Records an instant, such as the first menu frame.
+     *
+     * @param name  The instant name
+     */
+    static void mark(const std::string& name);
+
+    /** Returns a copy of the finished spans, in the order they ended */
+    static std::vector<Span> getSpans();
+
+    /** Returns true if the trace has been finished */
+    static bool isFinished();
+
+    /**
+     * Finishes the trace and writes it as Chrome trace JSON.
+     *
+     * Later calls do nothing. Spans that are still open are dropped.
+     *
+     * @param file  The full path of the trace file (empty to not write it)
+     *
+     * @return true if the trace was written
+     */
+    static bool finish(const std::string& file);
+};
+
+/**
+ * A span that lasts as long as this object.
+ */
+class StartupSpan {
+private:
+    /** The span name */
+    std::string _name;
+
+public:
+    /**
+     * Starts a span with the given name.
+     *
+     * @param name  The span name
+     */
+    StartupSpan(const std::string& name) : _name(name) { StartupTrace::begin(_name); }
+
+    /**
+     * Ends the span.
+     */
+    ~StartupSpan() { StartupTrace::end(_name); }
+};
+
+#endif /* __SSB_STARTUP_TRACE_H__ */
@@ -0,0 +1,181 @@
+//
+//  StaticLayerNode.cpp
+//  SweetSweetBetrayal
+//
+
+#include "StaticLayerNode.h"
+#include <algorithm>
+
+using namespace cugl;
+using namespace cugl::graphics;
+
+#pragma mark -
+#pragma mark Constructors
+/**
+ * Initializes an empty chunk.
+ *
+ * @return true if the chunk was initialized properly
+ */
+bool StaticLayerNode::init() {
+    if (!scene2::SceneNode::init()) {
+        return false;
+    }
+    _quads.clear();
+    _runs.clear();
+    _bounds = Rect::ZERO;
+    _dirty = false;
+    setAnchor(Vec2::ANCHOR_BOTTOM_LEFT);
+    return true;
+}
+
+#pragma mark -
+#pragma mark Sprites
+/**
+ * Bakes a sprite into this chunk, and hides it.
+ *
+ * The sprite must show the first frame of a single frame sheet, and must
+ * have the same parent as this node. It is baked where it is now.
+ *
+ * @param sprite    The sprite to bake
+ *
+ * @return true if the sprite was baked
+ */
+bool StaticLayerNode::addSprite(const std::shared_ptr<scene2::SpriteNode>& sprite) {
+    if (sprite == nullptr || sprite->getTexture() == nullptr || sprite->getSpan() != 1) {
+        return false;
+    }
+    Size size = sprite->getContentSize();
+    if (size.width <= 0 || size.height <= 0) {
+        return false;
+    }
+
+    Quad quad;
+    quad.sprite = sprite;
+    quad.texture = sprite->getTexture();
+    quad.color = sprite->getColor().getPacked();
+
+    // Corners go counter-clockwise from the bottom left, with texture
+    // coordinates chosen the same way as a TexturedNode
+    const Affine2& matrix = sprite->getNodeToParentTransform();
+    float minX = 0, minY = 0, maxX = 0, maxY = 0;
+    for (int ii = 0; ii < 4; ii++) {
+        float s = (ii == 1 || ii == 2) ? 1.0f : 0.0f;
+        float t = (ii >= 2) ? 1.0f : 0.0f;
+        quad.corners[ii] = matrix.transform(Vec2(s * size.width, t * size.height));
+        if (sprite->isFlipHorizontal()) {
+            s = 1 - s;
+        }
+        if (!sprite->isFlipVertical()) {
+            t = 1 - t;
+        }
+        quad.texcoords[ii].x = s * quad.texture->getMaxS() + (1 - s) * quad.texture->getMinS();
+        quad.texcoords[ii].y = t * quad.texture->getMaxT() + (1 - t) * quad.texture->getMinT();
+
+        const Vec2& corner = quad.corners[ii];
+        minX = (ii == 0) ? corner.x : std::min(minX, corner.x);
+        minY = (ii == 0) ? corner.y : std::min(minY, corner.y);
+        maxX = (ii == 0) ? corner.x : std::max(maxX, corner.x);
+        maxY = (ii == 0) ? corner.y : std::max(maxY, corner.y);
+    }
+
+    // Grow the node to cover the new sprite
+    if (!_quads.empty()) {
+        minX = std::min(minX, _bounds.getMinX());
+        minY = std::min(minY, _bounds.getMinY());
+        maxX = std::max(maxX, _bounds.getMaxX());
+        maxY = std::max(maxY, _bounds.getMaxY());
+    }
+    _bounds = Rect(minX, minY, maxX - minX, maxY - minY);
+    setPosition(_bounds.origin);
+    setContentSize(_bounds.size);
+
+    sprite->setVisible(false);
+    _quads.push_back(quad);
+    _dirty = true;
+    return true;
+}
+
+/**
+ * Shows every sprite baked into this chunk again, and forgets them.
+ */
+void StaticLayerNode::clear() {
+    for (Quad& quad : _quads) {
+        quad.sprite->setVisible(true);
+    }
+    _quads.clear();
+    _runs.clear();
+    _dirty = false;
+}
+
+#pragma mark -
+#pragma mark Drawing
+/**
+ * Rebuilds the meshes from the baked sprites.
+ *
+ * Sprites that left the scene are dropped first.
+ */
+void StaticLayerNode::rebuild() {
+    scene2::SceneNode* parent = getParent();
+    _quads.erase(std::remove_if(_quads.begin(), _quads.end(), [=](const Quad& quad) {
+        return quad.sprite->getParent() != parent;
+    }), _quads.end());
+    _runs.clear();
+    _dirty = false;
+
+    SpriteVertex vertex;
+    vertex.gradcoord = Vec2::ZERO;
+    for (const Quad& quad : _quads) {
+        // Start a new run when the texture changes, so the drawing order is kept
+        if (_runs.empty() || _runs.back().texture != quad.texture) {
+            _runs.emplace_back();
+            _runs.back().texture = quad.texture;
+            _runs.back().mesh.command = GL_TRIANGLES;
+        }
+        Mesh<SpriteVertex>& mesh = _runs.back().mesh;
+
+        Uint32 base = (Uint32)mesh.vertices.size();
+        vertex.color = quad.color;
+        for (int ii = 0; ii < 4; ii++) {
+            vertex.position = quad.corners[ii] - _bounds.origin;
+            vertex.texcoord = quad.texcoords[ii];
+            mesh.vertices.push_back(vertex);
+        }
+        mesh.indices.push_back(base);
+        mesh.indices.push_back(base + 1);
+        mesh.indices.push_back(base + 2);
+        mesh.indices.push_back(base);
+        mesh.indices.push_back(base + 2);
+        mesh.indices.push_back(base + 3);
+    }
+}
+
+/**
+ * Draws the baked sprites with the given SpriteBatch.
+ *
+ * Checking for sprites that left the scene only reads a pointer per sprite,
+ * and only for the chunks that are drawn.
+ *
+ * @param batch     The SpriteBatch to draw with.
+ * @param transform The global transformation matrix.
+ * @param tint      The tint to blend with the sprite colors.
+ */
+void StaticLayerNode::draw(const std::shared_ptr<SpriteBatch>& batch, const Affine2& transform, Color4 tint) {
+    if (!_dirty) {
+        scene2::SceneNode* parent = getParent();
+        for (const Quad& quad : _quads) {
+            if (quad.sprite->getParent() != parent) {
+                _dirty = true;
+                break;
+            }
+        }
+    }
+    if (_dirty) {
+        rebuild();
+    }
+
+    batch->setColor(tint);
+    for (const Run& run : _runs) {
+        batch->setTexture(run.texture);
+        batch->drawMesh(run.mesh, transform);
+    }
+}
@@ -0,0 +1,128 @@
+//
+//  StaticLayerNode.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_STATIC_LAYER_NODE_H__
+#define __SSB_STATIC_LAYER_NODE_H__
+#include <cugl/cugl.h>
+#include <memory>
+#include <vector>
+
+using namespace cugl;
+using namespace cugl::graphics;
+
+/**
+ * A chunk of one layer of level art, baked into meshes.
+ *
+ * Sprites that never move (tiles and still art objects) are copied into this
+ * node as textured quads, and hidden. The quads are written into one mesh per
+ * run of sprites with the same texture, so the whole chunk is a few calls to
+ * the SpriteBatch, and none of the sprites is transformed again. Textures on
+ * the same atlas page do not even flush the batch between runs.
+ *
+ * A baked sprite is dropped when it leaves the scene (such as a tile blown up
+ * by a bomb), and the meshes are rebuilt the next time the chunk is drawn.
+ * The node is in the coordinates of the parent of its sprites, offset to the
+ * bottom left of their bounds.
+ */
+class StaticLayerNode : public scene2::SceneNode {
+private:
+    /** A baked sprite */
+    struct Quad {
+        /** The sprite (hidden while it is baked) */
+        std::shared_ptr<scene2::SpriteNode> sprite;
+        /** The texture of the sprite */
+        std::shared_ptr<Texture> texture;
+        /** The corners of the sprite (in parent coordinates) */
+        Vec2 corners[4];
+        /** The texture coordinates of each corner */
+        Vec2 texcoords[4];
+        /** The packed color of the sprite */
+        GLuint color;
+    };
+
+    /** The quads with the same texture, in drawing order */
+    struct Run {
+        /** The texture of the run */
+        std::shared_ptr<Texture> texture;
+        /** The quads of the run (in node coordinates) */
+        Mesh<SpriteVertex> mesh;
+    };
+
+    /** The baked sprites, in drawing order */
+    std::vector<Quad> _quads;
+    /** The meshes to draw */
+    std::vector<Run> _runs;
+    /** The bounds of the baked sprites (in parent coordinates) */
+    Rect _bounds;
+    /** Whether the meshes must be rebuilt */
+    bool _dirty;
+
+    /**
+     * Rebuilds the meshes from the baked sprites.
+     *
+     * Sprites that left the scene are dropped first.
+     */
+    void rebuild();
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates an empty chunk.
+     */
+    StaticLayerNode() : _dirty(false) {}
+
+    /**
+     * Initializes an empty chunk.
+     *
+     * @return true if the chunk was initialized properly
+     */
+    virtual bool init() override;
+
+    /**
+     * Returns a newly allocated empty chunk.
+     *
+     * @return a newly allocated empty chunk
+     */
+    static std::shared_ptr<StaticLayerNode> alloc() {
+        std::shared_ptr<StaticLayerNode> result = std::make_shared<StaticLayerNode>();
+        return (result->init() ? result : nullptr);
+    }
+
+#pragma mark Sprites
+    /**
+     * Bakes a sprite into this chunk, and hides it.
+     *
+     * The sprite must show the first frame of a single frame sheet, and must
+     * have the same parent as this node. It is baked where it is now.
+     *
+     * @param sprite    The sprite to bake
+     *
+     * @return true if the sprite was baked
+     */
+    bool addSprite(const std::shared_ptr<scene2::SpriteNode>& sprite);
+
+    /**
+     * Shows every sprite baked into this chunk again, and forgets them.
+     */
+    void clear();
+
+    /** Returns the number of baked sprites */
+    size_t getSpriteCount() const { return _quads.size(); }
+
+    /** Returns the number of meshes drawn (as of the last rebuild) */
+    size_t getRunCount() const { return _runs.size(); }
+
+#pragma mark Drawing
+    /**
+     * Draws the baked sprites with the given SpriteBatch.
+     *
+     * @param batch     The SpriteBatch to draw with.
+     * @param transform The global transformation matrix.
+     * @param tint      The tint to blend with the sprite colors.
+     */
+    virtual void draw(const std::shared_ptr<SpriteBatch>& batch, const Affine2& transform, Color4 tint) override;
+};
+
+#endif /* __SSB_STATIC_LAYER_NODE_H__ */
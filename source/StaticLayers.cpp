@@ -0,0 +1,122 @@
+//
+//  StaticLayers.cpp
+//  SweetSweetBetrayal
+//
+
+#include "StaticLayers.h"
+#include <cmath>
+#include <unordered_set>
+
+using namespace cugl;
+
+#pragma mark -
+#pragma mark Constructors
+/**
+ * Initializes empty layers for the children of the given node.
+ *
+ * @param root          The node holding the sprites
+ * @param culler        The culler for the chunks (nullptr if none)
+ * @param chunkWidth    The width of a chunk (in node coordinates)
+ *
+ * @return true if the layers were initialized properly
+ */
+bool StaticLayers::init(const std::shared_ptr<scene2::SceneNode>& root, const std::shared_ptr<SceneCuller>& culler,
+                        float chunkWidth) {
+    if (root == nullptr || chunkWidth <= 0) {
+        return false;
+    }
+    _root = root;
+    _culler = culler;
+    _chunkWidth = chunkWidth;
+    return true;
+}
+
+#pragma mark -
+#pragma mark Baking
+/**
+ * Queues a node to be baked.
+ *
+ * Only sprites showing a single frame sheet can be baked. The node must
+ * not move once it is baked.
+ *
+ * @param node  A child of the root
+ *
+ * @return true if the node will be baked (false if it must be drawn as usual)
+ */
+bool StaticLayers::add(const std::shared_ptr<scene2::SceneNode>& node) {
+    std::shared_ptr<scene2::SpriteNode> sprite = std::dynamic_pointer_cast<scene2::SpriteNode>(node);
+    if (sprite == nullptr || sprite->getTexture() == nullptr || sprite->getSpan() != 1) {
+        return false;
+    }
+    _pending.push_back(sprite);
+    return true;
+}
+
+/**
+ * Bakes the queued sprites into their chunks.
+ *
+ * This should be called before the scene is drawn. It does nothing if no
+ * sprite is queued.
+ */
+void StaticLayers::update() {
+    if (_pending.empty()) {
+        return;
+    }
+
+    std::unordered_set<StaticLayerNode*> touched;
+    for (auto& sprite : _pending) {
+        // The object was removed before it was baked
+        if (sprite->getParent() != _root.get()) {
+            continue;
+        }
+
+        Rect bounds = sprite->getBoundingRect();
+        int column = (int)std::floor(bounds.getMidX() / _chunkWidth);
+        std::pair<float, int> key = std::make_pair(sprite->getPriority(), column);
+        auto it = _chunks.find(key);
+        if (it == _chunks.end()) {
+            std::shared_ptr<StaticLayerNode> chunk = StaticLayerNode::alloc();
+            chunk->setPriority(key.first);
+            _root->addChild(chunk);
+            it = _chunks.emplace(key, chunk).first;
+        }
+        if (!it->second->addSprite(sprite)) {
+            CULog("Could not bake a sprite of layer %d", (int)key.first);
+            continue;
+        }
+        touched.insert(it->second.get());
+    }
+    _pending.clear();
+
+    // Index the chunks again now that their bounds have grown
+    if (_culler) {
+        for (auto& entry : _chunks) {
+            if (touched.count(entry.second.get())) {
+                _culler->addStatic(entry.second);
+            }
+        }
+    }
+}
+
+/**
+ * Shows every baked sprite again, and removes the chunks from the root.
+ */
+void StaticLayers::clear() {
+    for (auto& entry : _chunks) {
+        entry.second->clear();
+        if (entry.second->getParent()) {
+            entry.second->removeFromParent();
+        }
+    }
+    _chunks.clear();
+    _pending.clear();
+}
+
+/** Returns the number of baked sprites */
+size_t StaticLayers::getSpriteCount() const {
+    size_t count = 0;
+    for (auto& entry : _chunks) {
+        count += entry.second->getSpriteCount();
+    }
+    return count;
+}
@@ -0,0 +1,115 @@
+//
+//  StaticLayers.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_STATIC_LAYERS_H__
+#define __SSB_STATIC_LAYERS_H__
+#include <cugl/cugl.h>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "StaticLayerNode.h"
+#include "SceneCuller.h"
+
+using namespace cugl;
+
+/** The width of a chunk of a baked layer (in node coordinates) */
+#define STATIC_CHUNK_WIDTH  1024.0f
+
+/**
+ * The level art that never moves, baked into chunks of each layer.
+ *
+ * Sprites are queued as the level is loaded, and baked by the next
+ * {@link #update} (so they are baked where the level load leaves them).
+ * Each sprite goes to the {@link StaticLayerNode} of its layer (the drawing
+ * priority set from jsonTypeToLayer) and of the column of the level it is in.
+ * The chunk is added to the root at that priority, so the layers still draw
+ * in order with the nodes that are not baked.
+ *
+ * If there is a culler, chunks are added to it as static nodes, so only the
+ * chunks near the camera are drawn.
+ */
+class StaticLayers {
+private:
+    /** The node holding the sprites and chunks */
+    std::shared_ptr<scene2::SceneNode> _root;
+    /** The culler for the chunks (nullptr if none) */
+    std::shared_ptr<SceneCuller> _culler;
+    /** The width of a chunk (in node coordinates) */
+    float _chunkWidth;
+    /** The chunks, by layer and column */
+    std::map<std::pair<float, int>, std::shared_ptr<StaticLayerNode>> _chunks;
+    /** The sprites waiting to be baked */
+    std::vector<std::shared_ptr<scene2::SpriteNode>> _pending;
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates empty layers with no root.
+     */
+    StaticLayers() : _chunkWidth(STATIC_CHUNK_WIDTH) {}
+
+    /**
+     * Initializes empty layers for the children of the given node.
+     *
+     * @param root          The node holding the sprites
+     * @param culler        The culler for the chunks (nullptr if none)
+     * @param chunkWidth    The width of a chunk (in node coordinates)
+     *
+     * @return true if the layers were initialized properly
+     */
+    bool init(const std::shared_ptr<scene2::SceneNode>& root, const std::shared_ptr<SceneCuller>& culler,
+              float chunkWidth = STATIC_CHUNK_WIDTH);
+
+    /**
+     * Returns newly allocated empty layers for the children of the given node.
+     *
+     * @param root          The node holding the sprites
+     * @param culler        The culler for the chunks (nullptr if none)
+     * @param chunkWidth    The width of a chunk (in node coordinates)
+     *
+     * @return newly allocated empty layers
+     */
+    static std::shared_ptr<StaticLayers> alloc(const std::shared_ptr<scene2::SceneNode>& root,
+                                               const std::shared_ptr<SceneCuller>& culler,
+                                               float chunkWidth = STATIC_CHUNK_WIDTH) {
+        std::shared_ptr<StaticLayers> result = std::make_shared<StaticLayers>();
+        return (result->init(root, culler, chunkWidth) ? result : nullptr);
+    }
+
+#pragma mark Baking
+    /**
+     * Queues a node to be baked.
+     *
+     * Only sprites showing a single frame sheet can be baked. The node must
+     * not move once it is baked.
+     *
+     * @param node  A child of the root
+     *
+     * @return true if the node will be baked (false if it must be drawn as usual)
+     */
+    bool add(const std::shared_ptr<scene2::SceneNode>& node);
+
+    /**
+     * Bakes the queued sprites into their chunks.
+     *
+     * This should be called before the scene is drawn. It does nothing if no
+     * sprite is queued.
+     */
+    void update();
+
+    /**
+     * Shows every baked sprite again, and removes the chunks from the root.
+     */
+    void clear();
+
+    /** Returns the number of chunks */
+    size_t getChunkCount() const { return _chunks.size(); }
+
+    /** Returns the number of baked sprites */
+    size_t getSpriteCount() const;
+};
+
+#endif /* __SSB_STATIC_LAYERS_H__ */
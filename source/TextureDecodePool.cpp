@@ -0,0 +1,179 @@
+//
+//  TextureDecodePool.cpp
+//  SweetSweetBetrayal
+//
+
+#include "TextureDecodePool.h"
+#include "StartupTrace.h"
+#include <SDL_image.h>
+
+using namespace cugl;
+using namespace cugl::graphics;
+
+#pragma mark -
+#pragma mark Constructors
+/**
+ * Initializes the pool with the given number of threads.
+ *
+ * @param threads   The number of worker threads
+ *
+ * @return true if the pool was initialized properly
+ */
+bool TextureDecodePool::init(int threads) {
+    if (threads < 1) {
+        return false;
+    }
+    _stop = false;
+    for (int ii = 0; ii < threads; ii++) {
+        _workers.emplace_back([this] { work(); });
+    }
+    CULog("Decoding textures on %d threads", threads);
+    return true;
+}
+
+/**
+ * Stops the threads. Jobs that were not uploaded are dropped.
+ */
+void TextureDecodePool::dispose() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _signal.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+    _workers.clear();
+
+    for (auto& job : _decoded) {
+        if (job.image != nullptr) {
+            SDL_FreeSurface(job.image);
+        }
+    }
+    _pending.clear();
+    _decoded.clear();
+    _active = 0;
+}
+
+#pragma mark -
+#pragma mark Decoding
+/**
+ * Decodes an image file, and calls back with its texture on the main thread.
+ *
+ * This method must be called on the main thread.
+ *
+ * @param key       The texture key (for logging)
+ * @param path      The full path to the image file
+ * @param callback  The callback for the texture
+ */
+void TextureDecodePool::decode(const std::string& key, const std::string& path, Callback callback) {
+    if (_active == 0) {
+        _startTime = StartupTrace::now();
+        _uploadTime = 0;
+        _count = 0;
+        std::lock_guard<std::mutex> lock(_mutex);
+        _decodeTime = 0;
+    }
+    _active++;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Job job;
+        job.key = key;
+        job.path = path;
+        job.callback = callback;
+        _pending.push_back(std::move(job));
+    }
+    _signal.notify_one();
+
+    if (!_scheduled) {
+        _scheduled = true;
+        std::weak_ptr<TextureDecodePool> self = _self;
+        Application::get()->schedule([self] {
+            std::shared_ptr<TextureDecodePool> pool = self.lock();
+            return pool != nullptr && pool->upload();
+        });
+    }
+}
+
+/**
+ * Runs a worker thread, decoding jobs until the pool stops.
+ *
+ * Each image is converted to RGBA, which is what the texture is created from.
+ */
+void TextureDecodePool::work() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _signal.wait(lock, [this] { return _stop || !_pending.empty(); });
+            if (_stop) {
+                return;
+            }
+            job = std::move(_pending.front());
+            _pending.pop_front();
+        }
+
+        Uint64 start = StartupTrace::now();
+        SDL_Surface* loaded = IMG_Load_RW(SDL_RWFromFile(job.path.c_str(), "rb"), 1);
+        if (loaded != nullptr) {
+            job.image = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+            SDL_FreeSurface(loaded);
+        }
+        Uint64 time = StartupTrace::now() - start;
+        StartupTrace::record("decode " + job.key, start, start + time);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _decodeTime += time;
+        _decoded.push_back(std::move(job));
+    }
+}
+
+/**
+ * Creates the textures for decoded jobs, until the budget is used.
+ *
+ * At least one texture is created each frame, however large it is.
+ *
+ * @return true if there are jobs left
+ */
+bool TextureDecodePool::upload() {
+    Uint64 start = StartupTrace::now();
+    do {
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_decoded.empty()) {
+                break;
+            }
+            job = std::move(_decoded.front());
+            _decoded.pop_front();
+        }
+
+        std::shared_ptr<Texture> texture;
+        if (job.image != nullptr) {
+            texture = Texture::allocWithData(job.image->pixels, job.image->w, job.image->h);
+            SDL_FreeSurface(job.image);
+        }
+        if (texture == nullptr) {
+            CULogError("Could not decode %s (%s)", job.key.c_str(), job.path.c_str());
+        }
+        _active--;
+        _count++;
+        job.callback(texture);
+    } while (StartupTrace::now() - start < TEXTURE_UPLOAD_BUDGET);
+    _uploadTime += StartupTrace::now() - start;
+
+    if (_active > 0) {
+        return true;
+    }
+    _scheduled = false;
+    Uint64 total = StartupTrace::now() - _startTime;
+    Uint64 decode;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        decode = _decodeTime;
+    }
+    CULog("Loaded %zu textures in %.1f ms: %.1f ms of decode on %zu threads (%.1fx), %.1f ms of upload",
+          _count, total / 1000.0f, decode / 1000.0f, _workers.size(),
+          total > 0 ? (float)decode / total : 0.0f, _uploadTime / 1000.0f);
+    return false;
+}
@@ -0,0 +1,154 @@
+//
+//  TextureDecodePool.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_TEXTURE_DECODE_POOL_H__
+#define __SSB_TEXTURE_DECODE_POOL_H__
+#include <cugl/cugl.h>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cugl;
+using namespace cugl::graphics;
+
+/** The main thread time spent creating textures each frame (in microseconds) */
+#define TEXTURE_UPLOAD_BUDGET   4000
+
+/**
+ * A pool of threads that decode image files for asynchronous texture loads.
+ *
+ * Decoding a PNG is most of the cost of loading a texture, and needs no GL
+ * context, so it is done on several worker threads at once. Creating the
+ * texture from the decoded pixels must happen on the main thread. The pool
+ * does this in batches scheduled once a frame, each stopping when it has used
+ * {@link TEXTURE_UPLOAD_BUDGET}, so the loading animation keeps running.
+ *
+ * When the pool runs out of work, it logs how much decode time it did and
+ * how long that took, which shows how many cores the load actually used.
+ */
+class TextureDecodePool {
+public:
+    /** The callback for a finished texture (nullptr if it failed) */
+    typedef std::function<void(const std::shared_ptr<Texture>& texture)> Callback;
+
+private:
+    /** An image file to decode */
+    struct Job {
+        /** The texture key (for logging) */
+        std::string key;
+        /** The full path to the image file */
+        std::string path;
+        /** The callback for the texture */
+        Callback callback;
+        /** The decoded RGBA pixels (nullptr until decoded, or if it failed) */
+        SDL_Surface* image = nullptr;
+    };
+
+    /** The worker threads */
+    std::vector<std::thread> _workers;
+    /** The lock for the job queues */
+    std::mutex _mutex;
+    /** The signal for a new job (or for stopping) */
+    std::condition_variable _signal;
+    /** The jobs waiting for a worker */
+    std::deque<Job> _pending;
+    /** The jobs waiting to be uploaded */
+    std::deque<Job> _decoded;
+    /** Whether the workers should stop */
+    bool _stop;
+
+    /** The jobs that have not been uploaded (main thread only) */
+    size_t _active;
+    /** Whether the upload batches are scheduled (main thread only) */
+    bool _scheduled;
+    /** This pool, for the scheduled batches */
+    std::weak_ptr<TextureDecodePool> _self;
+
+    /** The time the pool last started working */
+    Uint64 _startTime;
+    /** The total decode time since then (in microseconds, under the lock) */
+    Uint64 _decodeTime;
+    /** The total upload time since then (in microseconds) */
+    Uint64 _uploadTime;
+    /** The number of images since then */
+    size_t _count;
+
+    /**
+     * Runs a worker thread, decoding jobs until the pool stops.
+     */
+    void work();
+
+    /**
+     * Creates the textures for decoded jobs, until the budget is used.
+     *
+     * @return true if there are jobs left
+     */
+    bool upload();
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates a pool with no threads.
+     */
+    TextureDecodePool() : _stop(false), _active(0), _scheduled(false),
+    _startTime(0), _decodeTime(0), _uploadTime(0), _count(0) {}
+
+    /**
+     * Disposes of the pool, stopping the threads.
+     */
+    ~TextureDecodePool() { dispose(); }
+
+    /**
+     * Stops the threads. Jobs that were not uploaded are dropped.
+     */
+    void dispose();
+
+    /**
+     * Initializes the pool with the given number of threads.
+     *
+     * @param threads   The number of worker threads
+     *
+     * @return true if the pool was initialized properly
+     */
+    bool init(int threads);
+
+    /**
+     * Returns a newly allocated pool with the given number of threads.
+     *
+     * The default is one thread for every core but the main one.
+     *
+     * @param threads   The number of worker threads
+     *
+     * @return a newly allocated pool
+     */
+    static std::shared_ptr<TextureDecodePool> alloc(int threads = std::max(1, SDL_GetCPUCount() - 1)) {
+        std::shared_ptr<TextureDecodePool> result = std::make_shared<TextureDecodePool>();
+        result->_self = result;
+        return (result->init(threads) ? result : nullptr);
+    }
+
+#pragma mark Decoding
+    /**
+     * Decodes an image file, and calls back with its texture on the main thread.
+     *
+     * This method must be called on the main thread.
+     *
+     * @param key       The texture key (for logging)
+     * @param path      The full path to the image file
+     * @param callback  The callback for the texture
+     */
+    void decode(const std::string& key, const std::string& path, Callback callback);
+
+    /** Returns the number of worker threads */
+    size_t getThreadCount() const { return _workers.size(); }
+};
+
+#endif /* __SSB_TEXTURE_DECODE_POOL_H__ */
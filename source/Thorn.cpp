@@ -72,15 +72,4 @@ void Thorn::update(float timestep) {
     PolygonObstacle::update(timestep);
 }
 
-std::map<std::string, std::any> Thorn::getMap() {
-    std::map<std::string, std::any> m = {
-        {"x", double(_position.x)},
-        {"y", double(_position.y)},
-        {"width", double(_size.getIWidth())},
-        {"height", double(_size.getIHeight())},
-        {"type", std::string(_jsonType)}
-    };
-    return m;
-}
-
 
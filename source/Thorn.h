@@ -58,7 +58,6 @@ public:
 
     std::shared_ptr<scene2::SceneNode>& getSceneNode() { return _sceneNode; }
 
-    std::map<std::string, std::any> getMap() override;
 };
 
 
@@ -0,0 +1,210 @@
+//
+//  TieredTextureLoader.cpp
+//  SweetSweetBetrayal
+//
+
+#include "TieredTextureLoader.h"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace cugl;
+using namespace cugl::graphics;
+
+/** The scale of the chosen variant of each tiered texture */
+std::unordered_map<std::string, float> TieredTextureLoader::_scales;
+
+#pragma mark -
+#pragma mark Constructors
+/**
+ * Initializes the loader with the tier manifest.
+ *
+ * The manifest has the "design" size the scenes are laid out in, and a
+ * "textures" object mapping each tiered texture key to its pixel "height",
+ * the "display" height it is drawn at (in design units), and the file of each
+ * of its "variants" by scale.
+ *
+ * @param manifest  The tier manifest (relative to the asset directory)
+ *
+ * @return true if the loader was initialized properly
+ */
+bool TieredTextureLoader::initWithTiers(const std::string& manifest) {
+    if (!TextureLoader::init()) {
+        return false;
+    }
+    _decoder = TextureDecodePool::alloc();
+
+    std::shared_ptr<JsonReader> reader = JsonReader::allocWithAsset(manifest);
+    if (reader == nullptr) {
+        CULog("No texture tiers (%s not found)", manifest.c_str());
+        return true;
+    }
+    std::shared_ptr<JsonValue> json = reader->readJson();
+    reader->close();
+    if (json == nullptr || json->get("design") == nullptr || json->get("textures") == nullptr) {
+        CULogError("Malformed tier manifest %s", manifest.c_str());
+        return true;
+    }
+
+    // The screen pixels covered by a design unit, on the larger axis
+    Size design(json->get("design")->get(0)->asFloat(), json->get("design")->get(1)->asFloat());
+    Size pixels = Application::get()->getDisplaySize() * Display::get()->getPixelDensity();
+    float density = std::max(pixels.width / design.width, pixels.height / design.height);
+
+    for (auto& entry : json->get("textures")->children()) {
+        float height = entry->getFloat("height", 0);
+        float display = entry->getFloat("display", 0);
+        std::shared_ptr<JsonValue> variants = entry->get("variants");
+        if (height <= 0 || display <= 0 || variants == nullptr) {
+            CULogError("Bad texture tiers for %s", entry->key().c_str());
+            continue;
+        }
+
+        // The smallest variant with a texel for every screen pixel
+        float needed = display * density / height;
+        float best = 1.0f;
+        for (auto& variant : variants->children()) {
+            // The key is the scale of the variant, such as "0.5"
+            std::string key = variant->key();
+            char* end = nullptr;
+            float scale = strtof(key.c_str(), &end);
+            if (end == key.c_str() || *end != '\0' || !(scale > 0)) {
+                CULogError("Bad texture tier \"%s\" for %s", key.c_str(), entry->key().c_str());
+                continue;
+            }
+            if (scale >= needed && scale < best) {
+                best = scale;
+                _files[entry->key()] = variant->asString();
+            }
+        }
+        _scales[entry->key()] = best;
+    }
+    CULog("Texture tiers chosen for %zu of %zu textures (%.2f pixels per unit)",
+          _files.size(), json->get("textures")->size(), density);
+    return true;
+}
+
+#pragma mark -
+#pragma mark Loading
+/**
+ * Loads a texture from a file, or from its chosen variant.
+ *
+ * @param key       The key to access the texture after loading
+ * @param source    The pathname to the texture file
+ * @param callback  An optional callback for asynchronous loading
+ * @param async     Whether the texture is loaded asynchronously
+ *
+ * @return true if the texture was found
+ */
+bool TieredTextureLoader::read(const std::string key, const std::string source,
+                               LoaderCallback callback, bool async) {
+    auto it = _files.find(key);
+    std::string file = it == _files.end() ? source : it->second;
+    if (async && _decoder != nullptr) {
+        return decode(key, file, nullptr, callback);
+    }
+    return TextureLoader::read(key, file, callback, async);
+}
+
+/**
+ * Loads a texture from its JSON entry, or from its chosen variant.
+ *
+ * The entry keeps its other settings (filters, wrap, mipmaps); only its
+ * file is replaced.
+ *
+ * @param json      The directory entry for the texture
+ * @param callback  An optional callback for asynchronous loading
+ * @param async     Whether the texture is loaded asynchronously
+ *
+ * @return true if the texture was found
+ */
+bool TieredTextureLoader::read(const std::shared_ptr<JsonValue>& json,
+                               LoaderCallback callback, bool async) {
+    auto it = _files.find(json->key());
+    if (it != _files.end()) {
+        if (json->isString()) {
+            json->set(it->second);
+        } else if (json->get("file") != nullptr) {
+            json->get("file")->set(it->second);
+        }
+    }
+    // CUGL sprite atlases are left to the base loader
+    if (async && _decoder != nullptr && !json->has("atlas")) {
+        std::string file = json->isString() ? json->asString() : json->getString("file");
+        return decode(json->key(), file, json, callback);
+    }
+    return TextureLoader::read(json, callback, async);
+}
+
+/** Returns the GL filter for a filter name in a texture entry */
+static GLuint getFilter(const std::string& name, GLuint fallback) {
+    if (name == "nearest") {
+        return GL_NEAREST;
+    } else if (name == "linear") {
+        return GL_LINEAR;
+    } else if (name == "nearest-nearest") {
+        return GL_NEAREST_MIPMAP_NEAREST;
+    } else if (name == "linear-nearest") {
+        return GL_LINEAR_MIPMAP_NEAREST;
+    } else if (name == "nearest-linear") {
+        return GL_NEAREST_MIPMAP_LINEAR;
+    } else if (name == "linear-linear") {
+        return GL_LINEAR_MIPMAP_LINEAR;
+    }
+    return fallback;
+}
+
+/** Returns the GL wrap for a wrap name in a texture entry */
+static GLuint getWrap(const std::string& name, GLuint fallback) {
+    if (name == "clamp") {
+        return GL_CLAMP_TO_EDGE;
+    } else if (name == "repeat") {
+        return GL_REPEAT;
+    } else if (name == "mirrored") {
+        return GL_MIRRORED_REPEAT;
+    }
+    return fallback;
+}
+
+/**
+ * Loads a texture asynchronously on the decode pool.
+ *
+ * The texture is queued (so the asset manager counts it as waiting) until it
+ * is uploaded on the main thread. The settings of its entry (filters, wrap,
+ * mipmaps) are then applied as the base loader would.
+ *
+ * @param key       The key to access the texture after loading
+ * @param source    The pathname to the texture file
+ * @param json      The directory entry for the texture (nullptr if none)
+ * @param callback  An optional callback for the texture
+ *
+ * @return true if the texture was queued
+ */
+bool TieredTextureLoader::decode(const std::string& key, const std::string& source,
+                                 const std::shared_ptr<JsonValue>& json, LoaderCallback callback) {
+    if (_assets.find(key) != _assets.end() || _queue.find(key) != _queue.end()) {
+        return false;
+    }
+    _queue.emplace(key);
+
+    std::string path = Application::get()->getAssetDirectory() + source;
+    _decoder->decode(key, path, [this, key, json, callback](const std::shared_ptr<Texture>& texture) {
+        _queue.erase(key);
+        if (texture != nullptr) {
+            texture->setName(key);
+            if (json != nullptr && json->isObject()) {
+                if (json->getBool("mipmaps", false)) {
+                    texture->buildMipMaps();
+                }
+                texture->setMinFilter(getFilter(json->getString("minfilter"), texture->getMinFilter()));
+                texture->setMagFilter(getFilter(json->getString("magfilter"), texture->getMagFilter()));
+                texture->setWrapS(getWrap(json->getString("wrapS"), texture->getWrapS()));
+                texture->setWrapT(getWrap(json->getString("wrapT"), texture->getWrapT()));
+            }
+            _assets[key] = texture;
+        }
+        if (callback) {
+            callback(key, texture != nullptr);
+        }
+    });
+    return true;
+}
@@ -0,0 +1,125 @@
+//
+//  TieredTextureLoader.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_TIERED_TEXTURE_LOADER_H__
+#define __SSB_TIERED_TEXTURE_LOADER_H__
+#include <cugl/cugl.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "TextureDecodePool.h"
+
+using namespace cugl;
+using namespace cugl::graphics;
+
+/** The tier manifest written by the tier generator (tools/texturetiers) */
+#define TEXTURE_TIERS_MANIFEST  "json/tiers.json"
+
+/**
+ * A texture loader that loads reduced variants of large textures.
+ *
+ * The tier generator writes 0.5x and 0.25x variants of the textures named in
+ * its config, and a manifest with the pixel height of each texture, the height
+ * it is drawn at (in design units), and the file of each variant. At startup,
+ * this loader measures how many screen pixels a design unit covers and picks,
+ * for each texture, the smallest variant that still has a texel per screen
+ * pixel. The texture keeps its key, so callers are unchanged, but it is
+ * smaller than the original. Code that sizes a node from its texture should
+ * divide by {@link #getScale}.
+ *
+ * Textures that are not in the manifest (or when there is no manifest) are
+ * loaded as usual.
+ *
+ * Asynchronous loads are decoded on a {@link TextureDecodePool}, several at a
+ * time, instead of one by one on the asset manager's thread. A texture counts
+ * as waiting (for {@link AssetManager#progress}) until it has been uploaded.
+ */
+class TieredTextureLoader : public TextureLoader {
+private:
+    /** The file of the chosen variant of each tiered texture */
+    std::unordered_map<std::string, std::string> _files;
+    /** The scale of the chosen variant of each tiered texture */
+    static std::unordered_map<std::string, float> _scales;
+    /** The threads that decode asynchronous loads */
+    std::shared_ptr<TextureDecodePool> _decoder;
+
+    /**
+     * Loads a texture asynchronously on the decode pool.
+     *
+     * @param key       The key to access the texture after loading
+     * @param source    The pathname to the texture file
+     * @param json      The directory entry for the texture (nullptr if none)
+     * @param callback  An optional callback for the texture
+     *
+     * @return true if the texture was queued
+     */
+    bool decode(const std::string& key, const std::string& source,
+                const std::shared_ptr<JsonValue>& json, LoaderCallback callback);
+
+public:
+#pragma mark Constructors
+    /**
+     * Initializes the loader with the tier manifest.
+     *
+     * A missing manifest is not an error: every texture is loaded in full.
+     *
+     * @param manifest  The tier manifest (relative to the asset directory)
+     *
+     * @return true if the loader was initialized properly
+     */
+    bool initWithTiers(const std::string& manifest);
+
+    /**
+     * Returns a newly allocated loader with the tier manifest.
+     *
+     * @param manifest  The tier manifest (relative to the asset directory)
+     *
+     * @return a newly allocated loader
+     */
+    static std::shared_ptr<TieredTextureLoader> alloc(const std::string& manifest = TEXTURE_TIERS_MANIFEST) {
+        std::shared_ptr<TieredTextureLoader> result = std::make_shared<TieredTextureLoader>();
+        return (result->initWithTiers(manifest) ? result : nullptr);
+    }
+
+    /**
+     * Returns the scale of the loaded texture relative to the original.
+     *
+     * This is 1 for textures loaded in full.
+     *
+     * @param key   The texture key
+     */
+    static float getScale(const std::string& key) {
+        auto it = _scales.find(key);
+        return it == _scales.end() ? 1.0f : it->second;
+    }
+
+#pragma mark Loading
+    /**
+     * Loads a texture from a file, or from its chosen variant.
+     *
+     * @param key       The key to access the texture after loading
+     * @param source    The pathname to the texture file
+     * @param callback  An optional callback for asynchronous loading
+     * @param async     Whether the texture is loaded asynchronously
+     *
+     * @return true if the texture was found
+     */
+    virtual bool read(const std::string key, const std::string source,
+                      LoaderCallback callback, bool async) override;
+
+    /**
+     * Loads a texture from its JSON entry, or from its chosen variant.
+     *
+     * @param json      The directory entry for the texture
+     * @param callback  An optional callback for asynchronous loading
+     * @param async     Whether the texture is loaded asynchronously
+     *
+     * @return true if the texture was found
+     */
+    virtual bool read(const std::shared_ptr<JsonValue>& json,
+                      LoaderCallback callback, bool async) override;
+};
+
+#endif /* __SSB_TIERED_TEXTURE_LOADER_H__ */
@@ -49,7 +49,7 @@ bool Tile::init(const Vec2 pos, const Size size, std::string jsonType, float sca
     _position = pos;
     _size = size;
     _jsonType = jsonType;
-    _itemType = jsonTypeToItemType[jsonType];
+    _itemType = jsonTypeToItemType(jsonType);
 //    float testScale = 1.0f;
     CULog("Tile drawscale: %f", scale);
     _drawScale = 1.0f;
@@ -64,15 +64,3 @@ bool Tile::init(const Vec2 pos, const Size size, std::string jsonType, float sca
     
     return false;
 }
-
-
-std::map<std::string, std::any> Tile::getMap() {
-    std::map<std::string, std::any> m = {
-        {"x", double(_position.x)},
-        {"y", double(_position.y)},
-        {"width", double(_size.getIWidth())},
-        {"height", double(_size.getIHeight())},
-         {"type", std::string(_jsonType)}
-    };
-    return m;
-}
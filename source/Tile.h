@@ -54,9 +54,6 @@ public:
 
     bool init(const Vec2 pos, const Size size, std::string jsonType, float scale);
 
-    // Map for JSON level management
-    std::map<std::string, std::any> getMap() override;
-
     // Gets if this is a wall
     bool isWall() { return _wall; }
 
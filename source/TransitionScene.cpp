@@ -10,6 +10,7 @@
 #include "TransitionScene.h"
 #include "Constants.h"
 
+#include <algorithm>
 #include <ctime>
 #include <string>
 #include <iostream>
@@ -28,6 +29,8 @@ using namespace Constants;
 /** This is adjusted by screen aspect ratio to get the height */
 #define SCENE_WIDTH 1024
 #define SCENE_HEIGHT 576
+/** The height of the level streaming bar */
+#define LOAD_BAR_HEIGHT 8
 
 
 
@@ -82,6 +85,14 @@ bool TransitionScene::init(const std::shared_ptr<AssetManager>& assets) {
 //    _blackScreen->setPriority(5);
     addChild(_blackScreen);
 
+    _loadBar = scene2::PolygonNode::allocWithPoly(Rect(0, 0, _size.width, LOAD_BAR_HEIGHT));
+    _loadBar->setColor(Color4::WHITE);
+    _loadBar->setAnchor(Vec2::ANCHOR_BOTTOM_LEFT);
+    _loadBar->setPosition(0, 0);
+    _loadBar->setVisible(false);
+    _loadBar->setPriority(6);
+    addChild(_loadBar);
+
     
 
     return true;
@@ -110,6 +121,10 @@ void TransitionScene::preUpdate(float dt) {
     {
         case TransitionType::FADE_IN:
             currColor = _blackScreen->getColor();
+            if (_loadProgress < 1.0f){
+                // Stay black until the level has streamed in
+                break;
+            }
             if (currColor.a > 0.0f){
                 if (currColor.a - FADE_RATE > 0.0f) {
                     currColor.a -= FADE_RATE;
@@ -157,6 +172,20 @@ void TransitionScene::startFadeIn(){
 }
 
 
+/**
+ * Sets how much of the level has streamed in.
+ *
+ * Until it reaches 1, a fade in holds at black and shows the progress,
+ * so the level is never seen half built.
+ *
+ * @param value the fraction of the level streamed in (1 if nothing is loading)
+ */
+void TransitionScene::setLoadProgress(float value){
+    _loadProgress = value;
+    _loadBar->setVisible(value < 1.0f);
+    _loadBar->setScale(Vec2(std::max(value, 0.0f), 1.0f));
+}
+
 void TransitionScene::startFadeOut(){
     Color4 newColor = Color4(0,0,0,0);
     _blackScreen->setColor(newColor);
@@ -40,6 +40,12 @@ protected:
 
     /** Reference to the progress bar */
     std::shared_ptr<cugl::scene2::PolygonNode> _blackScreen;
+
+    /** The bar showing how much of the level has streamed in */
+    std::shared_ptr<cugl::scene2::PolygonNode> _loadBar;
+
+    /** How much of the level has streamed in (1 if nothing is loading) */
+    float _loadProgress = 1.0f;
     
     /** The current type of transition **/
     TransitionType _transitionType = TransitionType::NONE;
@@ -126,6 +132,16 @@ public:
         return _fadingOutDone;
     }
 
+    /**
+     * Sets how much of the level has streamed in.
+     *
+     * Until it reaches 1, a fade in holds at black and shows the progress,
+     * so the level is never seen half built.
+     *
+     * @param value the fraction of the level streamed in (1 if nothing is loading)
+     */
+    void setLoadProgress(float value);
+
 
 #pragma mark -
 #pragma mark Attribute Functions
@@ -87,50 +87,20 @@ void Treasure::updateAnimation(float timestep){
 //    for (int i = 0; i < frames.size(); i++) {
 //        CULog("Frame %d: %d", i, frames[i]);
 //    }
-    doStrip(_spinAction, DURATION);
-    _timeline->update(timestep);
-    
-    
+    if (!_animator.isPlaying()) {
+        _animator.play(DURATION, true);
+    }
 }
 
-void Treasure::setAnimation(std::shared_ptr<scene2::SpriteNode> sprite){
+void Treasure::setAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip){
     _spinSpriteNode = sprite;
 
     _node = _spinSpriteNode;
     _spinSpriteNode->setVisible(true);
 //    _node->setScale(0.065f);
     
-    _timeline = ActionTimeline::alloc();
-
-    // Create the frame sequence
-    // For an 8x8 spritesheet
-    const int span = 32;
-
-    std::vector<int> forward;
-    for (int ii = 1; ii < span; ii++) {
-        forward.push_back(ii);
-    }
-    // Loop back to beginning
-    forward.push_back(0);
-    
-    // Create animation
-    _spinAnimateSprite = AnimateSprite::alloc(forward);
-    _spinAction = _spinAnimateSprite->attach<scene2::SpriteNode>(_spinSpriteNode);
-}
-
-/**
- * Performs a film strip action
- *
- * @param action The film strip action
- * @param slide  The associated movement slide
- */
-void Treasure::doStrip(cugl::ActionFunction action, float duration = DURATION) {
-
-    if (_timeline->isActive(ACT_KEY)) {
-        // NO OP
-    } else {
-        _timeline->add(ACT_KEY, action, duration);
-    }
+    // The frames are shared with every treasure
+    _animator.attach(_spinSpriteNode, clip);
 }
 
 void Treasure::setPositionInit(const cugl::Vec2 &position){
@@ -143,7 +113,11 @@ void Treasure::setPositionInit(const cugl::Vec2 &position){
 }
 
 void Treasure::dispose() {
-    _node->dispose();
+    _animator.release();
+    // The node is kept, since a level snapshot may put it back in the scene
+    if (_node && _node->getParent()) {
+        _node->removeFromParent();
+    }
 }
 
 
@@ -197,16 +171,22 @@ void Treasure::reset(){
     _atGoal = false;
 }
 
-std::map<std::string, std::any> Treasure::getMap() {
-    std::map<std::string, std::any> m = {
-        {"x", double(_position.x)},
-        {"y", double(_position.y)},
-        {"width", double(_size.getIWidth())},
-        {"height", double(_size.getIHeight())},
-        {"scale", double(_drawScale)},
-         {"type", std::string(_jsonType)}
-    };
-    return m;
+/**
+ * Returns the value of a level field of this object.
+ *
+ * @param field The field
+ * @param value The value of the field
+ *
+ * @return true if this object has the field
+ */
+bool Treasure::getLevelField(LevelField field, double& value) const {
+    switch (field) {
+        case FIELD_SCALE:
+            value = _drawScale;
+            return true;
+        default:
+            return Object::getLevelField(field, value);
+    }
 }
 
 
@@ -12,7 +12,6 @@
 #include <cugl/cugl.h>
 
 #define DURATION 4.0f
-#define ACT_KEY  "current"
 
 
 using namespace cugl;
@@ -62,13 +61,9 @@ protected:
     
     
 #pragma mark Animation Variables
-    /** Manager to process the animation actions */
-    std::shared_ptr<cugl::ActionTimeline> _timeline;
-    
     /** Animation variables */
-    std::shared_ptr<AnimateSprite> _spinAnimateSprite;
     std::shared_ptr<cugl::scene2::SpriteNode> _spinSpriteNode;
-    cugl::ActionFunction _spinAction;
+    Animator _animator;
 
 public:
     
@@ -134,14 +129,19 @@ public:
     /**
      Sets the spinning animation for the treasure.
      */
-    void setAnimation(std::shared_ptr<scene2::SpriteNode> sprite);
+    void setAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip);
     
     void updateAnimation(float timestep);
-    
-    /** Increments an animation film strip */
-    void doStrip(cugl::ActionFunction action, float duration);
 
-    std::map<std::string, std::any> getMap() override;
+    /**
+     * Returns the value of a level field of this object.
+     *
+     * @param field The field
+     * @param value The value of the field
+     *
+     * @return true if this object has the field
+     */
+    bool getLevelField(LevelField field, double& value) const override;
     /**
      * Sets the taken status of the treasure.
      * @param taken Whether the treasure has been taken by a player.
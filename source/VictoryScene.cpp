@@ -173,30 +173,49 @@ void VictoryScene::reset(){
     _winTextGreen->setVisible(false);
 }
 
+/**
+ * Sets the background to the given victory texture.
+ *
+ * The background keeps its size, whatever tier the texture was loaded at.
+ *
+ * @param key   The texture key
+ */
+void VictoryScene::setBackground(const std::string& key){
+    std::shared_ptr<Texture> texture = _assets->get<Texture>(key);
+    if (texture == nullptr) {
+        return;
+    }
+    // The polygon is in texture pixels, so it must follow the texture size
+    Size size = _background->getContentSize();
+    _background->setTexture(texture);
+    _background->setPolygon(Rect(Vec2::ZERO, texture->getSize()));
+    _background->setContentSize(size);
+}
+
 void VictoryScene::setWinColor(int winColorInt){
     _winColor = static_cast<ColorType>(winColorInt);
     
     switch (_winColor){
         case(ColorType::RED):
-            _background->setTexture(_assets->get<Texture>("red-victory"));
+            setBackground("red-victory");
             _winTextRed->setVisible(true);
             _winText = _winTextRed;
 //            _winText->setTexture(_assets->get<Texture>("red-wins"));
             break;
         case(ColorType::BLUE):
-            _background->setTexture(_assets->get<Texture>("blue-victory"));
+            setBackground("blue-victory");
             _winTextBlue->setVisible(true);
             _winText = _winTextBlue;
 //            _winText->setTexture(_assets->get<Texture>("blue-wins"));
             break;
         case(ColorType::GREEN):
-            _background->setTexture(_assets->get<Texture>("green-victory"));
+            setBackground("green-victory");
             _winTextGreen->setVisible(true);
             _winText = _winTextGreen;
 //            _winText->setTexture(_assets->get<Texture>("green-wins"));
             break;
         case(ColorType::YELLOW):
-            _background->setTexture(_assets->get<Texture>("yellow-victory"));
+            setBackground("yellow-victory");
             _winTextYellow->setVisible(true);
             _winText = _winTextYellow;
 //            _winText->setTexture(_assets->get<Texture>("yellow-wins"));
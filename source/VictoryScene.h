@@ -184,6 +184,15 @@ public:
     
     
     void setWinColor(int winColorInt);
+
+    /**
+     * Sets the background to the given victory texture.
+     *
+     * The background keeps its size, whatever tier the texture was loaded at.
+     *
+     * @param key   The texture key
+     */
+    void setBackground(const std::string& key);
     
     void animateButton();
 
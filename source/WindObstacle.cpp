@@ -51,46 +51,40 @@ void WindObstacle::update(float timestep) {
 
 void WindObstacle::updateAnimation(float timestep) {
     
-    if (!_fanTimeline->isActive("current")) {
-        _fanTimeline->add("current", _fanAction, FAN_ANIM_CYCLE);
+    if (!_fanAnimator.isPlaying()) {
+        _fanAnimator.play(FAN_ANIM_CYCLE, true);
     }
-    _fanTimeline->update(timestep);
     //we need this piece of shit variable becasue for some fucking reason raycasting only works every other call?
     //Seriously what the fuck
     float actualMin = min(_prevRayDist, _minRayDist);
 
-    if (_gustTimeline4 != nullptr) {
-        if (!_gustTimeline4->isActive("current")) {
-            _gustTimeline4->add("current", _gustAction4, GUST_ANIM_CYCLE);
-            _gustTimeline3->add("current", _gustAction3, GUST_ANIM_CYCLE);
-            _gustTimeline2->add("current", _gustAction2, GUST_ANIM_CYCLE);
-            _gustTimeline1->add("current", _gustAction1, GUST_ANIM_CYCLE);
-            _gustSpriteNode2->setVisible(false);
-            _gustSpriteNode3->setVisible(false);
-            _gustSpriteNode1->setVisible(false);
-        }
-        _gustSpriteNode2->setVisible(false);
-        _gustSpriteNode3->setVisible(false);
-        _gustSpriteNode1->setVisible(false);
-        _gustSpriteNode4->setVisible(false);
-
+    if (!_gustSpriteNodes.empty()) {
+        int level;
         if (actualMin >= 1.0f) {
-            _gustSpriteNode4->setVisible(true);
+            level = 3;
         }
         else if (actualMin >= 0.75f) {
-            _gustSpriteNode3->setVisible(true);
+            level = 2;
         }
         else if (actualMin >= 0.25f) {
-            _gustSpriteNode2->setVisible(true);
+            level = 1;
         }
         else {
-            _gustSpriteNode1->setVisible(true);
+            level = 0;
         }
 
-        _gustTimeline4->update(timestep);
-        _gustTimeline3->update(timestep);
-        _gustTimeline2->update(timestep);
-        _gustTimeline1->update(timestep);
+        // The gust levels play in step, so only the visible one is animated
+        if (level != _gustLevel) {
+            if (_gustLevel >= 0) {
+                _gustSpriteNodes[_gustLevel]->setVisible(false);
+            }
+            _gustSpriteNodes[level]->setVisible(true);
+            _gustAnimator.attach(_gustSpriteNodes[level], _gustClips[level]);
+            _gustLevel = level;
+        }
+        if (!_gustAnimator.isPlaying()) {
+            _gustAnimator.play(GUST_ANIM_CYCLE, true);
+        }
     }
 }
 void WindObstacle::setRayOrigins() {
@@ -156,6 +150,8 @@ void WindObstacle::dispose() {
 
     CULog("Diposing wind");
     markRemoved(true);
+    _fanAnimator.release();
+    _gustAnimator.release();
 
     if (_node && _node->getParent()) {
         _node->removeFromParent();
@@ -224,97 +220,62 @@ bool WindObstacle::init(const Vec2 pos, const Size size, float scale, const Vec2
     return false;
 }
 
-std::map<std::string, std::any> WindObstacle::getMap() {
-    std::map<std::string, std::any> m = {
-        {"x", double(_position.x)},
-        {"y", double(_position.y)},
-        {"width", double(_size.getIWidth())},
-        {"height", double(_size.getIHeight())},
-        {"scale", double(_drawScale)},
-        {"gustDirX", double(_windDirection.x)},
-        {"gustDirY", double(_windDirection.y)},
-        {"gustForceX", double(_windForce.x)},
-        {"gustForceY", double(_windForce.y)},
-        {"angle", double(_angle)},
-         {"type", std::string(_jsonType)}
-    };
-    return m;
+/**
+ * Returns the value of a level field of this object.
+ *
+ * @param field The field
+ * @param value The value of the field
+ *
+ * @return true if this object has the field
+ */
+bool WindObstacle::getLevelField(LevelField field, double& value) const {
+    switch (field) {
+        case FIELD_SCALE:
+            value = _drawScale;
+            return true;
+        case FIELD_ANGLE:
+            value = _angle;
+            return true;
+        case FIELD_GUST_DIR_X:
+            value = _windDirection.x;
+            return true;
+        case FIELD_GUST_DIR_Y:
+            value = _windDirection.y;
+            return true;
+        case FIELD_GUST_FORCE_X:
+            value = _windForce.x;
+            return true;
+        case FIELD_GUST_FORCE_Y:
+            value = _windForce.y;
+            return true;
+        default:
+            return Object::getLevelField(field, value);
+    }
 }
-void WindObstacle::setGustAnimation(std::vector<std::shared_ptr<scene2::SpriteNode>> sprite, int nFrames) {
+void WindObstacle::setGustAnimation(std::vector<std::shared_ptr<scene2::SpriteNode>> sprite, const std::vector<std::shared_ptr<AnimationClip>>& clips) {
     //Create and iterate through all our animations
     if (!_node) {
         _node = scene2::SceneNode::alloc();
         _node->setPriority(PRIORITY);
     }
-    //GustSpriteNode4
-    std::vector<int> forward;
-    _gustSpriteNode4 = sprite[3];
-    _gustSpriteNode4->setVisible(true);
-    _gustSpriteNode4->setPriority(PRIORITY);
-
-    _gustSpriteNode4->setAnchor(_anchorOffset);
-    _gustSpriteNode4->setPosition(_animationOffest);
-    
-    _node->addChild(_gustSpriteNode4);
-    //Create the spritesheet
-    _gustTimeline4 = ActionTimeline::alloc();
-    for (int ii = 1; ii < nFrames; ii++) {
-        forward.push_back(ii);
+    _gustSpriteNodes = sprite;
+    _gustClips = clips;
+    _gustLevel = -1;
+    // Highest level first, so the lowest is drawn on top
+    for (int ii = (int)_gustSpriteNodes.size() - 1; ii >= 0; ii--) {
+        std::shared_ptr<scene2::SpriteNode> gust = _gustSpriteNodes[ii];
+        gust->setVisible(false);
+        gust->setPriority(PRIORITY);
+
+        gust->setAnchor(_anchorOffset);
+        gust->setPosition(_animationOffest);
+
+        _node->addChild(gust);
     }
-    forward.push_back(0);
-    _gustAnimateSprite4 = AnimateSprite::alloc(forward);
-    _gustAction4 = (_gustAnimateSprite4->attach<scene2::SpriteNode>(_gustSpriteNode4));
-    //GustSpriteNode3
-    forward.clear();
-    _gustSpriteNode3 = sprite[2];
-    _gustSpriteNode3->setPriority(PRIORITY);
-
-    _gustSpriteNode3->setAnchor(_anchorOffset);
-    _gustSpriteNode3->setPosition(_animationOffest);
-    
-    _node->addChild(_gustSpriteNode3);
-    _gustTimeline3 = ActionTimeline::alloc();
-    for (int ii = 1; ii < nFrames; ii++) {
-        forward.push_back(ii);
-    }
-    forward.push_back(0);
-    _gustAnimateSprite3 = AnimateSprite::alloc(forward);
-    _gustAction3 = (_gustAnimateSprite3->attach<scene2::SpriteNode>(_gustSpriteNode3));
-    //GustSpriteNode2
-    forward.clear();
-    _gustSpriteNode2 = sprite[1];
-    _gustSpriteNode2->setPriority(PRIORITY);
-
-    _gustSpriteNode2->setAnchor(_anchorOffset);
-    _gustSpriteNode2->setPosition(_animationOffest);
-    
-    _node->addChild(_gustSpriteNode2);
-    _gustTimeline2 = ActionTimeline::alloc();
-    for (int ii = 1; ii < nFrames; ii++) {
-        forward.push_back(ii);
-    }
-    forward.push_back(0);
-    _gustAnimateSprite2 = AnimateSprite::alloc(forward);
-    _gustAction2 = (_gustAnimateSprite2->attach<scene2::SpriteNode>(_gustSpriteNode2));
-    forward.clear();
-    _gustSpriteNode1 = sprite[0];
-    _gustSpriteNode1->setPriority(PRIORITY);
-
-    _gustSpriteNode1->setAnchor(_anchorOffset);
-    _gustSpriteNode1->setPosition(_animationOffest);
-    
-    _node->addChild(_gustSpriteNode1);
-    _gustTimeline1 = ActionTimeline::alloc();
-    for (int ii = 1; ii < nFrames; ii++) {
-        forward.push_back(ii);
-    }
-    forward.push_back(0);
-    _gustAnimateSprite1 = AnimateSprite::alloc(forward);
-    _gustAction1 = (_gustAnimateSprite1->attach<scene2::SpriteNode>(_gustSpriteNode1));
 }
 
 /** Sets the fan animation and adds the fan sprite node to the scene node (_node) */
-void WindObstacle::setFanAnimation(std::shared_ptr<scene2::SpriteNode> sprite, int nFrames) {
+void WindObstacle::setFanAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip) {
     //Create sprite object
     _fanSpriteNode = sprite;
     _fanSpriteNode->setVisible(true);
@@ -328,18 +289,7 @@ void WindObstacle::setFanAnimation(std::shared_ptr<scene2::SpriteNode> sprite, i
     }
     _node->addChild(_fanSpriteNode);
     
-    //Create the spritesheet
-    _fanTimeline = ActionTimeline::alloc();
-
-    std::vector<int> forward;
-    for (int ii = 1; ii < nFrames; ii++) {
-        forward.push_back(ii);
-    }
-    // Loop back to beginning
-    forward.push_back(0);
-
-    // Create animations
-    _fanAnimateSprite = AnimateSprite::alloc(forward);
-    _fanAction = _fanAnimateSprite->attach<scene2::SpriteNode>(_fanSpriteNode);
+    // The frames are shared with every fan
+    _fanAnimator.attach(_fanSpriteNode, clip);
 }
 
@@ -130,41 +130,34 @@ public:
 
 	const int getPlayerHits() { return _playerHits; }
 	
-	std::map<std::string, std::any> getMap() override;
+	/**
+	 * Returns the value of a level field of this object.
+	 *
+	 * @param field The field
+	 * @param value The value of the field
+	 *
+	 * @return true if this object has the field
+	 */
+	bool getLevelField(LevelField field, double& value) const override;
 
 	/*Animation methods*/
-	void setFanAnimation(std::shared_ptr<scene2::SpriteNode> sprite, int nFrames);
+	void setFanAnimation(std::shared_ptr<scene2::SpriteNode> sprite, const std::shared_ptr<AnimationClip>& clip);
 	void updateAnimation(float timestep);
 
 	//Animation variables
-	std::shared_ptr<cugl::ActionTimeline> _fanTimeline;
 	std::shared_ptr<scene2::SceneNode> _node;
 	std::shared_ptr<cugl::scene2::SpriteNode> _fanSpriteNode;
-	std::shared_ptr<AnimateSprite> _fanAnimateSprite;
-	cugl::ActionFunction _fanAction;
-
-	/*Sets up all the gust animations using an array of gust sprites*/
-	void setGustAnimation(std::vector<std::shared_ptr<scene2::SpriteNode>> sprite, int nFrames);
-	/*Sprite Node representing the gust levels. Level 1 is lowest, level 4 is highest*/
-	std::shared_ptr<cugl::ActionTimeline> _gustTimeline1;
-	std::shared_ptr<cugl::scene2::SpriteNode> _gustSpriteNode1;
-	cugl::ActionFunction _gustAction1;
-	std::shared_ptr<AnimateSprite> _gustAnimateSprite1;
-
-	std::shared_ptr<cugl::ActionTimeline> _gustTimeline2;
-	std::shared_ptr<cugl::scene2::SpriteNode> _gustSpriteNode2;
-	cugl::ActionFunction _gustAction2;
-	std::shared_ptr<AnimateSprite> _gustAnimateSprite2;
-
-	std::shared_ptr<cugl::ActionTimeline> _gustTimeline3;
-	std::shared_ptr<cugl::scene2::SpriteNode> _gustSpriteNode3;
-	cugl::ActionFunction _gustAction3;
-	std::shared_ptr<AnimateSprite> _gustAnimateSprite3;
-
-	std::shared_ptr<cugl::ActionTimeline> _gustTimeline4;
-	std::shared_ptr<cugl::scene2::SpriteNode> _gustSpriteNode4;
-	cugl::ActionFunction _gustAction4;
-	std::shared_ptr<AnimateSprite> _gustAnimateSprite4;
+	Animator _fanAnimator;
+
+	/*Sets up all the gust animations using an array of gust sprites and their clips*/
+	void setGustAnimation(std::vector<std::shared_ptr<scene2::SpriteNode>> sprite, const std::vector<std::shared_ptr<AnimationClip>>& clips);
+	/*Sprite Nodes representing the gust levels. Level 1 (index 0) is lowest, level 4 is highest*/
+	std::vector<std::shared_ptr<cugl::scene2::SpriteNode>> _gustSpriteNodes;
+	std::vector<std::shared_ptr<AnimationClip>> _gustClips;
+	/*One playhead for all gust levels, attached to the visible one*/
+	Animator _gustAnimator;
+	/*The visible gust level (-1 if none yet)*/
+	int _gustLevel = -1;
 
 	/**
 	* Returns the scene graph node representing this WindObstacle.
@@ -0,0 +1,115 @@
+//
+//  WorldSnapshot.cpp
+//  SweetSweetBetrayal
+//
+
+#include "WorldSnapshot.h"
+
+using namespace cugl;
+
+#pragma mark -
+#pragma mark Constructors
+/**
+ * Initializes an empty snapshot for the given level.
+ *
+ * @param levelNum  The level number being captured
+ *
+ * @return true if the snapshot was initialized properly, false otherwise.
+ */
+bool WorldSnapshot::init(int levelNum) {
+    _levelNum = levelNum;
+    return true;
+}
+
+/**
+ * Releases all captured objects.
+ */
+void WorldSnapshot::dispose() {
+    _entries.clear();
+    _levelObjects.clear();
+    _goalDoor = nullptr;
+    _treasureSpawns.clear();
+}
+
+#pragma mark -
+#pragma mark Capture
+/**
+ * Records an obstacle and its scene node as part of the level.
+ *
+ * @param obstacle          The obstacle added to the world
+ * @param node              The scene node attached to the obstacle
+ * @param useObjPosition    Whether the node was positioned from the obstacle
+ */
+void WorldSnapshot::record(const std::shared_ptr<physics2::Obstacle>& obstacle,
+                           const std::shared_ptr<scene2::SceneNode>& node,
+                           bool useObjPosition) {
+    Entry entry;
+    entry.obstacle = obstacle;
+    entry.node = node;
+    entry.useObjPosition = useObjPosition;
+    entry.angle = 0;
+    entry.angularVelocity = 0;
+    entry.enabled = true;
+    entry.visible = true;
+    _entries.push_back(entry);
+}
+
+/**
+ * Reads the current transform of every recorded obstacle.
+ */
+void WorldSnapshot::captureTransforms() {
+    for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+        it->position = it->obstacle->getPosition();
+        it->angle = it->obstacle->getAngle();
+        it->linearVelocity = it->obstacle->getLinearVelocity();
+        it->angularVelocity = it->obstacle->getAngularVelocity();
+        it->enabled = it->obstacle->isEnabled();
+        if (it->node) {
+            it->nodePosition = it->node->getPosition();
+            it->visible = it->node->isVisible();
+        }
+    }
+}
+
+#pragma mark -
+#pragma mark Restore
+/**
+ * Puts every surviving obstacle back to its captured transform.
+ *
+ * @return the number of obstacles restored
+ */
+size_t WorldSnapshot::restoreTransforms() {
+    size_t count = 0;
+    for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+        if (it->obstacle->isRemoved()) {
+            continue;
+        }
+        it->obstacle->setPosition(it->position);
+        it->obstacle->setAngle(it->angle);
+        it->obstacle->setLinearVelocity(it->linearVelocity);
+        it->obstacle->setAngularVelocity(it->angularVelocity);
+        it->obstacle->setEnabled(it->enabled);
+        if (it->node) {
+            it->node->setPosition(it->nodePosition);
+            it->node->setVisible(it->visible);
+        }
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Prepares every captured obstacle to be added to a fresh world.
+ */
+void WorldSnapshot::revive() {
+    for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+        it->obstacle->markRemoved(false);
+        Object* obj = dynamic_cast<Object*>(it->obstacle.get());
+        if (obj && obj->getSceneNode() == nullptr) {
+            obj->setSceneNode(it->node);
+        }
+        if (it->node && it->node->getParent()) {
+            it->node->removeFromParent();
+        }
+    }
+}
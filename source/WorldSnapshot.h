@@ -0,0 +1,180 @@
+//
+//  WorldSnapshot.h
+//  SweetSweetBetrayal
+//
+
+#ifndef __SSB_WORLD_SNAPSHOT_H__
+#define __SSB_WORLD_SNAPSHOT_H__
+#include <cugl/cugl.h>
+#include <vector>
+#include "Object.h"
+
+using namespace cugl;
+
+/**
+ * A capture of the world as it was right after a level was loaded.
+ *
+ * The snapshot keeps every level obstacle alive together with its scene node
+ * and the transform it had after loading. This lets a round be put back with
+ * a single pass over the bodies, and lets "play again" on the same level
+ * re-add the existing obstacles instead of re-reading and re-instantiating
+ * the level file.
+ *
+ * Only the level geometry is captured. Players, the treasure and anything a
+ * player placed are networked objects and are created fresh as before.
+ */
+class WorldSnapshot {
+public:
+    /** The captured state of a single obstacle */
+    struct Entry {
+        /** The captured obstacle */
+        std::shared_ptr<physics2::Obstacle> obstacle;
+        /** The scene node attached to the obstacle */
+        std::shared_ptr<scene2::SceneNode> node;
+        /** Whether the node was positioned from the obstacle when attached */
+        bool useObjPosition;
+        /** The obstacle position */
+        Vec2 position;
+        /** The obstacle angle */
+        float angle;
+        /** The obstacle linear velocity */
+        Vec2 linearVelocity;
+        /** The obstacle angular velocity */
+        float angularVelocity;
+        /** Whether the obstacle body was enabled */
+        bool enabled;
+        /** The scene node position */
+        Vec2 nodePosition;
+        /** Whether the scene node was visible */
+        bool visible;
+    };
+
+protected:
+    /** The level number this snapshot was taken from */
+    int _levelNum;
+    /** The captured obstacles, in the order they were added to the world */
+    std::vector<Entry> _entries;
+    /** The level objects that occupy the grid */
+    std::vector<std::shared_ptr<Object>> _levelObjects;
+    /** The goal door of the level */
+    std::shared_ptr<Object> _goalDoor;
+    /** The goal position the goal door was created at */
+    Vec2 _goalPos;
+    /** The treasure spawn points of the level */
+    std::vector<Vec2> _treasureSpawns;
+
+public:
+#pragma mark -
+#pragma mark Constructors
+    /**
+     * Creates an empty snapshot.
+     */
+    WorldSnapshot() : _levelNum(0) {}
+
+    /**
+     * Disposes of this snapshot, releasing all captured objects.
+     */
+    ~WorldSnapshot() { dispose(); }
+
+    /**
+     * Initializes an empty snapshot for the given level.
+     *
+     * @param levelNum  The level number being captured
+     *
+     * @return true if the snapshot was initialized properly, false otherwise.
+     */
+    bool init(int levelNum);
+
+    /**
+     * Returns a newly allocated empty snapshot for the given level.
+     *
+     * @param levelNum  The level number being captured
+     *
+     * @return a newly allocated empty snapshot for the given level.
+     */
+    static std::shared_ptr<WorldSnapshot> alloc(int levelNum) {
+        std::shared_ptr<WorldSnapshot> result = std::make_shared<WorldSnapshot>();
+        return (result->init(levelNum) ? result : nullptr);
+    }
+
+    /**
+     * Releases all captured objects.
+     */
+    void dispose();
+
+#pragma mark -
+#pragma mark Capture
+    /**
+     * Records an obstacle and its scene node as part of the level.
+     *
+     * The transform is not read until {@link #captureTransforms} is called,
+     * so obstacles can be recorded as they are added to the world.
+     *
+     * @param obstacle          The obstacle added to the world
+     * @param node              The scene node attached to the obstacle
+     * @param useObjPosition    Whether the node was positioned from the obstacle
+     */
+    void record(const std::shared_ptr<physics2::Obstacle>& obstacle,
+                const std::shared_ptr<scene2::SceneNode>& node,
+                bool useObjPosition);
+
+    /**
+     * Reads the current transform of every recorded obstacle.
+     *
+     * This should be called once the level is fully loaded.
+     */
+    void captureTransforms();
+
+    /** Sets the level objects that occupy the grid */
+    void setLevelObjects(const std::vector<std::shared_ptr<Object>>& objects) { _levelObjects = objects; }
+
+    /** Sets the goal door of the level */
+    void setGoalDoor(const std::shared_ptr<Object>& door) { _goalDoor = door; }
+
+    /** Sets the goal position the goal door was created at */
+    void setGoalPos(const Vec2& pos) { _goalPos = pos; }
+
+    /** Adds a treasure spawn point of the level */
+    void addTreasureSpawn(const Vec2& pos) { _treasureSpawns.push_back(pos); }
+
+#pragma mark -
+#pragma mark Restore
+    /**
+     * Puts every surviving obstacle back to its captured transform.
+     *
+     * Obstacles that have been removed from the world (for example, by a bomb)
+     * are left alone, since destroyed geometry stays destroyed between rounds.
+     *
+     * @return the number of obstacles restored
+     */
+    size_t restoreTransforms();
+
+    /**
+     * Prepares every captured obstacle to be added to a fresh world.
+     *
+     * Obstacles removed during the last game are marked live again, and any
+     * object that lost its scene node gets it back. The caller is responsible
+     * for adding the obstacles to the world; see {@link #getEntries}.
+     */
+    void revive();
+
+    /** Returns the level number this snapshot was taken from */
+    int getLevelNum() const { return _levelNum; }
+
+    /** Returns the captured obstacles */
+    const std::vector<Entry>& getEntries() const { return _entries; }
+
+    /** Returns the level objects that occupy the grid */
+    const std::vector<std::shared_ptr<Object>>& getLevelObjects() const { return _levelObjects; }
+
+    /** Returns the goal door of the level */
+    const std::shared_ptr<Object>& getGoalDoor() const { return _goalDoor; }
+
+    /** Returns the goal position the goal door was created at */
+    const Vec2& getGoalPos() const { return _goalPos; }
+
+    /** Returns the treasure spawn points of the level */
+    const std::vector<Vec2>& getTreasureSpawns() const { return _treasureSpawns; }
+};
+
+#endif /* __SSB_WORLD_SNAPSHOT_H__ */
@@ -0,0 +1,291 @@
+//
+//  main.cpp
+//  SweetSweetBetrayal Atlas Packer
+//
+//  A command line tool that packs the textures in assets.json into a few
+//  atlas pages. See tools/README.md for how to build it (it only needs CUGL,
+//  for JSON and SDL_image); no window is ever opened.
+//
+//  Usage: atlaspack [-c pages.json] [assetdir]
+//
+//  The page config (default: pages.json next to this file) names each page
+//  and the texture keys (with * wildcards) that go on it, and lists the asset
+//  directories to pack (default: json/assets.json). Keep each asset group on
+//  pages of its own, so that unloading the group frees them. Each page is written
+//  to assetdir/textures/atlas/<page>-<n>.png, and the region of every packed
+//  texture to assetdir/json/atlases.json, which AtlasTextureLoader reads at
+//  startup. The directories are not changed: packed textures keep their keys.
+//
+//  Textures with their own atlas, a repeating wrap, or both sides larger than
+//  maxRegion are left alone. Each region is padded, with its edge pixels
+//  copied into the padding, so that filtering never samples a neighbor.
+//
+
+#include <cugl/cugl.h>
+#include <SDL_image.h>
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace cugl;
+
+/** A texture to pack */
+struct Entry {
+    /** The texture key */
+    std::string key;
+    /** The loaded image */
+    SDL_Surface* image;
+    /** The page key it was packed on */
+    std::string page;
+    /** The left edge of the image on the page */
+    int x;
+    /** The top edge of the image on the page */
+    int y;
+};
+
+/** Returns true if the key matches the pattern, where * matches any text */
+static bool matches(const std::string& pattern, const std::string& key) {
+    size_t star = pattern.find('*');
+    if (star == std::string::npos) {
+        return pattern == key;
+    }
+    std::string prefix = pattern.substr(0, star);
+    std::string rest = pattern.substr(star + 1);
+    if (key.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    for (size_t ii = prefix.size(); ii <= key.size(); ii++) {
+        if (matches(rest, key.substr(ii))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** Returns the smallest power of two at least n */
+static int powerOfTwo(int n) {
+    int result = 1;
+    while (result < n) {
+        result <<= 1;
+    }
+    return result;
+}
+
+/** Copies a rectangle of one surface into another, without blending */
+static void copy(SDL_Surface* src, int sx, int sy, int w, int h, SDL_Surface* dst, int dx, int dy) {
+    SDL_Rect from = { sx, sy, w, h };
+    SDL_Rect to = { dx, dy, w, h };
+    SDL_BlitSurface(src, &from, dst, &to);
+}
+
+/**
+ * Packs the entries onto shelves of pages of the given size.
+ *
+ * The entries are placed tallest first, left to right, starting a new shelf
+ * when a row is full and a new page when the shelves are. Returns the used
+ * height of each page.
+ */
+static std::vector<int> pack(std::vector<Entry*>& entries, const std::string& name, int size, int padding) {
+    std::sort(entries.begin(), entries.end(), [](const Entry* a, const Entry* b) {
+        return a->image->h != b->image->h ? a->image->h > b->image->h : a->key < b->key;
+    });
+
+    std::vector<int> heights;
+    int x = size;
+    int y = 0;
+    int shelf = 0;
+    for (Entry* entry : entries) {
+        int w = entry->image->w + 2 * padding;
+        int h = entry->image->h + 2 * padding;
+        if (x + w > size) {
+            x = 0;
+            y += shelf;
+            shelf = 0;
+        }
+        if (heights.empty() || y + h > size) {
+            heights.push_back(0);
+            x = 0;
+            y = 0;
+            shelf = 0;
+        }
+        entry->page = "atlas-" + name + "-" + std::to_string(heights.size() - 1);
+        entry->x = x + padding;
+        entry->y = y + padding;
+        x += w;
+        shelf = std::max(shelf, h);
+        heights.back() = std::max(heights.back(), y + h);
+    }
+    return heights;
+}
+
+/** Writes a page with every entry packed on it */
+static bool writePage(const std::vector<Entry*>& entries, const std::string& page, int width, int height,
+                      int padding, const std::string& path) {
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+    if (surface == nullptr) {
+        return false;
+    }
+    SDL_FillRect(surface, nullptr, 0);
+    for (const Entry* entry : entries) {
+        if (entry->page != page) {
+            continue;
+        }
+        SDL_Surface* image = entry->image;
+        int w = image->w;
+        int h = image->h;
+        copy(image, 0, 0, w, h, surface, entry->x, entry->y);
+        for (int pp = 1; pp <= padding; pp++) {
+            copy(image, 0, 0, 1, h, surface, entry->x - pp, entry->y);
+            copy(image, w - 1, 0, 1, h, surface, entry->x + w - 1 + pp, entry->y);
+        }
+        for (int pp = 1; pp <= padding; pp++) {
+            copy(surface, entry->x - padding, entry->y, w + 2 * padding, 1, surface, entry->x - padding, entry->y - pp);
+            copy(surface, entry->x - padding, entry->y + h - 1, w + 2 * padding, 1, surface, entry->x - padding, entry->y + h - 1 + pp);
+        }
+    }
+    bool success = IMG_SavePNG(surface, path.c_str()) == 0;
+    SDL_FreeSurface(surface);
+    return success;
+}
+
+int main(int argc, char* argv[]) {
+    std::string config = "tools/atlaspack/pages.json";
+    std::string assets = "assets";
+    for (int ii = 1; ii < argc; ii++) {
+        std::string arg = argv[ii];
+        if (arg == "-c" && ii + 1 < argc) {
+            config = argv[++ii];
+        } else {
+            assets = arg;
+        }
+    }
+    if (!assets.empty() && assets.back() != '/') {
+        assets += "/";
+    }
+
+    std::shared_ptr<JsonReader> reader = JsonReader::alloc(config);
+    std::shared_ptr<JsonValue> pages = reader == nullptr ? nullptr : reader->readJson();
+    if (pages == nullptr || pages->get("pages") == nullptr) {
+        fprintf(stderr, "usage: atlaspack [-c pages.json] [assetdir]\n");
+        return 1;
+    }
+    std::vector<std::string> files = { "json/assets.json" };
+    if (pages->get("directories") != nullptr) {
+        files = pages->get("directories")->asStringArray();
+    }
+    int size = pages->getInt("size", 4096);
+    int padding = pages->getInt("padding", 2);
+    int maxRegion = pages->getInt("maxRegion", 1024);
+
+    // Assign every texture to the first page that names it
+    std::map<std::string, std::vector<Entry*>> groups;
+    std::vector<std::shared_ptr<JsonValue>> textures;
+    for (auto& file : files) {
+        reader = JsonReader::alloc(assets + file);
+        std::shared_ptr<JsonValue> directory = reader == nullptr ? nullptr : reader->readJson();
+        if (directory == nullptr || directory->get("textures") == nullptr) {
+            fprintf(stderr, "could not read textures from %s%s\n", assets.c_str(), file.c_str());
+            return 1;
+        }
+        for (auto& texture : directory->get("textures")->children()) {
+            textures.push_back(texture);
+        }
+    }
+
+    std::vector<Entry> entries;
+    entries.reserve(textures.size());
+    int failures = 0;
+    for (auto& texture : textures) {
+        std::string page;
+        for (auto& group : pages->get("pages")->children()) {
+            for (auto& pattern : group->children()) {
+                if (page.empty() && matches(pattern->asString(), texture->key())) {
+                    page = group->key();
+                }
+            }
+        }
+        std::string file = texture->isString() ? texture->asString() : texture->getString("file");
+        bool repeats = !texture->isString() && (texture->getString("wrapS") == "repeat" || texture->getString("wrapT") == "repeat");
+        if (page.empty() || file.empty() || repeats || (!texture->isString() && texture->has("atlas"))) {
+            continue;
+        }
+
+        SDL_Surface* loaded = IMG_Load((assets + file).c_str());
+        SDL_Surface* image = loaded == nullptr ? nullptr : SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+        if (loaded != nullptr) {
+            SDL_FreeSurface(loaded);
+        }
+        if (image == nullptr) {
+            printf("    error: could not read %s\n", file.c_str());
+            failures++;
+            continue;
+        }
+        if ((image->w > maxRegion && image->h > maxRegion) || image->w + 2 * padding > size || image->h + 2 * padding > size) {
+            printf("    skipped: %s is %dx%d\n", texture->key().c_str(), image->w, image->h);
+            SDL_FreeSurface(image);
+            continue;
+        }
+        SDL_SetSurfaceBlendMode(image, SDL_BLENDMODE_NONE);
+        entries.push_back({ texture->key(), image, page, 0, 0 });
+    }
+    for (auto& entry : entries) {
+        groups[entry.page].push_back(&entry);
+    }
+
+    // Pack and write the pages, and list them with their regions in the manifest
+    std::shared_ptr<JsonValue> manifest = JsonValue::allocObject();
+    std::shared_ptr<JsonValue> pageList = JsonValue::allocObject();
+    std::shared_ptr<JsonValue> regions = JsonValue::allocObject();
+    printf("%-24s %10s %8s\n", "page", "size", "regions");
+    for (auto& group : groups) {
+        std::vector<int> heights = pack(group.second, group.first, size, padding);
+        for (size_t ii = 0; ii < heights.size(); ii++) {
+            std::string page = "atlas-" + group.first + "-" + std::to_string(ii);
+            std::string file = "textures/atlas/" + group.first + "-" + std::to_string(ii) + ".png";
+            int width = 0;
+            size_t count = 0;
+            for (Entry* entry : group.second) {
+                if (entry->page == page) {
+                    width = std::max(width, entry->x + entry->image->w + padding);
+                    count++;
+                }
+            }
+            width = powerOfTwo(width);
+            int height = powerOfTwo(heights[ii]);
+            if (!writePage(group.second, page, width, height, padding, assets + file)) {
+                printf("    error: could not write %s%s\n", assets.c_str(), file.c_str());
+                failures++;
+                continue;
+            }
+            pageList->appendValue(page, file);
+            printf("%-24s %5dx%-5d %7zu\n", page.c_str(), width, height, count);
+        }
+        for (Entry* entry : group.second) {
+            std::shared_ptr<JsonValue> region = JsonValue::allocArray();
+            region->appendValue(entry->page);
+            region->appendValue((long)entry->x);
+            region->appendValue((long)entry->y);
+            region->appendValue((long)entry->image->w);
+            region->appendValue((long)entry->image->h);
+            regions->appendChild(entry->key, region);
+        }
+    }
+    manifest->appendChild("pages", pageList);
+    manifest->appendChild("regions", regions);
+
+    std::shared_ptr<JsonWriter> writer = JsonWriter::alloc(assets + "json/atlases.json");
+    if (writer == nullptr) {
+        printf("    error: could not write %sjson/atlases.json\n", assets.c_str());
+        failures++;
+    } else {
+        writer->writeJson(manifest);
+        writer->close();
+    }
+
+    for (auto& entry : entries) {
+        SDL_FreeSurface(entry.image);
+    }
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,68 @@
+//
+//  main.cpp
+//  SweetSweetBetrayal Level Compiler
+//
+//  A command line tool that compiles JSON levels into .ssbl binary levels.
+//  See tools/README.md for how to build it (no window is ever opened).
+//
+//  Usage: levelc [-o outdir] level.json...
+//
+//  Each level is written next to its JSON (or into outdir) with the same name
+//  and an .ssbl extension, which createLevelFromJson then prefers at runtime.
+//  The exit code is 1 if any level failed to compile or validate.
+//
+
+#include <cugl/cugl.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "../../source/LevelBinary.h"
+#include "../../source/LevelCompiler.h"
+
+/** Returns the file name without its directory */
+static std::string baseName(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+int main(int argc, char* argv[]) {
+    std::string outdir;
+    std::vector<std::string> levels;
+    for (int ii = 1; ii < argc; ii++) {
+        std::string arg = argv[ii];
+        if (arg == "-o" && ii + 1 < argc) {
+            outdir = argv[++ii];
+            if (!outdir.empty() && outdir.back() != '/') {
+                outdir += "/";
+            }
+        } else {
+            levels.push_back(arg);
+        }
+    }
+    if (levels.empty()) {
+        fprintf(stderr, "usage: levelc [-o outdir] level.json...\n");
+        return 1;
+    }
+
+    LevelCompiler compiler;
+    int failures = 0;
+    printf("%-24s %8s %8s %8s %6s %6s %10s\n", "level", "objects", "bodies", "tiles", "fans", "rays", "draws");
+    for (auto& level : levels) {
+        std::string binary = LevelBinary::getBinaryName(level);
+        if (!outdir.empty()) {
+            binary = outdir + baseName(binary);
+        }
+
+        bool success = compiler.compile(level, binary);
+        const LevelCompilerStats& stats = compiler.getStats();
+        printf("%-24s %8zu %8zu %8zu %6zu %6zu %10zu\n", baseName(level).c_str(), stats.objectCount,
+               stats.bodyCount, stats.tileCount, stats.fanCount, stats.rayCount, stats.drawCalls);
+        for (auto& error : stats.errors) {
+            printf("    error: %s\n", error.c_str());
+        }
+        if (!success) {
+            failures++;
+        }
+    }
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,82 @@
+//
+//  main.cpp
+//  SweetSweetBetrayal Level Linter
+//
+//  A command line tool that measures the cost of JSON levels and checks them
+//  against a budget. See tools/README.md for how to build it (no window is
+//  ever opened).
+//
+//  Usage: levellint [-a assetdir] [-b budget.json] level.json...
+//
+//  The asset directory (default: assets) is used to measure texture memory.
+//  Without -b, the levels are only checked for out-of-bounds and overlapping
+//  objects. The exit code is 1 if any level has errors or exceeds the budget.
+//
+
+#include <cugl/cugl.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "../../source/LevelLinter.h"
+
+using namespace Constants;
+
+/** Returns the file name without its directory */
+static std::string baseName(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+int main(int argc, char* argv[]) {
+    std::string assets = "assets";
+    std::string budget;
+    std::vector<std::string> levels;
+    for (int ii = 1; ii < argc; ii++) {
+        std::string arg = argv[ii];
+        if (arg == "-a" && ii + 1 < argc) {
+            assets = argv[++ii];
+        } else if (arg == "-b" && ii + 1 < argc) {
+            budget = argv[++ii];
+        } else {
+            levels.push_back(arg);
+        }
+    }
+    if (levels.empty()) {
+        fprintf(stderr, "usage: levellint [-a assetdir] [-b budget.json] level.json...\n");
+        return 1;
+    }
+
+    LevelLinter linter;
+    if (!linter.loadAssets(assets)) {
+        fprintf(stderr, "warning: texture memory is not measured without %s/json/assets.json\n", assets.c_str());
+    }
+    if (!budget.empty() && !linter.loadBudget(budget)) {
+        return 1;
+    }
+
+    int failures = 0;
+    printf("%-24s %8s %8s %8s %6s %9s %6s %10s\n", "level", "objects", "bodies", "fixtures", "rays", "overdraw", "peak", "textures");
+    for (auto& level : levels) {
+        bool success = linter.lint(level);
+        const LevelLintStats& stats = linter.getStats();
+        std::string textures = std::to_string(stats.textureCount) + "/" + std::to_string(stats.textureBytes / (1024 * 1024)) + "MB";
+        printf("%-24s %8zu %8zu %8zu %6zu %9.2f %6zu %10s\n", baseName(level).c_str(), stats.objectCount,
+               stats.bodyCount, stats.fixtureCount, stats.rayCount, stats.overdraw, stats.peakOverdraw, textures.c_str());
+        for (auto& entry : stats.itemCounts) {
+            printf("    %-20s %6zu\n", itemToString(entry.first).c_str(), entry.second);
+        }
+        for (auto& entry : stats.layerCounts) {
+            printf("    art layer %-10d %6zu\n", entry.first, entry.second);
+        }
+        for (auto& error : stats.errors) {
+            printf("    error: %s\n", error.c_str());
+        }
+        for (auto& entry : stats.overBudget) {
+            printf("    over budget: %s\n", entry.c_str());
+        }
+        if (!success) {
+            failures++;
+        }
+    }
+    return failures > 0 ? 1 : 0;
+}
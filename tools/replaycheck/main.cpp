@@ -0,0 +1,66 @@
+//
+//  main.cpp
+//  SweetSweetBetrayal Replay Check
+//
+//  A command line tool that checks the per-tick state hashes of input
+//  replays. The game writes input-replay.json to its save directory at the
+//  end of every movement phase run with fixed-point movement (the host's F key).
+//  Recordings of the same input from the same start state, on one device or
+//  on several, must have the same hash at every tick. See tools/README.md
+//  for how to build it.
+//
+//  Usage: replaycheck expected.json actual.json...
+//
+//  Each recording is compared with the expected one. The exit code is 1 if
+//  any of them diverges, and the first divergent tick is printed.
+//
+
+#include <cugl/cugl.h>
+#include <cstdio>
+#include <string>
+#include "../../source/InputReplay.h"
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: replaycheck expected.json actual.json...\n");
+        return 1;
+    }
+
+    InputReplay expected;
+    if (!expected.load(argv[1])) {
+        fprintf(stderr, "error: could not read %s\n", argv[1]);
+        return 1;
+    }
+
+    int failures = 0;
+    for (int ii = 2; ii < argc; ii++) {
+        InputReplay actual;
+        if (!actual.load(argv[ii])) {
+            fprintf(stderr, "error: could not read %s\n", argv[ii]);
+            failures++;
+            continue;
+        }
+
+        long step = InputReplay::compare(expected, actual);
+        if (step < 0) {
+            printf("%s: matched all %zu ticks\n", argv[ii], expected.size());
+            continue;
+        }
+        failures++;
+        if ((size_t)step >= expected.size() || (size_t)step >= actual.size()) {
+            printf("%s: diverged at step %ld (%zu ticks recorded, %zu expected)\n",
+                   argv[ii], step, actual.size(), expected.size());
+        } else {
+            const InputReplay::Frame& want = expected.get(step);
+            const InputReplay::Frame& got = actual.get(step);
+            printf("%s: diverged at step %ld (tick %llu): state %016llx, expected %016llx\n",
+                   argv[ii], step, (unsigned long long)got.tick,
+                   (unsigned long long)got.hash, (unsigned long long)want.hash);
+            if (want.movement != got.movement || want.jumpHold != got.jumpHold) {
+                printf("    the input differs too (movement %g, jump %d; expected %g, jump %d)\n",
+                       got.movement, got.jumpHold, want.movement, want.jumpHold);
+            }
+        }
+    }
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,140 @@
+//
+//  replaytest.cpp
+//  SweetSweetBetrayal
+//
+//  A test of input replays and state hashes, run by ctest. It needs no window.
+//
+//  A body is moved through a Box2D world by a fixed input stream, the way the
+//  fixed-point player movement moves the player, and the state hash of every
+//  step is recorded. The test checks that the same input gives the same hash
+//  on every step, that a recording reads back exactly, and that a changed
+//  input or a short recording is found at the right step.
+//
+//  Usage: replaytest [outdir]
+//
+
+#include <cugl/cugl.h>
+#include <box2d/b2_body.h>
+#include <box2d/b2_polygon_shape.h>
+#include <box2d/b2_world.h>
+#include <cstdio>
+#include <string>
+#include "../../source/FixedPoint.h"
+#include "../../source/InputReplay.h"
+
+/** The number of steps of a run */
+#define STEPS       600
+/** The length of a step */
+#define STEP_TIME   (1.0f / 60.0f)
+
+/** The number of failed checks */
+static int failures = 0;
+
+/** Fails the test if the condition is false */
+static void check(bool condition, const char* message) {
+    if (!condition) {
+        fprintf(stderr, "FAILED: %s\n", message);
+        failures++;
+    }
+}
+
+/** Returns the movement input of the given step */
+static float inputAt(int step) {
+    return (step / 40) % 3 == 0 ? -1.0f : ((step / 40) % 3 == 1 ? 0.0f : 1.0f);
+}
+
+/** Returns whether jump is held on the given step */
+static bool jumpAt(int step) {
+    return step % 90 < 10;
+}
+
+/**
+ * Runs the input stream from the same start state, and records every step.
+ *
+ * @param replay    The recording to fill
+ * @param changed   The step whose input is flipped (-1 for none)
+ */
+static void run(InputReplay& replay, int changed) {
+    b2World world(b2Vec2(0, -9.8f));
+
+    b2BodyDef groundDef;
+    b2Body* ground = world.CreateBody(&groundDef);
+    b2PolygonShape groundShape;
+    groundShape.SetAsBox(200.0f, 0.5f);
+    ground->CreateFixture(&groundShape, 0.0f);
+
+    b2BodyDef bodyDef;
+    bodyDef.type = b2_dynamicBody;
+    bodyDef.position.Set(0.0f, 2.0f);
+    bodyDef.fixedRotation = true;
+    b2Body* body = world.CreateBody(&bodyDef);
+    b2PolygonShape shape;
+    shape.SetAsBox(0.4f, 0.9f);
+    body->CreateFixture(&shape, 1.0f);
+
+    replay.clear();
+    for (int step = 0; step < STEPS; step++) {
+        float movement = (step == changed ? -inputAt(step) + 0.5f : inputAt(step));
+        bool jump = jumpAt(step);
+
+        // Quantized like the fixed-point player movement
+        FixedVec2 vel(body->GetLinearVelocity());
+        vel.x = vel.x * Fixed(0.9f);
+        if (jump && vel.y.abs() < Fixed(0.01f)) {
+            vel.y = Fixed(8.0f);
+        }
+        if (vel.y > Fixed(12.5f)) {
+            vel.y = Fixed(12.5f);
+        }
+        body->SetLinearVelocity(vel.toB2());
+        FixedVec2 force(Fixed(movement) * Fixed(40.0f), Fixed());
+        body->ApplyForceToCenter(force.toB2(), true);
+        world.Step(STEP_TIME, 8, 3);
+
+        StateHash hash;
+        hash.add(FixedVec2(body->GetPosition()));
+        hash.add(FixedVec2(body->GetLinearVelocity()));
+        replay.record((Uint64)step, movement, jump, hash.get());
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string outdir = argc > 1 ? std::string(argv[1]) + "/" : "";
+
+    InputReplay first;
+    InputReplay second;
+    run(first, -1);
+    run(second, -1);
+    check(first.size() == STEPS, "a run records every step");
+    check(InputReplay::compare(first, second) == -1, "the same input gives the same hashes");
+
+    std::string file = outdir + "replaytest.json";
+    check(first.save(file), "a recording can be written");
+    InputReplay loaded;
+    check(loaded.load(file), "a recording can be read");
+    check(InputReplay::compare(first, loaded) == -1, "a recording reads back with the same hashes");
+    bool same = loaded.size() == first.size();
+    for (size_t ii = 0; same && ii < first.size(); ii++) {
+        const InputReplay::Frame& want = first.get(ii);
+        const InputReplay::Frame& got = loaded.get(ii);
+        same = want.tick == got.tick && want.movement == got.movement && want.jumpHold == got.jumpHold;
+    }
+    check(same, "a recording reads back with the same input");
+
+    InputReplay changed;
+    run(changed, 250);
+    check(InputReplay::compare(first, changed) == 250, "a changed input diverges at its step");
+
+    InputReplay shorter;
+    for (size_t ii = 0; ii < 100; ii++) {
+        const InputReplay::Frame& frame = first.get(ii);
+        shorter.record(frame.tick, frame.movement, frame.jumpHold, frame.hash);
+    }
+    check(InputReplay::compare(first, shorter) == 100, "a short recording diverges where it ends");
+
+    if (failures > 0) {
+        return 1;
+    }
+    printf("replaytest: all checks passed\n");
+    return 0;
+}
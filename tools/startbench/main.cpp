@@ -0,0 +1,271 @@
+//
+//  main.cpp
+//  SweetSweetBetrayal Startup Benchmark
+//
+//  A command line tool that times the cold-start path of the game: the same
+//  asset manager and loaders as SSBApp (with the atlas pages, texture tiers
+//  and the threaded TextureDecodePool), loading json/loading.json at once and
+//  json/assets.json asynchronously over frames, like the loading scene. See
+//  tools/README.md for how to build it.
+//
+//  Usage: startbench [-n runs] [-t trace.json] [-b baseline.json] [-w baseline.json]
+//
+//  Textures need a GL context, so the tool opens a small window. Assets are
+//  read from the asset directory of the executable, like the game. Each run
+//  starts from a fresh asset manager (default: 5 runs). The first run is the
+//  cold one (the files may not be in the OS cache yet), and the median is
+//  reported beside it. The audio engine is started once, as in onStartup, and
+//  the network layer is only measured in the game's own trace.
+//
+//  -t writes the first run as a Chrome trace. -w writes the medians as a new
+//  baseline, and -b compares the medians with one: the exit code is 1 if any
+//  phase is slower than its baseline times the "tolerance" (default 1.25).
+//
+
+#include <cugl/cugl.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+#include "../../source/SSBApp.h"
+#include "../../source/StartupTrace.h"
+
+using namespace cugl;
+using namespace cugl::audio;
+
+/** The asset directory loaded before the loading scene */
+#define LOADING_DIRECTORY   "json/loading.json"
+/** The asset directory the loading scene loads asynchronously */
+#define ASSETS_DIRECTORY    "json/assets.json"
+
+/**
+ * An application that loads the startup assets the way the game does, a
+ * number of times, and reports how long each phase took.
+ */
+class StartBench : public Application {
+protected:
+    /** The number of runs */
+    int _runs;
+    /** The file to write the first run to as a Chrome trace (empty for none) */
+    std::string _trace;
+    /** The baseline to compare with (empty for none) */
+    std::string _baseline;
+    /** The file to write the medians to as a baseline (empty for none) */
+    std::string _output;
+
+    /** The asset manager of the current run */
+    std::shared_ptr<AssetManager> _assets;
+    /** The current run */
+    int _run;
+    /** The start of the current run */
+    Uint64 _runStart;
+    /** The start of the asynchronous load of the current run */
+    Uint64 _loadStart;
+    /** The time of every run of each phase, in milliseconds */
+    std::map<std::string, std::vector<float>> _times;
+    /** The phases, in the order they ran */
+    std::vector<std::string> _phases;
+    /** The number of problems found */
+    int _failures;
+
+    /** Records the time of a phase of the current run */
+    void addTime(const std::string& name, Uint64 start, Uint64 end) {
+        if (_times.find(name) == _times.end()) {
+            _phases.push_back(name);
+        }
+        _times[name].push_back((end - start) / 1000.0f);
+    }
+
+    /** Starts a run with a fresh asset manager */
+    void startRun() {
+        StartupTrace::begin("cold start");
+        _runStart = StartupTrace::now();
+        _assets = AssetManager::alloc();
+
+        Uint64 start = StartupTrace::now();
+        StartupTrace::begin("attach loaders");
+        SSBApp::attachLoaders(_assets);
+        StartupTrace::end("attach loaders");
+        addTime("attach loaders", start, StartupTrace::now());
+
+        start = StartupTrace::now();
+        StartupTrace::begin("load " LOADING_DIRECTORY);
+        if (!_assets->loadDirectory(LOADING_DIRECTORY) && _run == 0) {
+            printf("    error: could not load %s\n", LOADING_DIRECTORY);
+            _failures++;
+        }
+        StartupTrace::end("load " LOADING_DIRECTORY);
+        addTime("load " LOADING_DIRECTORY, start, StartupTrace::now());
+
+        _loadStart = StartupTrace::now();
+        StartupTrace::begin("load " ASSETS_DIRECTORY);
+        _assets->loadDirectoryAsync(ASSETS_DIRECTORY, nullptr);
+    }
+
+    /** Ends the current run, once the asynchronous load is complete */
+    void finishRun() {
+        Uint64 end = StartupTrace::now();
+        StartupTrace::end("load " ASSETS_DIRECTORY);
+        addTime("load " ASSETS_DIRECTORY, _loadStart, end);
+        addTime("total", _runStart, end);
+        StartupTrace::end("cold start");
+
+        if (_run == 0) {
+            StartupTrace::finish(_trace);
+        }
+        _assets->unloadAll();
+        _assets = nullptr;
+        _run++;
+    }
+
+    /** Prints the cold run and the median of every phase, and checks the baseline */
+    void report() {
+        std::shared_ptr<JsonValue> limits;
+        float tolerance = 1.25f;
+        if (!_baseline.empty()) {
+            std::shared_ptr<JsonReader> reader = JsonReader::alloc(_baseline);
+            limits = reader == nullptr ? nullptr : reader->readJson();
+            if (limits == nullptr || limits->get("phases") == nullptr) {
+                printf("    error: could not read baseline %s\n", _baseline.c_str());
+                _failures++;
+                limits = nullptr;
+            } else {
+                tolerance = limits->getFloat("tolerance", tolerance);
+            }
+        }
+
+        std::shared_ptr<JsonValue> medians = JsonValue::allocObject();
+        printf("%-28s %10s %10s %10s\n", "phase", "cold ms", "median ms", "baseline");
+        for (auto& name : _phases) {
+            std::vector<float> sorted = _times[name];
+            std::sort(sorted.begin(), sorted.end());
+            float median = sorted[sorted.size() / 2];
+            medians->appendValue(name, (double)median);
+
+            std::string limit = "-";
+            if (limits != nullptr && limits->get("phases")->has(name)) {
+                float expected = limits->get("phases")->getFloat(name);
+                char text[32];
+                snprintf(text, sizeof(text), "%.1f", expected);
+                limit = text;
+                if (median > expected * tolerance) {
+                    limit += " SLOWER";
+                    _failures++;
+                }
+            }
+            printf("%-28s %10.1f %10.1f %10s\n", name.c_str(), _times[name][0], median, limit.c_str());
+        }
+
+        if (!_output.empty()) {
+            std::shared_ptr<JsonValue> json = JsonValue::allocObject();
+            json->appendValue("tolerance", (double)tolerance);
+            json->appendChild("phases", medians);
+            std::shared_ptr<JsonWriter> writer = JsonWriter::alloc(_output);
+            if (writer == nullptr) {
+                printf("    error: could not write %s\n", _output.c_str());
+                _failures++;
+            } else {
+                writer->writeJson(json);
+                writer->close();
+            }
+        }
+    }
+
+public:
+    /**
+     * Creates the benchmark with the given options.
+     *
+     * @param runs      The number of runs
+     * @param trace     The file to write the first run to (empty for none)
+     * @param baseline  The baseline to compare with (empty for none)
+     * @param output    The file to write the medians to (empty for none)
+     */
+    StartBench(int runs, const std::string& trace, const std::string& baseline, const std::string& output) :
+    Application(), _runs(runs), _trace(trace), _baseline(baseline), _output(output),
+    _run(0), _runStart(0), _loadStart(0), _failures(0) {}
+
+    /** Returns the number of problems found */
+    int getFailures() const { return _failures; }
+
+    /**
+     * Starts the audio engine, as the game does, and the first run.
+     */
+    virtual void onStartup() override {
+        AudioEngine::start();
+        startRun();
+        Application::onStartup();
+    }
+
+    /**
+     * Releases the assets of an unfinished run, and stops the audio engine.
+     */
+    virtual void onShutdown() override {
+        _assets = nullptr;
+        AudioEngine::stop();
+        Application::onShutdown();
+    }
+
+    /**
+     * Finishes the current run once its assets are loaded.
+     *
+     * The textures decoded by the pool are created in callbacks the
+     * application runs between frames, so a run spans several frames.
+     *
+     * @param dt    The amount of time (in seconds) since the last frame
+     */
+    virtual void update(float dt) override {
+        if (_assets == nullptr || _assets->progress() < 1) {
+            return;
+        }
+        finishRun();
+        if (_run < _runs) {
+            startRun();
+        } else {
+            report();
+            quit();
+        }
+    }
+
+    /**
+     * Draws nothing; the benchmark only loads.
+     */
+    virtual void draw() override {}
+};
+
+int main(int argc, char* argv[]) {
+    std::string trace;
+    std::string baseline;
+    std::string output;
+    int runs = 5;
+    for (int ii = 1; ii < argc; ii++) {
+        std::string arg = argv[ii];
+        if (arg == "-n" && ii + 1 < argc) {
+            runs = std::max(1, atoi(argv[++ii]));
+        } else if (arg == "-t" && ii + 1 < argc) {
+            trace = argv[++ii];
+        } else if (arg == "-b" && ii + 1 < argc) {
+            baseline = argv[++ii];
+        } else if (arg == "-w" && ii + 1 < argc) {
+            output = argv[++ii];
+        } else {
+            fprintf(stderr, "usage: startbench [-n runs] [-t trace.json] [-b baseline.json] [-w baseline.json]\n");
+            return 1;
+        }
+    }
+
+    StartBench app(runs, trace, baseline, output);
+    app.setName("Sweet Sweet Betrayal Startup Benchmark");
+    app.setOrganization("GDIAC");
+    app.setDisplaySize(320, 180);
+    app.setFPS(60.0f);
+    if (!app.init()) {
+        return 1;
+    }
+
+    app.onStartup();
+    while (app.step());
+    app.onShutdown();
+    return app.getFailures() > 0 ? 1 : 0;
+}
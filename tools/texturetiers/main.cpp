@@ -0,0 +1,195 @@
+//
+//  main.cpp
+//  SweetSweetBetrayal Texture Tiers
+//
+//  A command line tool that writes reduced variants of large textures. See
+//  tools/README.md for how to build it (it only needs CUGL, for JSON and
+//  SDL_image); no window is ever opened.
+//
+//  Usage: texturetiers [-c tiers.json] [assetdir]
+//
+//  The config (default: tiers.json next to this file) names each texture to
+//  reduce with the height it is drawn at in design units, the design size of
+//  the scenes, the scales to write, and the asset directories to find the
+//  textures in. Each variant is written to assetdir/textures/tiers/<percent>/,
+//  and the variants of every texture to assetdir/json/tiers.json, which
+//  TieredTextureLoader reads at startup to pick a tier for the display. The
+//  directories are not changed: reduced textures keep their keys. The
+//  textures/tiers/<percent> directories must already exist.
+//
+//  Each halving is a 2x2 box filter weighted by alpha, so transparent pixels
+//  never darken the edges of opaque ones.
+//
+
+#include <cugl/cugl.h>
+#include <SDL_image.h>
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace cugl;
+
+/** Returns the file name without its directory */
+static std::string baseName(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+/** Returns a new RGBA32 surface with half the size of the given one */
+static SDL_Surface* halve(SDL_Surface* image) {
+    int w = std::max(1, image->w / 2);
+    int h = std::max(1, image->h / 2);
+    SDL_Surface* result = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA32);
+    if (result == nullptr) {
+        return nullptr;
+    }
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            int color[3] = { 0, 0, 0 };
+            int alpha = 0;
+            for (int dy = 0; dy < 2; dy++) {
+                for (int dx = 0; dx < 2; dx++) {
+                    int sx = std::min(2 * x + dx, image->w - 1);
+                    int sy = std::min(2 * y + dy, image->h - 1);
+                    Uint8* src = (Uint8*)image->pixels + sy * image->pitch + sx * 4;
+                    for (int cc = 0; cc < 3; cc++) {
+                        color[cc] += src[cc] * src[3];
+                    }
+                    alpha += src[3];
+                }
+            }
+            Uint8* dst = (Uint8*)result->pixels + y * result->pitch + x * 4;
+            for (int cc = 0; cc < 3; cc++) {
+                dst[cc] = alpha > 0 ? (Uint8)(color[cc] / alpha) : 0;
+            }
+            dst[3] = (Uint8)((alpha + 2) / 4);
+        }
+    }
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    std::string config = "tools/texturetiers/tiers.json";
+    std::string assets = "assets";
+    for (int ii = 1; ii < argc; ii++) {
+        std::string arg = argv[ii];
+        if (arg == "-c" && ii + 1 < argc) {
+            config = argv[++ii];
+        } else {
+            assets = arg;
+        }
+    }
+    if (!assets.empty() && assets.back() != '/') {
+        assets += "/";
+    }
+
+    std::shared_ptr<JsonReader> reader = JsonReader::alloc(config);
+    std::shared_ptr<JsonValue> tiers = reader == nullptr ? nullptr : reader->readJson();
+    if (tiers == nullptr || tiers->get("design") == nullptr || tiers->get("textures") == nullptr) {
+        fprintf(stderr, "usage: texturetiers [-c tiers.json] [assetdir]\n");
+        return 1;
+    }
+    std::vector<float> scales = { 0.5f, 0.25f };
+    if (tiers->get("tiers") != nullptr) {
+        scales = tiers->get("tiers")->asFloatArray();
+    }
+    std::vector<std::string> directories = { "json/assets.json" };
+    if (tiers->get("directories") != nullptr) {
+        directories = tiers->get("directories")->asStringArray();
+    }
+
+    // Find the file of every texture in the directories
+    std::map<std::string, std::string> files;
+    for (auto& directory : directories) {
+        reader = JsonReader::alloc(assets + directory);
+        std::shared_ptr<JsonValue> json = reader == nullptr ? nullptr : reader->readJson();
+        if (json == nullptr || json->get("textures") == nullptr) {
+            printf("    error: could not read textures from %s%s\n", assets.c_str(), directory.c_str());
+            continue;
+        }
+        for (auto& texture : json->get("textures")->children()) {
+            files[texture->key()] = texture->isString() ? texture->asString() : texture->getString("file");
+        }
+    }
+
+    std::shared_ptr<JsonValue> manifest = JsonValue::allocObject();
+    std::shared_ptr<JsonValue> design = JsonValue::allocArray();
+    design->appendValue((double)tiers->get("design")->get(0)->asFloat());
+    design->appendValue((double)tiers->get("design")->get(1)->asFloat());
+    manifest->appendChild("design", design);
+    std::shared_ptr<JsonValue> textures = JsonValue::allocObject();
+    int failures = 0;
+    printf("%-24s %11s %8s %10s\n", "texture", "size", "display", "variants");
+    for (auto& entry : tiers->get("textures")->children()) {
+        std::string key = entry->key();
+        if (files.find(key) == files.end() || files[key].empty()) {
+            printf("    error: %s is not in any directory\n", key.c_str());
+            failures++;
+            continue;
+        }
+        std::string file = files[key];
+        SDL_Surface* loaded = IMG_Load((assets + file).c_str());
+        SDL_Surface* image = loaded == nullptr ? nullptr : SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+        if (loaded != nullptr) {
+            SDL_FreeSurface(loaded);
+        }
+        if (image == nullptr) {
+            printf("    error: could not read %s\n", file.c_str());
+            failures++;
+            continue;
+        }
+
+        // Halve the image down to each scale, smallest last
+        std::shared_ptr<JsonValue> variants = JsonValue::allocObject();
+        SDL_Surface* current = image;
+        float size = 1.0f;
+        for (float scale : scales) {
+            while (size > scale && current != nullptr) {
+                SDL_Surface* next = halve(current);
+                if (current != image) {
+                    SDL_FreeSurface(current);
+                }
+                current = next;
+                size /= 2;
+            }
+            if (current == nullptr) {
+                break;
+            }
+            char percent[8];
+            snprintf(percent, sizeof(percent), "%d", (int)(scale * 100));
+            char label[8];
+            snprintf(label, sizeof(label), "%g", scale);
+            std::string variant = "textures/tiers/" + std::string(percent) + "/" + baseName(file);
+            if (IMG_SavePNG(current, (assets + variant).c_str()) != 0) {
+                printf("    error: could not write %s%s\n", assets.c_str(), variant.c_str());
+                failures++;
+                continue;
+            }
+            variants->appendValue(label, variant);
+        }
+        if (current != nullptr && current != image) {
+            SDL_FreeSurface(current);
+        }
+
+        std::shared_ptr<JsonValue> tiered = JsonValue::allocObject();
+        tiered->appendValue("height", (long)image->h);
+        tiered->appendValue("display", (double)entry->asFloat());
+        tiered->appendChild("variants", variants);
+        textures->appendChild(key, tiered);
+        printf("%-24s %5dx%-5d %8g %10zu\n", key.c_str(), image->w, image->h, entry->asFloat(), variants->size());
+        SDL_FreeSurface(image);
+    }
+    manifest->appendChild("textures", textures);
+
+    std::shared_ptr<JsonWriter> writer = JsonWriter::alloc(assets + "json/tiers.json");
+    if (writer == nullptr) {
+        printf("    error: could not write %sjson/tiers.json\n", assets.c_str());
+        failures++;
+    } else {
+        writer->writeJson(manifest);
+        writer->close();
+    }
+    return failures > 0 ? 1 : 0;
+}